@@ -9,8 +9,9 @@ namespace Poly
 	/// <summary>
 	/// Dynarray is a vector based container thet allocates its memory in one, continous block.
 	/// This should be the goto container for all general purpose usage.
+	/// Memory is obtained from Allocator policy, see <see cref="HeapAllocator"/> and <see cref="FrameAllocator"/>.
 	/// </summary>
-	template<typename T>
+	template<typename T, typename Allocator = HeapAllocator>
 	class Dynarray final : public BaseObjectLiteralType<>
 	{
 	public:
@@ -47,7 +48,7 @@ namespace Poly
 
 			size_t Idx = 0;
 			T* Data = nullptr;
-			friend class Dynarray<T>;
+			friend class Dynarray;
 		};
 
 		/// <summary>Dynarray's ConstIterator class provides basic random access const iterator API for traversing dynarray memory</summary>
@@ -80,7 +81,7 @@ namespace Poly
 
 			size_t Idx = 0;
 			const T* Data = nullptr;
-			friend class Dynarray<T>;
+			friend class Dynarray;
 		};
 
 		/// <summary>Base dynarray constructor that creates empty object with capacity == 0.</summary>
@@ -96,11 +97,11 @@ namespace Poly
 
 		/// <summary>Basic copy constructor</summary>
 		/// <param name="rhs">Reference to Dynarray instance which state should be copied.</param>
-		Dynarray(const Dynarray<T>& rhs) { Copy(rhs); }
+		Dynarray(const Dynarray& rhs) { Copy(rhs); }
 
 		/// <summary>Basic move constructor</summary>
 		/// <param name="rhs">R-value reference to Dynarray instance which state should be moved.</param>
-		Dynarray(Dynarray<T>&& rhs) { Move(std::forward<Dynarray<T>>(rhs)); }
+		Dynarray(Dynarray&& rhs) { Move(std::forward<Dynarray>(rhs)); }
 
 		/// <summary>Basic destructor.</summary>
 		~Dynarray()
@@ -111,7 +112,7 @@ namespace Poly
 
 		/// <summary>Basic copy operator</summary>
 		/// <param name="rhs">Reference to Dynarray instance which state should be copied.</param>
-		Dynarray<T>& operator=(const Dynarray<T>& rhs)
+		Dynarray& operator=(const Dynarray& rhs)
 		{
 			Clear();
 			Copy(rhs);
@@ -120,17 +121,17 @@ namespace Poly
 
 		/// <summary>Basic move operator</summary>
 		/// <param name="rhs">R-value reference to Dynarray instance which state should be moved.</param>
-		Dynarray<T>& operator=(Dynarray<T>&& rhs)
+		Dynarray& operator=(Dynarray&& rhs)
 		{
 			Clear();
 			Free();
-			Move(std::forward<Dynarray<T>>(rhs));
+			Move(std::forward<Dynarray>(rhs));
 			return *this;
 		}
 
 		/// <summary>Clears current dynarray content and populates it with content from initializer list.</summary>
 		/// <param name="list"></param>
-		Dynarray<T>& operator=(const std::initializer_list<T>& list)
+		Dynarray& operator=(const std::initializer_list<T>& list)
 		{
 			Clear();
 			PopulateFromInitializerList(list);
@@ -140,7 +141,7 @@ namespace Poly
 		/// <summary>Equal comparison operator with other dynarray.</summary>
 		/// <returns>True if size of the containers match and objects represented by both containers
 		/// are identical and in the same order, false otherwise.</returns>
-		bool operator==(const Dynarray<T>& rhs) const
+		bool operator==(const Dynarray& rhs) const
 		{
 			if (GetSize() != rhs.GetSize())
 				return false;
@@ -154,7 +155,7 @@ namespace Poly
 
 		/// <summary>Not-equal comparison operator with other dynarray.</summary>
 		/// <returns>bool True when equal operator returns false, false otherwise.</returns>
-		bool operator!=(const Dynarray<T>& rhs) const { return !(*this == rhs); };
+		bool operator!=(const Dynarray& rhs) const { return !(*this == rhs); };
 
 		/// <summary>Checks whether dynarray is empty.</summary>
 		/// <returns>True if is empty, false otherwise.</returns>
@@ -208,8 +209,13 @@ namespace Poly
 			HEAVY_ASSERTE(idx <= GetSize(), "Index out of bounds!");
 			if (Size == GetCapacity())
 				Enlarge();
-			MoveDataRight(idx, Size, 1);
-			ObjectLifetimeHelper::CopyCreate(Data + idx, obj);
+			if (idx == Size)
+				ObjectLifetimeHelper::CopyCreate(Data + idx, obj);
+			else
+			{
+				MakeGapAt(idx);
+				Data[idx] = obj;
+			}
 			++Size;
 		}
 
@@ -225,8 +231,13 @@ namespace Poly
 			HEAVY_ASSERTE(idx <= GetSize(), "Index out of bounds!");
 			if (Size == GetCapacity())
 				Enlarge();
-			MoveDataRight(idx, Size, 1);
-			ObjectLifetimeHelper::MoveCreate(Data + idx, std::move(obj));
+			if (idx == Size)
+				ObjectLifetimeHelper::MoveCreate(Data + idx, std::move(obj));
+			else
+			{
+				MakeGapAt(idx);
+				Data[idx] = std::move(obj);
+			}
 			++Size;
 		}
 
@@ -239,9 +250,9 @@ namespace Poly
 		void RemoveByIdx(size_t idx)
 		{
 			HEAVY_ASSERTE(idx < GetSize(), "Index out of bounds!");
-			ObjectLifetimeHelper::Destroy(Data + idx);
+			// shifted elements are move assigned to live objects, only the last one is destroyed
 			MoveDataLeft(idx + 1, Size, 1);
-			//std::move(Begin() + idx + 1, End(), Begin() + idx);
+			ObjectLifetimeHelper::Destroy(Data + Size - 1);
 			--Size;
 		}
 
@@ -420,7 +431,7 @@ namespace Poly
 			return false;
 		}
 
-		friend std::ostream& operator<< (std::ostream& stream, const Dynarray<T>& rhs)
+		friend std::ostream& operator<< (std::ostream& stream, const Dynarray& rhs)
 		{
 			stream << "Dynarray[ ";
 			for (size_t i = 0; i < rhs.GetSize(); ++i)
@@ -433,7 +444,7 @@ namespace Poly
 		void Realloc(size_t capacity)
 		{
 			HEAVY_ASSERTE(Size <= capacity, "Invalid resize capacity!");
-			T* newData = Allocate<T>(capacity);
+			T* newData = Allocator::template Allocate<T>(capacity);
 
 			// move all elements
 			for (size_t i = 0; i < Size; ++i)
@@ -442,15 +453,15 @@ namespace Poly
 				ObjectLifetimeHelper::Destroy(Data + i);
 			}
 
-			Deallocate(Data);
+			Allocator::Deallocate(Data);
 			Data = newData;
 			Capacity = capacity;
 		}
 
-		void Free() { if (Data) Deallocate(Data); }
+		void Free() { if (Data) Allocator::Deallocate(Data); }
 
 		//------------------------------------------------------------------------------
-		void Copy(const Dynarray<T>& rhs)
+		void Copy(const Dynarray& rhs)
 		{
 			Reserve(rhs.GetSize());
 			for (size_t idx = 0; idx < rhs.GetSize(); ++idx)
@@ -458,7 +469,7 @@ namespace Poly
 		}
 
 		//------------------------------------------------------------------------------
-		void Move(Dynarray<T>&& rhs)
+		void Move(Dynarray&& rhs)
 		{
 			Size = rhs.Size;
 			Capacity = rhs.Capacity;
@@ -475,6 +486,14 @@ namespace Poly
 				Data[currPos + size - 1] = std::move(Data[currPos - 1]);
 		}
 
+		//------------------------------------------------------------------------------
+		void MakeGapAt(size_t idx)
+		{
+			// last element is moved to uninitialized memory, the rest is move assigned to live objects
+			ObjectLifetimeHelper::MoveCreate(Data + Size, std::move(Data[Size - 1]));
+			MoveDataRight(idx, Size - 1, 1);
+		}
+
 		//------------------------------------------------------------------------------
 		void MoveDataLeft(size_t start, size_t end, size_t size)
 		{
@@ -498,8 +517,8 @@ namespace Poly
 	};
 
 	// std library for each enablers
-	template <typename T> typename Poly::Dynarray<T>::Iterator begin(Poly::Dynarray<T>& rhs) { return rhs.Begin(); }
-	template <typename T> typename Poly::Dynarray<T>::Iterator end(Poly::Dynarray<T>& rhs) { return rhs.End(); }
-	template <typename T> typename Poly::Dynarray<T>::ConstIterator begin(const Poly::Dynarray<T>& rhs) { return rhs.Begin(); }
-	template <typename T> typename Poly::Dynarray<T>::ConstIterator end(const Poly::Dynarray<T>& rhs) { return rhs.End(); }
+	template <typename T, typename A> typename Poly::Dynarray<T, A>::Iterator begin(Poly::Dynarray<T, A>& rhs) { return rhs.Begin(); }
+	template <typename T, typename A> typename Poly::Dynarray<T, A>::Iterator end(Poly::Dynarray<T, A>& rhs) { return rhs.End(); }
+	template <typename T, typename A> typename Poly::Dynarray<T, A>::ConstIterator begin(const Poly::Dynarray<T, A>& rhs) { return rhs.Begin(); }
+	template <typename T, typename A> typename Poly::Dynarray<T, A>::ConstIterator end(const Poly::Dynarray<T, A>& rhs) { return rhs.End(); }
 }
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "Collections/HashTable.hpp"
+#include "Utils/Optional.hpp"
+
+namespace Poly
+{
+	/**
+	 * <summary>
+	 * An unordered map storing key-value pairs directly in one open addressing table.
+	 * </summary>
+	 *
+	 * <typeparam name="K">Key type, must be equality comparable</typeparam>
+	 * <typeparam name="V">Value type</typeparam>
+	 * <typeparam name="Hasher">Hash function object, <c>std::hash&lt;K&gt;</c> by default</typeparam>
+	 *
+	 * Lookups compare keys only for slots with matching hash bits, found with SIMD, which makes it much faster than <see cref="OrderedMap<K, V>"/>.
+	 * Insertion and removal invalidate iterators and references to values, same as in <see cref="Dynarray<T>"/>.
+	 */
+	template<typename K, typename V, typename Hasher = std::hash<K>>
+	class HashMap final : public BaseObjectLiteralType<>
+	{
+		using Slot = Impl::HashMapSlot<K, V>;
+		using Table = Impl::HashTable<K, Slot, Hasher>;
+		template<typename RetKV, typename MapPtr> class IteratorBase;
+	public:
+		struct ConstKV final
+		{
+			const K& key;
+			const V& value;
+			const ConstKV* operator->() const { return this; }
+		};
+		struct KV final
+		{
+			const K& key;
+			V& value;
+			KV* operator->() { return this; }
+		};
+		using ConstIterator = IteratorBase<ConstKV, const HashMap*>;
+		using Iterator = IteratorBase<KV, HashMap*>;
+
+		/// <summary>Constructs a new, empty <c>HashMap<K, V></c>. The map will not allocate until elements are inserted into it. </summary>
+		HashMap() = default;
+
+		/**
+		 * <summary>Inserts a key-value pair into the map. Updates the value if the key was already present.</summary>
+		 * <param name="key"></param>
+		 * <param name="value"></param>
+		 * <returns>The old value if it was present.</returns>
+		 */
+		Optional<V> Insert(const K&  key, const V&  value) { return InsertPimple(          key ,           value ); }
+		Optional<V> Insert(const K&  key,       V&& value) { return InsertPimple(          key , std::move(value)); }
+		Optional<V> Insert(      K&& key, const V&  value) { return InsertPimple(std::move(key),           value ); }
+		Optional<V> Insert(      K&& key,       V&& value) { return InsertPimple(std::move(key), std::move(value)); }
+
+		/**
+		 * <summary>Inserts a key-value pair into the map. Panics if the key was already present.</summary>
+		 * <param name="key"></param>
+		 * <param name="value"></param>
+		 */
+		void MustInsert(const K&  key, const V&  value) { MustInsertPimple(          key ,           value ); }
+		void MustInsert(const K&  key,       V&& value) { MustInsertPimple(          key , std::move(value)); }
+		void MustInsert(      K&& key, const V&  value) { MustInsertPimple(std::move(key),           value ); }
+		void MustInsert(      K&& key,       V&& value) { MustInsertPimple(std::move(key), std::move(value)); }
+
+		/**
+		 * <summary>Ensures a value is in the map by inserting if the key is not present.</summary>
+		 * <param name="key"></param>
+		 * <param name="value">A value to insert if the key is not present.</param>
+		 * <returns>Reference to the value in the map.</returns>
+		 */
+		V& GetOrInsert(const K& key, const V&  value) { return table.GetSlot(table.TryEmplace(key, value).first).Value; }
+		V& GetOrInsert(const K& key,       V&& value) { return table.GetSlot(table.TryEmplace(key, std::move(value)).first).Value; }
+
+		/**
+		 * <summary>Removes a key from the map.</summary>
+		 * <param name="key"></param>
+		 * <returns>Value at key if it was present in the map.</returns>
+		 */
+		Optional<V> Remove(const K& key)
+		{
+			const size_t idx = table.Find(key);
+			if (idx == Table::NPOS)
+				return {};
+
+			V old = std::move(table.GetSlot(idx).Value);
+			table.EraseAt(idx);
+			return {std::move(old)};
+		}
+
+		/**
+		 * <summary>Removes a key from the map. Panics if the key is not present in the map.</summary>
+		 * <param name="key"></param>
+		 * <returns>Value at key.</returns>
+		 */
+		V MustRemove(const K& key) { Optional<V> old = Remove(key); ASSERTE(old.HasValue(), "Key not present in the map!"); return old.TakeValue(); }
+
+		/**
+		 * <summary>Get a reference to the value at key.</summary>
+		 * <param name="key"></param>
+		 * <returns>The reference if the keys is in the map.</returns>
+		 */
+		Optional<V&> Get(const K& key)
+		{
+			const size_t idx = table.Find(key);
+			if (idx == Table::NPOS)
+				return {};
+			return {table.GetSlot(idx).Value};
+		}
+		Optional<const V&> Get(const K& key) const
+		{
+			const size_t idx = table.Find(key);
+			if (idx == Table::NPOS)
+				return {};
+			return {table.GetSlot(idx).Value};
+		}
+
+		      V& operator[](const K& key)       { return Get(key).Value(); }
+		const V& operator[](const K& key) const { return Get(key).Value(); }
+
+		/// <returns>True if the key is in the map.</returns>
+		bool Contains(const K& key) const { return table.Find(key) != Table::NPOS; }
+
+		/// <returns>The number of elements in the map.</returns>
+		size_t GetSize() const { return table.GetSize(); }
+		/// <returns>True if the map contains no elements.</returns>
+		bool IsEmpty() const { return GetSize() == 0; }
+		/// <returns>The number of slots, map rehashes when 7/8 of them are used.</returns>
+		size_t GetCapacity() const { return table.GetCapacity(); }
+
+		/// <summary>Clears the map, removing all elements. Keeps allocated memory.</summary>
+		void Clear() { table.Clear(); }
+
+		/// <summary>Reserves memory, so given number of elements can be inserted without rehashing.</summary>
+		void Reserve(size_t count) { table.Reserve(count); }
+
+		ConstIterator cbegin() const { return ConstIterator(this, table.NextFull(0)); }
+		ConstIterator cend() const { return ConstIterator(this, table.GetCapacity()); }
+
+		ConstIterator begin() const { return cbegin(); }
+		ConstIterator end()   const { return cend();   }
+
+		Iterator begin() { return Iterator(this, table.NextFull(0)); }
+		Iterator end()   { return Iterator(this, table.GetCapacity()); }
+
+		/// <summary>Swaps the contents of this map with the other map.</summary>
+		void Swap(HashMap& other) { table.Swap(other.table); }
+
+	private:
+		template<typename Key, typename Val>
+		Optional<V> InsertPimple(Key&& key, Val&& value)
+		{
+			const size_t idx = table.Find(key);
+			if (idx != Table::NPOS)
+			{
+				V old = std::move(table.GetSlot(idx).Value);
+				table.GetSlot(idx).Value = std::forward<Val>(value);
+				return {std::move(old)};
+			}
+
+			table.TryEmplace(std::forward<Key>(key), std::forward<Val>(value));
+			return {};
+		}
+
+		template<typename Key, typename Val>
+		void MustInsertPimple(Key&& key, Val&& value)
+		{
+			const bool inserted = table.TryEmplace(std::forward<Key>(key), std::forward<Val>(value)).second;
+			ASSERTE(inserted, "Key already present in the map!");
+			UNUSED(inserted);
+		}
+
+		template<typename RetKV, typename MapPtr>
+		class IteratorBase final : public BaseObjectLiteralType<>, public std::iterator<std::forward_iterator_tag, RetKV>
+		{
+		public:
+			bool operator==(const IteratorBase& other) const { return Idx == other.Idx; }
+			bool operator!=(const IteratorBase& other) const { return !(*this == other); }
+
+			RetKV operator*() const { auto& slot = Map->table.GetSlot(Idx); return RetKV{slot.Key, slot.Value}; }
+			RetKV operator->() const { return **this; }
+
+			IteratorBase& operator++() { Idx = Map->table.NextFull(Idx + 1); return *this; }
+			IteratorBase operator++(int) { IteratorBase ret(Map, Idx); ++(*this); return ret; }
+		private:
+			IteratorBase(MapPtr map, size_t idx) : Map(map), Idx(idx) {}
+
+			MapPtr Map;
+			size_t Idx;
+			friend class HashMap;
+		};
+
+		Table table;
+	};
+}
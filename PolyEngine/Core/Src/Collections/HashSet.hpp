@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "Collections/HashTable.hpp"
+
+namespace Poly
+{
+	/**
+	 * <summary>
+	 * An unordered set of unique keys stored in one open addressing table.
+	 * </summary>
+	 *
+	 * <typeparam name="K">Key type, must be equality comparable</typeparam>
+	 * <typeparam name="Hasher">Hash function object, <c>std::hash&lt;K&gt;</c> by default</typeparam>
+	 *
+	 * <seealso cref="HashMap<K, V>"/>
+	 */
+	template<typename K, typename Hasher = std::hash<K>>
+	class HashSet final : public BaseObjectLiteralType<>
+	{
+		using Slot = Impl::HashSetSlot<K>;
+		using Table = Impl::HashTable<K, Slot, Hasher>;
+	public:
+		class ConstIterator final : public BaseObjectLiteralType<>, public std::iterator<std::forward_iterator_tag, K>
+		{
+		public:
+			bool operator==(const ConstIterator& other) const { return Idx == other.Idx; }
+			bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+
+			const K& operator*() const { return Set->table.GetSlot(Idx).Key; }
+			const K* operator->() const { return &**this; }
+
+			ConstIterator& operator++() { Idx = Set->table.NextFull(Idx + 1); return *this; }
+			ConstIterator operator++(int) { ConstIterator ret(Set, Idx); ++(*this); return ret; }
+		private:
+			ConstIterator(const HashSet* set, size_t idx) : Set(set), Idx(idx) {}
+
+			const HashSet* Set;
+			size_t Idx;
+			friend class HashSet;
+		};
+
+		/// <summary>Constructs a new, empty <c>HashSet<K></c>. The set will not allocate until elements are inserted into it. </summary>
+		HashSet() = default;
+
+		/// <summary>Inserts a key into the set.</summary>
+		/// <returns>True if the key was not present before.</returns>
+		bool Insert(const K&  key) { return table.TryEmplace(key).second; }
+		bool Insert(      K&& key) { return table.TryEmplace(std::move(key)).second; }
+
+		/// <summary>Removes a key from the set.</summary>
+		/// <returns>True if the key was present.</returns>
+		bool Remove(const K& key)
+		{
+			const size_t idx = table.Find(key);
+			if (idx == Table::NPOS)
+				return false;
+			table.EraseAt(idx);
+			return true;
+		}
+
+		/// <returns>True if the key is in the set.</returns>
+		bool Contains(const K& key) const { return table.Find(key) != Table::NPOS; }
+
+		/// <returns>The number of elements in the set.</returns>
+		size_t GetSize() const { return table.GetSize(); }
+		/// <returns>True if the set contains no elements.</returns>
+		bool IsEmpty() const { return GetSize() == 0; }
+		/// <returns>The number of slots, set rehashes when 7/8 of them are used.</returns>
+		size_t GetCapacity() const { return table.GetCapacity(); }
+
+		/// <summary>Clears the set, removing all elements. Keeps allocated memory.</summary>
+		void Clear() { table.Clear(); }
+
+		/// <summary>Reserves memory, so given number of elements can be inserted without rehashing.</summary>
+		void Reserve(size_t count) { table.Reserve(count); }
+
+		ConstIterator begin() const { return ConstIterator(this, table.NextFull(0)); }
+		ConstIterator end()   const { return ConstIterator(this, table.GetCapacity()); }
+
+		/// <summary>Swaps the contents of this set with the other set.</summary>
+		void Swap(HashSet& other) { table.Swap(other.table); }
+
+	private:
+		Table table;
+	};
+}
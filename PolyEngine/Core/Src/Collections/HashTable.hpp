@@ -0,0 +1,307 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "Memory/Allocator.hpp"
+#include "Memory/ObjectLifetimeHelpers.hpp"
+#include "Math/BasicMath.hpp"
+#include "Math/SimdMath.hpp"
+
+namespace Poly
+{
+	namespace Impl
+	{
+		template<typename K, typename V>
+		struct HashMapSlot
+		{
+			K Key;
+			V Value;
+		};
+
+		template<typename K>
+		struct HashSetSlot
+		{
+			K Key;
+		};
+
+		/**
+		 * <summary>
+		 * Open addressing hash table shared by <see cref="HashMap"/> and <see cref="HashSet"/>.
+		 * </summary>
+		 *
+		 * Every slot has a control byte, which is either EMPTY, DELETED or 7 bits of key's hash.
+		 * Control bytes are grouped by 16, so one SIMD comparison finds all candidate slots of a group,
+		 * and keys are compared only for slots with matching hash bits.
+		 * Groups are probed quadratically, probing stops at the first group with an EMPTY slot.
+		 * Table grows when 7/8 of slots are used, removal leaves DELETED marker only in groups without EMPTY slots.
+		 *
+		 * <typeparam name="K">Key type</typeparam>
+		 * <typeparam name="Slot">Stored type, must have member <c>Key</c></typeparam>
+		 * <typeparam name="Hasher">Hash function object</typeparam>
+		 */
+		template<typename K, typename Slot, typename Hasher>
+		class HashTable final : public BaseObjectLiteralType<>
+		{
+			static_assert(alignof(Slot) <= MEM_ALIGNMENT, "Slots with alignment stronger than allocator's one are not supported.");
+		public:
+			static constexpr size_t GROUP_SIZE = 16;
+			static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+
+			HashTable() = default;
+			HashTable(const HashTable& other)
+			{
+				if (other.Capacity == 0)
+					return;
+
+				AllocateTable(other.Capacity);
+				memcpy(Control, other.Control, Capacity);
+				for (size_t i = 0; i < Capacity; ++i)
+					if (IsFull(i))
+						ObjectLifetimeHelper::CopyCreate(Slots + i, other.Slots[i]);
+				Size = other.Size;
+				GrowthLeft = other.GrowthLeft;
+			}
+			HashTable(HashTable&& other) { Swap(other); }
+			~HashTable() { Free(); }
+
+			HashTable& operator=(const HashTable& other) { HashTable copy(other); Swap(copy); return *this; }
+			HashTable& operator=(HashTable&& other) { Free(); Swap(other); return *this; }
+
+			/// <returns>Index of slot with given key or NPOS if there is none.</returns>
+			size_t Find(const K& key) const
+			{
+				if (Size == 0)
+					return NPOS;
+
+				const u64 hash = Hash(key);
+				const u8 h2 = GetH2(hash);
+				size_t group = GetH1(hash) & GroupMask;
+				for (size_t step = 1;; ++step)
+				{
+					for (u32 match = MatchByte(group, h2); match != 0; match &= match - 1)
+					{
+						const size_t idx = group * GROUP_SIZE + CountTrailingZeros(match);
+						if (Slots[idx].Key == key)
+							return idx;
+					}
+
+					if (MatchByte(group, EMPTY) != 0)
+						return NPOS;
+					group = (group + step) & GroupMask;
+				}
+			}
+
+			/**
+			 * <summary>Finds slot with given key, constructs a new one when key is not present.</summary>
+			 * <param name="key">Searched key, moved into the new slot if it is inserted.</param>
+			 * <param name="args">Remaining members of the new slot, not used when key is already present.</param>
+			 * <returns>Index of the slot and true if it was inserted.</returns>
+			 */
+			template<typename Key, typename... Args>
+			std::pair<size_t, bool> TryEmplace(Key&& key, Args&&... args)
+			{
+				const size_t found = Find(key);
+				if (found != NPOS)
+					return std::make_pair(found, false);
+
+				// table full of DELETED markers is cleaned up without growing
+				if (GrowthLeft == 0)
+					Rehash(Size * 32 <= Capacity * 25 ? (Capacity > 0 ? Capacity : GROUP_SIZE) : Capacity * 2);
+
+				const u64 hash = Hash(key);
+				const size_t idx = FindFreeSlot(hash);
+				if (Control[idx] == EMPTY)
+					--GrowthLeft;
+				Control[idx] = GetH2(hash);
+				++Size;
+				new(Slots + idx) Slot{ std::forward<Key>(key), std::forward<Args>(args)... };
+				return std::make_pair(idx, true);
+			}
+
+			/// <summary>Destroys slot at given index.</summary>
+			void EraseAt(size_t idx)
+			{
+				HEAVY_ASSERTE(idx < Capacity && IsFull(idx), "Erasing empty slot!");
+				ObjectLifetimeHelper::Destroy(Slots + idx);
+				--Size;
+
+				// Probing never continues past a group with an EMPTY slot, so no key depends on this slot being occupied.
+				if (MatchByte(idx / GROUP_SIZE, EMPTY) != 0)
+				{
+					Control[idx] = EMPTY;
+					++GrowthLeft;
+				}
+				else
+					Control[idx] = DELETED;
+			}
+
+			/// <summary>Destroys all slots, keeps allocated memory.</summary>
+			void Clear()
+			{
+				for (size_t i = 0; i < Capacity; ++i)
+					if (IsFull(i))
+						ObjectLifetimeHelper::Destroy(Slots + i);
+				if (Capacity > 0)
+					memset(Control, EMPTY, Capacity);
+				Size = 0;
+				GrowthLeft = GetMaxLoad(Capacity);
+			}
+
+			/// <summary>Makes sure that given number of elements fits without rehashing.</summary>
+			void Reserve(size_t count)
+			{
+				size_t capacity = GROUP_SIZE;
+				while (GetMaxLoad(capacity) < count)
+					capacity *= 2;
+				if (capacity > Capacity)
+					Rehash(capacity);
+			}
+
+			/// <returns>Index of first occupied slot at position >= idx or capacity if there is none.</returns>
+			size_t NextFull(size_t idx) const
+			{
+				while (idx < Capacity && !IsFull(idx))
+					++idx;
+				return idx;
+			}
+
+			bool IsFull(size_t idx) const { return (Control[idx] & EMPTY) == 0; }
+			Slot& GetSlot(size_t idx) { HEAVY_ASSERTE(idx < Capacity && IsFull(idx), "Accessing empty slot!"); return Slots[idx]; }
+			const Slot& GetSlot(size_t idx) const { HEAVY_ASSERTE(idx < Capacity && IsFull(idx), "Accessing empty slot!"); return Slots[idx]; }
+
+			size_t GetSize() const { return Size; }
+			size_t GetCapacity() const { return Capacity; }
+
+			void Swap(HashTable& other)
+			{
+				std::swap(Control, other.Control);
+				std::swap(Slots, other.Slots);
+				std::swap(Capacity, other.Capacity);
+				std::swap(GroupMask, other.GroupMask);
+				std::swap(Size, other.Size);
+				std::swap(GrowthLeft, other.GrowthLeft);
+			}
+
+		private:
+			static constexpr u8 EMPTY = 0x80;
+			static constexpr u8 DELETED = 0xFE;
+
+			struct alignas(GROUP_SIZE) ControlGroup
+			{
+				u8 Bytes[GROUP_SIZE];
+			};
+
+			static size_t GetMaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+			static u64 Hash(const K& key)
+			{
+				// std::hash of integers and pointers is identity, mix it so both parts of the hash are well distributed
+				u64 hash = static_cast<u64>(Hasher()(key));
+				hash ^= hash >> 33;
+				hash *= 0xff51afd7ed558ccdull;
+				hash ^= hash >> 33;
+				hash *= 0xc4ceb9fe1a85ec53ull;
+				hash ^= hash >> 33;
+				return hash;
+			}
+			static size_t GetH1(u64 hash) { return static_cast<size_t>(hash >> 7); }
+			static u8 GetH2(u64 hash) { return static_cast<u8>(hash & 0x7F); }
+
+			/// <returns>Bit mask of slots in the group with given control byte.</returns>
+			u32 MatchByte(size_t group, u8 value) const
+			{
+				const u8* bytes = Control + group * GROUP_SIZE;
+#if !DISABLE_SIMD
+				const __m128i ctrl = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+				return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(value)))));
+#else
+				u32 mask = 0;
+				for (size_t i = 0; i < GROUP_SIZE; ++i)
+					mask |= (bytes[i] == value ? 1u : 0u) << i;
+				return mask;
+#endif
+			}
+
+			/// <returns>Bit mask of EMPTY and DELETED slots in the group.</returns>
+			u32 MatchFree(size_t group) const
+			{
+				const u8* bytes = Control + group * GROUP_SIZE;
+#if !DISABLE_SIMD
+				// only EMPTY and DELETED have the highest bit set
+				return static_cast<u32>(_mm_movemask_epi8(_mm_load_si128(reinterpret_cast<const __m128i*>(bytes))));
+#else
+				u32 mask = 0;
+				for (size_t i = 0; i < GROUP_SIZE; ++i)
+					mask |= ((bytes[i] & EMPTY) != 0 ? 1u : 0u) << i;
+				return mask;
+#endif
+			}
+
+			size_t FindFreeSlot(u64 hash) const
+			{
+				size_t group = GetH1(hash) & GroupMask;
+				for (size_t step = 1;; ++step)
+				{
+					const u32 free = MatchFree(group);
+					if (free != 0)
+						return group * GROUP_SIZE + CountTrailingZeros(free);
+					group = (group + step) & GroupMask;
+				}
+			}
+
+			void AllocateTable(size_t capacity)
+			{
+				HEAVY_ASSERTE(capacity >= GROUP_SIZE && (capacity & (capacity - 1)) == 0, "Capacity must be a power of two not smaller than group size!");
+				// control bytes and slots share one allocation
+				const size_t slotGroups = (capacity * sizeof(Slot) + sizeof(ControlGroup) - 1) / sizeof(ControlGroup);
+				ControlGroup* memory = Allocate<ControlGroup>(capacity / GROUP_SIZE + slotGroups);
+				Control = memory[0].Bytes;
+				Slots = reinterpret_cast<Slot*>(memory + capacity / GROUP_SIZE);
+				memset(Control, EMPTY, capacity);
+				Capacity = capacity;
+				GroupMask = capacity / GROUP_SIZE - 1;
+				Size = 0;
+				GrowthLeft = GetMaxLoad(capacity);
+			}
+
+			void Rehash(size_t capacity)
+			{
+				HashTable table;
+				table.AllocateTable(capacity);
+				for (size_t i = 0; i < Capacity; ++i)
+				{
+					if (!IsFull(i))
+						continue;
+
+					const u64 hash = Hash(Slots[i].Key);
+					const size_t idx = table.FindFreeSlot(hash);
+					table.Control[idx] = GetH2(hash);
+					ObjectLifetimeHelper::MoveCreate(table.Slots + idx, std::move(Slots[i]));
+				}
+				table.Size = Size;
+				table.GrowthLeft -= Size;
+				Free();
+				Swap(table);
+			}
+
+			void Free()
+			{
+				if (Capacity == 0)
+					return;
+				Clear();
+				Deallocate(reinterpret_cast<ControlGroup*>(Control));
+				Control = nullptr;
+				Slots = nullptr;
+				Capacity = 0;
+				GroupMask = 0;
+				GrowthLeft = 0;
+			}
+
+			u8* Control = nullptr;
+			Slot* Slots = nullptr;
+			size_t Capacity = 0;
+			size_t GroupMask = 0;
+			size_t Size = 0;
+			size_t GrowthLeft = 0;
+		};
+	}
+}
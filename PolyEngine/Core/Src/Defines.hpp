@@ -78,6 +78,14 @@
 #include <typeindex>
 #include <typeinfo>
 #include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 // Custom type names
 using u8 = uint8_t;
@@ -100,4 +100,38 @@ namespace Poly {
 		T t = Clamp((x - edge1) / (edge2 - edge1), 0.0f, 1.0f);
 		return (T)(t * t * (3.0f - 2.0f * t));
 	}
+
+	// Bit manipulation functions
+	/// <summary>Returns index of the lowest set bit. Value must not be zero.</summary>
+	inline size_t CountTrailingZeros(u64 val) {
+		HEAVY_ASSERTE(val != 0, "Bit scan of zero is undefined!");
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanForward64(&idx, val);
+		return idx;
+#else
+		return static_cast<size_t>(__builtin_ctzll(val));
+#endif
+	}
+
+	/// <summary>Returns count of zero bits above the highest set bit. Value must not be zero.</summary>
+	inline size_t CountLeadingZeros(u64 val) {
+		HEAVY_ASSERTE(val != 0, "Bit scan of zero is undefined!");
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanReverse64(&idx, val);
+		return 63 - idx;
+#else
+		return static_cast<size_t>(__builtin_clzll(val));
+#endif
+	}
+
+	/// <summary>Returns number of set bits.</summary>
+	inline size_t PopCount(u64 val) {
+#if defined(_MSC_VER)
+		return static_cast<size_t>(__popcnt64(val));
+#else
+		return static_cast<size_t>(__builtin_popcountll(val));
+#endif
+	}
 }
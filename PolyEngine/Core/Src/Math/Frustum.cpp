@@ -61,6 +61,25 @@ Frustum::eObjectLocation Frustum::GetObjectLocation(const AABox& box, const Matr
 	return atLeastOneIntersects ? eObjectLocation::PARTIALY_INSIDE : eObjectLocation::INSIDE;
 }
 
+std::array<Vector, 8> Frustum::GetVertices() const
+{
+	// extents have to match side planes, which use fov scaled by aspect
+	const float tanX = Tan(FOV * Aspect / 2);
+	const float tanY = Tan(FOV / 2);
+	std::array<Vector, 8> vertices;
+	for (size_t i = 0; i < 2; ++i)
+	{
+		const float z = i == 0 ? ZNear : ZFar;
+		const float x = z * tanX;
+		const float y = z * tanY;
+		vertices[4 * i + 0] = Vector(-x, -y, -z);
+		vertices[4 * i + 1] = Vector(x, -y, -z);
+		vertices[4 * i + 2] = Vector(x, y, -z);
+		vertices[4 * i + 3] = Vector(-x, y, -z);
+	}
+	return vertices;
+}
+
 //------------------------------------------------------------------------------
 namespace Poly {
 	std::ostream & operator<<(std::ostream& stream, const Frustum& frust)
@@ -39,6 +39,10 @@ namespace Poly {
 
 		eObjectLocation GetObjectLocation(const AABox& box, const Matrix& boxToFrustumTransformation) const;
 
+		/// <summary>Calculates corners of the frustum, four on near plane followed by four on far plane.</summary>
+		/// <returns>Corners in frustum space.</returns>
+		std::array<Vector, 8> GetVertices() const;
+
 		CORE_DLLEXPORT friend std::ostream& operator<< (std::ostream& stream, const Frustum& color);
 
 		const EnumArray<Plane, eFrustumPlane>& GetPlanes() const { return Planes; }
@@ -0,0 +1,176 @@
+#include "CorePCH.hpp"
+
+#include "Math/FrustumCulling.hpp"
+#include "Math/SimdMath.hpp"
+
+using namespace Poly;
+
+//------------------------------------------------------------------------------
+void AABoxSoA::PushBack(const AABox& box)
+{
+	const Vector min = box.GetMin();
+	const Vector max = box.GetMax();
+	MinX.PushBack(min.X);
+	MinY.PushBack(min.Y);
+	MinZ.PushBack(min.Z);
+	MaxX.PushBack(max.X);
+	MaxY.PushBack(max.Y);
+	MaxZ.PushBack(max.Z);
+}
+
+//------------------------------------------------------------------------------
+void AABoxSoA::Set(size_t idx, const AABox& box)
+{
+	HEAVY_ASSERTE(idx < GetSize(), "Index out of bounds!");
+	const Vector min = box.GetMin();
+	const Vector max = box.GetMax();
+	MinX[idx] = min.X;
+	MinY[idx] = min.Y;
+	MinZ[idx] = min.Z;
+	MaxX[idx] = max.X;
+	MaxY[idx] = max.Y;
+	MaxZ[idx] = max.Z;
+}
+
+//------------------------------------------------------------------------------
+AABox AABoxSoA::Get(size_t idx) const
+{
+	HEAVY_ASSERTE(idx < GetSize(), "Index out of bounds!");
+	const Vector min(MinX[idx], MinY[idx], MinZ[idx]);
+	const Vector max(MaxX[idx], MaxY[idx], MaxZ[idx]);
+	return AABox(min, max - min);
+}
+
+//------------------------------------------------------------------------------
+void AABoxSoA::Clear()
+{
+	MinX.Clear(); MinY.Clear(); MinZ.Clear();
+	MaxX.Clear(); MaxY.Clear(); MaxZ.Clear();
+}
+
+//------------------------------------------------------------------------------
+void AABoxSoA::Reserve(size_t capacity)
+{
+	MinX.Reserve(capacity); MinY.Reserve(capacity); MinZ.Reserve(capacity);
+	MaxX.Reserve(capacity); MaxY.Reserve(capacity); MaxZ.Reserve(capacity);
+}
+
+//------------------------------------------------------------------------------
+FrustumCuller::FrustumCuller(const Frustum& frustum, const Matrix& frustumFromBoxes)
+{
+	for (eFrustumPlane type : IterateEnum<eFrustumPlane>())
+	{
+		const Plane& plane = frustum.GetPlanes()[type];
+		SetPlane(static_cast<size_t>(type), plane.GetPoint(), plane.GetNormal(), frustumFromBoxes);
+	}
+}
+
+//------------------------------------------------------------------------------
+FrustumCuller::FrustumCuller(const AABox& volume, const Matrix& volumeFromBoxes)
+{
+	const Vector min = volume.GetMin();
+	const Vector max = volume.GetMax();
+	SetPlane(0, min, Vector::UNIT_X, volumeFromBoxes);
+	SetPlane(1, max, -Vector::UNIT_X, volumeFromBoxes);
+	SetPlane(2, min, Vector::UNIT_Y, volumeFromBoxes);
+	SetPlane(3, max, -Vector::UNIT_Y, volumeFromBoxes);
+	SetPlane(4, min, Vector::UNIT_Z, volumeFromBoxes);
+	SetPlane(5, max, -Vector::UNIT_Z, volumeFromBoxes);
+}
+
+//------------------------------------------------------------------------------
+void FrustumCuller::SetPlane(size_t idx, const Vector& point, const Vector& normal, const Matrix& planeFromBoxes)
+{
+	// For x' = A * x + t plane dot(n, x') - dot(n, p) becomes dot(A^T * n, x) + dot(n, t) - dot(n, p).
+	const Matrix& m = planeFromBoxes;
+	const Vector translation(m.m03, m.m13, m.m23);
+	NormalX[idx] = m.m00 * normal.X + m.m10 * normal.Y + m.m20 * normal.Z;
+	NormalY[idx] = m.m01 * normal.X + m.m11 * normal.Y + m.m21 * normal.Z;
+	NormalZ[idx] = m.m02 * normal.X + m.m12 * normal.Y + m.m22 * normal.Z;
+	Offset[idx] = normal.Dot(translation) - normal.Dot(point);
+}
+
+//------------------------------------------------------------------------------
+bool FrustumCuller::IsVisible(const AABox& box) const
+{
+	const Vector min = box.GetMin();
+	const Vector max = box.GetMax();
+	for (size_t i = 0; i < PLANE_COUNT; ++i)
+	{
+		// vertex furthest along plane normal
+		const float x = NormalX[i] > 0 ? max.X : min.X;
+		const float y = NormalY[i] > 0 ? max.Y : min.Y;
+		const float z = NormalZ[i] > 0 ? max.Z : min.Z;
+		if (NormalX[i] * x + NormalY[i] * y + NormalZ[i] * z + Offset[i] < 0)
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool FrustumCuller::IsVisible(size_t idx, const AABoxSoA& boxes) const
+{
+	for (size_t i = 0; i < PLANE_COUNT; ++i)
+	{
+		const float x = NormalX[i] > 0 ? boxes.GetMaxX()[idx] : boxes.GetMinX()[idx];
+		const float y = NormalY[i] > 0 ? boxes.GetMaxY()[idx] : boxes.GetMinY()[idx];
+		const float z = NormalZ[i] > 0 ? boxes.GetMaxZ()[idx] : boxes.GetMinZ()[idx];
+		if (NormalX[i] * x + NormalY[i] * y + NormalZ[i] * z + Offset[i] < 0)
+			return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+size_t FrustumCuller::Cull(const AABoxSoA& boxes, Dynarray<bool>& visibility) const
+{
+	const size_t count = boxes.GetSize();
+	visibility.Resize(count);
+	size_t visibleCount = 0;
+	size_t idx = 0;
+
+#if !DISABLE_SIMD
+	// Vertex furthest along plane normal is selected per plane, not per box,
+	// so the choice between min and max array is made once for the whole batch.
+	const float* xs[PLANE_COUNT];
+	const float* ys[PLANE_COUNT];
+	const float* zs[PLANE_COUNT];
+	__m128 nx[PLANE_COUNT], ny[PLANE_COUNT], nz[PLANE_COUNT], offset[PLANE_COUNT];
+	for (size_t i = 0; i < PLANE_COUNT; ++i)
+	{
+		xs[i] = NormalX[i] > 0 ? boxes.GetMaxX() : boxes.GetMinX();
+		ys[i] = NormalY[i] > 0 ? boxes.GetMaxY() : boxes.GetMinY();
+		zs[i] = NormalZ[i] > 0 ? boxes.GetMaxZ() : boxes.GetMinZ();
+		nx[i] = _mm_set1_ps(NormalX[i]);
+		ny[i] = _mm_set1_ps(NormalY[i]);
+		nz[i] = _mm_set1_ps(NormalZ[i]);
+		offset[i] = _mm_set1_ps(Offset[i]);
+	}
+
+	const __m128 zero = _mm_setzero_ps();
+	for (; idx + 4 <= count; idx += 4)
+	{
+		__m128 outside = zero;
+		for (size_t i = 0; i < PLANE_COUNT; ++i)
+		{
+			__m128 dist = _mm_mul_ps(nx[i], _mm_loadu_ps(xs[i] + idx));
+			dist = _mm_add_ps(dist, _mm_mul_ps(ny[i], _mm_loadu_ps(ys[i] + idx)));
+			dist = _mm_add_ps(dist, _mm_mul_ps(nz[i], _mm_loadu_ps(zs[i] + idx)));
+			dist = _mm_add_ps(dist, offset[i]);
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, zero));
+		}
+
+		const int outsideMask = _mm_movemask_ps(outside);
+		for (size_t k = 0; k < 4; ++k)
+			visibility[idx + k] = (outsideMask & (1 << k)) == 0;
+		visibleCount += 4 - PopCount(static_cast<u64>(outsideMask));
+	}
+#endif
+
+	for (; idx < count; ++idx)
+	{
+		visibility[idx] = IsVisible(idx, boxes);
+		visibleCount += visibility[idx] ? 1 : 0;
+	}
+	return visibleCount;
+}
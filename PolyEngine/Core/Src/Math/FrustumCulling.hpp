@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "Math/AABox.hpp"
+#include "Math/Frustum.hpp"
+#include "Collections/Dynarray.hpp"
+
+namespace Poly {
+
+	/// <summary>Collection of axis aligned boxes stored as separate arrays of min and max coordinates,
+	/// so many boxes can be loaded into SIMD registers at once.</summary>
+	class CORE_DLLEXPORT AABoxSoA final : public BaseObject<>
+	{
+	public:
+		void PushBack(const AABox& box);
+		void Set(size_t idx, const AABox& box);
+		AABox Get(size_t idx) const;
+
+		void Clear();
+		void Reserve(size_t capacity);
+		size_t GetSize() const { return MinX.GetSize(); }
+
+		const float* GetMinX() const { return MinX.GetData(); }
+		const float* GetMinY() const { return MinY.GetData(); }
+		const float* GetMinZ() const { return MinZ.GetData(); }
+		const float* GetMaxX() const { return MaxX.GetData(); }
+		const float* GetMaxY() const { return MaxY.GetData(); }
+		const float* GetMaxZ() const { return MaxZ.GetData(); }
+
+	private:
+		Dynarray<float> MinX, MinY, MinZ;
+		Dynarray<float> MaxX, MaxY, MaxZ;
+	};
+
+	/// <summary>Frustum with planes transformed to the space of tested boxes.
+	/// Box is culled when it lies entirely behind any of the planes,
+	/// which is the same condition as Frustum::eObjectLocation::OUTSIDE for untransformed boxes.</summary>
+	class CORE_DLLEXPORT FrustumCuller final : public BaseObjectLiteralType<>
+	{
+	public:
+		/// <summary>Prepares planes for testing.</summary>
+		/// <param name="frustum">Tested frustum.</param>
+		/// <param name="frustumFromBoxes">Affine transformation from space of tested boxes to space of frustum (i.e. camera ViewFromWorld).</param>
+		FrustumCuller(const Frustum& frustum, const Matrix& frustumFromBoxes);
+
+		/// <summary>Prepares planes of box shaped volume (i.e. orthographic projection volume) for testing.</summary>
+		/// <param name="volume">Tested volume.</param>
+		/// <param name="volumeFromBoxes">Affine transformation from space of tested boxes to space of volume.</param>
+		FrustumCuller(const AABox& volume, const Matrix& volumeFromBoxes);
+
+		bool IsVisible(const AABox& box) const;
+
+		/// <summary>Tests all boxes, four at a time.</summary>
+		/// <param name="boxes">Tested boxes.</param>
+		/// <param name="visibility">Output visibility flag for every box, resized to number of boxes.</param>
+		/// <returns>Number of visible boxes.</returns>
+		size_t Cull(const AABoxSoA& boxes, Dynarray<bool>& visibility) const;
+
+	private:
+		static constexpr size_t PLANE_COUNT = static_cast<size_t>(eFrustumPlane::_COUNT);
+
+		void SetPlane(size_t idx, const Vector& point, const Vector& normal, const Matrix& planeFromBoxes);
+		bool IsVisible(size_t idx, const AABoxSoA& boxes) const;
+
+		// plane equation: dot(Normal, x) + Offset >= 0 for points inside
+		float NormalX[PLANE_COUNT];
+		float NormalY[PLANE_COUNT];
+		float NormalZ[PLANE_COUNT];
+		float Offset[PLANE_COUNT];
+	};
+}
@@ -69,14 +69,13 @@ Matrix Matrix::operator*(const Matrix& rhs) const {
     }
   }
 #else
-  Matrix t_rhs = rhs.GetTransposed();
+  // every row of the result is a linear combination of rhs rows, no transposition or horizontal adds needed
   for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      __m128 c = _mm_mul_ps(SimdRow[i], t_rhs.SimdRow[j]);
-      c = _mm_hadd_ps(c, c);
-      c = _mm_hadd_ps(c, c);
-      _mm_store_ss(&ret.Data[4*i + j], c);
-    }
+    __m128 c = _mm_mul_ps(_mm_set1_ps(Data[4*i]), rhs.SimdRow[0]);
+    c = _mm_add_ps(c, _mm_mul_ps(_mm_set1_ps(Data[4*i + 1]), rhs.SimdRow[1]));
+    c = _mm_add_ps(c, _mm_mul_ps(_mm_set1_ps(Data[4*i + 2]), rhs.SimdRow[2]));
+    c = _mm_add_ps(c, _mm_mul_ps(_mm_set1_ps(Data[4*i + 3]), rhs.SimdRow[3]));
+    ret.SimdRow[i] = c;
   }
 #endif
   return ret;
@@ -221,6 +220,26 @@ Matrix& Matrix::SetScale(const Vector& scale) {
   return *this;
 }
 
+//------------------------------------------------------------------------------
+Matrix& Matrix::SetTransformation(const Vector& translation, const Quaternion& rotation, const Vector& scale) {
+  *this = rotation.ToRotationMatrix();
+  // scaling columns of the first three rows, their last elements are zero so scale.W does not matter
+#if DISABLE_SIMD
+  for (int row = 0; row < 3; ++row) {
+    Data[4*row + 0] *= scale.X;
+    Data[4*row + 1] *= scale.Y;
+    Data[4*row + 2] *= scale.Z;
+  }
+#else
+  for (int row = 0; row < 3; ++row)
+    SimdRow[row] = _mm_mul_ps(SimdRow[row], scale.SimdData);
+#endif
+  m03 = translation.X;
+  m13 = translation.Y;
+  m23 = translation.Z;
+  return *this;
+}
+
 //------------------------------------------------------------------------------
 Matrix& Matrix::SetLookAt(const Vector& pos, const Vector& lookAt, const Vector& up)
 {
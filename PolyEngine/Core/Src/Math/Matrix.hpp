@@ -77,6 +77,13 @@ namespace Poly
 		/// <returns>Reference to itself.</returns>
 		Matrix& SetScale(const Vector& scale);
 
+		/// <summary>Initializes matrix with translation * rotation * scale, inverse of <see cref="Matrix.Decompose()"/>.</summary>
+		/// <param name="translation">Translation placed in the last column.</param>
+		/// <param name="rotation">Unit quaternion describing the rotation.</param>
+		/// <param name="scale">Scale applied before rotation.</param>
+		/// <returns>Reference to itself.</returns>
+		Matrix& SetTransformation(const Vector& translation, const Quaternion& rotation, const Vector& scale);
+
 		/// <summary>Initializes matrix with rotation based on look at position.</summary>
 		/// <param name="pos">Origin of rotation.</param>
 		/// <param name="lookAt">Position to look at.</param>
@@ -0,0 +1,178 @@
+#include "CorePCH.hpp"
+
+#include "Math/Random.hpp"
+#include "Math/SimdMath.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	constexpr size_t LANE_COUNT = 4;
+	constexpr float FLOAT_UNIT = 1.0f / 16777216.0f;
+	constexpr size_t VECTOR_BATCH_SIZE = 64;
+
+	u64 SplitMix64(u64& state)
+	{
+		u64 z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// generators of threads are split from this one
+	struct RootGenerator
+	{
+		std::mutex Mutex;
+		RandomGenerator Generator;
+	};
+
+	RootGenerator& GetRoot()
+	{
+		static RootGenerator root;
+		return root;
+	}
+
+	// one step of xoshiro128+ for every lane, lanes are stored word major
+	void StepLanes(u32 (&lanes)[4][LANE_COUNT], u32 (&result)[LANE_COUNT])
+	{
+		for (size_t lane = 0; lane < LANE_COUNT; ++lane)
+		{
+			u32& s0 = lanes[0][lane];
+			u32& s1 = lanes[1][lane];
+			u32& s2 = lanes[2][lane];
+			u32& s3 = lanes[3][lane];
+			result[lane] = s0 + s3;
+			const u32 t = s1 << 9;
+			s2 ^= s0;
+			s3 ^= s1;
+			s1 ^= s2;
+			s0 ^= s3;
+			s2 ^= t;
+			s3 = (s3 << 11) | (s3 >> 21);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void RandomGenerator::SetSeed(u64 seed)
+{
+	// splitmix64 spreads similar seeds over the whole state
+	const u64 low = SplitMix64(seed);
+	const u64 high = SplitMix64(seed);
+	State[0] = static_cast<u32>(low);
+	State[1] = static_cast<u32>(low >> 32);
+	State[2] = static_cast<u32>(high);
+	State[3] = static_cast<u32>(high >> 32);
+
+	// zero state is a fixed point of the generator
+	if ((State[0] | State[1] | State[2] | State[3]) == 0)
+		State[0] = 1;
+}
+
+//------------------------------------------------------------------------------
+void RandomGenerator::Jump()
+{
+	static const u32 JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+	u32 jumped[4] = { 0, 0, 0, 0 };
+	for (u32 jump : JUMP)
+	{
+		for (int bit = 0; bit < 32; ++bit)
+		{
+			if (jump & (1u << bit))
+			{
+				for (size_t i = 0; i < 4; ++i)
+					jumped[i] ^= State[i];
+			}
+			NextU32();
+		}
+	}
+	memcpy(State, jumped, sizeof(State));
+}
+
+//------------------------------------------------------------------------------
+void RandomGenerator::FillUniform(float* values, size_t count, float min, float max)
+{
+	alignas(16) u32 lanes[4][LANE_COUNT];
+	for (size_t lane = 0; lane < LANE_COUNT; ++lane)
+	{
+		for (size_t word = 0; word < 4; ++word)
+			lanes[word][lane] = NextU32();
+		if ((lanes[0][lane] | lanes[1][lane] | lanes[2][lane] | lanes[3][lane]) == 0)
+			lanes[0][lane] = 1;
+	}
+
+	const float scale = (max - min) * FLOAT_UNIT;
+	size_t idx = 0;
+
+#if !DISABLE_SIMD
+	__m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes[0]));
+	__m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes[1]));
+	__m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes[2]));
+	__m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes[3]));
+	const __m128 simdScale = _mm_set1_ps(scale);
+	const __m128 simdMin = _mm_set1_ps(min);
+	for (; idx + LANE_COUNT <= count; idx += LANE_COUNT)
+	{
+		const __m128i result = _mm_add_epi32(s0, s3);
+		const __m128i t = _mm_slli_epi32(s1, 9);
+		s2 = _mm_xor_si128(s2, s0);
+		s3 = _mm_xor_si128(s3, s1);
+		s1 = _mm_xor_si128(s1, s2);
+		s0 = _mm_xor_si128(s0, s3);
+		s2 = _mm_xor_si128(s2, t);
+		s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+		const __m128 unit = _mm_cvtepi32_ps(_mm_srli_epi32(result, 8));
+		_mm_storeu_ps(values + idx, _mm_add_ps(_mm_mul_ps(unit, simdScale), simdMin));
+	}
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes[0]), s0);
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes[1]), s1);
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes[2]), s2);
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes[3]), s3);
+#endif
+
+	// scalar version of the same streams, so results do not depend on SIMD support
+	while (idx < count)
+	{
+		u32 result[LANE_COUNT];
+		StepLanes(lanes, result);
+		for (size_t lane = 0; lane < LANE_COUNT && idx < count; ++lane, ++idx)
+			values[idx] = static_cast<float>(result[lane] >> 8) * scale + min;
+	}
+}
+
+//------------------------------------------------------------------------------
+void RandomGenerator::FillVectorRange(Vector* vectors, size_t count, float min, float max)
+{
+	float coordinates[3 * VECTOR_BATCH_SIZE];
+	for (size_t first = 0; first < count; first += VECTOR_BATCH_SIZE)
+	{
+		const size_t batchSize = std::min(VECTOR_BATCH_SIZE, count - first);
+		FillUniform(coordinates, 3 * batchSize, min, max);
+		for (size_t i = 0; i < batchSize; ++i)
+			vectors[first + i] = Vector(coordinates[3 * i], coordinates[3 * i + 1], coordinates[3 * i + 2]);
+	}
+}
+
+//------------------------------------------------------------------------------
+RandomGenerator& RandomGenerator::GetThreadLocal()
+{
+	thread_local RandomGenerator generator = []()
+	{
+		RootGenerator& root = GetRoot();
+		std::lock_guard<std::mutex> lock(root.Mutex);
+		return root.Generator.SplitStream();
+	}();
+	return generator;
+}
+
+//------------------------------------------------------------------------------
+void RandomGenerator::SeedThreadLocal(u64 seed)
+{
+	RandomGenerator& generator = GetThreadLocal();
+	RootGenerator& root = GetRoot();
+	std::lock_guard<std::mutex> lock(root.Mutex);
+	root.Generator.SetSeed(seed);
+	generator = root.Generator.SplitStream();
+}
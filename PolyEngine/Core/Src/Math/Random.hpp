@@ -6,26 +6,88 @@
 
 namespace Poly {
 
+	/// <summary>Pseudorandom number generator (xoshiro128**) with 128 bits of state.
+	/// Every generator is an independent stream, so systems can own their generators and stay deterministic
+	/// regardless of what other systems and threads draw.</summary>
+	class CORE_DLLEXPORT RandomGenerator final : public BaseObjectLiteralType<>
+	{
+	public:
+		explicit RandomGenerator(u64 seed = 0) { SetSeed(seed); }
+
+		/// <summary>Resets the generator, equal seeds produce equal sequences.</summary>
+		void SetSeed(u64 seed);
+
+		inline u32 NextU32()
+		{
+			const u32 result = RotateLeft(State[1] * 5, 7) * 9;
+			const u32 t = State[1] << 9;
+			State[2] ^= State[0];
+			State[3] ^= State[1];
+			State[1] ^= State[2];
+			State[0] ^= State[3];
+			State[2] ^= t;
+			State[3] = RotateLeft(State[3], 11);
+			return result;
+		}
+
+		inline u64 NextU64() { const u64 high = NextU32(); return (high << 32) | NextU32(); }
+
+		/// <returns>Uniformly distributed number in range [0, 1).</returns>
+		inline float NextFloat() { return static_cast<float>(NextU32() >> 8) * (1.0f / 16777216.0f); }
+
+		template <typename T> inline T Range(const T& min, const T& max) { return Lerp(min, max, NextFloat()); }
+
+		inline Vector VectorRange(float min, float max) { return Vector(Range(min, max), Range(min, max), Range(min, max)); }
+
+		/// <summary>Advances the generator by 2^64 draws. Generators jumped different number of times never overlap.</summary>
+		void Jump();
+
+		/// <summary>Creates a new stream for parallel worker.</summary>
+		/// <returns>Copy of this generator, which is then jumped ahead.</returns>
+		RandomGenerator SplitStream() { RandomGenerator stream = *this; Jump(); return stream; }
+
+		/// <summary>Fills array with numbers uniformly distributed between min and max.
+		/// Four interleaved xoshiro128+ streams seeded from this generator are advanced at once with SIMD.
+		/// Results depend only on the state of this generator, which advances by a fixed number of draws.</summary>
+		void FillUniform(float* values, size_t count, float min = 0.0f, float max = 1.0f);
+
+		/// <summary>Fills array with vectors of coordinates uniformly distributed between min and max, see <see cref="FillUniform"/>.</summary>
+		void FillVectorRange(Vector* vectors, size_t count, float min, float max);
+
+		/// <summary>Returns generator of calling thread. Generators of threads are split streams of one root generator,
+		/// in order of first use. Root generator starts with seed 0 until <see cref="SeedThreadLocal"/> is called.</summary>
+		static RandomGenerator& GetThreadLocal();
+
+		/// <summary>Reseeds root generator and the generator of calling thread, which takes the first stream split from new root.
+		/// Threads that draw their first number afterwards get the following streams, threads that already have
+		/// a generator keep their streams.</summary>
+		static void SeedThreadLocal(u64 seed);
+
+	private:
+		static constexpr u32 RotateLeft(u32 x, int k) { return (x << k) | (x >> (32 - k)); }
+
+		u32 State[4];
+	};
+
+	/// <summary>Seeds generator of calling thread and of threads drawing their first number later, see <see cref="RandomGenerator::SeedThreadLocal"/>.</summary>
 	inline void RandomSetSeed(int value)
 	{
-		srand(value);
+		RandomGenerator::SeedThreadLocal(static_cast<u64>(value));
 	}
 
 	inline float Random()
 	{
-		float rnd = static_cast <float> (rand()) / static_cast <float> (RAND_MAX);
-		return rnd - floor(rnd);
+		return RandomGenerator::GetThreadLocal().NextFloat();
 	}
 
 	template <typename T> inline T RandomRange(const T& min, const T& max)
 	{
-		float rnd = Random();
-		return Lerp(min, max, rnd);
+		return RandomGenerator::GetThreadLocal().Range(min, max);
 	}
 
 	inline Vector RandomVectorRange(float min, float max)
 	{
-		return Vector(RandomRange(min, max), RandomRange(min, max), RandomRange(min, max));
+		return RandomGenerator::GetThreadLocal().VectorRange(min, max);
 	}
 
 	inline Vector RandomVector()
@@ -0,0 +1,13 @@
+#include "CorePCH.hpp"
+
+#include "Memory/Allocator.hpp"
+
+using namespace Poly;
+
+AllocationHook Poly::Impl::gAllocationHook = nullptr;
+
+//------------------------------------------------------------------------------
+void Poly::SetAllocationHook(AllocationHook hook)
+{
+	Impl::gAllocationHook = hook;
+}
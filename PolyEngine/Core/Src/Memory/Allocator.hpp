@@ -9,9 +9,22 @@ namespace Poly
 		constexpr size_t MEM_ALIGNMENT = 16;
 	}
 
+	/// <summary>Function called with size in bytes of every heap allocation made by Allocate.</summary>
+	using AllocationHook = void(*)(size_t size);
+
+	/// <summary>Installs allocation hook, used by tests to verify that code paths do not allocate. Pass nullptr to remove it.</summary>
+	CORE_DLLEXPORT void SetAllocationHook(AllocationHook hook);
+
+	namespace Impl
+	{
+		CORE_DLLEXPORT extern AllocationHook gAllocationHook;
+	}
+
 	template<typename T>
 	T* Allocate(size_t count)
 	{
+		if (Impl::gAllocationHook)
+			Impl::gAllocationHook(count * sizeof(T));
 		using AlignedT = typename std::aligned_storage<sizeof(T), Impl::MEM_ALIGNMENT>::type;
 		auto fresh = new(std::nothrow) AlignedT[count];
 		return reinterpret_cast<T*>(fresh);
@@ -27,4 +40,11 @@ namespace Poly
 	}
 
 	inline void Deallocate(void* memory) { Deallocate(static_cast<char*>(memory)); }
+
+	/// <summary>Allocator policy of collections that keep their memory on the heap, see <see cref="Allocate"/>.</summary>
+	struct HeapAllocator final
+	{
+		template<typename T> static T* Allocate(size_t count) { return Poly::Allocate<T>(count); }
+		template<typename T> static void Deallocate(T* memory) { Poly::Deallocate(memory); }
+	};
 } //namespace Poly
@@ -23,8 +23,8 @@ namespace Poly
 		size_t GetSize() const { return Size; }
 
 	private:
-		char* Data;
-		size_t Size;
+		char* Data = nullptr;
+		size_t Size = 0;
 	};
 
 } // namespace Poly
\ No newline at end of file
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "Memory/Allocator.hpp"
+#include "Memory/IterablePoolAllocator.hpp"
+#include "Math/BasicMath.hpp"
+
+namespace Poly {
+
+	/// <summary>Iterable pool allocator that tracks occupied cells with a two-level bitmap.
+	/// Alloc and Free do not depend on the number of live objects, new objects are always placed
+	/// in the lowest free cell, so live objects stay packed at the front of the pool.
+	/// Iteration visits objects in ascending address order (same order as <see cref="IterablePoolAllocator"/>)
+	/// and skips whole empty 64-cell blocks using bit scans.</summary>
+	template<typename T>
+	class BitmapPoolAllocator : public IterablePoolAllocatorBase
+	{
+		static constexpr size_t BITS_PER_WORD = 64;
+		static constexpr u64 FULL_WORD = ~u64(0);
+	public:
+		//------------------------------------------------------------------------------
+		class Iterator : public BaseObject<>, public std::iterator<std::bidirectional_iterator_tag, T>
+		{
+		public:
+			bool operator==(const Iterator& rhs) const { return Idx == rhs.Idx; }
+			bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+
+			T& operator*() const { return Allocator->Data[Idx]; }
+			T* operator->() const { return Allocator->Data + Idx; }
+
+			Iterator& operator++() { Idx = Allocator->FindNextOccupied(Idx + 1); return *this; }
+			Iterator operator++(int) { Iterator ret(Allocator, Idx); ++(*this); return ret; }
+			Iterator& operator--() { Idx = Allocator->FindPrevOccupied(Idx); return *this; }
+			Iterator operator--(int) { Iterator ret(Allocator, Idx); --(*this); return ret; }
+
+		private:
+			Iterator(const BitmapPoolAllocator* allocator, size_t idx) : Allocator(allocator), Idx(idx) {}
+
+			const BitmapPoolAllocator* Allocator = nullptr;
+			size_t Idx = 0;
+			friend class BitmapPoolAllocator;
+		};
+
+		//------------------------------------------------------------------------------
+		class ConstIterator : public BaseObject<>, public std::iterator<std::bidirectional_iterator_tag, T>
+		{
+		public:
+			bool operator==(const ConstIterator& rhs) const { return Idx == rhs.Idx; }
+			bool operator!=(const ConstIterator& rhs) const { return !(*this == rhs); }
+
+			const T& operator*() const { return Allocator->Data[Idx]; }
+			const T* operator->() const { return Allocator->Data + Idx; }
+
+			ConstIterator& operator++() { Idx = Allocator->FindNextOccupied(Idx + 1); return *this; }
+			ConstIterator operator++(int) { ConstIterator ret(Allocator, Idx); ++(*this); return ret; }
+			ConstIterator& operator--() { Idx = Allocator->FindPrevOccupied(Idx); return *this; }
+			ConstIterator operator--(int) { ConstIterator ret(Allocator, Idx); --(*this); return ret; }
+
+		private:
+			ConstIterator(const BitmapPoolAllocator* allocator, size_t idx) : Allocator(allocator), Idx(idx) {}
+
+			const BitmapPoolAllocator* Allocator = nullptr;
+			size_t Idx = 0;
+			friend class BitmapPoolAllocator;
+		};
+
+		//------------------------------------------------------------------------------
+		Iterator Begin() { return Iterator(this, FindNextOccupied(0)); }
+		Iterator End() { return Iterator(this, Capacity); }
+		ConstIterator Begin() const { return ConstIterator(this, FindNextOccupied(0)); }
+		ConstIterator End() const { return ConstIterator(this, Capacity); }
+
+		/// <summary>Constuctor that allocates memory for provided amount of objects. </summary>
+		/// <param name="count"></param>
+		explicit BitmapPoolAllocator(size_t count)
+			: Capacity(count), FreeBlockCount(count),
+			WordCount((count + BITS_PER_WORD - 1) / BITS_PER_WORD),
+			SummaryWordCount((WordCount + BITS_PER_WORD - 1) / BITS_PER_WORD)
+		{
+			ASSERTE(count > 0, "Cell count cannot be lower than 1.");
+			Data = Allocate<T>(Capacity);
+			Occupancy = Allocate<u64>(WordCount);
+			NonEmptyWords = Allocate<u64>(SummaryWordCount);
+			FullWords = Allocate<u64>(SummaryWordCount);
+			memset(Occupancy, 0, sizeof(u64) * WordCount);
+			memset(NonEmptyWords, 0, sizeof(u64) * SummaryWordCount);
+			memset(FullWords, 0, sizeof(u64) * SummaryWordCount);
+
+			// Mark summary bits of nonexistent words as full, so allocation never looks at them.
+			const size_t usedBits = WordCount % BITS_PER_WORD;
+			if (usedBits != 0)
+				FullWords[SummaryWordCount - 1] = FULL_WORD << usedBits;
+		}
+
+		//------------------------------------------------------------------------------
+		virtual ~BitmapPoolAllocator()
+		{
+			ASSERTE(Data, "Allocator is invalid");
+			Deallocate(Data);
+			Deallocate(Occupancy);
+			Deallocate(NonEmptyWords);
+			Deallocate(FullWords);
+			Data = nullptr;
+		}
+
+		/// <summary>Allocation method</summary>
+		/// <returns>Pointer to uninitialized memory for object of type T or nullptr when the pool is full.</returns>
+		T* Alloc()
+		{
+			if (FreeBlockCount == 0)
+				return nullptr;
+
+			// first word that still has a free cell
+			size_t summaryIdx = 0;
+			while (FullWords[summaryIdx] == FULL_WORD)
+				++summaryIdx;
+			const size_t word = summaryIdx * BITS_PER_WORD + CountTrailingZeros(~FullWords[summaryIdx]);
+			HEAVY_ASSERTE(word < WordCount, "Free block count does not match occupancy bitmap!");
+
+			const size_t bit = CountTrailingZeros(~Occupancy[word]);
+			const size_t idx = word * BITS_PER_WORD + bit;
+			HEAVY_ASSERTE(idx < Capacity, "Free block count does not match occupancy bitmap!");
+
+			Occupancy[word] |= u64(1) << bit;
+			SetSummaryBit(NonEmptyWords, word, true);
+			if (Occupancy[word] == FULL_WORD)
+				SetSummaryBit(FullWords, word, true);
+
+			--FreeBlockCount;
+			return Data + idx;
+		}
+
+		//------------------------------------------------------------------------------
+		void GenericFree(void* p) override { Free(reinterpret_cast<T*>(p)); }
+		void* GenericAlloc() override { return Alloc(); }
+
+		/// <summary>Method for freeing allocated memory. Allocator does not call any object destructors!</summary>
+		/// <param name="p">Pointer to memory to free.</param>
+		void Free(T* p)
+		{
+			HEAVY_ASSERTE(p >= Data && p < Data + Capacity, "Pointer does not belong to this allocator!");
+			const size_t idx = p - Data;
+			const size_t word = idx / BITS_PER_WORD;
+			const u64 mask = u64(1) << (idx % BITS_PER_WORD);
+			HEAVY_ASSERTE((Occupancy[word] & mask) != 0, "Double free detected!");
+
+			Occupancy[word] &= ~mask;
+			SetSummaryBit(FullWords, word, false);
+			if (Occupancy[word] == 0)
+				SetSummaryBit(NonEmptyWords, word, false);
+
+			++FreeBlockCount;
+		}
+
+		/// <summary>Gets current size of the allocator.</summary>
+		/// <returns>Count of allocated objects.</returns>
+		size_t GetSize() const { return Capacity - FreeBlockCount; }
+
+		size_t GetFreeBlockCount() const { return FreeBlockCount; }
+		size_t GetCapacity() const { return Capacity; }
+
+	private:
+		static void SetSummaryBit(u64* summary, size_t word, bool value)
+		{
+			const u64 mask = u64(1) << (word % BITS_PER_WORD);
+			if (value)
+				summary[word / BITS_PER_WORD] |= mask;
+			else
+				summary[word / BITS_PER_WORD] &= ~mask;
+		}
+
+		/// <summary>Returns index of first occupied cell at position >= idx or Capacity if there is none.</summary>
+		size_t FindNextOccupied(size_t idx) const
+		{
+			if (idx >= Capacity)
+				return Capacity;
+
+			size_t word = idx / BITS_PER_WORD;
+			const u64 bits = Occupancy[word] & (FULL_WORD << (idx % BITS_PER_WORD));
+			if (bits != 0)
+				return word * BITS_PER_WORD + CountTrailingZeros(bits);
+
+			// find next non-empty word using the summary
+			++word;
+			if (word >= WordCount)
+				return Capacity;
+			size_t summaryIdx = word / BITS_PER_WORD;
+			u64 summary = NonEmptyWords[summaryIdx] & (FULL_WORD << (word % BITS_PER_WORD));
+			while (summary == 0)
+			{
+				if (++summaryIdx >= SummaryWordCount)
+					return Capacity;
+				summary = NonEmptyWords[summaryIdx];
+			}
+			word = summaryIdx * BITS_PER_WORD + CountTrailingZeros(summary);
+			return word * BITS_PER_WORD + CountTrailingZeros(Occupancy[word]);
+		}
+
+		/// <summary>Returns index of last occupied cell at position < idx or Capacity if there is none.</summary>
+		size_t FindPrevOccupied(size_t idx) const
+		{
+			if (idx == 0)
+				return Capacity;
+
+			const size_t last = idx - 1;
+			size_t word = last / BITS_PER_WORD;
+			const u64 bits = Occupancy[word] & (FULL_WORD >> (BITS_PER_WORD - 1 - last % BITS_PER_WORD));
+			if (bits != 0)
+				return word * BITS_PER_WORD + BITS_PER_WORD - 1 - CountLeadingZeros(bits);
+
+			// find previous non-empty word using the summary
+			if (word == 0)
+				return Capacity;
+			--word;
+			size_t summaryIdx = word / BITS_PER_WORD;
+			u64 summary = NonEmptyWords[summaryIdx] & (FULL_WORD >> (BITS_PER_WORD - 1 - word % BITS_PER_WORD));
+			while (summary == 0)
+			{
+				if (summaryIdx == 0)
+					return Capacity;
+				summary = NonEmptyWords[--summaryIdx];
+			}
+			word = summaryIdx * BITS_PER_WORD + BITS_PER_WORD - 1 - CountLeadingZeros(summary);
+			return word * BITS_PER_WORD + BITS_PER_WORD - 1 - CountLeadingZeros(Occupancy[word]);
+		}
+
+		const size_t Capacity = 0;
+		size_t FreeBlockCount = 0;
+		const size_t WordCount = 0;
+		const size_t SummaryWordCount = 0;
+		T* Data = nullptr;
+		u64* Occupancy = nullptr;		// bit per cell, set when cell is allocated
+		u64* NonEmptyWords = nullptr;	// bit per occupancy word, set when word has any allocated cell
+		u64* FullWords = nullptr;		// bit per occupancy word, set when word has no free cell
+	};
+
+	// std library for each enablers
+	template <typename T> typename Poly::BitmapPoolAllocator<T>::Iterator begin(Poly::BitmapPoolAllocator<T>& rhs) { return rhs.Begin(); }
+	template <typename T> typename Poly::BitmapPoolAllocator<T>::Iterator end(Poly::BitmapPoolAllocator<T>& rhs) { return rhs.End(); }
+	template <typename T> typename Poly::BitmapPoolAllocator<T>::ConstIterator begin(const Poly::BitmapPoolAllocator<T>& rhs) { return rhs.Begin(); }
+	template <typename T> typename Poly::BitmapPoolAllocator<T>::ConstIterator end(const Poly::BitmapPoolAllocator<T>& rhs) { return rhs.End(); }
+}
@@ -0,0 +1,88 @@
+#include "CorePCH.hpp"
+
+#include "Memory/FrameAllocator.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	constexpr size_t AlignSize(size_t size) { return (size + Impl::MEM_ALIGNMENT - 1) & ~(Impl::MEM_ALIGNMENT - 1); }
+
+	struct FrameArenas
+	{
+		LinearAllocator First{ FrameAllocator::INITIAL_CAPACITY };
+		LinearAllocator Second{ FrameAllocator::INITIAL_CAPACITY };
+		LinearAllocator* Current = &First;
+	};
+
+	FrameArenas& GetFrameArenas()
+	{
+		static FrameArenas arenas;
+		return arenas;
+	}
+}
+
+//------------------------------------------------------------------------------
+LinearAllocator::LinearAllocator(size_t capacity)
+	: Capacity(AlignSize(capacity)), Offset(0)
+{
+	HEAVY_ASSERTE(Capacity > 0, "Creating linear allocator with capacity == 0!");
+	Block = AllocateSlab(Capacity);
+	HEAVY_ASSERTE(Block, "Couldn't allocate memory!");
+}
+
+//------------------------------------------------------------------------------
+LinearAllocator::~LinearAllocator()
+{
+	Reset();
+	Deallocate(Block);
+}
+
+//------------------------------------------------------------------------------
+void* LinearAllocator::Alloc(size_t size)
+{
+	const size_t alignedSize = AlignSize(size);
+	const size_t begin = Offset.fetch_add(alignedSize, std::memory_order_relaxed);
+	if (begin + alignedSize <= Capacity)
+		return Block + begin;
+
+	// block is full, the request is remembered in Offset so that Reset() makes room for it
+	std::lock_guard<std::mutex> lock(OverflowMutex);
+	char* memory = AllocateSlab(alignedSize);
+	HEAVY_ASSERTE(memory, "Couldn't allocate memory!");
+	OverflowAllocations.PushBack(memory);
+	return memory;
+}
+
+//------------------------------------------------------------------------------
+void LinearAllocator::Reset()
+{
+	const size_t usedSize = Offset.load(std::memory_order_relaxed);
+	if (!OverflowAllocations.IsEmpty())
+	{
+		for (char* memory : OverflowAllocations)
+			Deallocate(memory);
+		OverflowAllocations.Clear();
+
+		Deallocate(Block);
+		while (Capacity < usedSize)
+			Capacity *= 2;
+		Block = AllocateSlab(Capacity);
+		HEAVY_ASSERTE(Block, "Couldn't allocate memory!");
+	}
+	Offset.store(0, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+void FrameAllocator::EndFrame()
+{
+	FrameArenas& arenas = GetFrameArenas();
+	arenas.Current = arenas.Current == &arenas.First ? &arenas.Second : &arenas.First;
+	arenas.Current->Reset();
+}
+
+//------------------------------------------------------------------------------
+LinearAllocator& FrameAllocator::GetCurrentArena()
+{
+	return *GetFrameArenas().Current;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "BaseObject.hpp"
+#include "Memory/Allocator.hpp"
+#include "Collections/Dynarray.hpp"
+
+namespace Poly
+{
+	/// <summary>
+	/// Linear (bump) allocator that hands out consecutive parts of one memory block and releases them all at once in Reset().
+	/// Allocation is thread safe and lock free as long as the block is big enough. Requests that do not fit
+	/// are served from the heap and the block is enlarged on next reset, so repeating workloads stop allocating.
+	/// </summary>
+	class CORE_DLLEXPORT LinearAllocator final : public BaseObjectLiteralType<>
+	{
+	public:
+		explicit LinearAllocator(size_t capacity);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		/// <summary>Allocates memory aligned to Impl::MEM_ALIGNMENT, which lives until next Reset().</summary>
+		/// <param name="size">Size of the allocation in bytes.</param>
+		void* Alloc(size_t size);
+
+		/// <summary>Releases all allocations. Must not be called concurrently with Alloc().</summary>
+		void Reset();
+
+		/// <summary>Returns number of bytes allocated since last reset, including allocations that did not fit the block.</summary>
+		size_t GetUsedSize() const { return Offset.load(std::memory_order_relaxed); }
+
+		/// <summary>Returns size of the block in bytes.</summary>
+		size_t GetCapacity() const { return Capacity; }
+
+	private:
+		char* Block = nullptr;
+		size_t Capacity = 0;
+		std::atomic<size_t> Offset;
+
+		std::mutex OverflowMutex;
+		Dynarray<char*> OverflowAllocations;
+	};
+
+	/// <summary>
+	/// Allocator policy for transient per frame data, e.g. <see cref="FrameDynarray"/>.
+	/// Memory comes from one of two linear allocators which are swapped in EndFrame(), so memory allocated
+	/// during a frame stays valid until the end of the next frame. Deallocation does nothing.
+	/// </summary>
+	class CORE_DLLEXPORT FrameAllocator final
+	{
+	public:
+		static constexpr size_t INITIAL_CAPACITY = 1 << 20;
+
+		template<typename T> static T* Allocate(size_t count)
+		{
+			STATIC_ASSERTE(alignof(T) <= Impl::MEM_ALIGNMENT, "Frame allocator does not support overaligned types");
+			return static_cast<T*>(GetCurrentArena().Alloc(count * sizeof(T)));
+		}
+
+		template<typename T> static void Deallocate(T*) {}
+
+		/// <summary>Resets memory allocated in previous frame and makes it current.
+		/// Called by the engine once per frame, when no systems are running.</summary>
+		static void EndFrame();
+
+		/// <summary>Returns allocator used by current frame.</summary>
+		static LinearAllocator& GetCurrentArena();
+	};
+
+	/// <summary>Dynarray which memory lives until the end of the next frame. Use for transient data built every frame.
+	/// Buffers abandoned by growth are not reclaimed until the arena is reset, so an array grown by PushBack
+	/// takes about twice its final size. Reserve from a known count (or an upper bound) when possible.</summary>
+	template<typename T> using FrameDynarray = Dynarray<T, FrameAllocator>;
+}
@@ -7,7 +7,7 @@ RTTI_DEFINE_TYPE(::Poly::SafePtrRoot);
 using namespace Poly;
 
 //------------------------------------------------------------------------------
-std::unordered_map<SafePtrRoot*, size_t> SafePtrRoot::PointersMap;
+HashMap<SafePtrRoot*, size_t> SafePtrRoot::PointersMap;
 Dynarray<SafePtrRoot*> SafePtrRoot::Pointers;
 
 //------------------------------------------------------------------------------
@@ -18,16 +18,10 @@ SafePtrRoot::~SafePtrRoot()
 
 size_t SafePtrRoot::RegisterPointer(SafePtrRoot *pointer)
 {
-	const auto it = PointersMap.find(pointer);
-	if (it != PointersMap.end())
-		return it->second;
-	else
-	{
+	size_t& idx = PointersMap.GetOrInsert(pointer, SafePtrRoot::Pointers.GetSize());
+	if (idx == SafePtrRoot::Pointers.GetSize())
 		SafePtrRoot::Pointers.PushBack(pointer);
-		size_t idx = SafePtrRoot::Pointers.GetSize() - 1;
-		SafePtrRoot::PointersMap[pointer] = idx;
-		return idx;
-	}
+	return idx;
 }
 
 /// <summary>Registers pointer in array and map</summary>
@@ -37,12 +31,9 @@ void SafePtrRoot::ClearPointer(SafePtrRoot *pointer)
 {
 	HEAVY_ASSERTE(pointer != nullptr, "Cannot unregister nullptr");
 
-	const auto it = SafePtrRoot::PointersMap.find(pointer);
-	if (it != SafePtrRoot::PointersMap.end())
-	{
-		SafePtrRoot::Pointers[it->second] = nullptr;
-		SafePtrRoot::PointersMap.erase(it);
-	}
+	const Optional<size_t> idx = SafePtrRoot::PointersMap.Remove(pointer);
+	if (idx.HasValue())
+		SafePtrRoot::Pointers[idx.Value()] = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -2,6 +2,7 @@
 
 #include "Defines.hpp"
 #include "Collections/Dynarray.hpp"
+#include "Collections/HashMap.hpp"
 #include "RTTI/RTTI.hpp"
 
 namespace Poly {
@@ -28,6 +29,6 @@ namespace Poly {
 		static void ClearPointer(SafePtrRoot *pointer);
 
 		static Dynarray<SafePtrRoot*> Pointers;
-		static std::unordered_map<SafePtrRoot*, size_t> PointersMap;
+		static HashMap<SafePtrRoot*, size_t> PointersMap;
 	};
 }
\ No newline at end of file
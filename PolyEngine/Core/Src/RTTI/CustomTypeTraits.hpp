@@ -5,7 +5,7 @@
 
 namespace Poly
 {
-	template<typename T> class Dynarray;
+	template<typename T, typename Allocator> class Dynarray;
 	template<typename K, typename V, size_t Bfactor> class OrderedMap;
 	template<typename T, typename E> class EnumArray;
 	template<typename E> class EnumFlags;
@@ -15,10 +15,10 @@ namespace Poly
 	{
 		// Is dynarray
 		template <typename> struct IsDynarray : public std::false_type {};
-		template <typename T> struct IsDynarray<Dynarray<T>> : public std::true_type {};
+		template <typename T, typename A> struct IsDynarray<Dynarray<T, A>> : public std::true_type {};
 
 		template <typename> struct DynarrayValueType {};
-		template <typename T> struct DynarrayValueType<Dynarray<T>> { using type = T; };
+		template <typename T, typename A> struct DynarrayValueType<Dynarray<T, A>> { using type = T; };
 
 		// Is Ordered map
 		template <typename> struct IsOrderedMap : public std::false_type {};
@@ -10,14 +10,20 @@ using namespace Poly;
 
 
 Poly::RTTIBase::RTTIBase()
-	: UUID(UniqueID::Generate())
 {
-	RTTIObjectsManager::Get().Register(this);
 }
 
 Poly::RTTIBase::~RTTIBase()
 {
-	RTTIObjectsManager::Get().Unregister(GetUUID());
+	if (HasUUID())
+		RTTIObjectsManager::Get().Unregister(UUID);
+}
+
+void RTTIBase::AssignUUID() const
+{
+	HEAVY_ASSERTE(!HasUUID(), "UUID is assigned already!");
+	UUID = UniqueID::Generate();
+	RTTIObjectsManager::Get().Register(const_cast<RTTIBase*>(this));
 }
 
 void RTTIBase::SerializeToFile(const String& fileName, eSerializationType type)
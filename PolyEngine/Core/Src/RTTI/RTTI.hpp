@@ -32,9 +32,16 @@ namespace Poly {
 		virtual void BeforeDeserializationCallback() {}
 		virtual void AfterDeserializationCallback() {}
 
-		inline const UniqueID& GetUUID() const { return UUID; }
+		/// <summary>Returns UUID of the object. UUID is generated on first request, which also registers the object
+		/// in <see cref="RTTIObjectsManager"/>, so runtime only objects never pay for generation and registration.</summary>
+		inline const UniqueID& GetUUID() const { if (!UUID.IsValid()) AssignUUID(); return UUID; }
+
+		/// <summary>Checks whether UUID was generated or deserialized already, without generating it.</summary>
+		inline bool HasUUID() const { return UUID.IsValid(); }
 	private:
-		UniqueID UUID;
+		void AssignUUID() const;
+
+		mutable UniqueID UUID;
 	};
 
 	class CORE_DLLEXPORT RTTIObjectsManager : public BaseObject<>
@@ -46,8 +53,10 @@ namespace Poly {
 		void Unregister(const UniqueID& id);
 		void FixMapingAfterDeserialization(RTTIBase* obj, const UniqueID& oldID)
 		{
-			Unregister(oldID);
-			Register(obj);
+			if (oldID.IsValid())
+				Unregister(oldID);
+			if (obj->HasUUID())
+				Register(obj);
 		}
 
 		RTTIBase* TryGetObjectByID(const UniqueID& id);
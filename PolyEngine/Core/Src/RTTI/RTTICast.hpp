@@ -46,8 +46,8 @@ namespace Poly {
 		struct BaseClasses {
 		private:
 			// Returns dynarray of TypeInfo if class T has baseClassList, that is filled with TypeInfos of base types for type T
-			template<typename C, typename std::enable_if<std::is_fundamental<C>::value>::type* = nullptr>
-			static auto RetrieveImpl(int) -> decltype(C::baseClassList, Dynarray<TypeInfo>{}) {
+			template<typename C>
+			static auto RetrieveImpl(int) -> decltype(typename C::baseClassList{}, Dynarray<TypeInfo>{}) {
 				Dynarray<TypeInfo> result;
 				Impl::TypeInfoFromBaseClassList<typename C::baseClassList>::Fill(result);
 				return result;
@@ -42,6 +42,9 @@ void RTTI::SerializeObject(const RTTIBase* obj, rapidjson::GenericObject<false,
 	const TypeInfo typeInfo = obj->GetTypeInfo();
 	const PropertyManagerBase* propMgr = obj->GetPropertyManager();
 
+	// UUID property is read directly, serialized objects need their UUID generated first
+	obj->GetUUID();
+
 	currentValue.AddMember(rapidjson::StringRef(JSON_TYPE_ANNOTATION), rapidjson::StringRef(typeInfo.GetTypeName()), alloc);
 
 	for (auto& child : propMgr->GetPropertyList())
@@ -368,7 +371,7 @@ CORE_DLLEXPORT void Poly::RTTI::DeserializeObject(RTTIBase* obj,
 	const rapidjson::GenericObject<true, rapidjson::Value> currentValue, 
 	Dynarray<RTTI::UninitializedPointerEntry>& uninitializedPointers)
 {
-	UniqueID oldId = obj->GetUUID();
+	const UniqueID oldId = obj->HasUUID() ? obj->GetUUID() : UniqueID::INVALID;
 
 	const PropertyManagerBase* propMgr = obj->GetPropertyManager();
 
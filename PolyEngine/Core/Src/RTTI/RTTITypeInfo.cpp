@@ -13,45 +13,103 @@ namespace Poly {
 				return instance;
 			}
 
-			bool TypeManager::IsTypeDerivedFrom(const TypeInfo& checked, const TypeInfo& from) const {
-				ASSERTE(checked.IsValid(), "Checked type is not a valid TypeInfo");
-				ASSERTE(from.IsValid(), "From type is not a valid TypeInfo");
+			TypeManager::TypeManager()
+			{
+				Types.PushBack(TypeData());
+				Intervals.PushBack(TypeInterval());
+			}
 
-				if (checked == from)
-					return true;
+			TypeInfo TypeManager::RegisterType(const char* name, const Dynarray<TypeInfo>& baseClassList, std::function<void*(void*)>&& constructor)
+			{
+				// base class list contains all ancestors, the direct base class is the first one
+				TypeData data;
+				data.Name = name;
+				data.Parent = baseClassList.GetSize() > 0 ? baseClassList[0] : TypeInfo::INVALID;
+				data.Constructor = std::move(constructor);
+
+				size_t depth = 0;
+				for (TypeInfo ancestor = data.Parent; ancestor.IsValid(); ancestor = Types[static_cast<size_t>(ancestor.ID)].Parent)
+					++depth;
+				ASSERTE(depth == baseClassList.GetSize(), "Multiple inheritance is not supported by RTTI!");
+
+				const TypeInfo ti(static_cast<TypeInfo::TypeId>(Types.GetSize()));
+				NameToTypeMap.MustInsert(name, ti);
+				Types.PushBack(std::move(data));
+				Intervals.PushBack(TypeInterval());
+				UpdateTypeIntervals();
+				return ti;
+			}
 
-				for (auto& base : InheritanceListMap.at(checked)) {
-					ASSERTE(base.IsValid(), "Base type is not a valid TypeInfo");
-					if (from == base)
-						return true;
+			void TypeManager::UpdateTypeIntervals()
+			{
+				// children lists in counting sort layout, types are visited in order of registration
+				Dynarray<size_t> childrenOffsets;
+				childrenOffsets.Resize(Types.GetSize() + 1);
+				std::fill(childrenOffsets.Begin(), childrenOffsets.End(), 0);
+				for (size_t id = 1; id < Types.GetSize(); ++id)
+					++childrenOffsets[static_cast<size_t>(Types[id].Parent.ID) + 1];
+				for (size_t id = 1; id < childrenOffsets.GetSize(); ++id)
+					childrenOffsets[id] += childrenOffsets[id - 1];
+
+				Dynarray<size_t> children;
+				children.Resize(Types.GetSize() - 1);
+				Dynarray<size_t> fill = childrenOffsets;
+				for (size_t id = 1; id < Types.GetSize(); ++id)
+					children[fill[static_cast<size_t>(Types[id].Parent.ID)]++] = id;
+
+				// depth first traversal from the invalid type, which is the root of all hierarchies
+				struct StackEntry { size_t ID; size_t NextChild; };
+				Dynarray<StackEntry> stack;
+				stack.PushBack(StackEntry{ 0, childrenOffsets[0] });
+				size_t index = 0;
+				Intervals[0].Begin = index++;
+				while (stack.GetSize() > 0)
+				{
+					StackEntry& top = stack[stack.GetSize() - 1];
+					if (top.NextChild < childrenOffsets[top.ID + 1])
+					{
+						const size_t child = children[top.NextChild++];
+						Intervals[child].Begin = index++;
+						stack.PushBack(StackEntry{ child, childrenOffsets[child] });
+					}
+					else
+					{
+						Intervals[top.ID].End = index - 1;
+						stack.PopBack();
+					}
 				}
+			}
+
+			bool TypeManager::IsTypeDerivedFrom(const TypeInfo& checked, const TypeInfo& from) const {
+				ASSERTE(checked.IsValid(), "Checked type is not a valid TypeInfo");
+				ASSERTE(from.IsValid(), "From type is not a valid TypeInfo");
 
-				return false;
+				const TypeInterval& checkedInterval = Intervals[static_cast<size_t>(checked.ID)];
+				const TypeInterval& fromInterval = Intervals[static_cast<size_t>(from.ID)];
+				return fromInterval.Begin <= checkedInterval.Begin && checkedInterval.Begin <= fromInterval.End;
 			}
 
 			const char* TypeManager::GetTypeName(const TypeInfo& typeInfo) const
 			{
-				const auto& it = TypeToNameMap.find(typeInfo);
-				ASSERTE(it != TypeToNameMap.end(), "Type has no name! Not registered?");
-				return it->second;
+				ASSERTE(typeInfo.IsValid() && static_cast<size_t>(typeInfo.ID) < Types.GetSize(), "Type has no name! Not registered?");
+				return Types[static_cast<size_t>(typeInfo.ID)].Name;
 			}
 
 			const std::function<void*(void*)>& TypeManager::GetConstructor(const TypeInfo & typeInfo) const
 			{
-				const auto& it = ConstructorsMap.find(typeInfo);
-				ASSERTE(it != ConstructorsMap.end(), "Type has no name! Not registered?");
-				return it->second;
+				ASSERTE(typeInfo.IsValid() && static_cast<size_t>(typeInfo.ID) < Types.GetSize(), "Type has no constructor! Not registered?");
+				return Types[static_cast<size_t>(typeInfo.ID)].Constructor;
 			}
 
 			TypeInfo TypeManager::GetTypeByName(const char* name) const
 			{
-				const auto& it = NameToTypeMap.find(name);
-				if (it == NameToTypeMap.end())
+				const Optional<const TypeInfo&> typeInfo = NameToTypeMap.Get(name);
+				if (!typeInfo.HasValue())
 				{
 					return TypeInfo::INVALID;
 					HEAVY_ASSERTE(false, "Type has no name! Not registered?");
 				}
-				return it->second;
+				return typeInfo.Value();
 			}
 
 		} // namespace Impl
@@ -4,6 +4,7 @@
 
 #include "Memory/ObjectLifetimeHelpers.hpp"
 #include "Collections/Dynarray.hpp"
+#include "Collections/HashMap.hpp"
 
 namespace Poly 
 {
@@ -54,10 +55,27 @@ namespace Poly
 			TypeInfo(TypeId id);
 
 			friend Impl::TypeManager;
+			friend struct std::hash<TypeInfo>;
 
 		private:
 			TypeId ID = 0;
 		};
+	} // namespace RTTI
+} // namespace Poly
+
+namespace std
+{
+	template<>
+	struct hash<::Poly::RTTI::TypeInfo>
+	{
+		size_t operator()(const ::Poly::RTTI::TypeInfo& typeInfo) const { return static_cast<size_t>(typeInfo.ID); }
+	};
+}
+
+namespace Poly
+{
+	namespace RTTI
+	{
 
 		namespace Impl {
 
@@ -69,36 +87,50 @@ namespace Poly
 				template <typename T>
 				TypeInfo RegisterOrGetType(const char* name, const Dynarray<TypeInfo>& baseClassList)
 				{
-					if (NameToTypeMap.find(name) != NameToTypeMap.end())
-						return NameToTypeMap[name];
+					const Optional<TypeInfo&> registered = NameToTypeMap.Get(name);
+					if (registered.HasValue())
+						return registered.Value();
 					else {
-						TypeInfo ti(++Counter);
-						NameToTypeMap.insert(std::make_pair(name, ti));
-						TypeToNameMap.insert(std::make_pair(ti, name));
-
-						ConstructorsMap.insert(std::make_pair(ti, [](void* memory)
+						return RegisterType(name, baseClassList, [](void* memory)
 						{
 							return (void*)ObjectLifetimeHelper::DefaultAllocateAndCreate<T>((T*)memory);
-						}));
-						InheritanceListMap[ti] = baseClassList;
-						return ti;
+						});
 					}
 				}
+
+				/// <summary>Checks whether type is the same as or derived from other type. Costs two integer comparisons.</summary>
 				bool IsTypeDerivedFrom(const TypeInfo& checked, const TypeInfo& from) const;
 
 				const char* GetTypeName(const TypeInfo& typeInfo) const;
 				const std::function<void*(void*)>& GetConstructor(const TypeInfo& typeInfo) const;
 				TypeInfo GetTypeByName(const char* name) const;
 			private:
-				TypeManager() = default;
+				/// <summary>Range of depth first pre-order indices of type and all types derived from it.</summary>
+				struct TypeInterval
+				{
+					size_t Begin = 0;
+					size_t End = 0;
+				};
+
+				struct TypeData
+				{
+					const char* Name = nullptr;
+					TypeInfo Parent;
+					std::function<void*(void*)> Constructor;
+				};
+
+				TypeManager();
 				TypeManager(const TypeManager& rhs) = delete;
 				TypeManager& operator=(const TypeManager& rhs) = delete;
 
-				long long Counter = 0;
-				std::map<std::string, TypeInfo> NameToTypeMap;
-				std::map<TypeInfo, const char*> TypeToNameMap;
-				std::map<TypeInfo, Dynarray<TypeInfo>> InheritanceListMap;
-				std::map<TypeInfo, std::function<void*(void*)>> ConstructorsMap;
+				TypeInfo RegisterType(const char* name, const Dynarray<TypeInfo>& baseClassList, std::function<void*(void*)>&& constructor);
+				void UpdateTypeIntervals();
+
+				HashMap<std::string, TypeInfo> NameToTypeMap;
+				// indexed by type ID, index 0 is the invalid type
+				Dynarray<TypeData> Types;
+				// intervals are rebuilt on registration, which happens mostly during static initialization
+				Dynarray<TypeInterval> Intervals;
 			};
 
 		} // namespace Impl
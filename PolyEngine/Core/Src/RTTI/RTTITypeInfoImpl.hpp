@@ -51,6 +51,7 @@ struct AutoRegisterType {
 	struct MetaTypeInfo { \
 		static Poly::RTTI::TypeInfo GetTypeInfo() \
 		{ \
-			return Poly::RTTI::Impl::TypeManager::Get().RegisterOrGetType<T>(#T, Poly::RTTI::BaseClasses<T>::Retrieve()); \
+			static const Poly::RTTI::TypeInfo typeInfo = Poly::RTTI::Impl::TypeManager::Get().RegisterOrGetType<T>(#T, Poly::RTTI::BaseClasses<T>::Retrieve()); \
+			return typeInfo; \
 		} \
 	};
@@ -0,0 +1,185 @@
+#include "CorePCH.hpp"
+
+#include "Threading/JobSystem.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	constexpr size_t NOT_A_WORKER = static_cast<size_t>(-1);
+
+	// Index of the worker executing on current thread and the system that owns it.
+	thread_local const JobSystem* tCurrentSystem = nullptr;
+	thread_local size_t tCurrentWorkerIdx = NOT_A_WORKER;
+}
+
+//------------------------------------------------------------------------------
+JobSystem::JobSystem(size_t workerCount)
+{
+	for (size_t i = 0; i < workerCount; ++i)
+		Workers.PushBack(std::make_unique<Worker>());
+
+	// start threads after all queues exist, workers steal from each other right away
+	for (size_t i = 0; i < workerCount; ++i)
+		Workers[i]->Thread = std::thread(&JobSystem::WorkerLoop, this, i);
+}
+
+//------------------------------------------------------------------------------
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(SleepMutex);
+		Stopping = true;
+	}
+	SleepCondition.notify_all();
+
+	for (std::unique_ptr<Worker>& worker : Workers)
+		worker->Thread.join();
+	ASSERTE(QueuedJobCount.load() == 0, "Job system destroyed with pending jobs!");
+}
+
+//------------------------------------------------------------------------------
+size_t JobSystem::GetDefaultWorkerCount()
+{
+	const size_t hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+//------------------------------------------------------------------------------
+void JobSystem::Submit(Job job, JobCounter& counter)
+{
+	counter.Pending.fetch_add(1, std::memory_order_relaxed);
+
+	QueuedJob queued;
+	queued.Function = std::move(job);
+	queued.Counter = &counter;
+
+	if (IsSerial())
+	{
+		Execute(queued);
+		return;
+	}
+
+	// count the job before it becomes visible, so stealing it can never underflow the counter
+	{
+		std::lock_guard<std::mutex> lock(SleepMutex);
+		QueuedJobCount.fetch_add(1, std::memory_order_release);
+	}
+
+	const size_t queueIdx = tCurrentSystem == this
+		? tCurrentWorkerIdx
+		: NextQueueIdx.fetch_add(1, std::memory_order_relaxed) % Workers.GetSize();
+	{
+		Worker& worker = *Workers[queueIdx];
+		std::lock_guard<std::mutex> lock(worker.QueueMutex);
+		worker.Jobs.PushBack(queued);
+	}
+	SleepCondition.notify_one();
+}
+
+//------------------------------------------------------------------------------
+void JobSystem::Wait(JobCounter& counter)
+{
+	const size_t ownIdx = tCurrentSystem == this ? tCurrentWorkerIdx : NOT_A_WORKER;
+	while (!counter.IsDone())
+	{
+		if (!TryExecuteJob(ownIdx))
+			std::this_thread::yield();
+	}
+}
+
+//------------------------------------------------------------------------------
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const RangeJob& job)
+{
+	HEAVY_ASSERTE(grainSize > 0, "Grain size has to be at least 1!");
+	if (count == 0)
+		return;
+
+	if (IsSerial() || count <= grainSize)
+	{
+		job(0, count);
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t begin = 0; begin < count; begin += grainSize)
+	{
+		const size_t end = std::min(begin + grainSize, count);
+		Submit([&job, begin, end]() { job(begin, end); }, counter);
+	}
+	Wait(counter);
+}
+
+//------------------------------------------------------------------------------
+void JobSystem::WorkerLoop(size_t workerIdx)
+{
+	tCurrentSystem = this;
+	tCurrentWorkerIdx = workerIdx;
+
+	while (true)
+	{
+		if (TryExecuteJob(workerIdx))
+			continue;
+
+		std::unique_lock<std::mutex> lock(SleepMutex);
+		SleepCondition.wait(lock, [this]() { return Stopping || QueuedJobCount.load(std::memory_order_acquire) > 0; });
+		if (Stopping && QueuedJobCount.load(std::memory_order_acquire) == 0)
+			return;
+	}
+}
+
+//------------------------------------------------------------------------------
+bool JobSystem::TryExecuteJob(size_t ownIdx)
+{
+	QueuedJob job;
+	if ((ownIdx != NOT_A_WORKER && TryPopOwn(ownIdx, job)) || TrySteal(ownIdx, job))
+	{
+		QueuedJobCount.fetch_sub(1, std::memory_order_acq_rel);
+		Execute(job);
+		return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------------
+bool JobSystem::TryPopOwn(size_t workerIdx, QueuedJob& job)
+{
+	Worker& worker = *Workers[workerIdx];
+	std::lock_guard<std::mutex> lock(worker.QueueMutex);
+	if (worker.Jobs.IsEmpty())
+		return false;
+
+	job = std::move(worker.Jobs.Back());
+	worker.Jobs.PopBack();
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool JobSystem::TrySteal(size_t thiefIdx, QueuedJob& job)
+{
+	const size_t workerCount = Workers.GetSize();
+	const size_t start = thiefIdx == NOT_A_WORKER ? 0 : thiefIdx + 1;
+	for (size_t i = 0; i < workerCount; ++i)
+	{
+		const size_t victimIdx = (start + i) % workerCount;
+		if (victimIdx == thiefIdx)
+			continue;
+
+		Worker& victim = *Workers[victimIdx];
+		std::lock_guard<std::mutex> lock(victim.QueueMutex);
+		if (victim.Jobs.IsEmpty())
+			continue;
+
+		job = std::move(victim.Jobs.Front());
+		victim.Jobs.PopFront();
+		return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------------
+void JobSystem::Execute(QueuedJob& job)
+{
+	job.Function();
+	job.Counter->Pending.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "Collections/Dynarray.hpp"
+#include "Collections/Queue.hpp"
+
+namespace Poly
+{
+	/// <summary>Tracks completion of a group of jobs submitted to <see cref="JobSystem"/>.
+	/// Counter has to outlive all jobs submitted with it.</summary>
+	class CORE_DLLEXPORT JobCounter final : public BaseObject<>
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		/// <summary>Checks whether every job submitted with this counter has finished.</summary>
+		bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+
+	private:
+		std::atomic<size_t> Pending{ 0 };
+
+		friend class JobSystem;
+	};
+
+	/// <summary>Pool of worker threads executing short jobs.
+	/// Every worker owns a queue, it takes its own jobs from the back (most recent first)
+	/// and when it runs out of work it steals the oldest jobs from other workers.
+	/// Thread waiting for a counter helps executing jobs instead of blocking.
+	/// Job system with zero workers executes every job immediately on the submitting thread,
+	/// in submission order, which makes it fully deterministic.</summary>
+	class CORE_DLLEXPORT JobSystem final : public BaseObject<>
+	{
+	public:
+		using Job = std::function<void()>;
+		using RangeJob = std::function<void(size_t, size_t)>;
+
+		/// <summary>Starts given number of worker threads.</summary>
+		/// <param name="workerCount">Number of worker threads, 0 runs all jobs inline.</param>
+		explicit JobSystem(size_t workerCount);
+		~JobSystem();
+
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		/// <summary>Returns worker count that leaves one hardware thread for the main thread.</summary>
+		static size_t GetDefaultWorkerCount();
+
+		size_t GetWorkerCount() const { return Workers.GetSize(); }
+
+		/// <summary>Checks whether jobs are executed inline, in submission order.</summary>
+		bool IsSerial() const { return Workers.GetSize() == 0; }
+
+		/// <summary>Queues job for execution. Jobs submitted from a worker go to its own queue.</summary>
+		/// <param name="job">Function to execute.</param>
+		/// <param name="counter">Counter that will be decremented when job finishes.</param>
+		void Submit(Job job, JobCounter& counter);
+
+		/// <summary>Executes pending jobs on the calling thread until every job tracked by counter finishes.</summary>
+		void Wait(JobCounter& counter);
+
+		/// <summary>Splits [0, count) range into chunks of at most grainSize elements,
+		/// executes them concurrently and waits for all of them.</summary>
+		/// <param name="count">Number of elements.</param>
+		/// <param name="grainSize">Maximum number of elements processed by a single job, at least 1.</param>
+		/// <param name="job">Function called with [begin, end) range of each chunk.</param>
+		void ParallelFor(size_t count, size_t grainSize, const RangeJob& job);
+
+	private:
+		struct QueuedJob
+		{
+			Job Function;
+			JobCounter* Counter = nullptr;
+		};
+
+		struct Worker
+		{
+			std::thread Thread;
+			std::mutex QueueMutex;
+			Queue<QueuedJob> Jobs;
+		};
+
+		void WorkerLoop(size_t workerIdx);
+		bool TryExecuteJob(size_t ownIdx);
+		bool TryPopOwn(size_t workerIdx, QueuedJob& job);
+		bool TrySteal(size_t thiefIdx, QueuedJob& job);
+		void Execute(QueuedJob& job);
+
+		Dynarray<std::unique_ptr<Worker>> Workers;
+		std::atomic<size_t> QueuedJobCount{ 0 };
+		std::atomic<size_t> NextQueueIdx{ 0 };
+		std::mutex SleepMutex;
+		std::condition_variable SleepCondition;
+		bool Stopping = false;
+	};
+}
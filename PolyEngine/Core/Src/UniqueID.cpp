@@ -14,13 +14,25 @@ UniqueID::UniqueID()
 	UUID.fill(0);
 }
 
+namespace
+{
+	// not affected by RandomSetSeed, so seeding gameplay randomness never repeats identifiers
+	RandomGenerator& GetIdentifierGenerator()
+	{
+		thread_local RandomGenerator generator(static_cast<u64>(std::chrono::high_resolution_clock::now().time_since_epoch().count())
+			^ (static_cast<u64>(std::hash<std::thread::id>{}(std::this_thread::get_id())) << 17));
+		return generator;
+	}
+}
+
 UniqueID UniqueID::Generate() 
 { 
 	UniqueID ret;
 
 	// 1. Generate 16 random bytes = 128 bits
-	for (size_t i = 0; i < ret.UUID.size(); ++i)
-		ret.UUID[i] = RandomRange(0x00, 0xFF);
+	RandomGenerator& generator = GetIdentifierGenerator();
+	const u64 random[2] = { generator.NextU64(), generator.NextU64() };
+	memcpy(ret.UUID.data(), random, sizeof(random));
 
 	// 2. Adjust certain bits according to RFC 4122 section 4.4.
 	// This just means do the following
@@ -36,12 +48,7 @@ UniqueID UniqueID::Generate()
 
 bool UniqueID::operator==(const UniqueID& rhs) const 
 { 
-	for (size_t i = 0; i < UUID.size(); ++i)
-	{
-		if (UUID[i] != rhs.UUID[i])
-			return false;
-	}
-	return true; 
+	return memcmp(UUID.data(), rhs.UUID.data(), UUID.size()) == 0;
 }
 bool UniqueID::operator!=(const UniqueID& rhs) const { return !(*this == rhs); }
 
@@ -57,10 +64,10 @@ UniqueID::operator bool() const
 
 size_t Poly::UniqueID::GetHash() const
 {
-	// @fixme(muniu) slow implementation, optimize
-	std::stringstream ss;
-	ss << *this;
-	return std::hash<std::string>{}(ss.str());
+	// generated bytes are random already, so folding them is enough
+	u64 halves[2];
+	memcpy(halves, UUID.data(), sizeof(halves));
+	return static_cast<size_t>(halves[0] ^ (halves[1] * 0x9E3779B97F4A7C15ull));
 }
 
 String Poly::UniqueID::ToString() const
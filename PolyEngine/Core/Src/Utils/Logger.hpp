@@ -25,6 +25,7 @@ namespace Poly
 		{
 			constexpr bool isStream = std::is_base_of<OutputStream, S>::value; // Strange workaround to STATIC_ASSERTE macro on MSVC
 			STATIC_ASSERTE(isStream, "Provided value is not stream!");
+			std::lock_guard<std::mutex> lock(StreamMutex);
 			if (CurrentStream)
 				CurrentStream->OnUnregister();
 			CurrentStream = std::make_unique<S>(std::forward<Args>(args)...);
@@ -33,6 +34,7 @@ namespace Poly
 		
 		void RegisterDefaultStream()
 		{
+			std::lock_guard<std::mutex> lock(StreamMutex);
 			if (CurrentStream)
 				CurrentStream->OnUnregister();
 			CurrentStream = nullptr;
@@ -52,6 +54,7 @@ namespace Poly
 		*  - Markers that do not have coresponding arguments will be treated as normal
 		* string.
 		*  - Arguments that do not have coresponding markers will be ignored.
+		*  - Logging is thread safe, messages logged concurrently are not interleaved.
 		*/
 		template <typename... Args>
 		void Log(eLogLevel lvl, const String& fmt, Args&&... args) { LogImpl(lvl, GetEnumName(lvl), fmt, std::forward<Args>(args)...); }
@@ -81,16 +84,18 @@ namespace Poly
 		{
 			if (level >= LOG_LEVEL_FILTER)
 			{
-				static StringBuilder sb;
 				String fullFmt = StringBuilder().AppendFormat("[{}] {}", levelStr, fmt).StealString();
+				StringBuilder sb;
 				sb.AppendFormat(fullFmt.GetCStr(), std::forward<Args>(args)...);
+				std::lock_guard<std::mutex> lock(StreamMutex);
 				*Ostream << sb.GetString() << std::endl;
-				sb.Clear();
 			}
 		}
 
 		std::unique_ptr<OutputStream> CurrentStream;
 		std::unique_ptr<std::ostream> Ostream;
+		// guards stream registration and writes, resources log from job system workers
+		std::mutex StreamMutex;
 	};
 
 	CORE_DLLEXPORT extern Console gConsole;
@@ -0,0 +1,12 @@
+// per view lights, uploaded once per frame by TiledForwardRenderer::UploadViewUniforms
+struct DirectionalLight
+{
+	vec4 ColorIntensity;
+	vec4 Direction;
+};
+
+layout(std140, binding = 1) uniform DirectionalLightData
+{
+	DirectionalLight uDirectionalLight[8];
+	int uDirectionalLightCount;
+};
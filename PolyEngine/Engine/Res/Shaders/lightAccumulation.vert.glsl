@@ -2,13 +2,10 @@
 layout(location = 0) in vec4 aPosition;
 layout(location = 1) in	vec2 aUV;
 layout(location = 2) in	vec3 aNormal;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;
+layout (location = 3) in vec4 aTangent; // w is handedness of tangent frame
+layout (location = 6) in mat4 aWorldFromModel;
 
-uniform mat4 uClipFromModel;
-uniform mat4 uWorldFromModel;
-uniform vec4 uViewPosition;
-uniform mat4 uDirLightFromWorld;
+#include "viewUniforms.glsl"
 
 out VERTEX_OUT
 {
@@ -26,14 +23,16 @@ void main()
 	vertex_out.uv = aUV;
 
 	vec4 vertexInModel = vec4(aPosition.xyz, 1.0);
-	gl_Position = uClipFromModel * vertexInModel;
-	vertex_out.positionInWorld = (uWorldFromModel * vertexInModel).xyz;
+	vec4 vertexInWorld = aWorldFromModel * vertexInModel;
+	gl_Position = uClipFromWorld * vertexInWorld;
+	vertex_out.positionInWorld = vertexInWorld.xyz;
 
-	mat3 transposedModelFromWorld = transpose(inverse(mat3(uWorldFromModel)));
+	mat3 transposedModelFromWorld = transpose(inverse(mat3(aWorldFromModel)));
 	vertex_out.normalInModel = normalize(transposedModelFromWorld * aNormal /*InModel*/);
 
-	vec3 tangentInWorld = normalize(transposedModelFromWorld * aTangent);
-	vec3 bitangentInWorld = normalize(transposedModelFromWorld * aBitangent);
+	vec3 bitangentInModel = cross(aNormal, aTangent.xyz) * aTangent.w;
+	vec3 tangentInWorld = normalize(transposedModelFromWorld * aTangent.xyz);
+	vec3 bitangentInWorld = normalize(transposedModelFromWorld * bitangentInModel);
 	vec3 normalInWorld = normalize(transposedModelFromWorld * aNormal);
 
 	// For tangent space normal mapping
@@ -16,12 +16,6 @@ in VERTEX_OUT
 } fragment_in;
 
 
-struct DirectionalLight
-{
-	vec4 ColorIntensity;
-	vec4 Direction;
-};
-
 struct Light
 {
 	vec4 Position;
@@ -64,15 +58,10 @@ uniform sampler2D uMetallicMap;
 uniform sampler2D uNormalMap;
 uniform sampler2D uAmbientOcclusionMap;
 
-uniform float uTime;
 uniform Material uMaterial;
 
-uniform DirectionalLight uDirectionalLight[8];
-uniform int uDirectionalLightCount;
-
-uniform int uLightCount;
-uniform int uWorkGroupsX;
-uniform int uWorkGroupsY;
+#include "viewUniforms.glsl"
+#include "directionalLightUniforms.glsl"
 
 layout(location = 0) out vec4 oColor;
 layout(location = 1) out vec4 oNormal;
@@ -26,14 +26,8 @@ layout(std430, binding = 1) writeonly buffer VisibleLightIndicesBuffer
 const uint MAX_NUM_LIGHTS = 1024;
 
 uniform sampler2D uDepthMap;
-uniform mat4 uViewFromWorld;
-uniform mat4 uClipFromWorld;
-uniform mat4 uClipFromView;
-uniform int uScreenSizeX;
-uniform int uScreenSizeY;
-uniform int uWorkGroupsX;
-uniform int uWorkGroupsY;
-uniform int uLightCount;
+
+#include "viewUniforms.glsl"
 
 shared uint sMinDepthInt;
 shared uint sMaxDepthInt;
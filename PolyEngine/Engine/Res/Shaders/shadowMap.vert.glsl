@@ -3,9 +3,10 @@
 layout(location = 0) in vec4 aPos;
 // layout(location = 1) in vec2 aTexCoord;
 // layout(location = 2) in vec3 aNormal;
+layout(location = 6) in mat4 aWorldFromModel;
 
-uniform mat4 uClipFromModel;
+uniform mat4 uClipFromWorld;
 
 void main() {
-    gl_Position = uClipFromModel * aPos;
+    gl_Position = uClipFromWorld * aWorldFromModel * aPos;
 }
\ No newline at end of file
@@ -15,12 +15,6 @@ in VERTEX_OUT
 }
 fragment_in;
 
-struct DirectionalLight
-{
-	vec4 ColorIntensity;
-	vec4 Direction;
-};
-
 struct Material
 {
     vec4 Emissive;
@@ -43,8 +37,7 @@ uniform sampler2D uAmbientOcclusionMap;
 
 uniform Material uMaterial;
 
-uniform DirectionalLight uDirectionalLight[8];
-uniform int uDirectionalLightCount;
+#include "directionalLightUniforms.glsl"
 
 layout(location = 0) out vec4 oColor;
 layout(location = 1) out vec4 oNormal;
@@ -2,12 +2,12 @@
 layout(location = 0) in vec4 aPosition;
 layout(location = 1) in	vec2 aUV;
 layout(location = 2) in	vec3 aNormal;
-layout (location = 3) in vec3 aTangent;
-layout (location = 4) in vec3 aBitangent;
+layout (location = 3) in vec4 aTangent; // w is handedness of tangent frame
 
 uniform mat4 uClipFromModel;
 uniform mat4 uWorldFromModel;
-uniform vec4 uViewPosition;
+
+#include "viewUniforms.glsl"
 
 out VERTEX_OUT
 {
@@ -31,8 +31,9 @@ void main()
 	mat3 transposedModelFromWorld = transpose(inverse(mat3(uWorldFromModel)));
 	vertex_out.normalInModel = normalize(transposedModelFromWorld * aNormal /*InModel*/);
 
-	vec3 tangentInWorld = normalize(transposedModelFromWorld * aTangent);
-	vec3 bitangentInWorld = normalize(transposedModelFromWorld * aBitangent);
+	vec3 bitangentInModel = cross(aNormal, aTangent.xyz) * aTangent.w;
+	vec3 tangentInWorld = normalize(transposedModelFromWorld * aTangent.xyz);
+	vec3 bitangentInWorld = normalize(transposedModelFromWorld * bitangentInModel);
 	vec3 normalInWorld = normalize(transposedModelFromWorld * aNormal);
 
 	// For tangent space normal mapping
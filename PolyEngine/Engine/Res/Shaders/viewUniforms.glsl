@@ -0,0 +1,15 @@
+// per view data, uploaded once per frame by TiledForwardRenderer::UploadViewUniforms
+layout(std140, row_major, binding = 0) uniform ViewData
+{
+	mat4 uClipFromWorld;
+	mat4 uViewFromWorld;
+	mat4 uClipFromView;
+	mat4 uDirLightFromWorld;
+	vec4 uViewPosition;
+	float uTime;
+	int uScreenSizeX;
+	int uScreenSizeY;
+	int uWorkGroupsX;
+	int uWorkGroupsY;
+	int uLightCount;
+};
@@ -37,7 +37,7 @@ Optional<Dynarray<Vector>> CalculateNewPath(const NavGraph* graph, const Vector&
 	Dynarray<PathNode> AllNodes;
 
 	PriorityQueue<std::pair<i64, float>, PathNodeCmp> openList, closedList;
-	OrderedMap<const NavNode*, float> minCosts;
+	HashMap<const NavNode*, float> minCosts;
 
 	AllNodes.PushBack(PathNode(startNode, 0, graph->GetHeuristicCost(startNode, destNode) ));
 	openList.Push(std::make_pair(AllNodes.GetSize() - 1, graph->GetHeuristicCost(startNode, destNode)));
@@ -71,11 +71,7 @@ Optional<Dynarray<Vector>> CalculateNewPath(const NavGraph* graph, const Vector&
 
 			AllNodes.PushBack(s);
 			openList.Push(std::make_pair(AllNodes.GetSize() - 1, s.TotalCost()));
-			auto entry = minCosts.Entry(s.Node);
-			if (entry.IsVacant())
-				entry.VacantInsert(s.Cost);
-			else
-				entry.OccupiedReplace(s.Cost);
+			minCosts.Insert(s.Node, s.Cost);
 		}
 
 		closedList.Push(std::make_pair(qIdx, AllNodes[qIdx].TotalCost()));
@@ -8,6 +8,8 @@ namespace Poly
 {
 	static const String DEFAULT_ENGINE_ASSETS_PATH = String("../Engine/Res/");
 	static const String DEFAULT_GAME_ASSETS_PATH = String("../Games/SGJGame/Res/");
+	// relative to working directory, which is the build output directory
+	static const String DEFAULT_ASSET_CACHE_DIRECTORY = String("AssetCache/");
 
 	AssetsPathConfig gAssetsPathConfig;
 
@@ -16,6 +18,7 @@ namespace Poly
 	{
 		EngineAssetsPath = DEFAULT_ENGINE_ASSETS_PATH;
 		GameAssetsPath = DEFAULT_GAME_ASSETS_PATH;
+		AssetCacheDirectory = DEFAULT_ASSET_CACHE_DIRECTORY;
 	}
 
 	const String& AssetsPathConfig::GetAssetsPath(eResourceSource source) const
@@ -13,6 +13,7 @@ namespace Poly
 			RTTI_PROPERTY(GameAssetsPath, "GameAssetsPath", RTTI::ePropertyFlag::NONE);
 			RTTI_PROPERTY(RenderingDeviceLibPath, "RenderingDeviceLibPath", RTTI::ePropertyFlag::NONE);
 			RTTI_PROPERTY(GameLibPath, "GameLibPath", RTTI::ePropertyFlag::NONE);
+			RTTI_PROPERTY(AssetCacheDirectory, "AssetCacheDirectory", RTTI::ePropertyFlag::NONE);
 		}
 	public:
 		AssetsPathConfig();
@@ -21,11 +22,14 @@ namespace Poly
 
 		const String& GetGameLibPath() const { return GameLibPath; }
 		const String& GetRenderingDeviceLibPath() const { return RenderingDeviceLibPath; }
+		/// <summary>Returns directory for cooked assets and other machine specific caches, never a source asset directory.</summary>
+		const String& GetAssetCacheDirectory() const { return AssetCacheDirectory; }
 	private:
 		String EngineAssetsPath;
 		String GameAssetsPath;
 		String RenderingDeviceLibPath;
 		String GameLibPath;
+		String AssetCacheDirectory;
 	};
 
 	ENGINE_DLLEXPORT extern AssetsPathConfig gAssetsPathConfig;
@@ -61,7 +61,7 @@ namespace Poly
 		Dynarray<DebugLineColor> DebugLinesColors;
 		Dynarray<DebugText2D> DebugTexts2D;
 
-		Dynarray<SafePtr<Entity>> Text2DEntityPool;
+		Dynarray<EntityHandle> Text2DEntityPool;
 	};
 
 	REGISTER_COMPONENT(ComponentsIDGroup, DebugDrawStateWorldComponent)
@@ -73,9 +73,9 @@ void DebugDrawSystem::DebugRenderingUpdatePhase(Scene* world)
 			Entity* entToUse = nullptr;
 			while (usedTextEntites < debugDrawWorldCmp->Text2DEntityPool.GetSize())
 			{
-				if (debugDrawWorldCmp->Text2DEntityPool[usedTextEntites])
+				entToUse = world->GetEntity(debugDrawWorldCmp->Text2DEntityPool[usedTextEntites]);
+				if (entToUse)
 				{
-					entToUse = debugDrawWorldCmp->Text2DEntityPool[usedTextEntites].Get();
 					++usedTextEntites;
 					break;
 				}
@@ -87,7 +87,7 @@ void DebugDrawSystem::DebugRenderingUpdatePhase(Scene* world)
 			{
 				entToUse = DeferredTaskSystem::SpawnEntityImmediate(world);
 				DeferredTaskSystem::AddComponentImmediate<ScreenSpaceTextComponent>(world, entToUse, Vector2i::ZERO, "Fonts/Raleway/Raleway-Regular.ttf", eResourceSource::ENGINE, 0);
-				debugDrawWorldCmp->Text2DEntityPool.PushBack(entToUse);
+				debugDrawWorldCmp->Text2DEntityPool.PushBack(entToUse->GetHandle());
 				++usedTextEntites;
 			}
 
@@ -102,7 +102,7 @@ void DebugDrawSystem::DebugRenderingUpdatePhase(Scene* world)
 		// Clear rest of the text entities
 		for (size_t i = usedTextEntites; i < debugDrawWorldCmp->Text2DEntityPool.GetSize(); ++i)
 		{
-			Entity* ent = debugDrawWorldCmp->Text2DEntityPool[i].Get();
+			Entity* ent = world->GetEntity(debugDrawWorldCmp->Text2DEntityPool[i]);
 			if (ent)
 			{
 				ScreenSpaceTextComponent* textCmp = ent->GetComponent<ScreenSpaceTextComponent>();
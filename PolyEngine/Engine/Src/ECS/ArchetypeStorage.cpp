@@ -0,0 +1,94 @@
+#include "EnginePCH.hpp"
+
+#include "ECS/ArchetypeStorage.hpp"
+#include "ECS/ComponentBase.hpp"
+
+using namespace Poly;
+
+//------------------------------------------------------------------------------
+ComponentArchetype::ComponentArchetype(u64 signature)
+	: Signature(signature)
+{
+	ColumnIndices.fill(INVALID_COLUMN);
+	for (size_t id = 0; id < MAX_COMPONENTS_COUNT; ++id)
+	{
+		if ((Signature & (u64(1) << id)) == 0)
+			continue;
+		ColumnIndices[id] = static_cast<u8>(Columns.GetSize());
+		Columns.PushBack(Dynarray<ComponentBase*>());
+	}
+}
+
+//------------------------------------------------------------------------------
+size_t ComponentArchetype::AddEntity(Entity* entity)
+{
+	const size_t row = Entities.GetSize();
+	Entities.PushBack(entity);
+	for (size_t id = 0; id < MAX_COMPONENTS_COUNT; ++id)
+	{
+		if (ColumnIndices[id] == INVALID_COLUMN)
+			continue;
+		HEAVY_ASSERTE(entity->HasComponent(id), "Entity signature does not match its components!");
+		Columns[ColumnIndices[id]].PushBack(entity->GetComponentByID(id));
+	}
+	return row;
+}
+
+//------------------------------------------------------------------------------
+void ComponentArchetype::RemoveEntity(size_t row)
+{
+	HEAVY_ASSERTE(row < Entities.GetSize(), "Invalid archetype row!");
+	const size_t last = Entities.GetSize() - 1;
+
+	// swap with last row to keep columns packed
+	if (row != last)
+	{
+		Entities[row] = Entities[last];
+		Entities[row]->ArchetypeRow = row;
+		for (Dynarray<ComponentBase*>& column : Columns)
+			column[row] = column[last];
+	}
+
+	Entities.PopBack();
+	for (Dynarray<ComponentBase*>& column : Columns)
+		column.PopBack();
+}
+
+//------------------------------------------------------------------------------
+void ArchetypeStorage::UpdateEntity(Entity* entity)
+{
+	HEAVY_ASSERTE(entity, "Invalid entity!");
+	STATIC_ASSERTE(MAX_COMPONENTS_COUNT <= 64, "Archetype signature does not fit in 64 bits.");
+	const u64 signature = entity->ComponentPosessionFlags.to_ullong();
+
+	RemoveEntity(entity);
+	if (signature == 0)
+		return;
+
+	ComponentArchetype* archetype = GetOrCreateArchetype(signature);
+	entity->ArchetypeRow = archetype->AddEntity(entity);
+	entity->Archetype = archetype;
+}
+
+//------------------------------------------------------------------------------
+void ArchetypeStorage::RemoveEntity(Entity* entity)
+{
+	HEAVY_ASSERTE(entity, "Invalid entity!");
+	if (!entity->Archetype)
+		return;
+
+	entity->Archetype->RemoveEntity(entity->ArchetypeRow);
+	entity->Archetype = nullptr;
+	entity->ArchetypeRow = 0;
+}
+
+//------------------------------------------------------------------------------
+ComponentArchetype* ArchetypeStorage::GetOrCreateArchetype(u64 signature)
+{
+	if (Optional<size_t&> idx = ArchetypeIndices.Get(signature))
+		return Archetypes[idx.Value()].get();
+
+	ArchetypeIndices.MustInsert(signature, Archetypes.GetSize());
+	Archetypes.PushBack(std::unique_ptr<ComponentArchetype>(new ComponentArchetype(signature)));
+	return Archetypes[Archetypes.GetSize() - 1].get();
+}
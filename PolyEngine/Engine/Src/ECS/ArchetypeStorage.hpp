@@ -0,0 +1,100 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Collections/HashMap.hpp>
+#include "ECS/Entity.hpp"
+
+namespace Poly
+{
+	class ComponentBase;
+
+	/// <summary>Selects how scene keeps track of its components for the purpose of iteration.</summary>
+	/// <see cref="Scene.IterateComponents()"/>
+	enum class eComponentStorageMode
+	{
+		POOL,		// iterate primary component pool and look up secondary components through the owner entity
+		ARCHETYPE,	// iterate entities grouped by component signature, stored in tightly packed columns
+		_COUNT
+	};
+
+	/// <summary>Group of entities that share exactly the same set of components.
+	/// Component pointers are kept in one contiguous column per component type, so iterating
+	/// over several component types at once is a linear scan with no per-entity lookups.</summary>
+	class ENGINE_DLLEXPORT ComponentArchetype final : public BaseObject<>
+	{
+	public:
+		static constexpr u8 INVALID_COLUMN = 0xFF;
+
+		explicit ComponentArchetype(u64 signature);
+
+		/// <summary>Returns bit mask of component IDs present in every entity of this archetype.</summary>
+		u64 GetSignature() const { return Signature; }
+
+		/// <summary>Checks whether every component from given mask is present in this archetype.</summary>
+		/// <param name="mask">Bit mask of component IDs.</param>
+		bool Matches(u64 mask) const { return (Signature & mask) == mask; }
+
+		size_t GetEntityCount() const { return Entities.GetSize(); }
+		Entity* GetEntity(size_t row) const { return Entities[row]; }
+
+		/// <summary>Returns packed column of components with given ID.</summary>
+		/// <param name="componentID">ID of a component type present in this archetype.</param>
+		/// <returns>Pointer to first element of the column, valid until next structural change in the scene.</returns>
+		ComponentBase* const* GetColumn(size_t componentID) const
+		{
+			HEAVY_ASSERTE(componentID < MAX_COMPONENTS_COUNT && ColumnIndices[componentID] != INVALID_COLUMN, "Component is not part of this archetype!");
+			return Columns[ColumnIndices[componentID]].GetData();
+		}
+
+	private:
+		size_t AddEntity(Entity* entity);
+		void RemoveEntity(size_t row);
+
+		u64 Signature = 0;
+		Dynarray<Entity*> Entities;
+		Dynarray<Dynarray<ComponentBase*>> Columns;
+		std::array<u8, MAX_COMPONENTS_COUNT> ColumnIndices;
+
+		friend class ArchetypeStorage;
+	};
+
+	/// <summary>Index of scene entities grouped by their component signatures.
+	/// Archetypes are created on demand and live as long as the storage does.</summary>
+	class ENGINE_DLLEXPORT ArchetypeStorage final : public BaseObject<>
+	{
+	public:
+		ArchetypeStorage() = default;
+		ArchetypeStorage(const ArchetypeStorage&) = delete;
+		ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+		/// <summary>Moves entity to the archetype that matches its current set of components.
+		/// Entities without any components are not tracked.</summary>
+		void UpdateEntity(Entity* entity);
+
+		/// <summary>Stops tracking given entity. Does nothing if the entity is not tracked.</summary>
+		void RemoveEntity(Entity* entity);
+
+		size_t GetArchetypeCount() const { return Archetypes.GetSize(); }
+		ComponentArchetype* GetArchetype(size_t idx) const { return Archetypes[idx].get(); }
+
+		/// <summary>Finds first non-empty archetype at position >= startIdx that contains all components from mask.</summary>
+		/// <returns>Index of found archetype or endIdx when none was found.</returns>
+		size_t FindNextMatching(size_t startIdx, size_t endIdx, u64 mask) const
+		{
+			for (size_t idx = startIdx; idx < endIdx; ++idx)
+			{
+				const ComponentArchetype* archetype = Archetypes[idx].get();
+				if (archetype->GetEntityCount() > 0 && archetype->Matches(mask))
+					return idx;
+			}
+			return endIdx;
+		}
+
+	private:
+		ComponentArchetype* GetOrCreateArchetype(u64 signature);
+
+		Dynarray<std::unique_ptr<ComponentArchetype>> Archetypes;
+		HashMap<u64, size_t> ArchetypeIndices;
+	};
+}
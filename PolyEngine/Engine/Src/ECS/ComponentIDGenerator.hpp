@@ -2,6 +2,7 @@
 
 #include <Defines.hpp>
 #include <Memory/IterablePoolAllocator.hpp>
+#include <Memory/BitmapPoolAllocator.hpp>
 
 #if defined(_ENGINE)
 #    define EXPORT_TEMPLATE
@@ -64,6 +65,15 @@ namespace Poly
 		return ComponentsIDGroup::GetComponentTypeID<T>();
 	}
 
+	//------------------------------------------------------------------------------
+	/// <summary>Selects pool type used by scenes to store components of type T.
+	/// By default components live in <see cref="IterablePoolAllocator"/>, components that are
+	/// created and destroyed in large numbers can opt in to <see cref="BitmapPoolAllocator"/>
+	/// with COMPONENT_USE_BITMAP_POOL macro placed next to REGISTER_COMPONENT.</summary>
+	template<typename T> struct ComponentPoolSelector { using Type = IterablePoolAllocator<T>; };
+
+	template<typename T> using ComponentPool = typename ComponentPoolSelector<T>::Type;
+
 	class ENGINE_DLLEXPORT ComponentManager
 	{
 	public:
@@ -84,7 +94,7 @@ namespace Poly
 			TypeToIDMap.insert({ typeinfo, id });
 			IDToTypeMap.insert({ id, typeinfo});
 			IDToCreatorMap.insert({id,
-				[](size_t count) { return static_cast<IterablePoolAllocatorBase*>(new IterablePoolAllocator<T>(count)); } });
+				[](size_t count) { return static_cast<IterablePoolAllocatorBase*>(new ComponentPool<T>(count)); } });
 		}
 
 		Optional<size_t> GetComponentID(const RTTI::TypeInfo& typeinfo) const;
@@ -113,6 +123,9 @@ struct AutoRegisterComponent {
 #define REGISTER_COMPONENT(GROUP, COMPONENT) \
 	EXPORT_TEMPLATE template size_t ENGINE_DLLEXPORT GROUP::GetComponentTypeID<COMPONENT>() noexcept;
 
+#define COMPONENT_USE_BITMAP_POOL(COMPONENT) \
+	template<> struct ComponentPoolSelector<COMPONENT> { using Type = ::Poly::BitmapPoolAllocator<COMPONENT>; };
+
 #define RTTI_DECLARE_COMPONENT(TYPE) \
 	public: \
 	size_t GetComponentID() const override { return ::Poly::GetComponentID<TYPE>(); }	\
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <Defines.hpp>
-#include <Memory/SafePtr.hpp>
 #include "ECS/DeferredTaskSystem.hpp"
 #include "ECS/DeferredTaskBase.hpp"
 #include "ECS/Scene.hpp"
@@ -22,13 +21,13 @@ namespace Poly
 	class DestroyEntityDeferredTask : public DeferredTaskBase
 	{
 	public:
-		DestroyEntityDeferredTask(Entity* entity) : Ent(entity) {}
+		DestroyEntityDeferredTask(Entity* entity) : Ent(entity->GetHandle()) {}
 
-		virtual void Execute(Scene* w) { if(Ent) DeferredTaskSystem::DestroyEntityImmediate(w, Ent.Get()); }
+		virtual void Execute(Scene* w) { if(Entity* entity = w->GetEntity(Ent)) DeferredTaskSystem::DestroyEntityImmediate(w, entity); }
 
 		virtual const char* GetDescription() const { return "Destroy entity"; }
 	private:
-		SafePtr<Entity> Ent;
+		EntityHandle Ent;
 	};
 
 	//---------------------------------------------------------------
@@ -36,16 +35,16 @@ namespace Poly
 	class AddComponentDeferredTask : public DeferredTaskBase
 	{
 	public:
-		AddComponentDeferredTask(Entity* entity, Args&&... args) : Ent(entity), arguments(std::forward<Args>(args)...) {}
+		AddComponentDeferredTask(Entity* entity, Args&&... args) : Ent(entity->GetHandle()), arguments(std::forward<Args>(args)...) {}
 
 		virtual void Execute(Scene* w) { func(w, arguments); }
 
 		virtual const char* GetDescription() const { return "Add component"; }
 
-		template <typename... ARG, std::size_t... Is> void func(Scene* w, std::tuple<ARG...>& tup, index<Is...>) { if(Ent) DeferredTaskSystem::AddComponentImmediate<T>(w, Ent.Get(), std::get<Is>(tup)...); }
+		template <typename... ARG, std::size_t... Is> void func(Scene* w, std::tuple<ARG...>& tup, index<Is...>) { if(Entity* entity = w->GetEntity(Ent)) DeferredTaskSystem::AddComponentImmediate<T>(w, entity, std::get<Is>(tup)...); }
 		template <typename... ARG> void func(Scene* w, std::tuple<ARG...>& tup) { func(w, tup, gen_seq<sizeof...(ARG)>{}); }
 	private:
-		SafePtr<Entity> Ent;
+		EntityHandle Ent;
 		std::tuple<Args...> arguments;
 	};
 
@@ -54,12 +53,12 @@ namespace Poly
 	class RemoveComponentDeferredTask : public DeferredTaskBase
 	{
 	public:
-		RemoveComponentDeferredTask(Entity* entity) : Ent(entity) {}
+		RemoveComponentDeferredTask(Entity* entity) : Ent(entity->GetHandle()) {}
 
-		virtual void Execute(Scene* w) { if(Ent) w->RemoveComponent<T>(Ent.Get()); }
+		virtual void Execute(Scene* w) { if(Entity* entity = w->GetEntity(Ent)) w->RemoveComponent<T>(entity); }
 
 		virtual const char* GetDescription() const { return "Remove component"; }
 	private:
-		SafePtr<Entity> Ent;
+		EntityHandle Ent;
 	};
 }
@@ -12,6 +12,16 @@ RTTI_DEFINE_TYPE(::Poly::Entity);
 void Poly::EntityDeleter::operator()(Entity* e)
 {
 	Scene* scene = e->GetEntityScene();
+	// entities created without scene (tests) are allocated with new
+	if (!scene)
+	{
+		delete e;
+		return;
+	}
+	scene->Archetypes.RemoveEntity(e);
+	scene->Transforms.SetStructureDirty();
+	if (!e->GetHandle().IsNull())
+		scene->EntityHandles.Release(e->GetHandle());
 	e->~Entity();
 	scene->EntitiesAllocator.Free(e);
 }
@@ -29,8 +39,7 @@ void Poly::ComponentDeleter::operator()(ComponentBase* c)
 Entity::Entity(Scene* world, Entity* parent)
 	: Transform(this), EntityScene(world), ComponentPosessionFlags(0)
 {
-	Components.Resize(MAX_COMPONENTS_COUNT);
-	std::fill(Components.Begin(), Components.End(), nullptr);
+	SetGlobalBBoxDirty();
 
 	if (parent)
 		SetParent(parent);
@@ -40,20 +49,29 @@ void Poly::Entity::SetBBoxDirty()
 {
 	for (eEntityBoundingChannel channel : IterateEnum<eEntityBoundingChannel>())
 		BBoxDirty[channel] = true;
+	SetGlobalBBoxDirty();
 	if (Parent)
 		Parent->SetBBoxDirty();
 }
 
+void Poly::Entity::SetGlobalBBoxDirty() const
+{
+	for (eEntityBoundingChannel channel : IterateEnum<eEntityBoundingChannel>())
+		GlobalBBoxDirty[channel] = true;
+}
+
 void Poly::Entity::ReleaseFromParent()
 {
 	if (Parent != nullptr)
 	{
-		for (auto& child : Parent->Children)
-		{
-			if (child.get() == this)
-				child.release();
-		}
-		Parent->Children.Remove([](const EntityUniquePtr& p) { return p.get() == nullptr; });
+		// recently spawned entities are at the back and are the most likely to be destroyed
+		Dynarray<EntityUniquePtr>& siblings = Parent->Children;
+		size_t idx = siblings.GetSize();
+		while (idx > 0 && siblings[idx - 1].get() != this)
+			--idx;
+		HEAVY_ASSERTE(idx > 0, "Entity not found among children of its parent!");
+		siblings[idx - 1].release();
+		siblings.RemoveByIdx(idx - 1);
 		Parent = nullptr;
 		Transform.UpdateParentTransform();
 	}
@@ -62,8 +80,6 @@ void Poly::Entity::ReleaseFromParent()
 Poly::Entity::Entity()
  : Transform(this)
 {
-	Components.Resize(MAX_COMPONENTS_COUNT);
-	std::fill(Components.Begin(), Components.End(), nullptr);
 }
 
 Poly::Entity::~Entity()
@@ -78,6 +94,7 @@ void* Poly::Entity::AllocateEntity(RTTI::TypeInfo t)
 	Scene* s = gEngine->GetCurrentlySerializedScene();
 	Entity* ent = s->GetEntityAllocator().Alloc();
 	::new(ent) Entity();
+	ent->Handle = s->EntityHandles.Acquire(ent);
 	return ent;
 }
 
@@ -100,7 +117,10 @@ void Poly::Entity::SetParent(Entity* parent)
 	ReleaseFromParent();
 
 	Parent = parent;
-	Parent->Children.PushBack(EntityUniquePtr(this, EntityScene->GetEntityDeleter()));
+	// deleter is stateless, entities created without scene (tests) can be parented too
+	Parent->Children.PushBack(EntityUniquePtr(this, EntityDeleter()));
+	if (EntityScene)
+		EntityScene->Transforms.SetStructureDirty();
 	Parent->SetBBoxDirty();
 
 	Transform.UpdateParentTransform();
@@ -135,9 +155,6 @@ const AABox& Poly::Entity::GetLocalBoundingBox(eEntityBoundingChannel channel) c
 		// Components that affect bounding box
 		for (auto& component : Components)
 		{
-			if (!component)
-				continue;
-
 			auto bboxOpt = component->GetBoundingBox(channel);
 			if (bboxOpt.HasValue())
 				LocalBBox[channel].Expand(bboxOpt.Value());
@@ -147,9 +164,14 @@ const AABox& Poly::Entity::GetLocalBoundingBox(eEntityBoundingChannel channel) c
 	return LocalBBox[channel];
 }
 
-AABox Poly::Entity::GetGlobalBoundingBox(eEntityBoundingChannel channel) const
+const AABox& Poly::Entity::GetGlobalBoundingBox(eEntityBoundingChannel channel) const
 {
-	return GetLocalBoundingBox(channel).GetTransformed(GetTransform().GetWorldFromModel());
+	if (GlobalBBoxDirty[channel])
+	{
+		GlobalBBox[channel] = GetLocalBoundingBox(channel).GetTransformed(GetTransform().GetWorldFromModel());
+		GlobalBBoxDirty[channel] = false;
+	}
+	return GlobalBBox[channel];
 }
 
 bool Entity::HasComponent(size_t ID) const
@@ -157,3 +179,38 @@ bool Entity::HasComponent(size_t ID) const
 	HEAVY_ASSERTE(ID < MAX_COMPONENTS_COUNT, "Invalid component ID - greater than MAX_COMPONENTS_COUNT.");
 	return ComponentPosessionFlags[ID];
 }
+
+void Poly::Entity::InsertComponent(size_t ID, ComponentBase* component)
+{
+	HEAVY_ASSERTE(!HasComponent(ID), "Component of given ID is already present!");
+	// components are rarely added after spawn, grow by one to keep the array tight
+	if (Components.GetSize() == Components.GetCapacity())
+		Components.Reserve(Components.GetSize() + 1);
+	Components.Insert(GetComponentIndex(ID), ComponentUniquePtr(component));
+	ComponentPosessionFlags.set(ID, true);
+}
+
+void Poly::Entity::EraseComponent(size_t ID)
+{
+	HEAVY_ASSERTE(HasComponent(ID), "Removing not present component!");
+	// component deleter may query its siblings, so the slot is freed before the component is destroyed
+	ComponentUniquePtr component = std::move(Components[GetComponentIndex(ID)]);
+	Components.RemoveByIdx(GetComponentIndex(ID));
+	ComponentPosessionFlags.set(ID, false);
+}
+
+size_t Poly::Entity::GetComponentStorageMemory() const
+{
+	// allocator aligns every element of a dynarray separately
+	const size_t slotSize = (sizeof(ComponentUniquePtr) + Impl::MEM_ALIGNMENT - 1) / Impl::MEM_ALIGNMENT * Impl::MEM_ALIGNMENT;
+	return sizeof(Entity) + Components.GetCapacity() * slotSize;
+}
+
+void Poly::Entity::AfterDeserializationCallback()
+{
+	// only the components are serialized, rebuild possession flags and restore ordering by ID
+	std::sort(Components.Begin(), Components.End(), [](const ComponentUniquePtr& a, const ComponentUniquePtr& b) { return a->GetComponentID() < b->GetComponentID(); });
+	ComponentPosessionFlags.reset();
+	for (const ComponentUniquePtr& component : Components)
+		ComponentPosessionFlags.set(component->GetComponentID(), true);
+}
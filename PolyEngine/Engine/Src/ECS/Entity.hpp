@@ -1,18 +1,20 @@
 #pragma once
 
 #include <Defines.hpp>
-#include <Memory/SafePtrRoot.hpp>
 #include <Math/AABox.hpp>
 #include <Utils/EnumUtils.hpp>
 #include <RTTI/RTTI.hpp>
 #include "ECS/EntityTransform.hpp"
 #include "ECS/ComponentIDGenerator.hpp"
+#include "ECS/EntityHandle.hpp"
 #include "Collections/Dynarray.hpp"
+#include "Math/BasicMath.hpp"
 #include "Engine.hpp"
 
 namespace Poly
 {
 	class ComponentBase;
+	class ComponentArchetype;
 	constexpr unsigned int MAX_COMPONENTS_COUNT = 64;
 
 	struct ENGINE_DLLEXPORT ComponentDeleter final : public BaseObjectLiteralType<>
@@ -32,9 +34,9 @@ namespace Poly
 	};
 
 	/// <summary>Class that represent entity inside core engine systems. Should not be used anywhere else.</summary>
-	class ENGINE_DLLEXPORT Entity : public SafePtrRoot
+	class ENGINE_DLLEXPORT Entity : public RTTIBase
 	{
-		RTTI_DECLARE_TYPE_DERIVED(::Poly::Entity, ::Poly::SafePtrRoot)
+		RTTI_DECLARE_TYPE_DERIVED(::Poly::Entity, ::Poly::RTTIBase)
 		{
 			RTTI_PROPERTY_AUTONAME(NameTemplate, RTTI::ePropertyFlag::NONE);
 			RTTI_PROPERTY_AUTONAME(Name, RTTI::ePropertyFlag::NONE);
@@ -58,8 +60,12 @@ namespace Poly
 		static void* AllocateEntity(RTTI::TypeInfo t);
 		static void* AllocateComponent(RTTI::TypeInfo t);
 
-		const Scene* GetEntityScene() const { HEAVY_ASSERTE(GetUUID(), "Entity was not properly initialized");  return EntityScene; }
-		Scene* GetEntityScene() { HEAVY_ASSERTE(GetUUID(), "Entity was not properly initialized");  return EntityScene; }
+		const Scene* GetEntityScene() const { return EntityScene; }
+		Scene* GetEntityScene() { return EntityScene; }
+
+		/// <summary>Returns handle of this entity, which can be stored instead of a pointer.</summary>
+		/// <see cref="Scene.GetEntity()"/>
+		EntityHandle GetHandle() const { return Handle; }
 
 		/// <summary>Checks whether there is a component of a given ID under this Entity's ID.</summary>
 		/// <param name="ID">ID of a component type</param>
@@ -126,13 +132,28 @@ namespace Poly
 	
 	
 		const AABox& GetLocalBoundingBox(eEntityBoundingChannel channel) const;
-		AABox GetGlobalBoundingBox(eEntityBoundingChannel channel) const;
+
+		/// <summary>Returns bounding box in world space, cached until local bounding box or global transform changes.</summary>
+		const AABox& GetGlobalBoundingBox(eEntityBoundingChannel channel) const;
+
+		/// <summary>Returns number of bytes used by this entity to store its components, including the entity itself.</summary>
+		size_t GetComponentStorageMemory() const;
+
+		void AfterDeserializationCallback() override;
 
 	private:
 		Entity(Scene* world, Entity* parent = nullptr);
 
+		/// <summary>Returns index of a component with given ID in the compact component array.</summary>
+		size_t GetComponentIndex(size_t ID) const { return PopCount(ComponentPosessionFlags.to_ullong() & ((u64(1) << ID) - 1)); }
+
+		ComponentBase* GetComponentByID(size_t ID) const { return HasComponent(ID) ? Components[GetComponentIndex(ID)].get() : nullptr; }
+		void InsertComponent(size_t ID, ComponentBase* component);
+		void EraseComponent(size_t ID);
+
 		void ReleaseFromParent();
 		void SetBBoxDirty();
+		void SetGlobalBBoxDirty() const;
 
 		Entity* Parent = nullptr;
 		Dynarray<EntityUniquePtr> Children;
@@ -141,35 +162,39 @@ namespace Poly
 		String Name;
 		EntityTransform Transform;
 		Scene* EntityScene = nullptr;
+		EntityHandle Handle;
 
 		mutable EnumArray<AABox, eEntityBoundingChannel> LocalBBox;
 		mutable EnumArray<bool, eEntityBoundingChannel> BBoxDirty;
+		mutable EnumArray<AABox, eEntityBoundingChannel> GlobalBBox;
+		mutable EnumArray<bool, eEntityBoundingChannel> GlobalBBoxDirty;
 
+		// Components are kept sorted by ID, one slot per set possession flag.
+		// Index of a component is the number of set flags below its ID.
 		std::bitset<MAX_COMPONENTS_COUNT> ComponentPosessionFlags;
 		Dynarray<ComponentUniquePtr> Components;
 
+		// Position in scene archetype storage, used only with eComponentStorageMode::ARCHETYPE.
+		ComponentArchetype* Archetype = nullptr;
+		size_t ArchetypeRow = 0;
+
 		friend class Scene;
+		friend class EntityTransform;
+		friend class ComponentArchetype;
+		friend class ArchetypeStorage;
 	};
 
 	//defined here due to circular inclusion problem; FIXME: circular inclusion
 	template<typename T>
 	T* Entity::GetComponent()
 	{
-		const auto ctypeID = GetComponentID<T>();
-		if (HasComponent(ctypeID))
-			return static_cast<T*>(Components[ctypeID].get());
-		else
-			return nullptr;
+		return static_cast<T*>(GetComponentByID(GetComponentID<T>()));
 	}
 
 	template<typename T>
 	const T* Entity::GetComponent() const
 	{
-		const auto ctypeID = GetComponentID<T>();
-		if (HasComponent(ctypeID))
-			return static_cast<T*>(Components[ctypeID].get());
-		else
-			return nullptr;
+		return static_cast<T*>(GetComponentByID(GetComponentID<T>()));
 	}
 
 	template<class T >
@@ -0,0 +1,32 @@
+#include "EnginePCH.hpp"
+
+#include "ECS/EntityHandle.hpp"
+
+using namespace Poly;
+
+//------------------------------------------------------------------------------
+EntityHandle EntityHandleTable::Acquire(Entity* entity)
+{
+	HEAVY_ASSERTE(entity, "Cannot acquire handle for nullptr!");
+	if (FreeSlots.IsEmpty())
+	{
+		ASSERTE(Slots.GetSize() < EntityHandle::INVALID_INDEX, "Entity handle table is full!");
+		Slots.PushBack(Slot{ entity, 1 });
+		return EntityHandle(static_cast<u32>(Slots.GetSize() - 1), 1);
+	}
+
+	const u32 index = FreeSlots[FreeSlots.GetSize() - 1];
+	FreeSlots.PopBack();
+	Slots[index].Ptr = entity;
+	return EntityHandle(index, Slots[index].Generation);
+}
+
+//------------------------------------------------------------------------------
+void EntityHandleTable::Release(EntityHandle handle)
+{
+	HEAVY_ASSERTE(Resolve(handle), "Releasing invalid entity handle!");
+	Slot& slot = Slots[handle.Index];
+	slot.Ptr = nullptr;
+	++slot.Generation;
+	FreeSlots.PushBack(handle.Index);
+}
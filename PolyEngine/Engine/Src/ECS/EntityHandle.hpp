@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+
+namespace Poly
+{
+	class Entity;
+
+	/// <summary>Weak reference to an entity issued by the scene.
+	/// Handle consists of slot index and generation of the slot, slot generation changes when entity is destroyed,
+	/// so handles of destroyed entities never resolve, even if the slot is reused.</summary>
+	/// <see cref="Scene.GetEntity()"/>
+	struct EntityHandle final : public BaseObjectLiteralType<>
+	{
+		static constexpr u32 INVALID_INDEX = 0xFFFFFFFF;
+
+		EntityHandle() = default;
+		EntityHandle(u32 index, u32 generation) : Index(index), Generation(generation) {}
+
+		bool IsNull() const { return Index == INVALID_INDEX; }
+
+		bool operator==(const EntityHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+		bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+
+		u32 Index = INVALID_INDEX;
+		u32 Generation = 0;
+	};
+
+	/// <summary>Weak reference to a component of given type of an entity.
+	/// Resolves to nullptr when the entity was destroyed or no longer has component of that type.</summary>
+	/// <see cref="Scene.GetComponent()"/>
+	template<typename T>
+	struct ComponentHandle final : public BaseObjectLiteralType<>
+	{
+		ComponentHandle() = default;
+		explicit ComponentHandle(EntityHandle owner) : Owner(owner) {}
+
+		bool IsNull() const { return Owner.IsNull(); }
+
+		bool operator==(const ComponentHandle& other) const { return Owner == other.Owner; }
+		bool operator!=(const ComponentHandle& other) const { return !(*this == other); }
+
+		EntityHandle Owner;
+	};
+
+	/// <summary>Maps entity handles to entities. Slots of destroyed entities are reused in LIFO order.</summary>
+	class ENGINE_DLLEXPORT EntityHandleTable final : public BaseObject<>
+	{
+	public:
+		/// <summary>Assigns a slot to the entity.</summary>
+		/// <returns>Handle of the entity.</returns>
+		EntityHandle Acquire(Entity* entity);
+
+		/// <summary>Frees the slot of the entity, all handles to it become invalid.</summary>
+		void Release(EntityHandle handle);
+
+		/// <returns>Entity referenced by the handle or nullptr if it was destroyed.</returns>
+		Entity* Resolve(EntityHandle handle) const
+		{
+			if (handle.Index >= Slots.GetSize())
+				return nullptr;
+			const Slot& slot = Slots[handle.Index];
+			return slot.Generation == handle.Generation ? slot.Ptr : nullptr;
+		}
+
+		/// <returns>Number of live entities.</returns>
+		size_t GetSize() const { return Slots.GetSize() - FreeSlots.GetSize(); }
+
+	private:
+		struct Slot
+		{
+			Entity* Ptr;
+			u32 Generation;
+		};
+
+		Dynarray<Slot> Slots;
+		Dynarray<u32> FreeSlots;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include "ECS/EntityTransform.hpp"
 #include "ECS/Entity.hpp"
+#include "ECS/TransformHierarchy.hpp"
 
 using namespace Poly;
 
@@ -18,14 +19,18 @@ void EntityTransform::UpdateParentTransform()
 	{
 		EntityTransform& parentTransform = Owner->GetParent()->GetTransform();
 		
-		parentTransform.UpdateGlobalTransformationCache();
+		parentTransform.UpdateGlobalDecompositionCache();
 		LocalTranslation = LocalTranslation - parentTransform.GlobalTranslation;
 		LocalRotation = LocalRotation * parentTransform.GlobalRotation.GetConjugated();
 		Vector parentGlobalScale = parentTransform.GlobalScale;
 		LocalScale.X = LocalScale.X / parentGlobalScale.X;
 		LocalScale.Y = LocalScale.Y / parentGlobalScale.Y;
 		LocalScale.Z = LocalScale.Z / parentGlobalScale.Z;
+		// cached matrix may still hold world transform set when entity was released from previous parent
+		LocalDirty = true;
 		UpdateLocalTransformationCache();
+		UpdateHierarchyLocalTransform();
+		SetGlobalDirty();
 	}
 	else
 	{
@@ -38,7 +43,7 @@ void EntityTransform::UpdateParentTransform()
 //------------------------------------------------------------------------------
 const Vector& EntityTransform::GetGlobalTranslation() const
 {
-	UpdateGlobalTransformationCache();
+	UpdateGlobalDecompositionCache();
 	return GlobalTranslation;
 }
 
@@ -47,6 +52,7 @@ void EntityTransform::SetLocalTranslation(const Vector& position)
 {
 	LocalTranslation = position;
 	LocalDirty = true;
+	UpdateHierarchyLocalTransform();
 	SetGlobalDirty();
 }
 
@@ -60,7 +66,7 @@ void Poly::EntityTransform::SetGlobalTranslation(const Vector& position)
 //------------------------------------------------------------------------------
 const Quaternion& EntityTransform::GetGlobalRotation() const
 {
-	UpdateGlobalTransformationCache();
+	UpdateGlobalDecompositionCache();
 	return GlobalRotation;
 }
 
@@ -69,6 +75,7 @@ void EntityTransform::SetLocalRotation(const Quaternion& quaternion)
 {
 	LocalRotation = quaternion;
 	LocalDirty = true;
+	UpdateHierarchyLocalTransform();
 	SetGlobalDirty();
 }
 
@@ -81,7 +88,7 @@ void Poly::EntityTransform::SetGlobalRotation(const Quaternion& quaternion)
 //------------------------------------------------------------------------------
 const Vector& EntityTransform::GetGlobalScale() const
 {
-	UpdateGlobalTransformationCache();
+	UpdateGlobalDecompositionCache();
 	return GlobalScale;
 }
 
@@ -90,6 +97,7 @@ void EntityTransform::SetLocalScale(const Vector& scale)
 {
 	LocalScale = scale;
 	LocalDirty = true;
+	UpdateHierarchyLocalTransform();
 	SetGlobalDirty();
 }
 
@@ -125,6 +133,7 @@ void EntityTransform::SetParentFromModel(const Matrix& parentFromModel)
 	ParentFromModel = parentFromModel;
 	parentFromModel.Decompose(LocalTranslation, LocalRotation, LocalScale);
 	LocalDirty = false;
+	UpdateHierarchyLocalTransform();
 	SetGlobalDirty();
 }
 
@@ -133,12 +142,7 @@ bool EntityTransform::UpdateLocalTransformationCache() const
 {
 	if (LocalDirty)
 	{
-		Matrix translation;
-		Matrix rotation = LocalRotation.ToRotationMatrix();
-		Matrix scale;
-		translation.SetTranslation(LocalTranslation);
-		scale.SetScale(LocalScale);
-		ParentFromModel = translation * rotation * scale;
+		ParentFromModel.SetTransformation(LocalTranslation, LocalRotation, LocalScale);
 		LocalDirty = false;
 		return true;
 	}
@@ -160,14 +164,32 @@ void EntityTransform::UpdateGlobalTransformationCache() const
 		Matrix WorldFromParent = parent->GetTransform().GetWorldFromModel();
 		WorldFromModel = WorldFromParent * GetParentFromModel();
 	}
-	WorldFromModel.Decompose(GlobalTranslation, GlobalRotation, GlobalScale);
 	GlobalDirty = false;
+	GlobalDecompositionDirty = true;
+}
+
+//------------------------------------------------------------------------------
+void EntityTransform::UpdateGlobalDecompositionCache() const
+{
+	UpdateGlobalTransformationCache();
+	if (!GlobalDecompositionDirty) return;
+
+	WorldFromModel.Decompose(GlobalTranslation, GlobalRotation, GlobalScale);
+	GlobalDecompositionDirty = false;
+}
+
+//------------------------------------------------------------------------------
+void EntityTransform::UpdateHierarchyLocalTransform() const
+{
+	if (Hierarchy)
+		Hierarchy->SetLocalTransform(HierarchyIndex, LocalTranslation, LocalRotation, LocalScale);
 }
 
 //------------------------------------------------------------------------------
 void EntityTransform::SetGlobalDirty() const
 {
 	GlobalDirty = true;
+	Owner->SetGlobalBBoxDirty();
 	const auto& children = Owner->GetChildren();
 	for (const Entity::EntityUniquePtr& c : children)
 	{
@@ -8,6 +8,7 @@
 namespace Poly 
 {
 	class Entity;
+	class TransformHierarchy;
 
 	class ENGINE_DLLEXPORT EntityTransform final : public RTTIBase
 	{
@@ -54,6 +55,8 @@ namespace Poly
 		void UpdateParentTransform();
 
 		Entity* Owner = nullptr;
+		TransformHierarchy* Hierarchy = nullptr; // set when flattened hierarchy of the scene is rebuilt
+		size_t HierarchyIndex = 0;
 		Vector LocalTranslation;
 		mutable Vector GlobalTranslation;
 		Quaternion LocalRotation;
@@ -65,11 +68,15 @@ namespace Poly
 		mutable Matrix WorldFromModel;
 		mutable bool LocalDirty = true;
 		mutable bool GlobalDirty = true;
+		mutable bool GlobalDecompositionDirty = true; // global translation, rotation and scale are outdated
 
 		bool UpdateLocalTransformationCache() const;
 		void UpdateGlobalTransformationCache() const;
+		void UpdateGlobalDecompositionCache() const;
+		void UpdateHierarchyLocalTransform() const;
 		void SetGlobalDirty() const;
 
 		friend class Entity;
+		friend class TransformHierarchy;
 	};
 }
\ No newline at end of file
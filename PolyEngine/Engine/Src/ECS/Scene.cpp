@@ -7,8 +7,8 @@ using namespace Poly;
 RTTI_DEFINE_TYPE(::Poly::Scene);
 
 //------------------------------------------------------------------------------
-Scene::Scene()
-	: EntitiesAllocator(MAX_ENTITY_COUNT), ComponentDel(), EntityDel(), RootEntity(nullptr, EntityDel)
+Scene::Scene(eComponentStorageMode storageMode)
+	: EntitiesAllocator(MAX_ENTITY_COUNT), ComponentDel(), EntityDel(), StorageMode(storageMode), RootEntity(nullptr, EntityDel)
 {
 	memset(ComponentAllocators, 0, sizeof(IterablePoolAllocatorBase*) * MAX_COMPONENTS_COUNT);
 
@@ -36,9 +36,16 @@ void Poly::Scene::BeforeDeserializationCallback()
 //------------------------------------------------------------------------------
 void Poly::Scene::AfterDeserializationCallback()
 {
+	Transforms.SetStructureDirty();
 	gEngine->SetCurrentlySerializedScene(nullptr);
 }
 
+//------------------------------------------------------------------------------
+JobSystem& Scene::GetJobSystem() const
+{
+	return Poly::GetJobSystem();
+}
+
 //------------------------------------------------------------------------------
 Entity* Scene::SpawnEntity()
 {
@@ -52,6 +59,7 @@ Entity * Poly::Scene::SpawnEntityInternal()
 {
 	Entity* ent = EntitiesAllocator.Alloc();
 	::new(ent) Entity(this);
+	ent->Handle = EntityHandles.Acquire(ent);
 	return ent;
 }
 
@@ -73,6 +81,6 @@ bool Scene::HasWorldComponent(size_t ID) const
 //------------------------------------------------------------------------------
 void Scene::RemoveComponentById(Entity* ent, size_t id)
 {
-	HEAVY_ASSERTE(ent->Components[id], "Removing not present component");
-	ent->Components[id].reset();
+	ent->EraseComponent(id);
+	UpdateEntityArchetype(ent);
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <Defines.hpp>
 #include "ECS/Entity.hpp"
 #include "ECS/ComponentBase.hpp"
+#include "ECS/ArchetypeStorage.hpp"
+#include "ECS/TransformHierarchy.hpp"
 #include "Audio/SoundWorldComponent.hpp"
 #include "Engine.hpp"
 
@@ -32,7 +34,9 @@ namespace Poly {
 		}
 	public:
 		/// <summary>Allocates memory for entities, world components and components allocators.</summary>
-		Scene();
+		/// <param name="storageMode">Selects how components are tracked for iteration.</param>
+		/// <see cref="eComponentStorageMode"/>
+		Scene(eComponentStorageMode storageMode = eComponentStorageMode::POOL);
 
 		virtual ~Scene();
 
@@ -51,6 +55,24 @@ namespace Poly {
 			return entity->GetComponent<T>();
 		}
 
+		/// <summary>Resolves entity handle in constant time.</summary>
+		/// <param name="handle">Handle obtained with Entity::GetHandle().</param>
+		/// <returns>Pointer to the entity or nullptr if it was destroyed.</returns>
+		Entity* GetEntity(EntityHandle handle) const { return EntityHandles.Resolve(handle); }
+
+		/// <summary>Resolves component handle in constant time.</summary>
+		/// <returns>Pointer to the component or nullptr if its entity was destroyed or the component was removed.</returns>
+		template<typename T>
+		T* GetComponent(ComponentHandle<T> handle) const
+		{
+			Entity* entity = GetEntity(handle.Owner);
+			return entity ? entity->GetComponent<T>() : nullptr;
+		}
+
+		/// <summary>Creates handle to a component of given type of the entity.</summary>
+		template<typename T>
+		static ComponentHandle<T> GetComponentHandle(const T* component) { return ComponentHandle<T>(component->GetOwner()->GetHandle()); }
+
 		/// <summary>Checks whether world has component of given ID.</summary>
 		/// <param name="ID">Registered component ID.</param>
 		/// <returns>True when world has component of given ID, false otherwise</returns>
@@ -74,9 +96,17 @@ namespace Poly {
 		}
 		ComponentDeleter& GetComponentDeleter() { return ComponentDel; }
 
-		IterablePoolAllocator<Entity>& GetEntityAllocator() { return EntitiesAllocator; }
+		BitmapPoolAllocator<Entity>& GetEntityAllocator() { return EntitiesAllocator; }
 		EntityDeleter& GetEntityDeleter() { return EntityDel; }
 
+		/// <summary>Recomputes world transforms of all entities marked dirty, see TransformHierarchy.</summary>
+		/// <param name="jobs">Job system used to update independent subtrees concurrently, can be null.</param>
+		void UpdateTransformHierarchy(JobSystem* jobs = nullptr) { Transforms.Update(RootEntity.get(), jobs); }
+		const TransformHierarchy& GetTransformHierarchy() const { return Transforms; }
+
+		eComponentStorageMode GetComponentStorageMode() const { return StorageMode; }
+		const ArchetypeStorage& GetArchetypeStorage() const { return Archetypes; }
+
 
 		//------------------------------------------------------------------------------
 		/// <summary>Returns statically set component type ID from 'Scene' group.</summary>
@@ -99,6 +129,8 @@ namespace Poly {
 		/// <param name="PrimaryComponent">At least one component type must be specified</param>
 		/// <param name="SecondaryComponents">Additional component types (warning: returned pointers might be null!)</param>
 		/// <returns>A proxy object that can be used in a range-for loop.</returns>
+		/// <remarks>With eComponentStorageMode::ARCHETYPE entities are visited archetype by archetype.
+		/// Adding or removing components immediately during iteration invalidates the iterator, use DeferredTaskSystem instead.</remarks>
 		/// <see cref="Scene.ComponentIterator"/>
 		template<typename PrimaryComponent, typename... SecondaryComponents>
 		IteratorProxy<PrimaryComponent, SecondaryComponents...> IterateComponents()
@@ -106,17 +138,85 @@ namespace Poly {
 			return {this};
 		}
 
+		/// <summary>Calls fn(primary, secondary...) for every entity that has all given components.
+		/// Matching entities are split into chunks of at most grainSize entities that are executed
+		/// concurrently on the engine job system (serially when there is no engine or in test runs).</summary>
+		/// <param name="fn">Callable taking PrimaryComponent* followed by SecondaryComponents* (never null).</param>
+		/// <param name="grainSize">Maximum number of entities processed by a single job.</param>
+		/// <remarks>Inside the callback it is safe to:
+		/// - read and modify the passed components,
+		/// - read other components of the same entity,
+		/// - read local transform of the entity and set it when the entity has no children.
+		/// It is NOT safe to:
+		/// - read or set global transform (it updates cached matrices of parents and children shared between chunks),
+		/// - set local transform of an entity that has children (it marks the children dirty),
+		/// - spawn/destroy entities, add/remove components or schedule deferred tasks,
+		/// - touch components of other entities, world components being written by the caller,
+		///   rendering and audio devices.
+		/// Function returns after every chunk has been processed.</remarks>
+		/// <see cref="Scene.IterateComponents()"/>
+		template<typename PrimaryComponent, typename... SecondaryComponents, typename Function>
+		void ParallelForComponents(const Function& fn, size_t grainSize = 64)
+		{
+			ParallelForComponents<PrimaryComponent, SecondaryComponents...>(GetJobSystem(), fn, grainSize);
+		}
+
+		/// <summary>Same as ParallelForComponents(fn, grainSize), executed on the provided job system.</summary>
+		template<typename PrimaryComponent, typename... SecondaryComponents, typename Function>
+		void ParallelForComponents(JobSystem& jobs, const Function& fn, size_t grainSize = 64)
+		{
+			HEAVY_ASSERTE(grainSize > 0, "Grain size has to be at least 1!");
+			if (StorageMode == eComponentStorageMode::ARCHETYPE)
+			{
+				// archetype columns are already packed, chunks are row ranges of matching archetypes
+				struct Chunk { const ComponentArchetype* Archetype; size_t Begin; size_t End; };
+				const size_t ids[] = { GetComponentID<PrimaryComponent>(), GetComponentID<SecondaryComponents>()... };
+				u64 mask = 0;
+				for (size_t id : ids)
+					mask |= u64(1) << id;
+
+				Dynarray<Chunk> chunks;
+				const size_t archetypeCount = Archetypes.GetArchetypeCount();
+				for (size_t idx = Archetypes.FindNextMatching(0, archetypeCount, mask); idx < archetypeCount; idx = Archetypes.FindNextMatching(idx + 1, archetypeCount, mask))
+				{
+					const ComponentArchetype* archetype = Archetypes.GetArchetype(idx);
+					for (size_t begin = 0; begin < archetype->GetEntityCount(); begin += grainSize)
+						chunks.PushBack({ archetype, begin, std::min(begin + grainSize, archetype->GetEntityCount()) });
+				}
+
+				jobs.ParallelFor(chunks.GetSize(), 1, [&chunks, &fn](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; ++i)
+						InvokeForArchetypeRows<PrimaryComponent, SecondaryComponents...>(chunks[i].Archetype, chunks[i].Begin, chunks[i].End, fn, std::index_sequence_for<SecondaryComponents...>{});
+				});
+			}
+			else
+			{
+				// pools can not be split by index, matching tuples are gathered first
+				Dynarray<std::tuple<typename std::add_pointer<PrimaryComponent>::type, typename std::add_pointer<SecondaryComponents>::type...>> tuples;
+				for (auto components : IterateComponents<PrimaryComponent, SecondaryComponents...>())
+					tuples.PushBack(components);
+
+				jobs.ParallelFor(tuples.GetSize(), grainSize, [&tuples, &fn](size_t begin, size_t end) {
+					for (size_t i = begin; i < end; ++i)
+						std::apply(fn, tuples[i]);
+				});
+			}
+		}
+
 		/// Component iterator.
 		template<typename PrimaryComponent, typename... SecondaryComponents>
 		class ComponentIterator : public BaseObject<>,
 		                          public std::iterator<std::forward_iterator_tag, std::tuple<typename std::add_pointer<PrimaryComponent>::type, typename std::add_pointer<SecondaryComponents>::type...>>
 		{
 			public:
-			bool operator==(const ComponentIterator& rhs) const { return primary_iter == rhs.primary_iter; }
+			bool operator==(const ComponentIterator& rhs) const { return primary_iter == rhs.primary_iter && ArchetypeIdx == rhs.ArchetypeIdx && Row == rhs.Row; }
 			bool operator!=(const ComponentIterator& rhs) const { return !(*this == rhs); }
 
 			std::tuple<typename std::add_pointer<PrimaryComponent>::type, typename std::add_pointer<SecondaryComponents>::type...> operator*() const
 			{
+				if (Storage)
+					return GetFromColumns(std::index_sequence_for<SecondaryComponents...>{});
+
 				PrimaryComponent* primary = &*primary_iter;
 				return std::make_tuple(primary, primary->template GetSibling<SecondaryComponents>()...);
 			}
@@ -126,7 +226,7 @@ namespace Poly {
 			}
 
 			ComponentIterator& operator++() { Increment(); return *this; }
-			ComponentIterator operator++(int) { ComponentIterator ret(primary_iter); Increment(); return ret; }
+			ComponentIterator operator++(int) { ComponentIterator ret(*this); Increment(); return ret; }
 
 		private:
 			//------------------------------------------------------------------------------
@@ -140,25 +240,77 @@ namespace Poly {
 				return entity->template HasComponent<Component>() && HasComponents<Rest...>(entity);
 			}
 
+			//------------------------------------------------------------------------------
+			template<size_t... Is>
+			std::tuple<typename std::add_pointer<PrimaryComponent>::type, typename std::add_pointer<SecondaryComponents>::type...> GetFromColumns(std::index_sequence<Is...>) const
+			{
+				return std::make_tuple(static_cast<PrimaryComponent*>(Columns[0][Row]), static_cast<SecondaryComponents*>(Columns[Is + 1][Row])...);
+			}
+
 			//------------------------------------------------------------------------------
 			void Increment()
 			{
+				if (Storage)
+				{
+					if (++Row == RowCount)
+						SeekArchetype(ArchetypeIdx + 1);
+					return;
+				}
+
 				do { ++primary_iter; } 
 				while (primary_iter != End && !HasComponents<SecondaryComponents...>(primary_iter->GetOwner()));
 			}
 
-			explicit ComponentIterator(typename IterablePoolAllocator<PrimaryComponent>::Iterator parent, Scene* const w) : primary_iter(parent), 
+			//------------------------------------------------------------------------------
+			void SeekArchetype(size_t startIdx)
+			{
+				Row = 0;
+				RowCount = 0;
+				ArchetypeIdx = Storage->FindNextMatching(startIdx, ArchetypeEnd, Mask);
+				if (ArchetypeIdx == ArchetypeEnd)
+					return;
+
+				const ComponentArchetype* archetype = Storage->GetArchetype(ArchetypeIdx);
+				const size_t ids[] = { GetComponentID<PrimaryComponent>(), GetComponentID<SecondaryComponents>()... };
+				for (size_t i = 0; i < Columns.size(); ++i)
+					Columns[i] = archetype->GetColumn(ids[i]);
+				RowCount = archetype->GetEntityCount();
+			}
+
+			explicit ComponentIterator(typename ComponentPool<PrimaryComponent>::Iterator parent, Scene* const w) : primary_iter(parent), 
 				Begin(w->GetComponentAllocator<PrimaryComponent>()->Begin()),
 				End(w->GetComponentAllocator<PrimaryComponent>()->End())
 			{
 				if (primary_iter != End && !HasComponents<SecondaryComponents...>(primary_iter->GetOwner()))
 					Increment();
 			}
+
+			ComponentIterator(const ArchetypeStorage* storage, bool atEnd, Scene* const w) : primary_iter(w->GetComponentAllocator<PrimaryComponent>()->End()),
+				Begin(primary_iter), End(primary_iter), Storage(storage), ArchetypeEnd(storage->GetArchetypeCount())
+			{
+				const size_t ids[] = { GetComponentID<PrimaryComponent>(), GetComponentID<SecondaryComponents>()... };
+				for (size_t id : ids)
+					Mask |= u64(1) << id;
+
+				if (atEnd)
+					ArchetypeIdx = ArchetypeEnd;
+				else
+					SeekArchetype(0);
+			}
 			friend struct IteratorProxy<PrimaryComponent, SecondaryComponents...>;
 
-			typename IterablePoolAllocator<PrimaryComponent>::Iterator primary_iter;
-			typename IterablePoolAllocator<PrimaryComponent>::Iterator Begin;
-			typename IterablePoolAllocator<PrimaryComponent>::Iterator End;
+			typename ComponentPool<PrimaryComponent>::Iterator primary_iter;
+			typename ComponentPool<PrimaryComponent>::Iterator Begin;
+			typename ComponentPool<PrimaryComponent>::Iterator End;
+
+			// Archetype storage iteration state, Storage is null in pool mode.
+			const ArchetypeStorage* Storage = nullptr;
+			size_t ArchetypeIdx = 0;
+			size_t ArchetypeEnd = 0;
+			size_t Row = 0;
+			size_t RowCount = 0;
+			u64 Mask = 0;
+			std::array<ComponentBase* const*, 1 + sizeof...(SecondaryComponents)> Columns = {};
 		};
 
 		/// Iterator proxy
@@ -168,10 +320,14 @@ namespace Poly {
 			IteratorProxy(Scene* w) : W(w) {}
 			Scene::ComponentIterator<PrimaryComponent, SecondaryComponents...> Begin()
 			{
+				if (W->GetComponentStorageMode() == eComponentStorageMode::ARCHETYPE)
+					return ComponentIterator<PrimaryComponent, SecondaryComponents...>(&W->GetArchetypeStorage(), false, W);
 				return ComponentIterator<PrimaryComponent, SecondaryComponents...>(W->GetComponentAllocator<PrimaryComponent>()->Begin(), W);
 			}
 			Scene::ComponentIterator<PrimaryComponent, SecondaryComponents...> End()
 			{
+				if (W->GetComponentStorageMode() == eComponentStorageMode::ARCHETYPE)
+					return ComponentIterator<PrimaryComponent, SecondaryComponents...>(&W->GetArchetypeStorage(), true, W);
 				return ComponentIterator<PrimaryComponent, SecondaryComponents...>(W->GetComponentAllocator<PrimaryComponent>()->End(), W);
 			}
 			auto begin() { return Begin(); }
@@ -184,6 +340,7 @@ namespace Poly {
 		friend class DestroyEntityDeferredTask;
 		friend struct EntityDeleter;
 		friend struct ComponentDeleter;
+		friend class Entity;
 		template<typename T,typename... Args> friend class AddComponentDeferredTask;
 		template<typename T> friend class RemoveComponentDeferredTask;
 
@@ -209,10 +366,10 @@ namespace Poly {
 			::new(ptr) T(std::forward<Args>(args)...);
 			HEAVY_ASSERTE(entity, "Invalid entity ID");
 			HEAVY_ASSERTE(!entity->HasComponent(ctypeID), "Failed at AddComponent() - a component of a given UniqueID already exists!");
-			entity->ComponentPosessionFlags.set(ctypeID, true);
-			entity->Components[ctypeID].reset(ptr);
+			entity->InsertComponent(ctypeID, ptr);
 			ptr->Owner = entity;
 			HEAVY_ASSERTE(entity->HasComponent(ctypeID), "Failed at AddComponent() - the component was not added!");
+			UpdateEntityArchetype(entity);
 			entity->SetBBoxDirty();
 		}
 
@@ -223,18 +380,18 @@ namespace Poly {
 			const auto ctypeID = GetComponentID<T>();
 			HEAVY_ASSERTE(entity, "Invalid entity ID");
 			HEAVY_ASSERTE(entity->HasComponent(ctypeID), "Failed at RemoveComponent() - a component of a given UniqueID does not exist!");
-			entity->ComponentPosessionFlags.set(ctypeID, false);
-			entity->Components[ctypeID].reset(nullptr);
+			entity->EraseComponent(ctypeID);
 			HEAVY_ASSERTE(!entity->HasComponent(ctypeID), "Failed at AddComponent() - the component was not removed!");
+			UpdateEntityArchetype(entity);
 			entity->SetBBoxDirty();
 		}
 
 		//------------------------------------------------------------------------------
 		template<typename T>
-		IterablePoolAllocator<T>* GetComponentAllocator()
+		ComponentPool<T>* GetComponentAllocator()
 		{
 			const auto ctypeID = GetComponentID<T>();
-			return static_cast<IterablePoolAllocator<T>*>(GetComponentAllocator(ctypeID));
+			return static_cast<ComponentPool<T>*>(GetComponentAllocator(ctypeID));
 		}
 
 		//------------------------------------------------------------------------------
@@ -253,13 +410,39 @@ namespace Poly {
 
 		void RemoveComponentById(Entity* ent, size_t id);
 
+		//------------------------------------------------------------------------------
+		template<typename PrimaryComponent, typename... SecondaryComponents, typename Function, size_t... Is>
+		static void InvokeForArchetypeRows(const ComponentArchetype* archetype, size_t begin, size_t end, const Function& fn, std::index_sequence<Is...>)
+		{
+			ComponentBase* const* primary = archetype->GetColumn(GetComponentID<PrimaryComponent>());
+			const std::array<ComponentBase* const*, sizeof...(SecondaryComponents)> secondary = { { archetype->GetColumn(GetComponentID<SecondaryComponents>())... } };
+			UNUSED(secondary);
+			for (size_t row = begin; row < end; ++row)
+				fn(static_cast<PrimaryComponent*>(primary[row]), static_cast<SecondaryComponents*>(secondary[Is][row])...);
+		}
+
+		//------------------------------------------------------------------------------
+		JobSystem& GetJobSystem() const;
+
+		//------------------------------------------------------------------------------
+		void UpdateEntityArchetype(Entity* entity)
+		{
+			if (StorageMode == eComponentStorageMode::ARCHETYPE)
+				Archetypes.UpdateEntity(entity);
+		}
+
 		// Allocators
-		IterablePoolAllocator<Entity> EntitiesAllocator;
+		BitmapPoolAllocator<Entity> EntitiesAllocator;
+		EntityHandleTable EntityHandles;
 		IterablePoolAllocatorBase* ComponentAllocators[MAX_COMPONENTS_COUNT];
 
 		ComponentDeleter ComponentDel;
 		EntityDeleter EntityDel;
 
+		const eComponentStorageMode StorageMode;
+		ArchetypeStorage Archetypes;
+		TransformHierarchy Transforms;
+
 		Entity::EntityUniquePtr RootEntity;
 	};
 } //namespace Poly
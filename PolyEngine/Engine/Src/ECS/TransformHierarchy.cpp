@@ -0,0 +1,134 @@
+#include "EnginePCH.hpp"
+
+#include "ECS/TransformHierarchy.hpp"
+#include "ECS/Entity.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	// Subtrees smaller than this are grouped together into a single job.
+	constexpr size_t SUBTREES_PER_JOB = 64;
+}
+
+//------------------------------------------------------------------------------
+void TransformHierarchy::Update(Entity* root, JobSystem* jobs)
+{
+	HEAVY_ASSERTE(root && root->IsRoot(), "Transform hierarchy has to be updated from scene root!");
+	if (StructureDirty)
+		Rebuild(root);
+
+	size_t updated = UpdateRange(0, 1);
+	const size_t subtreeCount = SubtreeOffsets.GetSize() - 1;
+	if (!jobs || jobs->IsSerial())
+	{
+		updated += UpdateRange(SubtreeOffsets[0], SubtreeOffsets[subtreeCount]);
+	}
+	else
+	{
+		// consecutive subtrees form a consecutive range of nodes
+		std::atomic<size_t> updatedInJobs{ 0 };
+		jobs->ParallelFor(subtreeCount, SUBTREES_PER_JOB, [this, &updatedInJobs](size_t begin, size_t end) {
+			updatedInJobs += UpdateRange(SubtreeOffsets[begin], SubtreeOffsets[end]);
+		});
+		updated += updatedInJobs.load();
+	}
+	LastUpdatedCount = updated;
+}
+
+//------------------------------------------------------------------------------
+void TransformHierarchy::Rebuild(Entity* root)
+{
+	Nodes.Clear();
+	ParentIndices.Clear();
+	SubtreeOffsets.Clear();
+
+	Nodes.PushBack(&root->GetTransform());
+	ParentIndices.PushBack(NO_PARENT);
+
+	for (const Entity::EntityUniquePtr& subtreeRoot : root->GetChildren())
+	{
+		const size_t subtreeBegin = Nodes.GetSize();
+		SubtreeOffsets.PushBack(subtreeBegin);
+		Nodes.PushBack(&subtreeRoot->GetTransform());
+		ParentIndices.PushBack(0);
+
+		// breadth-first walk, nodes appended during the walk are visited later in the same loop
+		for (size_t idx = subtreeBegin; idx < Nodes.GetSize(); ++idx)
+		{
+			for (const Entity::EntityUniquePtr& child : Nodes[idx]->Owner->GetChildren())
+			{
+				Nodes.PushBack(&child->GetTransform());
+				ParentIndices.PushBack(idx);
+			}
+		}
+	}
+	SubtreeOffsets.PushBack(Nodes.GetSize());
+
+	const size_t nodeCount = Nodes.GetSize();
+	LocalTranslations.Resize(nodeCount);
+	LocalRotations.Resize(nodeCount);
+	LocalScales.Resize(nodeCount);
+	WorldMatrices.Resize(nodeCount);
+	LocalChanged.Resize(nodeCount);
+	WorldChanged.Resize(nodeCount);
+	for (size_t idx = 0; idx < nodeCount; ++idx)
+	{
+		EntityTransform* transform = Nodes[idx];
+		transform->Hierarchy = this;
+		transform->HierarchyIndex = idx;
+		LocalTranslations[idx] = transform->LocalTranslation;
+		LocalRotations[idx] = transform->LocalRotation;
+		LocalScales[idx] = transform->LocalScale;
+
+		// world matrices already computed by getters are valid, dirty flag is propagated to children so their parents are valid too
+		LocalChanged[idx] = transform->GlobalDirty;
+		if (!transform->GlobalDirty)
+			WorldMatrices[idx] = transform->WorldFromModel;
+	}
+	StructureDirty = false;
+}
+
+//------------------------------------------------------------------------------
+size_t TransformHierarchy::UpdateRange(size_t begin, size_t end)
+{
+	size_t updated = 0;
+	for (size_t idx = begin; idx < end; ++idx)
+	{
+		const size_t parentIdx = ParentIndices[idx];
+		const bool changed = LocalChanged[idx] || (parentIdx != NO_PARENT && WorldChanged[parentIdx]);
+		WorldChanged[idx] = changed;
+		if (!changed)
+			continue;
+
+		LocalChanged[idx] = false;
+		Matrix parentFromModel;
+		parentFromModel.SetTransformation(LocalTranslations[idx], LocalRotations[idx], LocalScales[idx]);
+		if (parentIdx == NO_PARENT)
+			WorldMatrices[idx] = parentFromModel;
+		else
+			WorldMatrices[idx] = WorldMatrices[parentIdx] * parentFromModel;
+
+		// global translation, rotation and scale are decomposed by getters when needed
+		EntityTransform* transform = Nodes[idx];
+		transform->WorldFromModel = WorldMatrices[idx];
+		transform->GlobalDirty = false;
+		transform->GlobalDecompositionDirty = true;
+		++updated;
+	}
+	return updated;
+}
+
+//------------------------------------------------------------------------------
+void TransformHierarchy::SetLocalTransform(size_t idx, const Vector& translation, const Quaternion& rotation, const Vector& scale)
+{
+	// indices are outdated, all local transforms are copied in rebuild
+	if (StructureDirty)
+		return;
+
+	HEAVY_ASSERTE(idx < LocalChanged.GetSize(), "Transform hierarchy index out of bounds!");
+	LocalTranslations[idx] = translation;
+	LocalRotations[idx] = rotation;
+	LocalScales[idx] = scale;
+	LocalChanged[idx] = true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/Quaternion.hpp>
+#include <Threading/JobSystem.hpp>
+
+namespace Poly
+{
+	class Entity;
+	class EntityTransform;
+
+	/// <summary>Flattened view of scene entity hierarchy used to update world transforms in one linear pass.
+	/// Local translations, rotations and scales and world matrices are stored in contiguous arrays, subtree by subtree
+	/// of root children, each subtree in breadth-first (depth-sorted) order, so parents are always processed before their children.
+	/// Local transform setters write through to the arrays, the pass composes and multiplies matrices reading only the arrays
+	/// and writes recomputed world matrices back to entity transforms, which decompose them only when global values are read.
+	/// After an update cached world transforms of all entities are valid and transform getters become plain reads.</summary>
+	class ENGINE_DLLEXPORT TransformHierarchy final : public BaseObject<>
+	{
+	public:
+		/// <summary>Marks flattened hierarchy as outdated.
+		/// Has to be called whenever an entity is spawned, destroyed or reparented.</summary>
+		void SetStructureDirty() { StructureDirty = true; }
+
+		/// <summary>Recomputes world matrices of all transforms marked dirty in hierarchy under root.</summary>
+		/// <param name="root">Scene root entity.</param>
+		/// <param name="jobs">Job system used to update subtrees of root children concurrently, can be null.</param>
+		void Update(Entity* root, JobSystem* jobs = nullptr);
+
+		size_t GetNodeCount() const { return Nodes.GetSize(); }
+
+		/// <summary>Returns number of world matrices recomputed during last update.</summary>
+		size_t GetLastUpdatedCount() const { return LastUpdatedCount; }
+
+	private:
+		static constexpr size_t NO_PARENT = static_cast<size_t>(-1);
+
+		void Rebuild(Entity* root);
+		size_t UpdateRange(size_t begin, size_t end);
+
+		// called by EntityTransform when its local transform changes, ignored until rebuild when structure is dirty
+		void SetLocalTransform(size_t idx, const Vector& translation, const Quaternion& rotation, const Vector& scale);
+
+		Dynarray<EntityTransform*> Nodes; // only written to when world matrix of the node changes
+		Dynarray<size_t> ParentIndices;
+		Dynarray<Vector> LocalTranslations;
+		Dynarray<Quaternion> LocalRotations;
+		Dynarray<Vector> LocalScales;
+		Dynarray<Matrix> WorldMatrices;
+		Dynarray<u8> LocalChanged; // local transform set since last update
+		Dynarray<u8> WorldChanged; // world matrix recomputed in last update, children have to follow
+		Dynarray<size_t> SubtreeOffsets; // first node of every root child subtree, followed by node count
+		size_t LastUpdatedCount = 0;
+		bool StructureDirty = true;
+
+		friend class EntityTransform;
+	};
+}
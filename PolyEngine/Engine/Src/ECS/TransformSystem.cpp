@@ -0,0 +1,12 @@
+#include "EnginePCH.hpp"
+
+#include "ECS/TransformSystem.hpp"
+#include "ECS/Scene.hpp"
+
+using namespace Poly;
+
+//------------------------------------------------------------------------------
+void TransformSystem::TransformUpdatePhase(Scene* world)
+{
+	world->UpdateTransformHierarchy(&gEngine->GetJobSystem());
+}
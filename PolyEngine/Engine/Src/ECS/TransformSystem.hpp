@@ -0,0 +1,16 @@
+#pragma once
+
+#include <Defines.hpp>
+
+namespace Poly
+{
+	class Scene;
+
+	namespace TransformSystem
+	{
+		/// <summary>Recomputes world transforms of all entities that changed since last frame
+		/// in one linear pass over the scene hierarchy. Registered right before rendering,
+		/// so renderer reads only cached matrices.</summary>
+		void TransformUpdatePhase(Scene* world);
+	}
+}
@@ -0,0 +1,103 @@
+#include "EnginePCH.hpp"
+
+#include "ECS/UpdatePhaseScheduler.hpp"
+
+using namespace Poly;
+
+//------------------------------------------------------------------------------
+UpdatePhaseAccess UpdatePhaseAccess::Exclusive()
+{
+	UpdatePhaseAccess access;
+	access.ExclusiveAccess = true;
+	return access;
+}
+
+//------------------------------------------------------------------------------
+bool UpdatePhaseAccess::ConflictsWith(const UpdatePhaseAccess& other) const
+{
+	if (ExclusiveAccess || other.ExclusiveAccess)
+		return true;
+
+	return Intersects(WriteTypes, other.WriteTypes)
+		|| Intersects(WriteTypes, other.ReadTypes)
+		|| Intersects(ReadTypes, other.WriteTypes);
+}
+
+//------------------------------------------------------------------------------
+bool UpdatePhaseAccess::Intersects(const Dynarray<RTTI::TypeInfo>& a, const Dynarray<RTTI::TypeInfo>& b)
+{
+	for (const RTTI::TypeInfo& type : a)
+		if (b.Contains(type))
+			return true;
+	return false;
+}
+
+//------------------------------------------------------------------------------
+void UpdatePhaseScheduler::AddPhase(const PhaseUpdateFunction& phaseFunction, const UpdatePhaseAccess& access)
+{
+	Phases.PushBack({ phaseFunction, access });
+	BatchesDirty = true;
+}
+
+//------------------------------------------------------------------------------
+const Dynarray<Dynarray<size_t>>& UpdatePhaseScheduler::GetBatches()
+{
+	if (BatchesDirty)
+		RebuildBatches();
+	return Batches;
+}
+
+//------------------------------------------------------------------------------
+void UpdatePhaseScheduler::Execute(Scene* scene, JobSystem& jobs)
+{
+	// registration order is a valid topological order of the dependency graph
+	if (jobs.IsSerial())
+	{
+		for (Phase& phase : Phases)
+			phase.Function(scene);
+		return;
+	}
+
+	for (const Dynarray<size_t>& batch : GetBatches())
+	{
+		JobCounter counter;
+		for (size_t idx : batch)
+		{
+			Phase& phase = Phases[idx];
+			if (!phase.Access.IsMainThreadOnly())
+				jobs.Submit([&phase, scene]() { phase.Function(scene); }, counter);
+		}
+
+		for (size_t idx : batch)
+		{
+			Phase& phase = Phases[idx];
+			if (phase.Access.IsMainThreadOnly())
+				phase.Function(scene);
+		}
+
+		jobs.Wait(counter);
+	}
+}
+
+//------------------------------------------------------------------------------
+void UpdatePhaseScheduler::RebuildBatches()
+{
+	// batch of a phase is one past the latest batch of any earlier phase it conflicts with
+	Dynarray<size_t> phaseBatch(Phases.GetSize());
+	Batches.Clear();
+	for (size_t i = 0; i < Phases.GetSize(); ++i)
+	{
+		size_t batchIdx = 0;
+		for (size_t j = 0; j < i; ++j)
+		{
+			if (Phases[i].Access.ConflictsWith(Phases[j].Access))
+				batchIdx = std::max(batchIdx, phaseBatch[j] + 1);
+		}
+
+		phaseBatch.PushBack(batchIdx);
+		if (batchIdx == Batches.GetSize())
+			Batches.PushBack(Dynarray<size_t>());
+		Batches[batchIdx].PushBack(i);
+	}
+	BatchesDirty = false;
+}
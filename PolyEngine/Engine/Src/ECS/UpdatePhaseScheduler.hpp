@@ -0,0 +1,79 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <RTTI/RTTI.hpp>
+#include <Threading/JobSystem.hpp>
+
+namespace Poly
+{
+	class Scene;
+	typedef std::function<void(Scene*)> PhaseUpdateFunction;
+
+	/// <summary>Declares which scene data an update phase touches.
+	/// Types are identified by RTTI, so both components, world components and EntityTransform can be listed.
+	/// Phases whose declarations do not conflict can be executed concurrently.</summary>
+	/// <remarks>Phases running outside of the main thread must not perform structural scene changes
+	/// (spawning/destroying entities, adding/removing components, scheduling deferred tasks)
+	/// and must not use rendering or audio devices. Reading global transform counts as a write,
+	/// because it updates cached matrices of the entity and its parents.</remarks>
+	class ENGINE_DLLEXPORT UpdatePhaseAccess final : public BaseObjectLiteralType<>
+	{
+	public:
+		/// <summary>Creates declaration of a phase that conflicts with every other phase and runs on the main thread.
+		/// Used for phases registered without any declaration.</summary>
+		static UpdatePhaseAccess Exclusive();
+
+		template<typename... Ts> UpdatePhaseAccess& Reads() { (ReadTypes.PushBack(RTTI::TypeInfo::Get<Ts>()), ...); return *this; }
+		template<typename... Ts> UpdatePhaseAccess& Writes() { (WriteTypes.PushBack(RTTI::TypeInfo::Get<Ts>()), ...); return *this; }
+
+		/// <summary>Marks phase as one that has to be executed on the thread calling Engine::Update().</summary>
+		UpdatePhaseAccess& OnMainThread() { MainThread = true; return *this; }
+
+		bool IsExclusive() const { return ExclusiveAccess; }
+		bool IsMainThreadOnly() const { return MainThread || ExclusiveAccess; }
+
+		/// <summary>Checks whether two phases can not be executed at the same time.</summary>
+		bool ConflictsWith(const UpdatePhaseAccess& other) const;
+
+	private:
+		static bool Intersects(const Dynarray<RTTI::TypeInfo>& a, const Dynarray<RTTI::TypeInfo>& b);
+
+		Dynarray<RTTI::TypeInfo> ReadTypes;
+		Dynarray<RTTI::TypeInfo> WriteTypes;
+		bool MainThread = false;
+		bool ExclusiveAccess = false;
+	};
+
+	/// <summary>Executes update phases registered for a single part of the frame.
+	/// Every phase depends on all earlier registered phases it conflicts with,
+	/// phases are grouped into batches by the length of their dependency chain
+	/// and every batch is executed concurrently on the job system.</summary>
+	/// <remarks>With serial job system phases are executed exactly in registration order.</remarks>
+	class ENGINE_DLLEXPORT UpdatePhaseScheduler final : public BaseObject<>
+	{
+	public:
+		void AddPhase(const PhaseUpdateFunction& phaseFunction, const UpdatePhaseAccess& access);
+
+		size_t GetPhaseCount() const { return Phases.GetSize(); }
+
+		/// <summary>Returns groups of phase indices (in registration order) that can be executed concurrently.</summary>
+		const Dynarray<Dynarray<size_t>>& GetBatches();
+
+		/// <summary>Executes all phases, returns after every one of them finished.</summary>
+		void Execute(Scene* scene, JobSystem& jobs);
+
+	private:
+		struct Phase
+		{
+			PhaseUpdateFunction Function;
+			UpdatePhaseAccess Access;
+		};
+
+		void RebuildBatches();
+
+		Dynarray<Phase> Phases;
+		Dynarray<Dynarray<size_t>> Batches;
+		bool BatchesDirty = true;
+	};
+}
@@ -4,9 +4,12 @@
 #include "Configs/AssetsPathConfig.hpp"
 #include "Configs/DebugConfig.hpp"
 #include "ECS/DeferredTaskSystem.hpp"
+#include "ECS/TransformSystem.hpp"
 #include "Input/InputWorldComponent.hpp"
 #include "Movement/FreeFloatMovementComponent.hpp"
 #include "AI/PathfindingSystem.hpp"
+#include "AI/PathfindingComponent.hpp"
+#include "Audio/SoundEmitterComponent.hpp"
 #include "Rendering/ViewportWorldComponent.hpp"
 #include "Rendering/Lighting/LightSourceComponent.hpp"
 #include "Rendering/RenderingSystem.hpp"
@@ -17,20 +20,32 @@
 #include "Physics2D/Physics2DWorldComponent.hpp"
 #include "Physics3D/Physics3DWorldComponent.hpp"
 #include "Debugging/DebugDrawSystem.hpp"
+#include "Resources/ResourceManager.hpp"
 
 using namespace Poly;
 
 Engine* Poly::gEngine = nullptr;
 
+//------------------------------------------------------------------------------
+JobSystem& Poly::GetJobSystem()
+{
+	if (gEngine)
+		return gEngine->GetJobSystem();
+
+	static JobSystem serialJobs(0);
+	return serialJobs;
+}
+
 //------------------------------------------------------------------------------
 Engine::Engine(bool testRun)
-	: Game()
+	: Game(), Jobs(testRun ? 0 : JobSystem::GetDefaultWorkerCount())
 {
 	ASSERTE(gEngine == nullptr, "Creating engine twice?");
 	gEngine = this;
 
 	if (!testRun)
 	{
+		// job workers create their generators on first draw, so the seed covers them too
 		RandomSetSeed((int)time(nullptr));
 
 		gAssetsPathConfig.Load();
@@ -44,8 +59,7 @@ Engine::Engine(bool testRun)
 void Poly::Engine::Init(std::unique_ptr<IGame> game, std::unique_ptr<IRenderingDevice> device)
 {
 	Game = std::move(game);
-	RenderingDevice = std::move(device);
-	RenderingDevice->Init();
+	InitRenderingDevice(std::move(device));
 	LoadDefaultScene();
 	Game->RegisterEngine(this);
 
@@ -70,12 +84,16 @@ void Poly::Engine::Init(std::unique_ptr<IGame> game, std::unique_ptr<IRenderingD
 	RegisterUpdatePhase(Physics3DSystem::Physics3DUpdatePhase, eUpdatePhaseOrder::PREUPDATE);
 	RegisterUpdatePhase(MovementSystem::MovementUpdatePhase, eUpdatePhaseOrder::PREUPDATE);
 
-	RegisterUpdatePhase(PathfindingSystem::UpdatePhase, eUpdatePhaseOrder::POSTUPDATE);
+	// pathfinding runs on a worker while sound is polled on the main thread
+	RegisterUpdatePhase(PathfindingSystem::UpdatePhase, eUpdatePhaseOrder::POSTUPDATE,
+		UpdatePhaseAccess().Writes<PathfindingComponent, EntityTransform>());
+	RegisterUpdatePhase(SoundSystem::SoundPhase, eUpdatePhaseOrder::POSTUPDATE,
+		UpdatePhaseAccess().Reads<SoundEmitterComponent>().OnMainThread());
 	RegisterUpdatePhase(CameraSystem::CameraUpdatePhase, eUpdatePhaseOrder::POSTUPDATE);
 	RegisterUpdatePhase(DebugDrawSystem::DebugRenderingUpdatePhase, eUpdatePhaseOrder::POSTUPDATE);
 	RegisterUpdatePhase(ParticleUpdateSystem::ParticleUpdatePhase, eUpdatePhaseOrder::POSTUPDATE);
+	RegisterUpdatePhase(TransformSystem::TransformUpdatePhase, eUpdatePhaseOrder::POSTUPDATE);
 	RegisterUpdatePhase(RenderingSystem::RenderingPhase, eUpdatePhaseOrder::POSTUPDATE);
-	RegisterUpdatePhase(SoundSystem::SoundPhase, eUpdatePhaseOrder::POSTUPDATE);
 	RegisterUpdatePhase(DeferredTaskSystem::DeferredTaskPhase, eUpdatePhaseOrder::POSTUPDATE);
 	RegisterUpdatePhase(FPSSystem::FPSUpdatePhase, eUpdatePhaseOrder::POSTUPDATE);
 
@@ -85,30 +103,47 @@ void Poly::Engine::Init(std::unique_ptr<IGame> game, std::unique_ptr<IRenderingD
 	Game->Init();
 }
 
+//------------------------------------------------------------------------------
+void Engine::InitRenderingDevice(std::unique_ptr<IRenderingDevice> device)
+{
+	RenderingDevice = std::move(device);
+	RenderingDevice->Init();
+}
+
 //------------------------------------------------------------------------------
 Engine::~Engine()
 {
-	Game->Deinit();
+	// test runs may have no game
+	if (Game)
+		Game->Deinit();
 	ActiveScene.reset();
 	Game.reset();
+	// background loads use job system workers and rendering device, let them finish first
+	while (AsyncResourceLoader::GetPendingCount() > 0)
+		AsyncResourceLoader::Update();
 	RenderingDevice.reset();
 	gEngine = nullptr;
 }
 
 //------------------------------------------------------------------------------
-void Engine::RegisterUpdatePhase(const PhaseUpdateFunction& phaseFunction, eUpdatePhaseOrder order)
+void Engine::RegisterUpdatePhase(const PhaseUpdateFunction& phaseFunction, eUpdatePhaseOrder order, const UpdatePhaseAccess& access)
 {
 	HEAVY_ASSERTE(order != eUpdatePhaseOrder::_COUNT, "_COUNT enum value passed to RegisterUpdatePhase(), which is an invalid value");
-	Dynarray<PhaseUpdateFunction>& UpdatePhases = GameUpdatePhases[static_cast<int>(order)];
-	UpdatePhases.PushBack(phaseFunction);
+	GameUpdatePhases[static_cast<int>(order)].AddPhase(phaseFunction, access);
 }
 
 //------------------------------------------------------------------------------
 void Engine::Update()
 {
+	// resources decoded in the background become available before systems run
+	AsyncResourceLoader::Update();
+
 	UpdatePhases(eUpdatePhaseOrder::PREUPDATE);
 	UpdatePhases(eUpdatePhaseOrder::UPDATE);
 	UpdatePhases(eUpdatePhaseOrder::POSTUPDATE);
+
+	// transient data of this frame stays valid during the next one
+	FrameAllocator::EndFrame();
 }
 
 //------------------------------------------------------------------------------
@@ -5,12 +5,12 @@
 #include "Rendering/IRenderingDevice.hpp"
 #include "Audio/OpenALDevice.hpp"
 #include "Input/InputSystem.hpp"
+#include "ECS/UpdatePhaseScheduler.hpp"
 
 namespace Poly
 {
 	class Scene;
 	class Engine;
-	typedef std::function<void(Scene*)> PhaseUpdateFunction;
 
 	/// <summary>Abstract class that every game has to inherit from.</summary>
 	class ENGINE_DLLEXPORT IGame : public BaseObject<>
@@ -26,6 +26,7 @@ namespace Poly
 	{
 	public:
 		/// <summary>Constructs engine instance.</summary>
+		/// <param name="testRun">Skips loading configs and runs all update phases serially, in registration order.</param>
 		Engine(bool testRun = false);
 
 		/// <summary>Deletes engine instance.</summary>
@@ -47,10 +48,22 @@ namespace Poly
 		/// <param name="device">Pointer to IRenderingDevice instance.</param>
 		void Init(std::unique_ptr<IGame> game, std::unique_ptr<IRenderingDevice> device);
 
+		/// <summary>Initializes only rendering device, so test runs can load resources and render scenes without a game.
+		/// Called by <see cref="Engine.Init()"/>.</summary>
+		/// <param name="device">Pointer to IRenderingDevice instance.</param>
+		void InitRenderingDevice(std::unique_ptr<IRenderingDevice> device);
+
 		/// <summary>Registers a PhaseUpdateFunction to be executed in the update.</summary>
 		/// <param name="phaseFunction"/>
 		void RegisterGameUpdatePhase(const PhaseUpdateFunction& phaseFunction) { RegisterUpdatePhase(phaseFunction, eUpdatePhaseOrder::UPDATE); }
 
+		/// <summary>Registers a PhaseUpdateFunction to be executed in the update,
+		/// concurrently with other phases whose declared access does not conflict with it.</summary>
+		/// <param name="phaseFunction"/>
+		/// <param name="access">Types read and written by the phase.</param>
+		/// <see cref="UpdatePhaseAccess"/>
+		void RegisterGameUpdatePhase(const PhaseUpdateFunction& phaseFunction, const UpdatePhaseAccess& access) { RegisterUpdatePhase(phaseFunction, eUpdatePhaseOrder::UPDATE, access); }
+
 		/// <summary>Executes update phases functions that were registered in RegisterUpdatePhase().
 		/// Functions are executrd with given order and with given update phase order.</summary>
 		/// <see cref="Engine.RegisterUpdatePhase()"/>
@@ -147,6 +160,9 @@ namespace Poly
 		/// <returns>Reference to InputQueue instance.</returns>
 		InputQueue& GetInputQueue() { return InputEventsQueue; }
 
+		/// <summary>Returns job system used to execute update phases.</summary>
+		JobSystem& GetJobSystem() { return Jobs; }
+
 		/// <summary>Makes renderer resizes its context.</summary>
 		/// <param name="size">New screen size</param>
 		void ResizeScreen(const ScreenSize& size);
@@ -155,16 +171,18 @@ namespace Poly
 		inline void UpdatePhases(eUpdatePhaseOrder order)
 		{
 			HEAVY_ASSERTE(order != eUpdatePhaseOrder::_COUNT, "_COUNT enum value passed to UpdatePhases(), which is an invalid value");
-			for (auto& update : GameUpdatePhases[static_cast<int>(order)])
-				update(GetActiveScene());
+			GameUpdatePhases[static_cast<int>(order)].Execute(GetActiveScene(), Jobs);
 		}
 
 		/// Registers a PhaseUpdateFunction to be executed in the update.
 		/// part of a single frame in the same order as they were passed in.
+		/// Phase registered without access declaration conflicts with every other phase.
 		/// @param phaseFunction - void function(Scene*)
 		/// @param order - enum eUpdatePhaseOrder value
+		/// @param access - types read and written by the phase
 		/// @see eUpdatePhaseOrder
-		void RegisterUpdatePhase(const PhaseUpdateFunction& phaseFunction, eUpdatePhaseOrder order);
+		/// @see UpdatePhaseAccess
+		void RegisterUpdatePhase(const PhaseUpdateFunction& phaseFunction, eUpdatePhaseOrder order, const UpdatePhaseAccess& access = UpdatePhaseAccess::Exclusive());
 
 		std::unique_ptr<Scene> ActiveScene;
 		Scene* SerializedScene = nullptr;
@@ -173,7 +191,8 @@ namespace Poly
 		OpenALDevice AudioDevice;
 		InputQueue InputEventsQueue;
 
-		Dynarray<PhaseUpdateFunction> GameUpdatePhases[static_cast<int>(eUpdatePhaseOrder::_COUNT)];
+		JobSystem Jobs;
+		UpdatePhaseScheduler GameUpdatePhases[static_cast<int>(eUpdatePhaseOrder::_COUNT)];
 
 		bool QuitRequested = false; //stop the game
 		bool MouseCaptureEnabled = false;
@@ -181,6 +200,10 @@ namespace Poly
 	};
 
 	ENGINE_DLLEXPORT extern Engine* gEngine;
+
+	/// <summary>Returns job system of the engine, or a serial one running jobs on the calling thread
+	/// when there is no engine (tools, tests).</summary>
+	ENGINE_DLLEXPORT JobSystem& GetJobSystem();
 }
 
 #define DECLARE_GAME() extern "C" { GAME_DLLEXPORT Poly::IGame* POLY_STDCALL CreateGame(); }
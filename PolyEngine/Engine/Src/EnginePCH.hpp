@@ -26,6 +26,8 @@
 #include <Memory/Allocator.hpp>
 #include <Memory/PoolAllocator.hpp>
 #include <Memory/IterablePoolAllocator.hpp>
+#include <Memory/BitmapPoolAllocator.hpp>
+#include <Memory/FrameAllocator.hpp>
 #include <Memory/RefCountedBase.hpp>
 #include <Memory/SafePtr.hpp>
 #include <Memory/SafePtrRoot.hpp>
@@ -37,6 +39,8 @@
 #include <Collections/Queue.hpp>
 #include <Collections/PriorityQueue.hpp>
 #include <Collections/OrderedMap.hpp>
+#include <Collections/HashMap.hpp>
+#include <Collections/HashSet.hpp>
 
 // Other
 #include <Math/Color.hpp>
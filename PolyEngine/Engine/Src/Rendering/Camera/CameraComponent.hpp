@@ -44,6 +44,9 @@ namespace Poly {
 		eRenderingModeType GetRenderingMode() const { return RenderingMode; }
 		void SetRenderingMode(eRenderingModeType value) { RenderingMode = value; }
 
+		bool GetIsPerspective() const { return IsPerspective; }
+		const Frustum& GetFrustum() const { HEAVY_ASSERTE(IsPerspective, "Only perspective camera has a frustum!"); return CameraFrustum.Value(); }
+
 		void UpdateProjection();
 
 		bool IsVisibleToCamera(const Entity* ent) const;
@@ -37,6 +37,25 @@ namespace Poly
 		_COUNT
 	};
 
+	//------------------------------------------------------------------------------
+	enum class eTextureCompression
+	{
+		NONE,
+		BC1,	// RGB, 4 bits per pixel
+		BC3,	// RGBA, 8 bits per pixel
+		_COUNT
+	};
+
+	/// <summary>Content of single mip level of a texture.</summary>
+	struct TextureMipLevel
+	{
+		size_t Width = 0;
+		size_t Height = 0;
+		/// <summary>Pixels in texture format or 4x4 blocks for compressed textures.</summary>
+		const void* Data = nullptr;
+		size_t Size = 0;
+	};
+
 	enum class eCubemapSide
 	{
 		RIGHT,
@@ -73,6 +92,9 @@ namespace Poly
 		virtual void SetContent(const unsigned char* data) = 0;
 		virtual void SetContentHDR(const float* data) = 0;
 		virtual void SetSubContent(size_t width, size_t height, size_t offsetX, size_t offsetY, const unsigned char* data) = 0;
+		/// <summary>Uploads precomputed mip chain, starting from full resolution level.
+		/// Uncompressed levels have the channel count and data type the texture was created with.</summary>
+		virtual void SetContentMips(eTextureCompression compression, const Dynarray<TextureMipLevel>& levels) = 0;
 		virtual unsigned int GetResourceID() const = 0;
 	};
 
@@ -113,6 +135,20 @@ namespace Poly
 		virtual void SetContent(const ParticleEmitter& particles) = 0;
 	};
 
+	//------------------------------------------------------------------------------
+	/// <summary>Counters gathered by rendering device during last rendered frame, for profiling.</summary>
+	struct ENGINE_DLLEXPORT RenderingStats
+	{
+		size_t ShadowCastersDrawn = 0;
+		size_t ShadowCastersCulled = 0;
+		size_t DrawCommands = 0;
+		size_t StateChangesSaved = 0;
+		size_t InstancedDrawsSaved = 0;
+		size_t TrianglesSubmitted = 0;
+		/// <summary>Triangles not submitted thanks to levels of detail, compared to drawing every mesh at full detail.</summary>
+		size_t TrianglesSkippedByLod = 0;
+	};
+
 	//------------------------------------------------------------------------------
 	class ENGINE_DLLEXPORT IRenderingDevice : public BaseObject<>
 	{
@@ -128,6 +164,9 @@ namespace Poly
 		virtual std::unique_ptr<ITextFieldBufferDeviceProxy> CreateTextFieldBuffer() = 0;
 		virtual std::unique_ptr<IMeshDeviceProxy> CreateMesh() = 0;
 		virtual std::unique_ptr<IParticleDeviceProxy> CreateParticle() = 0;
+
+		const RenderingStats& GetRenderingStats() const { return Stats; }
 	protected:
+		RenderingStats Stats;
 	};
 }
\ No newline at end of file
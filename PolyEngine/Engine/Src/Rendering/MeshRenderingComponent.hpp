@@ -53,6 +53,8 @@ namespace Poly {
 		bool GetIsWireframe() const { return IsWireframe; }
 		eShadingMode GetShadingModel() const { return ShadingMode; }
 		eBlendingMode GetBlendingMode() const { return BlendingMode; }
+		/// <summary>Returns level of detail of sub meshes selected for the last rendered view, see <see cref="VisibilityCuller::SelectLods()"/>.</summary>
+		size_t GetLodLevel() const { return LodLevel; }
 		
 		void SetMaterial(size_t i, const Material& value) { Materials[i] = value; }
 		void SetIsWireframe(bool value) { IsWireframe = value; }
@@ -67,7 +69,11 @@ namespace Poly {
 		eShadingMode ShadingMode = eShadingMode::PBR;
 		eBlendingMode BlendingMode = eBlendingMode::OPAUQE;
 		bool IsWireframe = false;
+		size_t LodLevel = 0;
+
+		friend class VisibilityCuller;
 	};
 
 	REGISTER_COMPONENT(ComponentsIDGroup, MeshRenderingComponent)
+	COMPONENT_USE_BITMAP_POOL(MeshRenderingComponent)
 }
\ No newline at end of file
@@ -63,7 +63,7 @@ namespace Poly
 		const IParticleDeviceProxy* GetParticleProxy() const { return ParticleProxy.get(); }
 		bool GetIsBurstEnabled() { return IsBurstEnabled; }
 		void SetBurstEnabled(bool value) { IsBurstEnabled = value; }
-		const IterablePoolAllocator<Particle>& GetParticlesPool() const { return ParticlesPool; }
+		const BitmapPoolAllocator<Particle>& GetParticlesPool() const { return ParticlesPool; }
 		bool HasInstances() const { return ParticlesPool.GetSize() != 0; }
 		size_t GetInstancesCount() const { return ParticlesPool.GetSize(); }
 		
@@ -76,6 +76,6 @@ namespace Poly
 		bool IsBurstEnabled = true;
 		float NextBurstTime = -1.0;
 		size_t ToEmit = 0;
-		IterablePoolAllocator<Particle> ParticlesPool;
+		BitmapPoolAllocator<Particle> ParticlesPool;
 	};
 }
\ No newline at end of file
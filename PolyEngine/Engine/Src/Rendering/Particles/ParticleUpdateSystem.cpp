@@ -74,7 +74,8 @@ void ParticleUpdateSystem::EmitterUpdate(Scene* world, ParticleEmitter* emitter)
 		}
 	}
 
-	Dynarray<ParticleEmitter::Particle*> ParticleToDelete;
+	// every particle may expire, reserving up front avoids regrowing in frame memory
+	FrameDynarray<ParticleEmitter::Particle*> ParticleToDelete(emitter->ParticlesPool.GetSize());
 
 	for (ParticleEmitter::Particle& p : emitter->ParticlesPool)
 	{
@@ -0,0 +1,162 @@
+#include "EnginePCH.hpp"
+
+#include "Rendering/RenderQueue.hpp"
+#include "Rendering/MeshRenderingComponent.hpp"
+#include "Resources/MeshResource.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	constexpr size_t RADIX_BITS = 8;
+	constexpr size_t RADIX_SIZE = 1 << RADIX_BITS;
+	constexpr size_t RADIX_PASSES = 64 / RADIX_BITS;
+}
+
+//------------------------------------------------------------------------------
+const void* RenderQueue::GetGeometry(const MeshRenderingComponent* meshCmp, size_t subMeshIdx)
+{
+	return meshCmp->GetMesh()->GetSubMeshes()[subMeshIdx];
+}
+
+//------------------------------------------------------------------------------
+u32 RenderQueue::GetLodLevel(const MeshRenderingComponent* meshCmp, size_t subMeshIdx)
+{
+	const MeshResource::SubMesh* subMesh = meshCmp->GetMesh()->GetSubMeshes()[subMeshIdx];
+	return static_cast<u32>(std::min(meshCmp->GetLodLevel(), subMesh->GetMeshData().GetLodCount() - 1));
+}
+
+//------------------------------------------------------------------------------
+u64 RenderQueue::GetMaterialHash(const MeshRenderingComponent* meshCmp, size_t subMeshIdx)
+{
+	const Material& material = meshCmp->GetMaterial((int)subMeshIdx);
+	const Mesh& meshData = meshCmp->GetMesh()->GetSubMeshes()[subMeshIdx]->GetMeshData();
+
+	// FNV-1a
+	u64 hash = 14695981039346656037ull;
+	auto combine = [&hash](const void* data, size_t size) {
+		const u8* bytes = static_cast<const u8*>(data);
+		for (size_t i = 0; i < size; ++i)
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+	};
+
+	const TextureResource* textures[] = { meshData.GetEmissiveMap(), meshData.GetAlbedoMap(), meshData.GetRoughnessMap(),
+		meshData.GetMetallicMap(), meshData.GetNormalMap(), meshData.GetAmbientOcclusionMap() };
+	combine(textures, sizeof(textures));
+
+	const float params[] = { material.Emissive.R, material.Emissive.G, material.Emissive.B, material.Emissive.A,
+		material.Albedo.R, material.Albedo.G, material.Albedo.B, material.Albedo.A,
+		material.Roughness, material.Metallic, material.OpacityMaskThreshold };
+	combine(params, sizeof(params));
+	return hash;
+}
+
+//------------------------------------------------------------------------------
+u64 RenderQueue::MakeSortKey(u32 pass, u32 material, u32 mesh, u16 depth)
+{
+	HEAVY_ASSERTE(pass <= MAX_PASS && material <= MAX_MATERIAL && mesh <= MAX_MESH, "Sort key field out of range!");
+	return (static_cast<u64>(pass) << 60)
+		| (static_cast<u64>(material) << 32)
+		| (static_cast<u64>(mesh) << 16)
+		| static_cast<u64>(depth);
+}
+
+//------------------------------------------------------------------------------
+void RenderQueue::Clear()
+{
+	Commands.Clear();
+	Batches.Clear();
+	MaterialIDs.Clear();
+	GeometryIDs.Clear();
+	MeshIDs.Clear();
+	Stats = RenderQueueStats();
+}
+
+//------------------------------------------------------------------------------
+void RenderQueue::Add(u32 pass, u64 materialHash, const void* geometry, u32 lodLevel, float depth, const MeshRenderingComponent* meshCmp, size_t subMeshIdx)
+{
+	// identifiers past the last one share MAX value, which is never treated as a repeated state
+	const u32 material = MaterialIDs.GetOrInsert(materialHash, std::min<u32>(static_cast<u32>(MaterialIDs.GetSize()), MAX_MATERIAL));
+	const u32 geometryID = GeometryIDs.GetOrInsert(geometry, static_cast<u32>(GeometryIDs.GetSize()));
+	const u64 meshKey = (static_cast<u64>(geometryID) << 32) | lodLevel;
+	const u32 mesh = MeshIDs.GetOrInsert(meshKey, std::min<u32>(static_cast<u32>(MeshIDs.GetSize()), MAX_MESH));
+	const u16 quantizedDepth = static_cast<u16>(Clamp(depth, 0.0f, 1.0f) * std::numeric_limits<u16>::max());
+
+	Command cmd;
+	cmd.SortKey = MakeSortKey(pass, material, mesh, quantizedDepth);
+	cmd.MeshCmp = meshCmp;
+	cmd.SubMeshIdx = subMeshIdx;
+	cmd.ObjectChanged = cmd.MaterialChanged = cmd.MeshChanged = true;
+	Commands.PushBack(cmd);
+}
+
+//------------------------------------------------------------------------------
+void RenderQueue::Sort()
+{
+	RadixSort();
+
+	Stats = RenderQueueStats();
+	Stats.Commands = Commands.GetSize();
+	Batches.Clear();
+	for (size_t i = 0; i < Commands.GetSize(); ++i)
+	{
+		Command& cmd = Commands[i];
+		bool passChanged = true;
+		if (i > 0)
+		{
+			const Command& prev = Commands[i - 1];
+			const u32 material = GetMaterial(cmd.SortKey);
+			const u32 mesh = GetMesh(cmd.SortKey);
+			// new pass binds its own shader program, which invalidates bound uniforms, but not textures and vertex arrays
+			passChanged = GetPass(cmd.SortKey) != GetPass(prev.SortKey);
+			cmd.ObjectChanged = passChanged || cmd.MeshCmp != prev.MeshCmp;
+			cmd.MaterialChanged = passChanged || material == MAX_MATERIAL || material != GetMaterial(prev.SortKey);
+			cmd.MeshChanged = mesh == MAX_MESH || mesh != GetMesh(prev.SortKey);
+		}
+
+		Stats.MaterialChanges += cmd.MaterialChanged ? 1 : 0;
+		Stats.MeshChanges += cmd.MeshChanged ? 1 : 0;
+
+		if (passChanged || cmd.MaterialChanged || cmd.MeshChanged)
+			Batches.PushBack(Batch{ i, 0 });
+		++Batches[Batches.GetSize() - 1].Count;
+	}
+	Stats.Batches = Batches.GetSize();
+}
+
+//------------------------------------------------------------------------------
+void RenderQueue::RadixSort()
+{
+	const size_t count = Commands.GetSize();
+	if (count < 2)
+		return;
+
+	// histograms of all digits are gathered in a single pass
+	size_t histograms[RADIX_PASSES][RADIX_SIZE] = {};
+	for (const Command& cmd : Commands)
+		for (size_t pass = 0; pass < RADIX_PASSES; ++pass)
+			++histograms[pass][(cmd.SortKey >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)];
+
+	SortBuffer.Resize(count);
+	for (size_t pass = 0; pass < RADIX_PASSES; ++pass)
+	{
+		size_t* histogram = histograms[pass];
+		const size_t shift = pass * RADIX_BITS;
+
+		// digit shared by all keys does not change the order
+		if (histogram[(Commands[0].SortKey >> shift) & (RADIX_SIZE - 1)] == count)
+			continue;
+
+		size_t offset = 0;
+		for (size_t digit = 0; digit < RADIX_SIZE; ++digit)
+		{
+			const size_t digitCount = histogram[digit];
+			histogram[digit] = offset;
+			offset += digitCount;
+		}
+
+		for (const Command& cmd : Commands)
+			SortBuffer[histogram[(cmd.SortKey >> shift) & (RADIX_SIZE - 1)]++] = cmd;
+		std::swap(Commands, SortBuffer);
+	}
+}
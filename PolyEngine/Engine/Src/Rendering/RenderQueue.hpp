@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Collections/HashMap.hpp>
+
+namespace Poly
+{
+	class MeshRenderingComponent;
+
+	/// <summary>State changes of a sorted render queue.</summary>
+	struct ENGINE_DLLEXPORT RenderQueueStats
+	{
+		size_t Commands = 0;
+		size_t MaterialChanges = 0;
+		size_t MeshChanges = 0;
+		size_t Batches = 0;
+
+		/// <summary>Returns number of material and mesh binds skipped compared to binding both for every command.</summary>
+		size_t GetStateChangesSaved() const { return 2 * Commands - MaterialChanges - MeshChanges; }
+
+		/// <summary>Returns number of draw calls skipped by drawing every batch as a single instanced draw.</summary>
+		size_t GetDrawsSaved() const { return Commands - Batches; }
+	};
+
+	/// <summary>Flat list of draw commands sorted by 64-bit keys built from
+	/// pass (4 bits), material (28 bits), mesh (16 bits) and depth (16 bits), most significant first.
+	/// Every pass of a queue is drawn with a single shader program, which is bound by the renderer.
+	/// After sorting every command knows which state differs from the previous one, so redundant binds can be skipped.
+	/// Consecutive sorted commands sharing pass, material and mesh form batches, which can be drawn with a single instanced draw.</summary>
+	/// <remarks>Materials and meshes get dense identifiers in order of first appearance since last Clear().
+	/// When identifiers run out, commands using the overflowing ones always rebind their state and are never batched.</remarks>
+	class ENGINE_DLLEXPORT RenderQueue final : public BaseObject<>
+	{
+	public:
+		struct Command
+		{
+			u64 SortKey;
+			const MeshRenderingComponent* MeshCmp;
+			size_t SubMeshIdx;
+
+			bool ObjectChanged;
+			bool MaterialChanged;
+			bool MeshChanged;
+		};
+
+		/// <summary>Range of sorted commands differing only in drawn object.</summary>
+		struct Batch
+		{
+			size_t First;
+			size_t Count;
+		};
+
+		static constexpr u32 MAX_PASS = (1u << 4) - 1;
+		static constexpr u32 MAX_MATERIAL = (1u << 28) - 1;
+		static constexpr u32 MAX_MESH = (1u << 16) - 1;
+
+		void Clear();
+
+		/// <summary>Records a draw.</summary>
+		/// <param name="pass">Index of the pass, passes are executed in ascending order and rebind all state.</param>
+		/// <param name="materialHash">Hash of material parameters and textures, equal hashes are assumed to be the same state.</param>
+		/// <param name="geometry">Identifies vertex data bound for the draw.</param>
+		/// <param name="lodLevel">Level of detail drawn from the vertex data, levels draw different index ranges so they are batched separately.</param>
+		/// <param name="depth">Distance from camera normalized to [0, 1], draws with the same state are sorted front to back.</param>
+		/// <param name="meshCmp">Drawn component, commands of the same component share per object uniforms.</param>
+		/// <param name="subMeshIdx">Drawn submesh of the component.</param>
+		void Add(u32 pass, u64 materialHash, const void* geometry, u32 lodLevel, float depth, const MeshRenderingComponent* meshCmp, size_t subMeshIdx);
+
+		/// <summary>Radix sorts commands, marks state changes between consecutive commands and groups them into batches.</summary>
+		void Sort();
+
+		const Dynarray<Command>& GetCommands() const { return Commands; }
+		const Dynarray<Batch>& GetBatches() const { return Batches; }
+		const RenderQueueStats& GetStats() const { return Stats; }
+
+		/// <summary>Returns identifier of vertex data of submesh, shared by all its levels of detail.</summary>
+		static const void* GetGeometry(const MeshRenderingComponent* meshCmp, size_t subMeshIdx);
+
+		/// <summary>Returns level of detail selected for the component, clamped to levels available in submesh.</summary>
+		static u32 GetLodLevel(const MeshRenderingComponent* meshCmp, size_t subMeshIdx);
+
+		/// <summary>Returns hash of material parameters and textures bound when drawing submesh with lighting.</summary>
+		static u64 GetMaterialHash(const MeshRenderingComponent* meshCmp, size_t subMeshIdx);
+
+		static u64 MakeSortKey(u32 pass, u32 material, u32 mesh, u16 depth);
+		static u32 GetPass(u64 key) { return static_cast<u32>(key >> 60); }
+		static u32 GetMaterial(u64 key) { return static_cast<u32>(key >> 32) & MAX_MATERIAL; }
+		static u32 GetMesh(u64 key) { return static_cast<u32>(key >> 16) & MAX_MESH; }
+
+	private:
+		void RadixSort();
+
+		Dynarray<Command> Commands;
+		Dynarray<Command> SortBuffer;
+		Dynarray<Batch> Batches;
+		HashMap<u64, u32> MaterialIDs;
+		HashMap<const void*, u32> GeometryIDs;
+		// keyed by geometry identifier in high and level of detail in low 32 bits
+		HashMap<u64, u32> MeshIDs;
+		RenderQueueStats Stats;
+	};
+}
@@ -0,0 +1,158 @@
+#include "EnginePCH.hpp"
+
+#include "Rendering/SceneView.hpp"
+#include "Rendering/IRenderingDevice.hpp"
+#include "Rendering/VisibilityCuller.hpp"
+#include "Rendering/MeshRenderingComponent.hpp"
+#include "Rendering/Lighting/LightSourceComponent.hpp"
+#include "Resources/MeshResource.hpp"
+#include "ECS/Scene.hpp"
+
+using namespace Poly;
+
+//------------------------------------------------------------------------------
+AABox Poly::GetDirShadowVolume()
+{
+	const Vector extent(DIR_SHADOW_VOLUME_EXTENT, DIR_SHADOW_VOLUME_EXTENT, DIR_SHADOW_VOLUME_EXTENT);
+	return AABox(-extent, extent * 2.0f);
+}
+
+//------------------------------------------------------------------------------
+void Poly::AddDrawStats(const MeshRenderingComponent* meshCmp, size_t subMeshIdx, size_t instanceCount, RenderingStats& stats)
+{
+	const Mesh& meshData = meshCmp->GetMesh()->GetSubMeshes()[subMeshIdx]->GetMeshData();
+	const Mesh::Lod lod = meshData.GetLod(meshCmp->GetLodLevel());
+	stats.TrianglesSubmitted += lod.IndexCount / 3 * instanceCount;
+	stats.TrianglesSkippedByLod += (meshData.GetTriangleCount() - lod.IndexCount / 3) * instanceCount;
+}
+
+//------------------------------------------------------------------------------
+void SceneView::Fill(VisibilityCuller& culler, const Optional<AABox>& dirShadowVolume, RenderingStats& stats)
+{
+	// frame memory is not reclaimed when arrays grow, so they are reserved from known counts
+	size_t dirLightCount = 0;
+	for (const auto componentsTuple : WorldData->IterateComponents<DirectionalLightComponent>())
+	{
+		UNUSED(componentsTuple);
+		++dirLightCount;
+	}
+	DirectionalLights.Reserve(dirLightCount);
+	for (const auto componentsTuple : WorldData->IterateComponents<DirectionalLightComponent>())
+	{
+		DirectionalLights.PushBack(std::get<DirectionalLightComponent*>(componentsTuple));
+	}
+
+	size_t pointLightCount = 0;
+	for (const auto componentsTuple : WorldData->IterateComponents<PointLightComponent>())
+	{
+		UNUSED(componentsTuple);
+		++pointLightCount;
+	}
+	PointLights.Reserve(pointLightCount);
+	for (const auto componentsTuple : WorldData->IterateComponents<PointLightComponent>())
+	{
+		PointLights.PushBack(std::get<PointLightComponent*>(componentsTuple));
+	}
+
+	culler.CullMeshes(CameraCmp);
+	culler.SelectLods(CameraCmp);
+
+	// Shadow map is rendered only for the first directional light
+	const bool castShadows = !DirectionalLights.IsEmpty() && dirShadowVolume.HasValue();
+	if (castShadows)
+	{
+		const Matrix lightFromWorld = DirectionalLights[0]->GetTransform().GetWorldFromModel().GetInversed();
+		culler.CullShadowCasters(CameraCmp, lightFromWorld, dirShadowVolume.Value());
+	}
+
+	size_t opaqueCount = 0;
+	size_t translucentCount = 0;
+	size_t shadowCasterCount = 0;
+	for (size_t i = 0; i < culler.GetMeshCount(); ++i)
+	{
+		const eBlendingMode blendingMode = culler.GetMesh(i)->GetBlendingMode();
+		if (culler.IsVisible(i))
+		{
+			opaqueCount += blendingMode == eBlendingMode::OPAUQE ? 1 : 0;
+			translucentCount += blendingMode == eBlendingMode::TRANSLUCENT ? 1 : 0;
+		}
+		else if (blendingMode == eBlendingMode::OPAUQE && castShadows && culler.IsShadowCaster(i))
+		{
+			++shadowCasterCount;
+		}
+	}
+	OpaqueQueue.Reserve(opaqueCount);
+	TranslucentQueue.Reserve(translucentCount);
+	DirShadowOpaqueQueue.Reserve(shadowCasterCount);
+
+	for (size_t i = 0; i < culler.GetMeshCount(); ++i)
+	{
+		const MeshRenderingComponent* meshCmp = culler.GetMesh(i);
+		const bool isOpaque = meshCmp->GetBlendingMode() == eBlendingMode::OPAUQE;
+
+		if (culler.IsVisible(i))
+		{
+			if (isOpaque)
+			{
+				OpaqueQueue.PushBack(meshCmp);
+			}
+			else if (meshCmp->GetBlendingMode() == eBlendingMode::TRANSLUCENT)
+			{
+				TranslucentQueue.PushBack(meshCmp);
+			}
+		}
+		else if (isOpaque && castShadows)
+		{
+			if (culler.IsShadowCaster(i))
+				DirShadowOpaqueQueue.PushBack(meshCmp);
+			else
+				++stats.ShadowCastersCulled;
+		}
+	}
+
+	// Visible opaque meshes are drawn into shadow map too
+	if (castShadows)
+		stats.ShadowCastersDrawn += OpaqueQueue.GetSize() + DirShadowOpaqueQueue.GetSize();
+}
+
+//------------------------------------------------------------------------------
+void SceneRenderQueues::Fill(const SceneView& sceneView, RenderingStats& stats)
+{
+	DirShadowQueue.Clear();
+	DepthPrePassQueue.Clear();
+	OpaqueLitQueue.Clear();
+
+	// shadow map pass binds no material, draws of the same submesh are instanced regardless of distance
+	if (!sceneView.DirectionalLights.IsEmpty())
+	{
+		for (const FrameDynarray<const MeshRenderingComponent*>* casters : { &sceneView.OpaqueQueue, &sceneView.DirShadowOpaqueQueue })
+			for (const MeshRenderingComponent* meshCmp : *casters)
+			{
+				const Dynarray<MeshResource::SubMesh*>& subMeshes = meshCmp->GetMesh()->GetSubMeshes();
+				for (size_t i = 0; i < subMeshes.GetSize(); ++i)
+					DirShadowQueue.Add(0, 0, RenderQueue::GetGeometry(meshCmp, i), RenderQueue::GetLodLevel(meshCmp, i), 0.0f, meshCmp, i);
+			}
+	}
+
+	const Matrix& viewFromWorld = sceneView.CameraCmp->GetViewFromWorld();
+	const float zFar = sceneView.CameraCmp->GetClippingPlaneFar();
+	for (const MeshRenderingComponent* meshCmp : sceneView.OpaqueQueue)
+	{
+		const float depth = -(viewFromWorld * meshCmp->GetTransform().GetGlobalTranslation()).Z / zFar;
+		for (size_t i = 0; i < meshCmp->GetMesh()->GetSubMeshes().GetSize(); ++i)
+		{
+			const void* geometry = RenderQueue::GetGeometry(meshCmp, i);
+			const u32 lodLevel = RenderQueue::GetLodLevel(meshCmp, i);
+			DepthPrePassQueue.Add(0, 0, geometry, lodLevel, depth, meshCmp, i);
+			OpaqueLitQueue.Add(0, RenderQueue::GetMaterialHash(meshCmp, i), geometry, lodLevel, depth, meshCmp, i);
+		}
+	}
+
+	for (RenderQueue* queue : { &DirShadowQueue, &DepthPrePassQueue, &OpaqueLitQueue })
+	{
+		queue->Sort();
+		stats.DrawCommands += queue->GetStats().Commands;
+		stats.StateChangesSaved += queue->GetStats().GetStateChangesSaved();
+		stats.InstancedDrawsSaved += queue->GetStats().GetDrawsSaved();
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Utils/Optional.hpp>
+#include <Math/AABox.hpp>
+#include <Memory/FrameAllocator.hpp>
+#include <Rendering/Viewport.hpp>
+#include <Rendering/RenderQueue.hpp>
+
+namespace Poly
+{
+	class Scene;
+	class VisibilityCuller;
+	class MeshRenderingComponent;
+	class DirectionalLightComponent;
+	class PointLightComponent;
+	struct RenderingStats;
+
+	/// <summary>Half of the size of light space volume covered by directional light shadow map.</summary>
+	constexpr float DIR_SHADOW_VOLUME_EXTENT = 4096.0f;
+
+	/// <summary>Returns light space volume covered by directional light shadow map.</summary>
+	ENGINE_DLLEXPORT AABox GetDirShadowVolume();
+
+	/// <summary>Lights and meshes of a scene seen through a viewport, gathered once per view in every frame.</summary>
+	struct ENGINE_DLLEXPORT SceneView : public BaseObject<>
+	{
+		SceneView(Scene* w, const Viewport& v)
+			: WorldData(w), ViewportData(v), Rect(v.GetRect()), CameraCmp(v.GetCamera())
+		{};
+
+		/// <summary>Gathers lights of the scene and splits meshes gathered by the culler into queues.
+		/// Meshes are culled against the camera and their levels of detail are selected. Opaque meshes hidden from the camera
+		/// are culled against directional light shadow volume, shadows are cast only by the first directional light.</summary>
+		/// <param name="culler">Culler with meshes of the scene gathered already.</param>
+		/// <param name="dirShadowVolume">Light space volume covered by shadow map, or nothing if shadows are not rendered.</param>
+		/// <param name="stats">Stats to which culled and drawn shadow casters are added.</param>
+		void Fill(VisibilityCuller& culler, const Optional<AABox>& dirShadowVolume, RenderingStats& stats);
+
+		Scene* WorldData;
+		const Viewport& ViewportData;
+		const AARect& Rect;
+		const CameraComponent* CameraCmp;
+
+		// queues are rebuilt for every view in every frame, so they live in frame memory
+		FrameDynarray<const MeshRenderingComponent*> DirShadowOpaqueQueue;
+		FrameDynarray<const MeshRenderingComponent*> OpaqueQueue;
+		FrameDynarray<const MeshRenderingComponent*> TranslucentQueue;
+
+		FrameDynarray<const DirectionalLightComponent*> DirectionalLights;
+		FrameDynarray<const PointLightComponent*> PointLights;
+	};
+
+	/// <summary>Opaque geometry of a scene view sorted into render queues of the shadow, depth prepass and lit passes.</summary>
+	class ENGINE_DLLEXPORT SceneRenderQueues final : public BaseObject<>
+	{
+	public:
+		/// <summary>Rebuilds and sorts the queues. Shadow casters are queued only if the view has a directional light.</summary>
+		/// <param name="stats">Stats to which draw commands and saved state changes are added.</param>
+		void Fill(const SceneView& sceneView, RenderingStats& stats);
+
+		const RenderQueue& GetDirShadowQueue() const { return DirShadowQueue; }
+		const RenderQueue& GetDepthPrePassQueue() const { return DepthPrePassQueue; }
+		const RenderQueue& GetOpaqueLitQueue() const { return OpaqueLitQueue; }
+
+	private:
+		RenderQueue DirShadowQueue;
+		RenderQueue DepthPrePassQueue;
+		RenderQueue OpaqueLitQueue;
+	};
+
+	/// <summary>Adds triangles of submesh at its selected level of detail to stats.</summary>
+	/// <param name="instanceCount">Number of instances drawn with a single draw call.</param>
+	ENGINE_DLLEXPORT void AddDrawStats(const MeshRenderingComponent* meshCmp, size_t subMeshIdx, size_t instanceCount, RenderingStats& stats);
+}
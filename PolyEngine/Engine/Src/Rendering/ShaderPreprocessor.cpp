@@ -0,0 +1,140 @@
+#include "EnginePCH.hpp"
+
+#include "Rendering/ShaderPreprocessor.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	struct PreprocessorContext
+	{
+		const ShaderPreprocessor::IncludeLoader& Loader;
+		Dynarray<String>& IncludedPaths;
+		String RootPath;
+		const Dynarray<String>* PendingDefines;
+	};
+
+	// resolves "." and ".." segments, so the same file included by different relative paths is recognized
+	String NormalizePath(const std::string& path)
+	{
+		std::vector<std::string> segments;
+		size_t begin = 0;
+		while (begin <= path.size())
+		{
+			size_t end = path.find('/', begin);
+			if (end == std::string::npos)
+				end = path.size();
+			const std::string segment = path.substr(begin, end - begin);
+			if (segment == ".." && !segments.empty() && segments.back() != "..")
+				segments.pop_back();
+			else if (segment != "." && (!segment.empty() || segments.empty()))
+				segments.push_back(segment);
+			begin = end + 1;
+		}
+
+		std::string result;
+		for (size_t i = 0; i < segments.size(); ++i)
+			result += (i > 0 ? "/" : "") + segments[i];
+		return String(result.c_str());
+	}
+
+	// returns true and the quoted path if the line is an #include directive
+	bool ParseInclude(const std::string& line, std::string& includePath)
+	{
+		const size_t hash = line.find_first_not_of(" \t");
+		if (hash == std::string::npos || line[hash] != '#')
+			return false;
+		const size_t directive = line.find_first_not_of(" \t", hash + 1);
+		if (directive == std::string::npos || line.compare(directive, 7, "include") != 0)
+			return false;
+		const size_t open = line.find('"', directive + 7);
+		const size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+		if (close == std::string::npos)
+			return false;
+		includePath = line.substr(open + 1, close - open - 1);
+		return true;
+	}
+
+	bool IsVersionDirective(const std::string& line)
+	{
+		const size_t hash = line.find_first_not_of(" \t");
+		if (hash == std::string::npos || line[hash] != '#')
+			return false;
+		const size_t directive = line.find_first_not_of(" \t", hash + 1);
+		return directive != std::string::npos && line.compare(directive, 7, "version") == 0;
+	}
+
+	void AppendDefines(const Dynarray<String>& defines, std::string& result)
+	{
+		for (const String& define : defines)
+			result += std::string("#define ") + define.GetCStr() + "\n";
+	}
+
+	void Expand(const String& source, const String& path, size_t sourceIndex, PreprocessorContext& context, std::string& result)
+	{
+		const std::string code = source.GetCStr();
+		const std::string pathStr = path.GetCStr();
+		const size_t lastSlash = pathStr.rfind('/');
+		const std::string directory = lastSlash == std::string::npos ? std::string() : pathStr.substr(0, lastSlash + 1);
+
+		size_t lineNumber = 1;
+		size_t begin = 0;
+		while (begin < code.size())
+		{
+			size_t end = code.find('\n', begin);
+			if (end == std::string::npos)
+				end = code.size();
+			const std::string line = code.substr(begin, end - begin);
+			begin = end + 1;
+
+			std::string includePath;
+			if (ParseInclude(line, includePath))
+			{
+				const String resolvedPath = NormalizePath(directory + includePath);
+				if (!(resolvedPath == context.RootPath) && !context.IncludedPaths.Contains(resolvedPath))
+				{
+					context.IncludedPaths.PushBack(resolvedPath);
+					const size_t includeIndex = context.IncludedPaths.GetSize();
+					const String includeSource = context.Loader(resolvedPath);
+					result += "#line 1 " + std::to_string(includeIndex) + "\n";
+					Expand(includeSource, resolvedPath, includeIndex, context, result);
+					result += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(sourceIndex) + "\n";
+				}
+				else
+					result += "\n"; // keeps line numbers of the following lines
+			}
+			else
+			{
+				result += line;
+				result += "\n";
+				if (context.PendingDefines && sourceIndex == 0 && IsVersionDirective(line))
+				{
+					AppendDefines(*context.PendingDefines, result);
+					result += "#line " + std::to_string(lineNumber + 1) + " 0\n";
+					context.PendingDefines = nullptr;
+				}
+			}
+			++lineNumber;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+String ShaderPreprocessor::Preprocess(const String& source, const String& path, const Dynarray<String>& defines,
+	const IncludeLoader& loader, Dynarray<String>& includedPaths)
+{
+	includedPaths.Clear();
+	PreprocessorContext context{ loader, includedPaths, NormalizePath(path.GetCStr()), defines.GetSize() > 0 ? &defines : nullptr };
+	std::string result;
+	result.reserve(source.GetLength());
+	Expand(source, context.RootPath, 0, context, result);
+
+	// without #version directive defines go to the beginning of the source
+	if (context.PendingDefines)
+	{
+		std::string prefix;
+		AppendDefines(defines, prefix);
+		result = prefix + "#line 1 0\n" + result;
+	}
+	return String(result.c_str());
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Collections/String.hpp>
+
+namespace Poly
+{
+	/// <summary>Expands #include directives and injects defines into GLSL sources, which the GL compiler does not do on its own.</summary>
+	namespace ShaderPreprocessor
+	{
+		/// <summary>Loads content of file included by shader.</summary>
+		using IncludeLoader = std::function<String(const String& path)>;
+
+		/// <summary>Preprocesses shader source.
+		/// Defines are inserted after #version directive, so different sets of defines compile different variants of the same shader.
+		/// Every file is included only once, later includes of the same file are skipped.
+		/// #line directives keep line numbers of compiler messages, the source string number is 0 for the shader
+		/// and index of included file, in order of first inclusion, for included files.</summary>
+		/// <param name="path">Path of the shader, #include paths are relative to directory of the file containing them.</param>
+		/// <param name="defines">Names of defined macros, optionally followed by a space and value ("MAX_LIGHTS 8").</param>
+		/// <param name="loader">Loads included files, exceptions thrown by it are propagated.</param>
+		/// <param name="includedPaths">Output, paths of included files, in order of their source string numbers.</param>
+		ENGINE_DLLEXPORT String Preprocess(const String& source, const String& path, const Dynarray<String>& defines,
+			const IncludeLoader& loader, Dynarray<String>& includedPaths);
+	}
+}
@@ -0,0 +1,46 @@
+#include "EnginePCH.hpp"
+
+#include "Rendering/UniformTable.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	const UniformTable::Entry* LowerBound(const Dynarray<UniformTable::Entry>& entries, u32 hash)
+	{
+		return std::lower_bound(entries.GetData(), entries.GetData() + entries.GetSize(), hash,
+			[](const UniformTable::Entry& entry, u32 value) { return entry.Hash < value; });
+	}
+}
+
+//------------------------------------------------------------------------------
+bool UniformTable::Register(const String& name, eUniformType type, int location)
+{
+	const u32 hash = UniformName(name).GetHash();
+	const size_t idx = LowerBound(Entries, hash) - Entries.GetData();
+	if (idx < Entries.GetSize() && Entries[idx].Hash == hash)
+		return false;
+	Entries.Insert(idx, Entry{ hash, location, type, name });
+	return true;
+}
+
+//------------------------------------------------------------------------------
+const UniformTable::Entry* UniformTable::Find(UniformName name) const
+{
+	const Entry* entry = LowerBound(Entries, name.GetHash());
+	return entry != Entries.GetData() + Entries.GetSize() && entry->Hash == name.GetHash() ? entry : nullptr;
+}
+
+//------------------------------------------------------------------------------
+eUniformType UniformTable::GetTypeFromName(const String& typeName)
+{
+	if (typeName == "int") return eUniformType::INT;
+	if (typeName == "uint") return eUniformType::UINT;
+	if (typeName == "float") return eUniformType::FLOAT;
+	if (typeName == "vec2") return eUniformType::VEC2;
+	if (typeName == "vec4") return eUniformType::VEC4;
+	if (typeName == "mat4") return eUniformType::MAT4;
+	if (typeName == "sampler2D") return eUniformType::SAMPLER_2D;
+	if (typeName == "samplerCube") return eUniformType::SAMPLER_CUBE;
+	return eUniformType::OTHER;
+}
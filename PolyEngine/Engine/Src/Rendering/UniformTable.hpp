@@ -0,0 +1,69 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Collections/String.hpp>
+
+namespace Poly
+{
+	/// <summary>Name of shader uniform with precomputed 32-bit FNV-1a hash.
+	/// Hashes of string literals are computed at compile time when the name is constexpr.</summary>
+	class UniformName final
+	{
+	public:
+		constexpr UniformName(const char* name) : Hash(HashString(name, 2166136261u)) {}
+		UniformName(const String& name) : UniformName(name.GetCStr()) {}
+
+		constexpr u32 GetHash() const { return Hash; }
+
+	private:
+		static constexpr u32 HashString(const char* str, u32 hash) { return *str ? HashString(str + 1, (hash ^ static_cast<u8>(*str)) * 16777619u) : hash; }
+
+		u32 Hash;
+	};
+
+	enum class eUniformType
+	{
+		INT,
+		UINT,
+		FLOAT,
+		VEC2,
+		VEC4,
+		MAT4,
+		SAMPLER_2D,
+		SAMPLER_CUBE,
+		OTHER,
+		_COUNT
+	};
+
+	/// <summary>Locations and types of uniforms of a shader program, resolved once when the program is created.
+	/// Lookups compare integer hashes only, so setting uniform by name costs no string operations.</summary>
+	class ENGINE_DLLEXPORT UniformTable final : public BaseObject<>
+	{
+	public:
+		struct Entry
+		{
+			u32 Hash;
+			int Location;
+			eUniformType Type;
+			// kept for error messages only, lookups compare hashes
+			String Name;
+		};
+
+		/// <summary>Adds uniform to the table.</summary>
+		/// <returns>False if uniform with the same name hash is registered already, see <see cref="Find()"/> to tell whether it is the same uniform.</returns>
+		bool Register(const String& name, eUniformType type, int location);
+
+		/// <returns>Registered uniform or nullptr.</returns>
+		const Entry* Find(UniformName name) const;
+
+		size_t GetSize() const { return Entries.GetSize(); }
+
+		/// <summary>Converts GLSL type name to uniform type, types without setters are OTHER.</summary>
+		static eUniformType GetTypeFromName(const String& typeName);
+
+	private:
+		// sorted by hash
+		Dynarray<Entry> Entries;
+	};
+}
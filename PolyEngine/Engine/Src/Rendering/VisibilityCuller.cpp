@@ -0,0 +1,114 @@
+#include "EnginePCH.hpp"
+
+#include "Rendering/VisibilityCuller.hpp"
+#include "Rendering/MeshRenderingComponent.hpp"
+#include "Rendering/Camera/CameraComponent.hpp"
+#include "ECS/Scene.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	// coverage of full detail level, every next level is used at half of the coverage of the previous one
+	constexpr float LOD_FULL_DETAIL_COVERAGE = 0.5f;
+	// fraction of a level by which coverage has to pass the transition point to change the level
+	constexpr float LOD_HYSTERESIS = 0.2f;
+	constexpr size_t MAX_LOD_LEVEL = 7;
+}
+
+//------------------------------------------------------------------------------
+void VisibilityCuller::GatherMeshes(Scene* scene)
+{
+	Meshes.Clear();
+	Bounds.Clear();
+	for (const auto componentsTuple : scene->IterateComponents<MeshRenderingComponent>())
+	{
+		MeshRenderingComponent* meshCmp = std::get<MeshRenderingComponent*>(componentsTuple);
+		Meshes.PushBack(meshCmp);
+		Bounds.PushBack(meshCmp->GetOwner()->GetGlobalBoundingBox(eEntityBoundingChannel::RENDERING));
+	}
+}
+
+//------------------------------------------------------------------------------
+size_t VisibilityCuller::CullMeshes(const CameraComponent* camera)
+{
+	if (camera->GetIsPerspective())
+	{
+		const FrustumCuller culler(camera->GetFrustum(), camera->GetViewFromWorld());
+		return culler.Cull(Bounds, Visibility);
+	}
+
+	size_t visibleCount = 0;
+	Visibility.Resize(Meshes.GetSize());
+	for (size_t i = 0; i < Meshes.GetSize(); ++i)
+	{
+		Visibility[i] = camera->IsVisibleToCamera(Meshes[i]->GetOwner());
+		visibleCount += Visibility[i] ? 1 : 0;
+	}
+	return visibleCount;
+}
+
+//------------------------------------------------------------------------------
+size_t VisibilityCuller::CullShadowCasters(const CameraComponent* camera, const Matrix& lightFromWorld, const AABox& shadowVolume)
+{
+	if (!camera->GetIsPerspective())
+		return FrustumCuller(shadowVolume, lightFromWorld).Cull(Bounds, ShadowCasters);
+
+	const Matrix lightFromView = lightFromWorld * camera->GetViewFromWorld().GetInversed();
+	const float maxFlt = std::numeric_limits<float>::max();
+	Vector min(maxFlt, maxFlt, maxFlt);
+	Vector max(-maxFlt, -maxFlt, -maxFlt);
+	for (const Vector& vertex : camera->GetFrustum().GetVertices())
+	{
+		const Vector lightSpaceVertex = lightFromView * vertex;
+		min = Vector::Min(min, lightSpaceVertex);
+		max = Vector::Max(max, lightSpaceVertex);
+	}
+
+	// extrude toward the light and clip to shadow map
+	max.Z = shadowVolume.GetMax().Z;
+	min = Vector::Max(min, shadowVolume.GetMin());
+	max = Vector::Min(max, shadowVolume.GetMax());
+	if (min.X > max.X || min.Y > max.Y || min.Z > max.Z)
+	{
+		ShadowCasters.Resize(Meshes.GetSize());
+		std::fill(ShadowCasters.Begin(), ShadowCasters.End(), false);
+		return 0;
+	}
+	return FrustumCuller(AABox(min, max - min), lightFromWorld).Cull(Bounds, ShadowCasters);
+}
+
+//------------------------------------------------------------------------------
+void VisibilityCuller::SelectLods(const CameraComponent* camera)
+{
+	const Matrix& viewFromWorld = camera->GetViewFromWorld();
+	const float projectionScale = camera->GetClipFromView().m11;
+	for (size_t i = 0; i < Meshes.GetSize(); ++i)
+	{
+		if (!Visibility[i])
+			continue;
+
+		const AABox box = Bounds.Get(i);
+		const float radius = box.GetSize().Length() * 0.5f;
+		float coverage = radius * projectionScale;
+		if (camera->GetIsPerspective())
+		{
+			// view space looks along -Z
+			const float depth = -(viewFromWorld * box.GetCenter()).Z;
+			coverage = depth > radius ? coverage / depth : 1.f;
+		}
+		Meshes[i]->LodLevel = SelectLodLevel(coverage, Meshes[i]->LodLevel);
+	}
+}
+
+//------------------------------------------------------------------------------
+size_t VisibilityCuller::SelectLodLevel(float coverage, size_t currentLevel)
+{
+	if (coverage >= LOD_FULL_DETAIL_COVERAGE)
+		return 0;
+
+	const float level = coverage > 0.f ? std::log2(LOD_FULL_DETAIL_COVERAGE / coverage) : float(MAX_LOD_LEVEL);
+	if (level >= float(currentLevel) - LOD_HYSTERESIS && level < float(currentLevel + 1) + LOD_HYSTERESIS)
+		return std::min(currentLevel, MAX_LOD_LEVEL);
+	return std::min(static_cast<size_t>(level), MAX_LOD_LEVEL);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Math/FrustumCulling.hpp>
+
+namespace Poly
+{
+	class Scene;
+	class CameraComponent;
+	class MeshRenderingComponent;
+
+	/// <summary>Culls mesh renderers of a scene against camera frustum.
+	/// World space bounds of all meshes are gathered once per frame into SoA arrays
+	/// and tested against every camera in batches.</summary>
+	class ENGINE_DLLEXPORT VisibilityCuller final : public BaseObject<>
+	{
+	public:
+		/// <summary>Collects mesh renderers of the scene and their world space bounds.
+		/// Bounds are cached by entities, so only moved or modified meshes recompute them.</summary>
+		void GatherMeshes(Scene* scene);
+
+		/// <summary>Tests gathered meshes against camera.</summary>
+		/// <returns>Number of meshes visible to the camera.</returns>
+		size_t CullMeshes(const CameraComponent* camera);
+
+		/// <summary>Finds gathered meshes that can cast directional light shadow on anything visible to camera.
+		/// Receivers lie inside camera frustum, so casters have to intersect light space bounds of the frustum
+		/// extruded toward the light, clipped to volume covered by shadow map.</summary>
+		/// <param name="camera">Camera for which shadows are rendered.</param>
+		/// <param name="lightFromWorld">Transformation to light space, in which light travels along -Z axis.</param>
+		/// <param name="shadowVolume">Light space volume covered by shadow map.</param>
+		/// <returns>Number of meshes that can cast shadow.</returns>
+		size_t CullShadowCasters(const CameraComponent* camera, const Matrix& lightFromWorld, const AABox& shadowVolume);
+
+		/// <summary>Selects level of detail of visible meshes from screen coverage of their bounds.
+		/// Selected level is stored in mesh component and used by all sub meshes.</summary>
+		void SelectLods(const CameraComponent* camera);
+
+		/// <summary>Picks level of detail for object covering given part of screen height.
+		/// Every level halves the triangle count, so it is used when coverage halves.
+		/// Current level is kept near transition points to avoid popping back and forth.</summary>
+		/// <param name="coverage">Projected bounding sphere diameter relative to screen height.</param>
+		/// <param name="currentLevel">Level selected in the previous frame.</param>
+		static size_t SelectLodLevel(float coverage, size_t currentLevel);
+
+		size_t GetMeshCount() const { return Meshes.GetSize(); }
+		const MeshRenderingComponent* GetMesh(size_t idx) const { return Meshes[idx]; }
+		bool IsVisible(size_t idx) const { return Visibility[idx]; }
+		bool IsShadowCaster(size_t idx) const { return ShadowCasters[idx]; }
+		const AABoxSoA& GetBounds() const { return Bounds; }
+
+	private:
+		Dynarray<MeshRenderingComponent*> Meshes;
+		AABoxSoA Bounds;
+		Dynarray<bool> Visibility;
+		Dynarray<bool> ShadowCasters;
+	};
+}
@@ -0,0 +1,179 @@
+#include "EnginePCH.hpp"
+
+#include "Resources/AssetCache.hpp"
+#include "Configs/AssetsPathConfig.hpp"
+
+#if defined(_WIN32)
+	#include <direct.h>
+#else
+	#include <sys/stat.h>
+#endif
+
+using namespace Poly;
+
+namespace
+{
+	constexpr size_t ASSET_CACHE_ALIGNMENT = 16;
+
+	struct AssetCacheHeader
+	{
+		u32 Magic;
+		u32 Version;
+		u64 SourceHash;
+	};
+
+	bool IsPathSeparator(char c) { return c == '/' || c == '\\'; }
+
+	void CreateParentDirectories(const String& path)
+	{
+		// existing directories make mkdir fail, which is fine, opening the file reports real errors
+		for (size_t i = 1; i < path.GetLength(); ++i)
+		{
+			if (!IsPathSeparator(path[i]))
+				continue;
+			const String directory = path.Substring(i);
+#if defined(_WIN32)
+			_mkdir(directory.GetCStr());
+#else
+			mkdir(directory.GetCStr(), 0755);
+#endif
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+u64 Poly::HashAssetSource(const BinaryBuffer& data)
+{
+	return HashAssetSource(data.GetData(), data.GetSize());
+}
+
+//------------------------------------------------------------------------------
+u64 Poly::HashAssetSource(const void* data, size_t size, u64 hash)
+{
+	// FNV-1a
+	const u8* bytes = reinterpret_cast<const u8*>(data);
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+//------------------------------------------------------------------------------
+String Poly::GetAssetCachePath(const String& sourcePath, const char* extension, u64 variant)
+{
+	// file name is kept for debugging, hash of the whole path tells apart sources with the same name
+	size_t nameStart = sourcePath.GetLength();
+	while (nameStart > 0 && !IsPathSeparator(sourcePath[nameStart - 1]))
+		--nameStart;
+
+	char pathHash[17];
+	const u64 hash = HashAssetSource(&variant, sizeof(variant), HashAssetSource(sourcePath.GetCStr(), sourcePath.GetLength()));
+	snprintf(pathHash, sizeof(pathHash), "%016llx", (unsigned long long)hash);
+
+	return StringBuilder().Append(gAssetsPathConfig.GetAssetCacheDirectory())
+		.Append(sourcePath.Substring(nameStart, sourcePath.GetLength()))
+		.Append('.').Append(pathHash).Append(extension).StealString();
+}
+
+//------------------------------------------------------------------------------
+AssetCacheWriter::AssetCacheWriter(u32 magic, u32 version, u64 sourceHash)
+{
+	Write(AssetCacheHeader{ magic, version, sourceHash });
+}
+
+//------------------------------------------------------------------------------
+void AssetCacheWriter::WriteString(const String& str)
+{
+	Write<u64>(str.GetLength());
+	WriteBytes(str.GetCStr(), str.GetLength());
+}
+
+//------------------------------------------------------------------------------
+bool AssetCacheWriter::SaveToFile(const String& path) const
+{
+	CreateParentDirectories(path);
+
+	FILE* f;
+	fopen_s(&f, path.GetCStr(), "wb");
+	if (!f)
+		return false;
+
+	const bool written = fwrite(Data.GetData(), 1, Data.GetSize(), f) == Data.GetSize();
+	fclose(f);
+	return written;
+}
+
+//------------------------------------------------------------------------------
+void AssetCacheWriter::WriteBytes(const void* data, size_t size)
+{
+	const size_t offset = Data.GetSize();
+	if (offset + size > Data.GetCapacity())
+		Data.Reserve(std::max(offset + size, Data.GetCapacity() * 2));
+	Data.Resize(offset + size);
+	if (size > 0)
+		memcpy(Data.GetData() + offset, data, size);
+}
+
+//------------------------------------------------------------------------------
+void AssetCacheWriter::Align()
+{
+	static const char padding[ASSET_CACHE_ALIGNMENT] = {};
+	WriteBytes(padding, (ASSET_CACHE_ALIGNMENT - Data.GetSize() % ASSET_CACHE_ALIGNMENT) % ASSET_CACHE_ALIGNMENT);
+}
+
+//------------------------------------------------------------------------------
+AssetCacheReader::AssetCacheReader(const BinaryBuffer& data)
+	: Data(data), Offset(sizeof(AssetCacheHeader))
+{
+}
+
+//------------------------------------------------------------------------------
+bool AssetCacheReader::IsUpToDate(u32 magic, u32 version, u64 sourceHash) const
+{
+	if (Data.GetSize() < sizeof(AssetCacheHeader))
+		return false;
+
+	AssetCacheHeader header;
+	memcpy(&header, Data.GetData(), sizeof(AssetCacheHeader));
+	return header.Magic == magic && header.Version == version && header.SourceHash == sourceHash;
+}
+
+//------------------------------------------------------------------------------
+String AssetCacheReader::ReadString()
+{
+	const u64 length = Read<u64>();
+	if (length > GetRemainingSize())
+		throw ResourceLoadFailedException();
+
+	Dynarray<char> chars;
+	chars.Resize(static_cast<size_t>(length) + 1);
+	ReadBytes(chars.GetData(), static_cast<size_t>(length));
+	chars[static_cast<size_t>(length)] = '\0';
+	return String(chars.GetData());
+}
+
+//------------------------------------------------------------------------------
+void AssetCacheReader::ReadBytes(void* data, size_t size)
+{
+	const char* src = Skip(size);
+	if (size > 0)
+		memcpy(data, src, size);
+}
+
+//------------------------------------------------------------------------------
+const char* AssetCacheReader::Skip(size_t size)
+{
+	if (size > GetRemainingSize())
+		throw ResourceLoadFailedException();
+	const char* data = Data.GetData() + Offset;
+	Offset += size;
+	return data;
+}
+
+//------------------------------------------------------------------------------
+void AssetCacheReader::Align()
+{
+	Offset = (Offset + ASSET_CACHE_ALIGNMENT - 1) / ASSET_CACHE_ALIGNMENT * ASSET_CACHE_ALIGNMENT;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Collections/String.hpp>
+#include <Memory/BinaryBuffer.hpp>
+#include "Resources/ResourceBase.hpp"
+
+namespace Poly
+{
+	/// <summary>Returns hash of asset source file content, cached assets cooked from different content are discarded.</summary>
+	ENGINE_DLLEXPORT u64 HashAssetSource(const BinaryBuffer& data);
+
+	/// <summary>Continues hash of asset source, so assets cooked from several sources can combine their hashes.</summary>
+	/// <param name="hash">Hash of preceding data, the default starts a new hash.</param>
+	ENGINE_DLLEXPORT u64 HashAssetSource(const void* data, size_t size, u64 hash = 0xcbf29ce484222325ull);
+
+	/// <summary>Returns path of the cooked version of given source file inside asset cache directory,
+	/// see <see cref="AssetsPathConfig::GetAssetCacheDirectory()"/>. Cooked files are never written next to sources.</summary>
+	/// <param name="extension">Extension of cooked asset type.</param>
+	/// <param name="variant">Identifies one of several assets cooked differently from the same source, e.g. for different usages.</param>
+	ENGINE_DLLEXPORT String GetAssetCachePath(const String& sourcePath, const char* extension, u64 variant = 0);
+
+	/// <summary>Builds cooked asset file. Arrays are stored as raw memory blocks aligned to 16 bytes,
+	/// so they can be read back with a single copy per array or used in place.</summary>
+	class ENGINE_DLLEXPORT AssetCacheWriter final : public BaseObject<>
+	{
+	public:
+		/// <param name="magic">Identifier of cooked asset type.</param>
+		/// <param name="version">Version of cooked asset format, has to change whenever the layout changes.</param>
+		/// <param name="sourceHash">Hash of the source file, see <see cref="HashAssetSource()"/>.</param>
+		AssetCacheWriter(u32 magic, u32 version, u64 sourceHash);
+
+		template<typename T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Only literal types can be cached!");
+			WriteBytes(&value, sizeof(T));
+		}
+
+		template<typename T>
+		void WriteArray(const Dynarray<T>& array)
+		{
+			WriteArray(array.GetData(), array.GetSize());
+		}
+
+		template<typename T>
+		void WriteArray(const T* data, size_t count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Only literal types can be cached!");
+			Write<u64>(count);
+			Align();
+			WriteBytes(data, count * sizeof(T));
+		}
+
+		void WriteString(const String& str);
+
+		/// <summary>Saves cooked asset to file, creating missing directories.</summary>
+		/// <returns>False if the file could not be written.</returns>
+		bool SaveToFile(const String& path) const;
+
+		const Dynarray<char>& GetData() const { return Data; }
+
+	private:
+		void WriteBytes(const void* data, size_t size);
+		void Align();
+
+		Dynarray<char> Data;
+	};
+
+	/// <summary>Reads cooked asset file written by <see cref="AssetCacheWriter"/>.
+	/// Reading past the end of data throws <see cref="ResourceLoadFailedException"/>.</summary>
+	class ENGINE_DLLEXPORT AssetCacheReader final : public BaseObject<>
+	{
+	public:
+		/// <param name="data">Whole content of cooked asset file, has to outlive the reader.</param>
+		explicit AssetCacheReader(const BinaryBuffer& data);
+
+		/// <summary>Checks whether data is a cooked asset of given type and format version cooked from source with given hash.</summary>
+		bool IsUpToDate(u32 magic, u32 version, u64 sourceHash) const;
+
+		template<typename T>
+		T Read()
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Only literal types can be cached!");
+			T value;
+			ReadBytes(&value, sizeof(T));
+			return value;
+		}
+
+		template<typename T>
+		void ReadArray(Dynarray<T>& array)
+		{
+			size_t count;
+			const T* data = ReadArrayView<T>(count);
+			array.Resize(count);
+			if (count > 0)
+				memcpy(array.GetData(), data, count * sizeof(T));
+		}
+
+		/// <summary>Reads array without copying it.</summary>
+		/// <param name="count">Number of elements in the array.</param>
+		/// <returns>Pointer to the array inside cooked asset data.</returns>
+		template<typename T>
+		const T* ReadArrayView(size_t& count)
+		{
+			static_assert(std::is_trivially_destructible<T>::value, "Only literal types can be cached!");
+			static_assert(alignof(T) <= 16, "Arrays are aligned to 16 bytes!");
+			const u64 size = Read<u64>();
+			Align();
+			if (size > GetRemainingSize() / sizeof(T))
+				throw ResourceLoadFailedException();
+			count = static_cast<size_t>(size);
+			return reinterpret_cast<const T*>(Skip(count * sizeof(T)));
+		}
+
+		String ReadString();
+
+	private:
+		void ReadBytes(void* data, size_t size);
+		const char* Skip(size_t size);
+		void Align();
+		size_t GetRemainingSize() const { return Offset < Data.GetSize() ? Data.GetSize() - Offset : 0; }
+
+		const BinaryBuffer& Data;
+		size_t Offset;
+	};
+}
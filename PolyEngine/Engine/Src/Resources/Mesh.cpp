@@ -1,8 +1,27 @@
 #include "EnginePCH.hpp"
 
 #include "Resources/Mesh.hpp"
+#include "Resources/MeshOptimization.hpp"
 #include "Resources/ResourceManager.hpp"
 #include "Resources/TextureResource.hpp"
+#include "Rendering/IRenderingDevice.hpp"
+
+namespace
+{
+	template<typename T>
+	void RemapStream(Poly::Dynarray<T>& stream, const Poly::Dynarray<u32>& remap, size_t vertexCount)
+	{
+		if (stream.IsEmpty())
+			return;
+
+		Poly::Dynarray<T> result;
+		result.Resize(vertexCount);
+		for (size_t i = 0; i < stream.GetSize(); ++i)
+			if (remap[i] != Poly::MeshOptimization::INVALID_VERTEX)
+				memcpy(static_cast<void*>(&result[remap[i]]), &stream[i], sizeof(T));
+		stream = std::move(result);
+	}
+}
 
 Poly::Mesh::~Mesh()
 {
@@ -24,3 +43,127 @@ Poly::Mesh::~Mesh()
 	if (EmissiveMap)
 		ResourceManager<TextureResource>::Release(EmissiveMap);
 }
+
+void Poly::Mesh::SetTexture(eTextureUsageType usage, TextureResource* texture)
+{
+	switch (usage)
+	{
+	case eTextureUsageType::ALBEDO:				AlbedoMap = texture;			break;
+	case eTextureUsageType::ROUGHNESS:			RoughnessMap = texture;			break;
+	case eTextureUsageType::METALLIC:			MetallicMap = texture;			break;
+	case eTextureUsageType::AMBIENT_OCCLUSION:	AmbientOcclusionMap = texture;	break;
+	case eTextureUsageType::NORMAL:				NormalMap = texture;			break;
+	case eTextureUsageType::EMISSIVE:			EmissiveMap = texture;			break;
+	default:
+		ASSERTE(false, "Texture usage is not a mesh material map!");
+	}
+}
+
+size_t Poly::Mesh::GetVertexSize() const
+{
+	if (HasPackedAttributes())
+		return sizeof(Vector3f) + sizeof(PackedAttributes);
+
+	// tangents are uploaded with bitangent sign in w instead of separate bitangents
+	return sizeof(Vector3f)
+		+ (HasTextCoords() ? sizeof(TextCoord) : 0)
+		+ (HasNormals() ? sizeof(Vector3f) : 0)
+		+ (HasTangents() ? 4 * sizeof(float) : 0);
+}
+
+void Poly::Mesh::Optimize(bool packAttributes)
+{
+	if (!HasVertices() || !HasIndicies())
+		return;
+
+	const size_t vertexCount = Positions.GetSize();
+	const float acmrBefore = MeshOptimization::ComputeACMR(Indices, vertexCount);
+	const size_t vertexSizeBefore = GetVertexSize();
+
+	MeshOptimization::OptimizeVertexCache(Indices, vertexCount);
+	MeshOptimization::OptimizeOverdraw(Indices, Positions);
+
+	Dynarray<u32> remap;
+	const size_t usedVertexCount = MeshOptimization::OptimizeVertexFetch(Indices, vertexCount, remap);
+	RemapStream(Positions, remap, usedVertexCount);
+	RemapStream(Normals, remap, usedVertexCount);
+	RemapStream(Tangents, remap, usedVertexCount);
+	RemapStream(Bitangents, remap, usedVertexCount);
+	RemapStream(TextCoords, remap, usedVertexCount);
+	RemapStream(Packed, remap, usedVertexCount);
+	// levels of detail use subset of full detail vertices
+	for (u32& index : LodIndices)
+		index = remap[index];
+
+	if (packAttributes && !HasPackedAttributes())
+	{
+		const Vector3f zero;
+		Packed.Resize(usedVertexCount);
+		for (size_t v = 0; v < usedVertexCount; ++v)
+		{
+			const Vector3f& normal = HasNormals() ? Normals[v] : zero;
+			float bitangentSign = 1.f;
+			if (HasTangents() && HasBitangents())
+			{
+				const Vector3f& t = Tangents[v];
+				const Vector3f& b = Bitangents[v];
+				const float handedness = (normal.Y * t.Z - normal.Z * t.Y) * b.X
+					+ (normal.Z * t.X - normal.X * t.Z) * b.Y
+					+ (normal.X * t.Y - normal.Y * t.X) * b.Z;
+				bitangentSign = handedness < 0.f ? -1.f : 1.f;
+			}
+
+			Packed[v].Normal = MeshOptimization::PackSnorm10(normal, 0.f);
+			Packed[v].Tangent = MeshOptimization::PackSnorm10(HasTangents() ? Tangents[v] : zero, bitangentSign);
+			Packed[v].TextCoord[0] = MeshOptimization::PackHalf(HasTextCoords() ? TextCoords[v].U : 0.f);
+			Packed[v].TextCoord[1] = MeshOptimization::PackHalf(HasTextCoords() ? TextCoords[v].V : 0.f);
+		}
+		Normals = Dynarray<Vector3f>();
+		Tangents = Dynarray<Vector3f>();
+		Bitangents = Dynarray<Vector3f>();
+		TextCoords = Dynarray<TextCoord>();
+	}
+
+	gConsole.LogDebug("Optimized mesh with {} triangles: ACMR {} -> {}, {} -> {} vertices, {} -> {} bytes per vertex",
+		GetTriangleCount(), acmrBefore, MeshOptimization::ComputeACMR(Indices, usedVertexCount),
+		vertexCount, usedVertexCount, vertexSizeBefore, GetVertexSize());
+}
+
+Poly::Mesh::Lod Poly::Mesh::GetLod(size_t level) const
+{
+	if (level == 0 || Lods.IsEmpty())
+		return Lod{ 0, Indices.GetSize(), 0.f };
+	return Lods[std::min(level, Lods.GetSize()) - 1];
+}
+
+void Poly::Mesh::GenerateLods(size_t maxLodCount, size_t minTriangleCount)
+{
+	// levels share vertices with full detail, so simplification error stays low enough for distant meshes only
+	constexpr float MAX_LOD_ERROR = 0.05f;
+
+	LodIndices.Clear();
+	Lods.Clear();
+
+	Dynarray<u32> source = Indices;
+	float error = 0.f;
+	while (GetLodCount() < maxLodCount && source.GetSize() / 6 >= minTriangleCount)
+	{
+		Dynarray<u32> simplified;
+		const size_t targetIndexCount = source.GetSize() / 6 * 3;
+		error = std::max(error, MeshOptimization::Simplify(source, Positions, targetIndexCount, MAX_LOD_ERROR, simplified));
+
+		// level saving few triangles costs more memory than it saves rendering time
+		if (simplified.GetSize() * 4 > source.GetSize() * 3)
+			break;
+
+		MeshOptimization::OptimizeVertexCache(simplified, Positions.GetSize());
+		Lods.PushBack(Lod{ Indices.GetSize() + LodIndices.GetSize(), simplified.GetSize(), error });
+		LodIndices.Reserve(LodIndices.GetSize() + simplified.GetSize());
+		for (u32 index : simplified)
+			LodIndices.PushBack(index);
+		source = std::move(simplified);
+	}
+
+	gConsole.LogDebug("Generated {} levels of detail for mesh with {} triangles, coarsest has {} triangles",
+		GetLodCount(), GetTriangleCount(), GetLod(GetLodCount() - 1).IndexCount / 3);
+}
@@ -7,6 +7,7 @@
 namespace Poly
 {
 	class TextureResource;
+	enum class eTextureUsageType;
 
 	class ENGINE_DLLEXPORT Mesh : public BaseObject<>
 	{
@@ -15,6 +16,26 @@ namespace Poly
 
 		struct ENGINE_DLLEXPORT TextCoord { float U = 0, V = 0; };
 
+		/// <summary>Quantized vertex attributes interleaved in single stream, positions are kept separately for depth only passes.</summary>
+		struct ENGINE_DLLEXPORT PackedAttributes
+		{
+			// GL_INT_2_10_10_10_REV signed normalized, w of tangent is the sign of bitangent
+			u32 Normal = 0;
+			u32 Tangent = 0;
+			// half floats
+			u16 TextCoord[2] = {};
+		};
+
+		/// <summary>Range of the index buffer drawn at a level of detail. Indices of all levels are stored
+		/// in a single buffer, <see cref="GetIndicies()"/> of full detail followed by <see cref="GetLodIndices()"/>.</summary>
+		struct ENGINE_DLLEXPORT Lod
+		{
+			size_t FirstIndex = 0;
+			size_t IndexCount = 0;
+			// distance from full detail surface, relative to mesh extent
+			float Error = 0.f;
+		};
+
 		const TextureResource* GetAlbedoMap() const { return AlbedoMap; }
 		const TextureResource* GetRoughnessMap() const { return RoughnessMap; }
 		const TextureResource* GetMetallicMap() const { return MetallicMap; }
@@ -30,6 +51,13 @@ namespace Poly
 		const Dynarray<Vector3f>& GetBitangents() const { return Bitangents; }
 		const Dynarray<TextCoord>& GetTextCoords() const { return TextCoords; }
 		const Dynarray<uint32_t>& GetIndicies() const { return Indices; }
+		const Dynarray<PackedAttributes>& GetPackedAttributes() const { return Packed; }
+		const Dynarray<uint32_t>& GetLodIndices() const { return LodIndices; }
+
+		/// <returns>Number of levels of detail, including full detail.</returns>
+		size_t GetLodCount() const { return Lods.GetSize() + 1; }
+		/// <summary>Returns range of indices drawn at given level of detail, levels past the last one return the coarsest level.</summary>
+		Lod GetLod(size_t level) const;
 
 		bool HasVertices() const { return Positions.GetSize() != 0; }
 		bool HasNormals() const { return Normals.GetSize() != 0; }
@@ -37,20 +65,41 @@ namespace Poly
 		bool HasBitangents() const { return Bitangents.GetSize() != 0; }
 		bool HasTextCoords() const { return TextCoords.GetSize() != 0; }
 		bool HasIndicies() const { return Indices.GetSize() != 0; }
+		/// <summary>Whether normals, tangents and texture coordinates were replaced by <see cref="PackedAttributes"/>.</summary>
+		bool HasPackedAttributes() const { return Packed.GetSize() != 0; }
+
+		/// <returns>Size of vertex data on the device, in bytes per vertex.</returns>
+		size_t GetVertexSize() const;
+
+		/// <summary>Prepares mesh for rendering: reorders triangles for post-transform vertex cache and overdraw,
+		/// and vertices for sequential fetch. Optionally quantizes attributes, the full precision streams are released then.</summary>
+		void Optimize(bool packAttributes);
+
+		/// <summary>Builds simplified levels of detail, each with about half of the triangles of the previous one.</summary>
+		/// <param name="maxLodCount">Maximum number of levels, including full detail.</param>
+		/// <param name="minTriangleCount">Meshes are not simplified below this number of triangles.</param>
+		void GenerateLods(size_t maxLodCount, size_t minTriangleCount);
 
 	private:
-		TextureResource* AlbedoMap;
-		TextureResource* RoughnessMap;
-		TextureResource* MetallicMap;
-		TextureResource* AmbientOcclusionMap;
-		TextureResource* NormalMap;
-		TextureResource* EmissiveMap;
+		/// <summary>Assigns texture to the map matching its usage, mesh takes over the reference to the texture.</summary>
+		void SetTexture(eTextureUsageType usage, TextureResource* texture);
+
+		TextureResource* AlbedoMap = nullptr;
+		TextureResource* RoughnessMap = nullptr;
+		TextureResource* MetallicMap = nullptr;
+		TextureResource* AmbientOcclusionMap = nullptr;
+		TextureResource* NormalMap = nullptr;
+		TextureResource* EmissiveMap = nullptr;
 		Dynarray<Vector3f> Positions;
 		Dynarray<Vector3f> Normals;
 		Dynarray<Vector3f> Tangents;
 		Dynarray<Vector3f> Bitangents;
 		Dynarray<TextCoord> TextCoords;
 		Dynarray<uint32_t> Indices;
+		Dynarray<PackedAttributes> Packed;
+		Dynarray<uint32_t> LodIndices;
+		// levels of detail past the full one
+		Dynarray<Lod> Lods;
 
 		friend class MeshResource;
 		friend class SubMesh;
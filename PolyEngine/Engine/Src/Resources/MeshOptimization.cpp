@@ -0,0 +1,665 @@
+#include "EnginePCH.hpp"
+
+#include "Resources/MeshOptimization.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	// Scoring follows "Linear-Speed Vertex Cache Optimisation" by Tom Forsyth
+	constexpr size_t FORSYTH_CACHE_SIZE = 32;
+	constexpr u32 INVALID_TRIANGLE = u32(-1);
+
+	float GetVertexScore(int cachePosition, u32 remainingTriangles)
+	{
+		if (remainingTriangles == 0)
+			return -1.f;
+
+		float score = 0.f;
+		if (cachePosition >= 0)
+		{
+			// vertices of the last triangle get fixed score, so the next triangle does not always reuse the same edge
+			if (cachePosition < 3)
+				score = 0.75f;
+			else
+				score = std::pow(1.f - float(cachePosition - 3) / float(FORSYTH_CACHE_SIZE - 3), 1.5f);
+		}
+		// prefer vertices with few triangles left, to finish them before they leave the cache
+		score += 2.f / std::sqrt(float(remainingTriangles));
+		return score;
+	}
+
+	void Sub(const Vector3f& a, const Vector3f& b, float out[3])
+	{
+		out[0] = a.X - b.X;
+		out[1] = a.Y - b.Y;
+		out[2] = a.Z - b.Z;
+	}
+
+	void Cross(const float a[3], const float b[3], float out[3])
+	{
+		out[0] = a[1] * b[2] - a[2] * b[1];
+		out[1] = a[2] * b[0] - a[0] * b[2];
+		out[2] = a[0] * b[1] - a[1] * b[0];
+	}
+
+	// Symmetric 4x4 matrix of plane equations, squared distance of point p to the planes is p^T Q p
+	struct Quadric
+	{
+		double A00 = 0, A11 = 0, A22 = 0, A01 = 0, A02 = 0, A12 = 0;
+		double B0 = 0, B1 = 0, B2 = 0;
+		double C = 0;
+		double Weight = 0;
+
+		void AddPlane(const float normal[3], float offset, float weight)
+		{
+			const double a = normal[0], b = normal[1], c = normal[2], d = offset;
+			A00 += weight * a * a; A11 += weight * b * b; A22 += weight * c * c;
+			A01 += weight * a * b; A02 += weight * a * c; A12 += weight * b * c;
+			B0 += weight * a * d; B1 += weight * b * d; B2 += weight * c * d;
+			C += weight * d * d;
+			Weight += weight;
+		}
+
+		void Add(const Quadric& other)
+		{
+			A00 += other.A00; A11 += other.A11; A22 += other.A22;
+			A01 += other.A01; A02 += other.A02; A12 += other.A12;
+			B0 += other.B0; B1 += other.B1; B2 += other.B2;
+			C += other.C;
+			Weight += other.Weight;
+		}
+
+		// average squared distance to the planes
+		double GetError(const Vector3f& p) const
+		{
+			const double x = p.X, y = p.Y, z = p.Z;
+			const double error = A00 * x * x + A11 * y * y + A22 * z * z
+				+ 2 * (A01 * x * y + A02 * x * z + A12 * y * z)
+				+ 2 * (B0 * x + B1 * y + B2 * z)
+				+ C;
+			return Weight > 0 ? std::abs(error) / Weight : 0.0;
+		}
+	};
+
+	struct EdgeCollapse
+	{
+		double Error;
+		u32 From;
+		u32 To;
+	};
+
+	u64 MakeEdgeKey(u32 from, u32 to)
+	{
+		return (u64(from) << 32) | u64(to);
+	}
+
+	void GetTriangleNormal(const Vector3f& p0, const Vector3f& p1, const Vector3f& p2, float normal[3])
+	{
+		float e1[3], e2[3];
+		Sub(p1, p0, e1);
+		Sub(p2, p0, e2);
+		Cross(e1, e2, normal);
+	}
+
+	struct TriangleCluster
+	{
+		size_t FirstTriangle = 0;
+		size_t TriangleCount = 0;
+		float Centroid[3] = { 0.f, 0.f, 0.f };
+		float Normal[3] = { 0.f, 0.f, 0.f };
+		float Area = 0.f;
+		float SortKey = 0.f;
+	};
+}
+
+//------------------------------------------------------------------------------
+float MeshOptimization::ComputeACMR(const Dynarray<u32>& indices, size_t vertexCount, size_t cacheSize)
+{
+	const size_t triangleCount = indices.GetSize() / 3;
+	if (triangleCount == 0)
+		return 0.f;
+
+	// vertex is in FIFO cache when it was inserted during last cacheSize insertions
+	Dynarray<size_t> insertTime;
+	insertTime.Resize(vertexCount);
+	for (size_t& time : insertTime)
+		time = 0;
+
+	size_t time = cacheSize + 1;
+	size_t misses = 0;
+	for (u32 index : indices)
+	{
+		HEAVY_ASSERTE(index < vertexCount, "Index out of vertex range!");
+		if (time - insertTime[index] > cacheSize)
+		{
+			insertTime[index] = time++;
+			++misses;
+		}
+	}
+	return float(misses) / float(triangleCount);
+}
+
+//------------------------------------------------------------------------------
+void MeshOptimization::OptimizeVertexCache(Dynarray<u32>& indices, size_t vertexCount)
+{
+	const size_t triangleCount = indices.GetSize() / 3;
+	if (triangleCount == 0)
+		return;
+
+	// triangles using every vertex, list of vertex v starts at adjacencyOffsets[v] and holds remainingTriangles[v] not emitted triangles
+	Dynarray<u32> remainingTriangles;
+	remainingTriangles.Resize(vertexCount);
+	for (u32& count : remainingTriangles)
+		count = 0;
+	for (u32 index : indices)
+	{
+		ASSERTE(index < vertexCount, "Index out of vertex range!");
+		++remainingTriangles[index];
+	}
+
+	Dynarray<u32> adjacencyOffsets;
+	adjacencyOffsets.Resize(vertexCount);
+	u32 offset = 0;
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		adjacencyOffsets[v] = offset;
+		offset += remainingTriangles[v];
+	}
+
+	Dynarray<u32> adjacency;
+	adjacency.Resize(indices.GetSize());
+	Dynarray<u32> fill(adjacencyOffsets);
+	for (size_t t = 0; t < triangleCount; ++t)
+		for (size_t k = 0; k < 3; ++k)
+			adjacency[fill[indices[t * 3 + k]]++] = u32(t);
+
+	Dynarray<int> cachePosition;
+	Dynarray<float> vertexScore;
+	cachePosition.Resize(vertexCount);
+	vertexScore.Resize(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		cachePosition[v] = -1;
+		vertexScore[v] = GetVertexScore(-1, remainingTriangles[v]);
+	}
+
+	Dynarray<float> triangleScore;
+	Dynarray<u8> emitted;
+	triangleScore.Resize(triangleCount);
+	emitted.Resize(triangleCount);
+	u32 bestTriangle = INVALID_TRIANGLE;
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		emitted[t] = 0;
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+		if (bestTriangle == INVALID_TRIANGLE || triangleScore[t] > triangleScore[bestTriangle])
+			bestTriangle = u32(t);
+	}
+
+	Dynarray<u32> result;
+	result.Reserve(indices.GetSize());
+	u32 cache[FORSYTH_CACHE_SIZE + 3];
+	size_t cacheSize = 0;
+	size_t scanPosition = 0;
+
+	while (bestTriangle != INVALID_TRIANGLE)
+	{
+		emitted[bestTriangle] = 1;
+		const u32* triangle = indices.GetData() + bestTriangle * 3;
+
+		u32 newCache[FORSYTH_CACHE_SIZE + 3];
+		size_t newCacheSize = 0;
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const u32 v = triangle[k];
+			result.PushBack(v);
+
+			// move emitted triangle past the end of the vertex list
+			u32* list = adjacency.GetData() + adjacencyOffsets[v];
+			for (u32 i = 0; i < remainingTriangles[v]; ++i)
+			{
+				if (list[i] == bestTriangle)
+				{
+					std::swap(list[i], list[remainingTriangles[v] - 1]);
+					--remainingTriangles[v];
+					break;
+				}
+			}
+
+			if (std::find(newCache, newCache + newCacheSize, v) == newCache + newCacheSize)
+				newCache[newCacheSize++] = v;
+		}
+		for (size_t i = 0; i < cacheSize; ++i)
+			if (std::find(triangle, triangle + 3, cache[i]) == triangle + 3)
+				newCache[newCacheSize++] = cache[i];
+
+		// vertices pushed out of the cache are rescored as well, as they lose their cache bonus
+		for (size_t i = 0; i < newCacheSize; ++i)
+		{
+			const u32 v = newCache[i];
+			cachePosition[v] = i < FORSYTH_CACHE_SIZE ? int(i) : -1;
+			vertexScore[v] = GetVertexScore(cachePosition[v], remainingTriangles[v]);
+		}
+		cacheSize = std::min(newCacheSize, FORSYTH_CACHE_SIZE);
+		std::copy(newCache, newCache + cacheSize, cache);
+
+		// only triangles touching changed vertices change their score, the best one is almost always among them
+		bestTriangle = INVALID_TRIANGLE;
+		float bestScore = 0.f;
+		for (size_t i = 0; i < newCacheSize; ++i)
+		{
+			const u32 v = newCache[i];
+			const u32* list = adjacency.GetData() + adjacencyOffsets[v];
+			for (u32 j = 0; j < remainingTriangles[v]; ++j)
+			{
+				const u32 t = list[j];
+				const u32* tv = indices.GetData() + t * 3;
+				triangleScore[t] = vertexScore[tv[0]] + vertexScore[tv[1]] + vertexScore[tv[2]];
+				if (triangleScore[t] > bestScore)
+				{
+					bestScore = triangleScore[t];
+					bestTriangle = t;
+				}
+			}
+		}
+
+		// dead end, continue with any triangle left
+		if (bestTriangle == INVALID_TRIANGLE)
+		{
+			while (scanPosition < triangleCount && emitted[scanPosition])
+				++scanPosition;
+			if (scanPosition < triangleCount)
+				bestTriangle = u32(scanPosition);
+		}
+	}
+
+	ASSERTE(result.GetSize() == triangleCount * 3, "Not all triangles were emitted!");
+	indices = std::move(result);
+}
+
+//------------------------------------------------------------------------------
+void MeshOptimization::OptimizeOverdraw(Dynarray<u32>& indices, const Dynarray<Vector3f>& positions, float threshold)
+{
+	// Simplified "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" (Sander, Nehab, Barczak).
+	// Clusters are cut where the cache optimized order restarts with cold cache, so moving them around costs little ACMR.
+	const size_t triangleCount = indices.GetSize() / 3;
+	if (triangleCount == 0)
+		return;
+
+	Dynarray<TriangleCluster> clusters;
+	Dynarray<size_t> insertTime;
+	insertTime.Resize(positions.GetSize());
+	for (size_t& time : insertTime)
+		time = 0;
+	size_t time = DEFAULT_CACHE_SIZE + 1;
+
+	for (size_t t = 0; t < triangleCount; ++t)
+	{
+		size_t misses = 0;
+		for (size_t k = 0; k < 3; ++k)
+		{
+			const u32 index = indices[t * 3 + k];
+			if (time - insertTime[index] > DEFAULT_CACHE_SIZE)
+			{
+				insertTime[index] = time++;
+				++misses;
+			}
+		}
+
+		if (t == 0 || misses == 3)
+		{
+			TriangleCluster cluster;
+			cluster.FirstTriangle = t;
+			clusters.PushBack(cluster);
+		}
+		++clusters[clusters.GetSize() - 1].TriangleCount;
+	}
+	if (clusters.GetSize() < 2)
+		return;
+
+	// area weighted centroids and normals of clusters
+	float meshCentroid[3] = { 0.f, 0.f, 0.f };
+	float meshArea = 0.f;
+	for (TriangleCluster& cluster : clusters)
+	{
+		for (size_t t = cluster.FirstTriangle; t < cluster.FirstTriangle + cluster.TriangleCount; ++t)
+		{
+			const Vector3f& p0 = positions[indices[t * 3]];
+			const Vector3f& p1 = positions[indices[t * 3 + 1]];
+			const Vector3f& p2 = positions[indices[t * 3 + 2]];
+			float e1[3], e2[3], normal[3];
+			Sub(p1, p0, e1);
+			Sub(p2, p0, e2);
+			Cross(e1, e2, normal);
+			const float area = 0.5f * std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+			cluster.Centroid[0] += area * (p0.X + p1.X + p2.X) / 3.f;
+			cluster.Centroid[1] += area * (p0.Y + p1.Y + p2.Y) / 3.f;
+			cluster.Centroid[2] += area * (p0.Z + p1.Z + p2.Z) / 3.f;
+			for (size_t c = 0; c < 3; ++c)
+				cluster.Normal[c] += normal[c];
+			cluster.Area += area;
+		}
+
+		for (size_t c = 0; c < 3; ++c)
+			meshCentroid[c] += cluster.Centroid[c];
+		meshArea += cluster.Area;
+		if (cluster.Area > 0.f)
+			for (size_t c = 0; c < 3; ++c)
+				cluster.Centroid[c] /= cluster.Area;
+	}
+	if (meshArea <= 0.f)
+		return;
+	for (size_t c = 0; c < 3; ++c)
+		meshCentroid[c] /= meshArea;
+
+	// clusters facing away from the center occlude the rest from most view directions, so they go first
+	for (TriangleCluster& cluster : clusters)
+	{
+		const float length = std::sqrt(cluster.Normal[0] * cluster.Normal[0] + cluster.Normal[1] * cluster.Normal[1] + cluster.Normal[2] * cluster.Normal[2]);
+		if (length <= 0.f)
+			continue;
+		for (size_t c = 0; c < 3; ++c)
+			cluster.SortKey += (cluster.Centroid[c] - meshCentroid[c]) * cluster.Normal[c] / length;
+	}
+	std::stable_sort(clusters.GetData(), clusters.GetData() + clusters.GetSize(),
+		[](const TriangleCluster& a, const TriangleCluster& b) { return a.SortKey > b.SortKey; });
+
+	Dynarray<u32> result;
+	result.Reserve(indices.GetSize());
+	for (const TriangleCluster& cluster : clusters)
+		for (size_t i = cluster.FirstTriangle * 3; i < (cluster.FirstTriangle + cluster.TriangleCount) * 3; ++i)
+			result.PushBack(indices[i]);
+
+	if (ComputeACMR(result, positions.GetSize()) <= ComputeACMR(indices, positions.GetSize()) * threshold)
+		indices = std::move(result);
+}
+
+//------------------------------------------------------------------------------
+float MeshOptimization::Simplify(const Dynarray<u32>& indices, const Dynarray<Vector3f>& positions, size_t targetIndexCount, float maxError, Dynarray<u32>& result)
+{
+	result = indices;
+	const size_t vertexCount = positions.GetSize();
+	if (indices.GetSize() <= targetIndexCount || vertexCount == 0)
+		return 0.f;
+
+	// positions are scaled to unit extent, so errors do not depend on mesh size
+	const float maxFloat = std::numeric_limits<float>::max();
+	float min[3] = { maxFloat, maxFloat, maxFloat };
+	float max[3] = { -maxFloat, -maxFloat, -maxFloat };
+	for (const Vector3f& p : positions)
+	{
+		min[0] = std::min(min[0], p.X); min[1] = std::min(min[1], p.Y); min[2] = std::min(min[2], p.Z);
+		max[0] = std::max(max[0], p.X); max[1] = std::max(max[1], p.Y); max[2] = std::max(max[2], p.Z);
+	}
+	const float extent = std::max(max[0] - min[0], std::max(max[1] - min[1], max[2] - min[2]));
+	const float scale = extent > 0.f ? 1.f / extent : 1.f;
+	Dynarray<Vector3f> scaled;
+	scaled.Resize(vertexCount);
+	for (size_t v = 0; v < vertexCount; ++v)
+	{
+		scaled[v].X = (positions[v].X - min[0]) * scale;
+		scaled[v].Y = (positions[v].Y - min[1]) * scale;
+		scaled[v].Z = (positions[v].Z - min[2]) * scale;
+	}
+
+	// area weighted planes of triangles around every vertex
+	Dynarray<Quadric> quadrics;
+	quadrics.Resize(vertexCount);
+	for (size_t i = 0; i < indices.GetSize(); i += 3)
+	{
+		float normal[3];
+		GetTriangleNormal(scaled[indices[i]], scaled[indices[i + 1]], scaled[indices[i + 2]], normal);
+		const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		if (length <= 0.f)
+			continue;
+		for (float& c : normal)
+			c /= length;
+		const Vector3f& p0 = scaled[indices[i]];
+		const float offset = -(normal[0] * p0.X + normal[1] * p0.Y + normal[2] * p0.Z);
+		for (size_t k = 0; k < 3; ++k)
+			quadrics[indices[i + k]].AddPlane(normal, offset, 0.5f * length);
+	}
+
+	// edge without its twin lies on a border, split vertices along attribute seams make such borders too
+	Dynarray<u64> edges;
+	edges.Resize(indices.GetSize());
+	for (size_t i = 0; i < indices.GetSize(); i += 3)
+		for (size_t k = 0; k < 3; ++k)
+			edges[i + k] = MakeEdgeKey(indices[i + k], indices[i + (k + 1) % 3]);
+	std::sort(edges.GetData(), edges.GetData() + edges.GetSize());
+	Dynarray<u8> locked;
+	locked.Resize(vertexCount);
+	for (u8& flag : locked)
+		flag = 0;
+	for (u64 edge : edges)
+	{
+		const u32 from = u32(edge >> 32), to = u32(edge);
+		if (!std::binary_search(edges.GetData(), edges.GetData() + edges.GetSize(), MakeEdgeKey(to, from)))
+			locked[from] = locked[to] = 1;
+	}
+
+	const double maxErrorSq = double(maxError) * double(maxError);
+	double resultError = 0.0;
+	Dynarray<u32> remap;
+	Dynarray<u8> touched;
+	Dynarray<u32> adjacencyOffsets;
+	Dynarray<u32> adjacencyCounts;
+	Dynarray<u32> adjacency;
+	Dynarray<EdgeCollapse> collapses;
+	remap.Resize(vertexCount);
+	touched.Resize(vertexCount);
+	adjacencyOffsets.Resize(vertexCount);
+	adjacencyCounts.Resize(vertexCount);
+
+	// every pass collapses independent edges with the lowest error, until target or error limit is reached
+	while (result.GetSize() > targetIndexCount)
+	{
+		const size_t triangleCount = result.GetSize() / 3;
+
+		for (u32& count : adjacencyCounts)
+			count = 0;
+		for (u32 index : result)
+			++adjacencyCounts[index];
+		u32 offset = 0;
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			adjacencyOffsets[v] = offset;
+			offset += adjacencyCounts[v];
+			adjacencyCounts[v] = 0;
+		}
+		adjacency.Resize(result.GetSize());
+		for (size_t t = 0; t < triangleCount; ++t)
+			for (size_t k = 0; k < 3; ++k)
+			{
+				const u32 v = result[t * 3 + k];
+				adjacency[adjacencyOffsets[v] + adjacencyCounts[v]++] = u32(t);
+			}
+
+		collapses.Clear();
+		for (size_t i = 0; i < result.GetSize(); ++i)
+		{
+			const u32 from = result[i];
+			const u32 to = result[i - i % 3 + (i + 1) % 3];
+			if (locked[from])
+				continue;
+			Quadric quadric = quadrics[from];
+			quadric.Add(quadrics[to]);
+			const double error = quadric.GetError(scaled[to]);
+			if (error <= maxErrorSq)
+				collapses.PushBack(EdgeCollapse{ error, from, to });
+		}
+		std::sort(collapses.GetData(), collapses.GetData() + collapses.GetSize(),
+			[](const EdgeCollapse& a, const EdgeCollapse& b) { return a.Error < b.Error; });
+
+		for (size_t v = 0; v < vertexCount; ++v)
+		{
+			remap[v] = u32(v);
+			touched[v] = 0;
+		}
+
+		const size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+		size_t removedTriangles = 0;
+		size_t collapseCount = 0;
+		for (const EdgeCollapse& collapse : collapses)
+		{
+			if (removedTriangles >= trianglesToRemove)
+				break;
+			if (touched[collapse.From] || touched[collapse.To])
+				continue;
+
+			// triangles around collapsed vertex must not flip, fold steeply or become slivers, which rounding could turn either way
+			const u32* around = adjacency.GetData() + adjacencyOffsets[collapse.From];
+			const u32 aroundCount = adjacencyCounts[collapse.From];
+			bool flips = false;
+			size_t degenerate = 0;
+			for (u32 j = 0; j < aroundCount && !flips; ++j)
+			{
+				const u32* tri = result.GetData() + around[j] * 3;
+				if (tri[0] == collapse.To || tri[1] == collapse.To || tri[2] == collapse.To)
+				{
+					++degenerate;
+					continue;
+				}
+				float before[3], after[3];
+				GetTriangleNormal(scaled[tri[0]], scaled[tri[1]], scaled[tri[2]], before);
+				GetTriangleNormal(tri[0] == collapse.From ? scaled[collapse.To] : scaled[tri[0]],
+					tri[1] == collapse.From ? scaled[collapse.To] : scaled[tri[1]],
+					tri[2] == collapse.From ? scaled[collapse.To] : scaled[tri[2]], after);
+				const float beforeSq = before[0] * before[0] + before[1] * before[1] + before[2] * before[2];
+				const float afterSq = after[0] * after[0] + after[1] * after[1] + after[2] * after[2];
+				const float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+				flips = dot <= 0.25f * std::sqrt(beforeSq * afterSq) || dot <= 1e-3f * beforeSq;
+			}
+			if (flips)
+				continue;
+
+			// whole neighbourhood is frozen for this pass, so flip tests of later collapses see current triangles
+			for (u32 j = 0; j < aroundCount; ++j)
+				for (size_t k = 0; k < 3; ++k)
+					touched[result[around[j] * 3 + k]] = 1;
+
+			remap[collapse.From] = collapse.To;
+			quadrics[collapse.To].Add(quadrics[collapse.From]);
+			resultError = std::max(resultError, collapse.Error);
+			removedTriangles += degenerate;
+			++collapseCount;
+		}
+		if (collapseCount == 0)
+			break;
+
+		size_t size = 0;
+		for (size_t i = 0; i < result.GetSize(); i += 3)
+		{
+			const u32 a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+			if (a == b || b == c || a == c)
+				continue;
+			result[size++] = a;
+			result[size++] = b;
+			result[size++] = c;
+		}
+		result.Resize(size);
+	}
+
+	return float(std::sqrt(resultError));
+}
+
+//------------------------------------------------------------------------------
+size_t MeshOptimization::OptimizeVertexFetch(Dynarray<u32>& indices, size_t vertexCount, Dynarray<u32>& remap)
+{
+	remap.Resize(vertexCount);
+	for (u32& target : remap)
+		target = INVALID_VERTEX;
+
+	u32 nextVertex = 0;
+	for (u32& index : indices)
+	{
+		ASSERTE(index < vertexCount, "Index out of vertex range!");
+		if (remap[index] == INVALID_VERTEX)
+			remap[index] = nextVertex++;
+		index = remap[index];
+	}
+	return nextVertex;
+}
+
+//------------------------------------------------------------------------------
+u32 MeshOptimization::PackSnorm10(const Vector3f& v, float w)
+{
+	const auto quantize = [](float value, float scale, u32 mask) {
+		const float clamped = std::max(-1.f, std::min(1.f, value));
+		return static_cast<u32>(static_cast<int>(std::round(clamped * scale))) & mask;
+	};
+	return quantize(v.X, 511.f, 0x3FF)
+		| (quantize(v.Y, 511.f, 0x3FF) << 10)
+		| (quantize(v.Z, 511.f, 0x3FF) << 20)
+		| (quantize(w, 1.f, 0x3) << 30);
+}
+
+//------------------------------------------------------------------------------
+Vector3f MeshOptimization::UnpackSnorm10(u32 packed, float& w)
+{
+	// sign extension by arithmetic shift, -512 maps to -1 like -511
+	const auto unpack = [](u32 bits, int shift) {
+		return std::max(-1.f, float(static_cast<int>(bits << (22 - shift)) >> 22) / 511.f);
+	};
+	w = std::max(-1.f, float(static_cast<int>(packed) >> 30));
+	return Vector3f(unpack(packed, 0), unpack(packed, 10), unpack(packed, 20));
+}
+
+//------------------------------------------------------------------------------
+u16 MeshOptimization::PackHalf(float value)
+{
+	u32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	const u32 sign = (bits >> 16) & 0x8000;
+	const u32 absBits = bits & 0x7FFFFFFF;
+
+	// infinity and NaN
+	if (absBits >= 0x7F800000)
+		return static_cast<u16>(sign | (absBits > 0x7F800000 ? 0x7E00 : 0x7C00));
+	// 65520 and above rounds to infinity
+	if (absBits >= 0x477FF000)
+		return static_cast<u16>(sign | 0x7C00);
+
+	// denormalized half
+	if (absBits < 0x38800000)
+	{
+		if (absBits < 0x33000000)
+			return static_cast<u16>(sign);
+		const u32 mantissa = (absBits & 0x007FFFFF) | 0x00800000;
+		const u32 shift = 126 - (absBits >> 23);
+		u32 result = mantissa >> shift;
+		const u32 remainder = mantissa & ((1u << shift) - 1);
+		const u32 halfway = 1u << (shift - 1);
+		if (remainder > halfway || (remainder == halfway && (result & 1)))
+			++result;
+		return static_cast<u16>(sign | result);
+	}
+
+	// rebias exponent from 127 to 15 and round mantissa to nearest even, carry into exponent is correct
+	u32 result = (absBits - 0x38000000) >> 13;
+	const u32 remainder = absBits & 0x1FFF;
+	if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1)))
+		++result;
+	return static_cast<u16>(sign | result);
+}
+
+//------------------------------------------------------------------------------
+float MeshOptimization::UnpackHalf(u16 value)
+{
+	const u32 sign = u32(value & 0x8000) << 16;
+	const u32 exponent = (value >> 10) & 0x1F;
+	const u32 mantissa = value & 0x3FF;
+
+	if (exponent == 0)
+	{
+		const float result = std::ldexp(float(mantissa), -24);
+		return sign ? -result : result;
+	}
+
+	const u32 bits = sign | (exponent == 31 ? 0x7F800000 : (exponent + 112) << 23) | (mantissa << 13);
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
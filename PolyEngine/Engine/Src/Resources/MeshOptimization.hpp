@@ -0,0 +1,51 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Math/Vector3f.hpp>
+
+namespace Poly
+{
+	/// <summary>Offline processing of triangle meshes: index reordering for GPU caches and vertex attribute quantization.</summary>
+	namespace MeshOptimization
+	{
+		/// <summary>Size of FIFO post-transform vertex cache used by <see cref="ComputeACMR()"/> by default.</summary>
+		constexpr size_t DEFAULT_CACHE_SIZE = 16;
+
+		/// <summary>Simulates FIFO post-transform vertex cache.</summary>
+		/// <returns>Average cache miss ratio, number of vertex shader invocations per triangle, between 0.5 and 3.</returns>
+		ENGINE_DLLEXPORT float ComputeACMR(const Dynarray<u32>& indices, size_t vertexCount, size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+		/// <summary>Reorders triangles to maximize post-transform vertex cache hits (Forsyth's linear-speed algorithm).</summary>
+		ENGINE_DLLEXPORT void OptimizeVertexCache(Dynarray<u32>& indices, size_t vertexCount);
+
+		/// <summary>Reorders clusters of cache optimized triangles so the outer surfaces are drawn first, which reduces overdraw.</summary>
+		/// <param name="threshold">Maximum allowed ACMR increase, the order is kept when reordering costs more vertex cache hits.</param>
+		ENGINE_DLLEXPORT void OptimizeOverdraw(Dynarray<u32>& indices, const Dynarray<Vector3f>& positions, float threshold = 1.05f);
+
+		/// <summary>Simplifies mesh by collapsing edges in order of quadric error (Garland, Heckbert).
+		/// Vertices collapse into their neighbours, so all levels of detail share vertex data of the source mesh.
+		/// Vertices on open borders, including attribute seams where vertices are split, are kept in place.</summary>
+		/// <param name="targetIndexCount">Desired number of indices, the result is larger when error limit is reached first.</param>
+		/// <param name="maxError">Maximum distance of the result from the source surface, relative to mesh extent.</param>
+		/// <param name="result">Output, indices of simplified mesh.</param>
+		/// <returns>Distance of the result from the source surface, relative to mesh extent.</returns>
+		ENGINE_DLLEXPORT float Simplify(const Dynarray<u32>& indices, const Dynarray<Vector3f>& positions, size_t targetIndexCount, float maxError, Dynarray<u32>& result);
+
+		/// <summary>Marks vertices dropped by <see cref="OptimizeVertexFetch()"/>.</summary>
+		constexpr u32 INVALID_VERTEX = u32(-1);
+
+		/// <summary>Renumbers vertices in order of first use, so vertex fetch reads memory sequentially. Unused vertices are dropped.</summary>
+		/// <param name="remap">Output, new index of every vertex or INVALID_VERTEX for unused ones.</param>
+		/// <returns>Number of vertices after remapping.</returns>
+		ENGINE_DLLEXPORT size_t OptimizeVertexFetch(Dynarray<u32>& indices, size_t vertexCount, Dynarray<u32>& remap);
+
+		/// <summary>Packs unit vector and sign to GL_INT_2_10_10_10_REV format, components are signed normalized.</summary>
+		ENGINE_DLLEXPORT u32 PackSnorm10(const Vector3f& v, float w);
+		ENGINE_DLLEXPORT Vector3f UnpackSnorm10(u32 packed, float& w);
+
+		/// <summary>Converts float to IEEE 754 half precision float, rounding to nearest.</summary>
+		ENGINE_DLLEXPORT u16 PackHalf(float value);
+		ENGINE_DLLEXPORT float UnpackHalf(u16 value);
+	}
+}
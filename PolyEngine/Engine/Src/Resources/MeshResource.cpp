@@ -3,10 +3,57 @@
 #include "Resources/MeshResource.hpp"
 #include "Resources/ResourceManager.hpp"
 #include "ECS/Scene.hpp"
+#include <Utils/FileIO.hpp>
 
 using namespace Poly;
 
+namespace
+{
+	constexpr u32 MESH_CACHE_MAGIC = 0x4853454D; // "MESH"
+	constexpr u32 MESH_CACHE_VERSION = 4;
+
+	// levels of detail halve triangle count, so the coarsest has 1/8 of the triangles
+	constexpr size_t MAX_LOD_COUNT = 4;
+	constexpr size_t MIN_LOD_TRIANGLE_COUNT = 256;
+}
+
 MeshResource::MeshResource(const String& path)
+{
+	Decode(path);
+	CreateDeviceProxies();
+
+	// textures are still decoded in parallel
+	for (SubMesh* subMesh : SubMeshes)
+		for (SubMesh::PendingTexture& texture : subMesh->Textures)
+			texture.Handle.Wait();
+	UpdateAsyncDependencies();
+}
+
+void MeshResource::Decode(const String& path)
+{
+	std::unique_ptr<BinaryBuffer> source;
+	try
+	{
+		source.reset(LoadBinaryFile(path));
+	}
+	catch (const FileIOException&)
+	{
+		gConsole.LogError("Error Importing Asset: cannot open {}", path);
+		throw ResourceLoadFailedException();
+	}
+	const u64 sourceHash = HashAssetSource(*source);
+	source.reset();
+
+	// Cooked mesh skips Assimp import and per-vertex conversion, it is refreshed when source content changes
+	const String cachePath = GetAssetCachePath(path, COOKED_EXTENSION);
+	if (LoadFromCache(cachePath, sourceHash))
+		return;
+
+	Import(path);
+	SaveToCache(cachePath, sourceHash);
+}
+
+void MeshResource::Import(const String& path)
 {
 	Assimp::Importer importer;
 	const aiScene *scene = importer.ReadFile(path.GetCStr(), aiProcessPreset_TargetRealtime_Fast);
@@ -36,6 +83,99 @@ MeshResource::MeshResource(const String& path)
 	AxisAlignedBoundingBox = AABox(min, max - min);
 }
 
+bool MeshResource::LoadFromCache(const String& cachePath, u64 sourceHash)
+{
+	if (!FileExists(cachePath))
+		return false;
+
+	std::unique_ptr<BinaryBuffer> data(LoadBinaryFile(cachePath));
+	AssetCacheReader reader(*data);
+	if (!reader.IsUpToDate(MESH_CACHE_MAGIC, MESH_CACHE_VERSION, sourceHash))
+	{
+		gConsole.LogInfo("Cooked mesh {} is outdated.", cachePath);
+		return false;
+	}
+
+	try
+	{
+		// vectors are stored as raw memory, their layout depends on SIMD settings
+		if (reader.Read<u32>() != sizeof(Vector) || reader.Read<u32>() != sizeof(Quaternion))
+		{
+			gConsole.LogInfo("Cooked mesh {} was cooked with different vector layout.", cachePath);
+			return false;
+		}
+
+		SubMeshes.Resize(static_cast<size_t>(reader.Read<u64>()));
+		for (SubMesh*& subMesh : SubMeshes)
+			subMesh = nullptr;
+		for (SubMesh*& subMesh : SubMeshes)
+		{
+			subMesh = new SubMesh();
+			subMesh->LoadFromCache(reader);
+		}
+
+		Animations.Resize(static_cast<size_t>(reader.Read<u64>()));
+		for (Animation*& animation : Animations)
+			animation = nullptr;
+		for (Animation*& animation : Animations)
+		{
+			animation = new Animation();
+			animation->LoadFromCache(reader);
+		}
+
+		const Vector min = reader.Read<Vector>();
+		const Vector size = reader.Read<Vector>();
+		AxisAlignedBoundingBox = AABox(min, size);
+	}
+	catch (const ResourceLoadFailedException&)
+	{
+		gConsole.LogWarning("Cooked mesh {} is corrupted.", cachePath);
+		for (SubMesh* subMesh : SubMeshes)
+			delete subMesh;
+		for (Animation* animation : Animations)
+			delete animation;
+		SubMeshes.Clear();
+		Animations.Clear();
+		return false;
+	}
+
+	gConsole.LogDebug("Loading cooked model {} sucessfull.", cachePath);
+	return true;
+}
+
+void MeshResource::SaveToCache(const String& cachePath, u64 sourceHash) const
+{
+	AssetCacheWriter writer(MESH_CACHE_MAGIC, MESH_CACHE_VERSION, sourceHash);
+	writer.Write<u32>(sizeof(Vector));
+	writer.Write<u32>(sizeof(Quaternion));
+	writer.Write<u64>(SubMeshes.GetSize());
+	for (const SubMesh* subMesh : SubMeshes)
+		subMesh->SaveToCache(writer);
+	writer.Write<u64>(Animations.GetSize());
+	for (const Animation* animation : Animations)
+		animation->SaveToCache(writer);
+	writer.Write(AxisAlignedBoundingBox.GetMin());
+	writer.Write(AxisAlignedBoundingBox.GetSize());
+
+	// assets directory may be read only, mesh is imported again next time then
+	if (!writer.SaveToFile(cachePath))
+		gConsole.LogWarning("Failed to save cooked mesh {}", cachePath);
+}
+
+void MeshResource::CreateDeviceProxies()
+{
+	for (SubMesh* subMesh : SubMeshes)
+		subMesh->CreateDeviceProxies();
+}
+
+bool MeshResource::UpdateAsyncDependencies()
+{
+	bool done = true;
+	for (SubMesh* subMesh : SubMeshes)
+		done = subMesh->UpdateTextures() && done;
+	return done;
+}
+
 MeshResource::~MeshResource()
 {
 	for (SubMesh* subMesh : SubMeshes)
@@ -53,12 +193,120 @@ MeshResource::SubMesh::SubMesh(const String& path, aiMesh* mesh, aiMaterial* mat
 	LoadGeometry(mesh);
 	LoadBones(mesh);
 	
-	MeshData.EmissiveMap			= LoadTexture(material, path, (unsigned int)aiTextureType_EMISSIVE,		eTextureUsageType::EMISSIVE);
-	MeshData.AlbedoMap				= LoadTexture(material, path, (unsigned int)aiTextureType_DIFFUSE,		eTextureUsageType::ALBEDO);
-	MeshData.MetallicMap			= LoadTexture(material, path, (unsigned int)aiTextureType_SPECULAR,		eTextureUsageType::METALLIC);
-	MeshData.RoughnessMap			= LoadTexture(material, path, (unsigned int)aiTextureType_SHININESS,	eTextureUsageType::ROUGHNESS);
-	MeshData.NormalMap				= LoadTexture(material, path, (unsigned int)aiTextureType_HEIGHT,		eTextureUsageType::NORMAL);
-	MeshData.AmbientOcclusionMap	= LoadTexture(material, path, (unsigned int)aiTextureType_AMBIENT,		eTextureUsageType::AMBIENT_OCCLUSION);
+	FindTexture(material, path, (unsigned int)aiTextureType_EMISSIVE,	eTextureUsageType::EMISSIVE);
+	FindTexture(material, path, (unsigned int)aiTextureType_DIFFUSE,	eTextureUsageType::ALBEDO);
+	FindTexture(material, path, (unsigned int)aiTextureType_SPECULAR,	eTextureUsageType::METALLIC);
+	FindTexture(material, path, (unsigned int)aiTextureType_SHININESS,	eTextureUsageType::ROUGHNESS);
+	FindTexture(material, path, (unsigned int)aiTextureType_HEIGHT,		eTextureUsageType::NORMAL);
+	FindTexture(material, path, (unsigned int)aiTextureType_AMBIENT,	eTextureUsageType::AMBIENT_OCCLUSION);
+}
+
+void MeshResource::SubMesh::CreateDeviceProxies()
+{
+	MeshProxy = gEngine->GetRenderingDevice()->CreateMesh();
+	MeshProxy->SetContent(MeshData);
+
+	// textures are shared between meshes, so they are loaded through resource manager on the main thread
+	for (PendingTexture& texture : Textures)
+		texture.Handle = ResourceManager<TextureResource>::LoadAsync(texture.Path, eResourceSource::NONE, texture.Usage);
+}
+
+bool MeshResource::SubMesh::UpdateTextures()
+{
+	for (const PendingTexture& texture : Textures)
+		if (!texture.Handle.IsReady())
+			return false;
+
+	for (const PendingTexture& texture : Textures)
+	{
+		if (TextureResource* loaded = texture.Handle.Get())
+		{
+			gConsole.LogDebug("Succeded to load texture: {}", texture.Path);
+			MeshData.SetTexture(texture.Usage, loaded);
+		}
+		else
+		{
+			gConsole.LogError("Failed to load texture: {}", texture.Path);
+			if (texture.Handle.GetResource())
+				ResourceManager<TextureResource>::Release(texture.Handle.GetResource());
+		}
+	}
+	Textures.Clear();
+	return true;
+}
+
+void MeshResource::SubMesh::SaveToCache(AssetCacheWriter& writer) const
+{
+	writer.Write(AxisAlignedBoundingBox.GetMin());
+	writer.Write(AxisAlignedBoundingBox.GetSize());
+	writer.WriteArray(MeshData.Positions);
+	writer.WriteArray(MeshData.Normals);
+	writer.WriteArray(MeshData.Tangents);
+	writer.WriteArray(MeshData.Bitangents);
+	writer.WriteArray(MeshData.TextCoords);
+	writer.WriteArray(MeshData.Indices);
+	writer.WriteArray(MeshData.Packed);
+	writer.WriteArray(MeshData.LodIndices);
+	// field by field, Lod has padding and platform dependent size_t members
+	writer.Write<u64>(MeshData.Lods.GetSize());
+	for (const Mesh::Lod& lod : MeshData.Lods)
+	{
+		writer.Write<u64>(lod.FirstIndex);
+		writer.Write<u64>(lod.IndexCount);
+		writer.Write<f32>(lod.Error);
+	}
+
+	writer.Write<u64>(Bones.GetSize());
+	for (const Bone& bone : Bones)
+		writer.WriteString(bone.name);
+
+	writer.Write<u64>(Textures.GetSize());
+	for (const PendingTexture& texture : Textures)
+	{
+		writer.Write(texture.Usage);
+		writer.WriteString(texture.Path);
+	}
+}
+
+void MeshResource::SubMesh::LoadFromCache(AssetCacheReader& reader)
+{
+	const Vector min = reader.Read<Vector>();
+	const Vector size = reader.Read<Vector>();
+	AxisAlignedBoundingBox = AABox(min, size);
+	reader.ReadArray(MeshData.Positions);
+	reader.ReadArray(MeshData.Normals);
+	reader.ReadArray(MeshData.Tangents);
+	reader.ReadArray(MeshData.Bitangents);
+	reader.ReadArray(MeshData.TextCoords);
+	reader.ReadArray(MeshData.Indices);
+	reader.ReadArray(MeshData.Packed);
+	reader.ReadArray(MeshData.LodIndices);
+	const u64 lodCount = reader.Read<u64>();
+	const u64 indexCount = MeshData.Indices.GetSize() + MeshData.LodIndices.GetSize();
+	MeshData.Lods.Clear();
+	for (u64 i = 0; i < lodCount; ++i)
+	{
+		Mesh::Lod lod;
+		const u64 firstIndex = reader.Read<u64>();
+		const u64 lodIndexCount = reader.Read<u64>();
+		lod.Error = reader.Read<f32>();
+		if (firstIndex > indexCount || lodIndexCount > indexCount - firstIndex)
+			throw ResourceLoadFailedException();
+		lod.FirstIndex = static_cast<size_t>(firstIndex);
+		lod.IndexCount = static_cast<size_t>(lodIndexCount);
+		MeshData.Lods.PushBack(lod);
+	}
+
+	Bones.Resize(static_cast<size_t>(reader.Read<u64>()));
+	for (Bone& bone : Bones)
+		bone.name = reader.ReadString();
+
+	const size_t textureCount = static_cast<size_t>(reader.Read<u64>());
+	for (size_t i = 0; i < textureCount; ++i)
+	{
+		const eTextureUsageType usage = reader.Read<eTextureUsageType>();
+		Textures.PushBack(PendingTexture{ reader.ReadString(), usage, {} });
+	}
 }
 
 void MeshResource::SubMesh::LoadBones(aiMesh* mesh)
@@ -138,8 +386,9 @@ void MeshResource::SubMesh::LoadGeometry(aiMesh* mesh)
 		}
 	}
 
-	MeshProxy = gEngine->GetRenderingDevice()->CreateMesh();
-	MeshProxy->SetContent(MeshData);
+	// done once on import, cooked mesh keeps the optimized layout and levels of detail
+	MeshData.Optimize(true);
+	MeshData.GenerateLods(MAX_LOD_COUNT, MIN_LOD_TRIANGLE_COUNT);
 
 	gConsole.LogDebug(
 		"Loaded mesh entry: {} with {} vertices, {} faces and parameters: "
@@ -151,10 +400,8 @@ void MeshResource::SubMesh::LoadGeometry(aiMesh* mesh)
 		mesh->HasFaces() ? "on" : "off");
 }
 
-TextureResource* MeshResource::SubMesh::LoadTexture(const aiMaterial* material, const String& path, const unsigned int aiType, const eTextureUsageType textureType)
+void MeshResource::SubMesh::FindTexture(const aiMaterial* material, const String& path, const unsigned int aiType, const eTextureUsageType textureType)
 {
-	TextureResource* texture = nullptr;
-
 	aiTextureType type = (aiTextureType)aiType;
 	aiString texturePath;
 	if (material->GetTexture(type, 0, &texturePath) == AI_SUCCESS)
@@ -168,19 +415,11 @@ TextureResource* MeshResource::SubMesh::LoadTexture(const aiMaterial* material,
 		String textPath(fullPath.c_str());
 		// end temporary code for extracting path
 
-		texture = ResourceManager<TextureResource>::Load(textPath, eResourceSource::NONE, textureType);
-		if (!texture) {
-			gConsole.LogError("Failed to load texture: {}", textPath);
-		}
-		else {
-			gConsole.LogDebug("Succeded to load texture: {}", textPath);
-		}
+		Textures.PushBack(PendingTexture{ textPath, textureType, {} });
 	}
 	else {
 		gConsole.LogError("Failed to load texture for material: {}", path);
 	}
-
-	return texture;
 }
 
 Poly::MeshResource::Animation::Animation(aiAnimation * anim)
@@ -210,3 +449,31 @@ Poly::MeshResource::Animation::Animation(aiAnimation * anim)
 		channels.PushBack(std::move(c));
 	}
 }
+
+void MeshResource::Animation::SaveToCache(AssetCacheWriter& writer) const
+{
+	writer.Write(Duration);
+	writer.Write(TicksPerSecond);
+	writer.Write<u64>(channels.GetSize());
+	for (const Channel& channel : channels)
+	{
+		writer.WriteString(channel.Name);
+		writer.WriteArray(channel.Positions);
+		writer.WriteArray(channel.Rotations);
+		writer.WriteArray(channel.Scales);
+	}
+}
+
+void MeshResource::Animation::LoadFromCache(AssetCacheReader& reader)
+{
+	Duration = reader.Read<float>();
+	TicksPerSecond = reader.Read<float>();
+	channels.Resize(static_cast<size_t>(reader.Read<u64>()));
+	for (Channel& channel : channels)
+	{
+		channel.Name = reader.ReadString();
+		reader.ReadArray(channel.Positions);
+		reader.ReadArray(channel.Rotations);
+		reader.ReadArray(channel.Scales);
+	}
+}
\ No newline at end of file
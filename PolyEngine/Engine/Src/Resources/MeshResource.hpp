@@ -3,7 +3,10 @@
 #include <Defines.hpp>
 #include <Collections/Dynarray.hpp>
 #include <Collections/String.hpp>
+#include <Math/AABox.hpp>
 #include "Resources/ResourceBase.hpp"
+#include "Resources/AssetCache.hpp"
+#include "Resources/ResourceManager.hpp"
 #include "Resources/TextureResource.hpp"
 #include "Resources/Mesh.hpp"
 #include "Rendering/IRenderingDevice.hpp"
@@ -30,22 +33,44 @@ namespace Poly
 
 			void LoadGeometry(aiMesh* mesh);
 			void LoadBones(aiMesh* mesh);
-			TextureResource* LoadTexture(const aiMaterial* material, const String& path, const unsigned int aiType, const eTextureUsageType textureType);
 
 			const Mesh& GetMeshData() const { return MeshData; }
+			const Dynarray<Bone>& GetBones() const { return Bones; }
 			const IMeshDeviceProxy* GetMeshProxy() const { return MeshProxy.get(); }
 			const AABox& GetAABox() const { return AxisAlignedBoundingBox; }
 		private:
+			struct PendingTexture
+			{
+				String Path;
+				eTextureUsageType Usage;
+				ResourceLoadHandle<TextureResource> Handle;
+			};
+
+			SubMesh() = default;
+
+			void FindTexture(const aiMaterial* material, const String& path, const unsigned int aiType, const eTextureUsageType textureType);
+			void CreateDeviceProxies();
+			bool UpdateTextures();
+			void SaveToCache(AssetCacheWriter& writer) const;
+			void LoadFromCache(AssetCacheReader& reader);
+
 			AABox AxisAlignedBoundingBox;
 			Mesh MeshData;
 			Dynarray<Bone> Bones;
 			std::unique_ptr<IMeshDeviceProxy> MeshProxy;
+			Dynarray<PendingTexture> Textures;
+
+			friend class MeshResource;
 		};
 
 		struct ENGINE_DLLEXPORT Animation {
 
+			Animation() = default;
 			Animation(aiAnimation* anim);
 
+			void SaveToCache(AssetCacheWriter& writer) const;
+			void LoadFromCache(AssetCacheReader& reader);
+
 			struct ENGINE_DLLEXPORT Channel {
 
 				template<typename T>
@@ -65,16 +90,34 @@ namespace Poly
 			Dynarray<Channel> channels;
 		};
 
+		/// <summary>Extension appended to source path to get path of the cooked mesh.</summary>
+		static constexpr const char* COOKED_EXTENSION = ".polymesh";
+
 		MeshResource(const String& path);
+		explicit MeshResource(ResourceAsyncLoadTag) {}
 		virtual ~MeshResource();
 
 
 		const Dynarray<SubMesh*>& GetSubMeshes() const { return SubMeshes; }
 		const Dynarray<Animation*>& GetAnimations() const { return Animations; }
 		const AABox& GetAABox() const { return AxisAlignedBoundingBox; }
+	protected:
+		bool UpdateAsyncDependencies() override;
+
+		/// <summary>Loads cooked mesh if it is up to date, otherwise imports the source file and cooks it.</summary>
+		void Decode(const String& path);
+		/// <summary>Imports source file with Assimp.</summary>
+		void Import(const String& path);
+		bool LoadFromCache(const String& cachePath, u64 sourceHash);
+		void SaveToCache(const String& cachePath, u64 sourceHash) const;
+
 	private:
+		void CreateDeviceProxies();
+
 		Dynarray<Animation*> Animations;
 		Dynarray<SubMesh*> SubMeshes;
 		AABox AxisAlignedBoundingBox;
+
+		template<typename T> friend class ResourceManager;
 	};
 }
\ No newline at end of file
@@ -15,12 +15,31 @@ namespace Poly
 	};
 	UNSILENCE_MSVC_WARNING()
 
+	//------------------------------------------------------------------------------
+	enum class eResourceState
+	{
+		LOADING,	// queued by ResourceManager::LoadAsync, data is being decoded or device proxies are not created yet
+		READY,
+		FAILED,
+		_COUNT
+	};
+
+	/// <summary>Tag selecting resource constructor used by asynchronous loading.
+	/// Resource constructed with it has to provide two loading steps:
+	/// <c>Decode(absolutePath, args...)</c>, which reads and decodes the file on a worker thread without touching rendering or audio devices,
+	/// and <c>CreateDeviceProxies()</c>, which is called afterwards on the main thread.</summary>
+	/// <see cref="ResourceManager.LoadAsync()"/>
+	struct ResourceAsyncLoadTag final {};
+
 	//------------------------------------------------------------------------------
 	class ENGINE_DLLEXPORT ResourceBase : public RefCountedBase
 	{
 	public:
 		const String& GetPath() const { return Path; }
 
+		/// <summary>Returns loading state, resources created synchronously are always ready.</summary>
+		eResourceState GetState() const { return State.load(std::memory_order_acquire); }
+
 		ResourceBase() = default;
 		ResourceBase(const ResourceBase&) = delete;
 		ResourceBase& operator=(const ResourceBase&) = delete;
@@ -28,9 +47,16 @@ namespace Poly
 	protected:
 		virtual ~ResourceBase() {}
 
+		/// <summary>Called on the main thread after device proxies were created, until it returns true.
+		/// Resources that load other resources asynchronously stay in LOADING state until those finish.</summary>
+		/// <returns>True when all dependencies finished loading.</returns>
+		virtual bool UpdateAsyncDependencies() { return true; }
+
 	private:
 		String Path;
+		std::atomic<eResourceState> State{ eResourceState::READY };
 
 		template<typename T> friend class ResourceManager;
+		friend class AsyncResourceLoader;
 	};
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "Resources/ResourceManager.hpp"
 #include "Resources/MeshResource.hpp"
 #include "Resources/SoundResource.hpp"
+#include "Threading/JobSystem.hpp"
+#include "Engine.hpp"
 
 SILENCE_CLANG_WARNING(-Wparentheses-equality, "Surpressing clang warnings in stb_image") //@fixme(celeborth) if put in PCH it throws violation of ODR linker error
 #define STB_IMAGE_IMPLEMENTATION
@@ -16,6 +18,111 @@ DEFINE_RESOURCE(TextureResource, gTextureResourcesMap)
 DEFINE_RESOURCE(FontResource, gFontResourcesMap)
 DEFINE_RESOURCE(SoundResource, gALSoundResourcesMap)
 
+namespace
+{
+	struct AsyncLoad
+	{
+		ResourceBase* Resource = nullptr;
+		std::function<void()> Decode;
+		std::function<void()> CreateDeviceProxies;
+		bool Decoded = false;
+		bool DeviceProxiesCreated = false;
+	};
+
+	// Loads are owned by the jobs decoding them, then by the list of loads waiting for the main thread
+	std::mutex gDecodedLoadsMutex;
+	Dynarray<std::unique_ptr<AsyncLoad>> gDecodedLoads;
+	std::atomic<size_t> gPendingLoadCount{ 0 };
+	JobCounter gDecodeJobsCounter;
+}
+
+//------------------------------------------------------------------------------
+void AsyncResourceLoader::Submit(ResourceBase* resource, std::function<void()> decode, std::function<void()> createDeviceProxies)
+{
+	AsyncLoad* load = new AsyncLoad();
+	load->Resource = resource;
+	load->Decode = std::move(decode);
+	load->CreateDeviceProxies = std::move(createDeviceProxies);
+	++gPendingLoadCount;
+
+	GetJobSystem().Submit([load]() {
+		try
+		{
+			load->Decode();
+			load->Decoded = true;
+		}
+		catch (const ResourceLoadFailedException&) {}
+		catch (const std::exception&) { HEAVY_ASSERTE(false, "Resource decoding failed for unknown reason!"); }
+
+		std::lock_guard<std::mutex> lock(gDecodedLoadsMutex);
+		gDecodedLoads.PushBack(std::unique_ptr<AsyncLoad>(load));
+	}, gDecodeJobsCounter);
+}
+
+//------------------------------------------------------------------------------
+void AsyncResourceLoader::Update()
+{
+	Dynarray<std::unique_ptr<AsyncLoad>> loads;
+	{
+		std::lock_guard<std::mutex> lock(gDecodedLoadsMutex);
+		loads = std::move(gDecodedLoads);
+	}
+
+	// Creating device proxies may start new loads, so the list is not locked meanwhile
+	Dynarray<std::unique_ptr<AsyncLoad>> waiting;
+	for (std::unique_ptr<AsyncLoad>& load : loads)
+	{
+		ResourceBase* resource = load->Resource;
+		if (load->Decoded && !load->DeviceProxiesCreated)
+		{
+			try
+			{
+				load->CreateDeviceProxies();
+				load->DeviceProxiesCreated = true;
+			}
+			catch (const ResourceLoadFailedException&) {}
+		}
+
+		if (!load->DeviceProxiesCreated)
+		{
+			gConsole.LogError("Resource loading failed! {}", resource->GetPath());
+			resource->State.store(eResourceState::FAILED, std::memory_order_release);
+		}
+		else if (resource->UpdateAsyncDependencies())
+			resource->State.store(eResourceState::READY, std::memory_order_release);
+		else
+		{
+			waiting.PushBack(std::move(load));
+			continue;
+		}
+		--gPendingLoadCount;
+	}
+
+	if (!waiting.IsEmpty())
+	{
+		std::lock_guard<std::mutex> lock(gDecodedLoadsMutex);
+		for (std::unique_ptr<AsyncLoad>& load : waiting)
+			gDecodedLoads.PushBack(std::move(load));
+	}
+}
+
+//------------------------------------------------------------------------------
+void AsyncResourceLoader::Wait(const ResourceBase* resource)
+{
+	while (resource->GetState() == eResourceState::LOADING)
+	{
+		Update();
+		if (resource->GetState() == eResourceState::LOADING)
+			std::this_thread::yield();
+	}
+}
+
+//------------------------------------------------------------------------------
+size_t AsyncResourceLoader::GetPendingCount()
+{
+	return gPendingLoadCount.load();
+}
+
 String Poly::EvaluateFullResourcePath(eResourceSource Source, const String& path)
 {
 	return gAssetsPathConfig.GetAssetsPath(Source) + path;
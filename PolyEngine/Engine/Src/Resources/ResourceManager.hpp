@@ -50,6 +50,62 @@ namespace Poly
 	ENGINE_DECLARE_RESOURCE(FontResource, gFontResourcesMap)
 	ENGINE_DECLARE_RESOURCE(SoundResource, gALSoundResourcesMap)
 
+	/// <summary>Runs decoding step of asynchronous resource loads on job system workers
+	/// and finishes them on the main thread.</summary>
+	/// <see cref="ResourceManager.LoadAsync()"/>
+	class ENGINE_DLLEXPORT AsyncResourceLoader final
+	{
+	public:
+		/// <summary>Finishes loads whose data was decoded: creates device proxies and marks resources as ready or failed.
+		/// Called by the engine every frame, has to be called on the main thread.</summary>
+		static void Update();
+
+		/// <summary>Blocks until given resource stops loading, finishing other loads in the meantime. Main thread only.</summary>
+		static void Wait(const ResourceBase* resource);
+
+		/// <summary>Returns number of asynchronous loads that did not finish yet.</summary>
+		static size_t GetPendingCount();
+
+	private:
+		static void Submit(ResourceBase* resource, std::function<void()> decode, std::function<void()> createDeviceProxies);
+
+		template<typename T> friend class ResourceManager;
+	};
+
+	/// <summary>Future-like result of <see cref="ResourceManager.LoadAsync()"/>.
+	/// Handle holds a reference to the resource, which has to be released with ResourceManager::Release(),
+	/// same as a resource returned by ResourceManager::Load(), also when loading failed.</summary>
+	template<typename T>
+	class ResourceLoadHandle final : public BaseObjectLiteralType<>
+	{
+	public:
+		ResourceLoadHandle() = default;
+		explicit ResourceLoadHandle(T* resource) : Resource(resource) {}
+
+		/// <summary>Checks whether loading finished, successfully or not.</summary>
+		bool IsReady() const { return !Resource || Resource->GetState() != eResourceState::LOADING; }
+
+		bool HasFailed() const { return !Resource || Resource->GetState() == eResourceState::FAILED; }
+
+		/// <summary>Returns loaded resource or nullptr if it is still loading or loading failed.</summary>
+		T* Get() const { return Resource && Resource->GetState() == eResourceState::READY ? Resource : nullptr; }
+
+		/// <summary>Blocks until loading finishes. Main thread only.</summary>
+		/// <returns>Loaded resource or nullptr if loading failed.</returns>
+		T* Wait() const
+		{
+			if (Resource)
+				AsyncResourceLoader::Wait(Resource);
+			return Get();
+		}
+
+		/// <summary>Returns resource regardless of its state, for releasing it.</summary>
+		T* GetResource() const { return Resource; }
+
+	private:
+		T* Resource = nullptr;
+	};
+
 	template<typename T>
 	class ResourceManager
 	{
@@ -73,6 +129,12 @@ namespace Poly
 			if (it != Impl::GetResources<T>().end())
 			{
 				T* resource = it->second.get();
+				AsyncResourceLoader::Wait(resource);
+				if (resource->GetState() == eResourceState::FAILED)
+				{
+					gConsole.LogError("Resource loading failed! {}", path);
+					return nullptr;
+				}
 				resource->AddRef();
 				return resource;
 			}
@@ -105,14 +167,64 @@ namespace Poly
 			return resource;
 		}
 
+		/// <summary>Starts loading resource in the background. File is read and decoded on job system workers,
+		/// device proxies are created on the main thread in <see cref="AsyncResourceLoader.Update()"/>.
+		/// Loads of the same path share one resource. Resources not supporting asynchronous loading are loaded immediately.</summary>
+		/// <param name="path">Path relative to the assets directory of given source.</param>
+		/// <param name="source">Assets directory.</param>
+		/// <param name="args">Additional arguments of resource constructor.</param>
+		/// <returns>Handle to the resource, it has to be released even if loading fails.</returns>
+		template<typename... Args>
+		static ResourceLoadHandle<T> LoadAsync(const String& path, eResourceSource source, Args&&... args)
+		{
+			return LoadAsync(std::is_constructible<T, ResourceAsyncLoadTag>{}, path, source, std::forward<Args>(args)...);
+		}
+
 		static void Release(T* resource)
 		{
 			if (resource->RemoveRef())
 			{
+				// worker may still be decoding into it
+				AsyncResourceLoader::Wait(resource);
 				auto it = Impl::GetResources<T>().find(resource->GetPath());
 				HEAVY_ASSERTE(it != Impl::GetResources<T>().end(), "Resource creation failed!");
 				Impl::GetResources<T>().erase(it);
 			}
 		}
+
+	private:
+		template<typename... Args>
+		static ResourceLoadHandle<T> LoadAsync(std::false_type, const String& path, eResourceSource source, Args&&... args)
+		{
+			return ResourceLoadHandle<T>(Load(path, source, std::forward<Args>(args)...));
+		}
+
+		template<typename... Args>
+		static ResourceLoadHandle<T> LoadAsync(std::true_type, const String& path, eResourceSource source, Args&&... args)
+		{
+			// Pending loads are in the map as well, so concurrent requests for the same path share the resource
+			auto it = Impl::GetResources<T>().find(path);
+			if (it != Impl::GetResources<T>().end())
+			{
+				T* resource = it->second.get();
+				resource->AddRef();
+				return ResourceLoadHandle<T>(resource);
+			}
+
+			String absolutePath = gAssetsPathConfig.GetAssetsPath(source) + path;
+			gConsole.LogInfo("ResourceManager: Loading asynchronously: {}", absolutePath);
+
+			T* resource = new T(ResourceAsyncLoadTag{});
+			resource->Path = path;
+			resource->State.store(eResourceState::LOADING, std::memory_order_release);
+			resource->AddRef();
+			Impl::GetResources<T>().insert(std::make_pair(path, std::unique_ptr<T>(resource)));
+
+			auto decode = [resource, absolutePath, arguments = std::make_tuple(std::decay_t<Args>(std::forward<Args>(args))...)]() {
+				std::apply([resource, &absolutePath](const auto&... unpacked) { resource->Decode(absolutePath, unpacked...); }, arguments);
+			};
+			AsyncResourceLoader::Submit(resource, std::move(decode), [resource]() { resource->CreateDeviceProxies(); });
+			return ResourceLoadHandle<T>(resource);
+		}
 	};
 }
@@ -6,8 +6,12 @@ using namespace Poly;
 
 SoundResource::SoundResource(const String& path)
 {
-	alGenBuffers(1, &BufferID);
+	Decode(path);
+	CreateDeviceProxies();
+}
 
+void SoundResource::Decode(const String& path)
+{
 	// Declarations and loading file to buffer.
 
 	BinaryBuffer* data = LoadBinaryFile(path);
@@ -240,7 +244,7 @@ SoundResource::SoundResource(const String& path)
 		else gConsole.LogDebug("Error: Corrupt header during playback initialization.");
 
 		// TODO: loading chained sounds;
-		alBufferData(BufferID, AL_FORMAT_STEREO16, rawData.GetData(), (ALsizei)rawData.GetSize(), vorbisInfo.rate);
+		SampleRate = vorbisInfo.rate;
 
 		ogg_stream_clear(&streamState);
 		vorbis_comment_clear(&vorbisComment);
@@ -252,9 +256,18 @@ SoundResource::SoundResource(const String& path)
 	ogg_sync_clear(&syncState);
 
 	delete data;
+	Samples = std::move(rawData);
+}
+
+void SoundResource::CreateDeviceProxies()
+{
+	alGenBuffers(1, &BufferID);
+	alBufferData(BufferID, AL_FORMAT_STEREO16, Samples.GetData(), (ALsizei)Samples.GetSize(), (ALsizei)SampleRate);
+	Samples = Dynarray<char>();
 }
 
 SoundResource::~SoundResource()
 {
-	alDeleteBuffers(1, &BufferID);
+	if (BufferID != 0)
+		alDeleteBuffers(1, &BufferID);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
 #include "Resources/ResourceBase.hpp"
 
 namespace Poly 
@@ -20,12 +21,22 @@ namespace Poly
 	{
 	public:
 		SoundResource(const String& path);
+		explicit SoundResource(ResourceAsyncLoadTag) {}
 		~SoundResource();
 
 		unsigned int GetBufferID() const { return BufferID; }
 
 	private:
-		unsigned int BufferID;
+		void Decode(const String& path);
+		void CreateDeviceProxies();
+
+		unsigned int BufferID = 0;
+
+		// decoded samples kept until audio buffer is created
+		Dynarray<char> Samples;
+		long SampleRate = 0;
+
+		template<typename T> friend class ResourceManager;
 	};
 
 } // namespace Poly
@@ -0,0 +1,336 @@
+#include "EnginePCH.hpp"
+
+#include "Resources/TextureCooking.hpp"
+#include "Math/SimdMath.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	constexpr size_t BLOCK_SIZE = 4;
+
+	struct BlockPixels
+	{
+		u8 Values[BLOCK_SIZE * BLOCK_SIZE][4];
+	};
+
+	// Pixels outside of the image repeat the last row and column
+	void FetchBlock(const u8* src, size_t width, size_t height, size_t channels, size_t blockX, size_t blockY, BlockPixels& block)
+	{
+		for (size_t y = 0; y < BLOCK_SIZE; ++y)
+		{
+			const size_t srcY = std::min(blockY * BLOCK_SIZE + y, height - 1);
+			for (size_t x = 0; x < BLOCK_SIZE; ++x)
+			{
+				const size_t srcX = std::min(blockX * BLOCK_SIZE + x, width - 1);
+				const u8* pixel = src + (srcY * width + srcX) * channels;
+				u8* value = block.Values[y * BLOCK_SIZE + x];
+				value[0] = pixel[0];
+				value[1] = channels > 1 ? pixel[1] : pixel[0];
+				value[2] = channels > 2 ? pixel[2] : pixel[0];
+				value[3] = channels > 3 ? pixel[3] : 255;
+			}
+		}
+	}
+
+	u16 PackRGB565(const int color[3])
+	{
+		const int r = (color[0] * 31 + 127) / 255;
+		const int g = (color[1] * 63 + 127) / 255;
+		const int b = (color[2] * 31 + 127) / 255;
+		return static_cast<u16>((r << 11) | (g << 5) | b);
+	}
+
+	void UnpackRGB565(u16 packed, int color[3])
+	{
+		const int r = (packed >> 11) & 31;
+		const int g = (packed >> 5) & 63;
+		const int b = packed & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	void WriteLittleEndian(u8* dst, u64 value, size_t bytes)
+	{
+		for (size_t i = 0; i < bytes; ++i)
+			dst[i] = static_cast<u8>(value >> (8 * i));
+	}
+
+	// Endpoints are corners of the color bounding box, on the diagonal matching color distribution, inset to reduce error.
+	void CompressColorBlock(const BlockPixels& block, u8* dst)
+	{
+		int minColor[3] = { 255, 255, 255 };
+		int maxColor[3] = { 0, 0, 0 };
+		int mean[3] = { 0, 0, 0 };
+		for (const auto& pixel : block.Values)
+			for (size_t c = 0; c < 3; ++c)
+			{
+				minColor[c] = std::min<int>(minColor[c], pixel[c]);
+				maxColor[c] = std::max<int>(maxColor[c], pixel[c]);
+				mean[c] += pixel[c];
+			}
+		for (size_t c = 0; c < 3; ++c)
+			mean[c] /= BLOCK_SIZE * BLOCK_SIZE;
+
+		int covRG = 0, covBG = 0;
+		for (const auto& pixel : block.Values)
+		{
+			covRG += (pixel[0] - mean[0]) * (pixel[1] - mean[1]);
+			covBG += (pixel[2] - mean[2]) * (pixel[1] - mean[1]);
+		}
+		if (covRG < 0)
+			std::swap(minColor[0], maxColor[0]);
+		if (covBG < 0)
+			std::swap(minColor[2], maxColor[2]);
+
+		for (size_t c = 0; c < 3; ++c)
+		{
+			const int inset = (maxColor[c] - minColor[c]) / 16;
+			minColor[c] += inset;
+			maxColor[c] -= inset;
+		}
+
+		u16 c0 = PackRGB565(maxColor);
+		u16 c1 = PackRGB565(minColor);
+		if (c0 < c1)
+			std::swap(c0, c1);
+
+		u32 indices = 0;
+		if (c0 != c1)
+		{
+			int palette[4][3];
+			UnpackRGB565(c0, palette[0]);
+			UnpackRGB565(c1, palette[1]);
+			for (size_t c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+				palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+			}
+
+			for (size_t i = 0; i < BLOCK_SIZE * BLOCK_SIZE; ++i)
+			{
+				u32 best = 0;
+				int bestError = std::numeric_limits<int>::max();
+				for (u32 p = 0; p < 4; ++p)
+				{
+					int error = 0;
+					for (size_t c = 0; c < 3; ++c)
+					{
+						const int diff = block.Values[i][c] - palette[p][c];
+						error += diff * diff;
+					}
+					if (error < bestError)
+					{
+						bestError = error;
+						best = p;
+					}
+				}
+				indices |= best << (2 * i);
+			}
+		}
+
+		WriteLittleEndian(dst, c0, 2);
+		WriteLittleEndian(dst + 2, c1, 2);
+		WriteLittleEndian(dst + 4, indices, 4);
+	}
+
+	void CompressAlphaBlock(const BlockPixels& block, u8* dst)
+	{
+		int minAlpha = 255, maxAlpha = 0;
+		for (const auto& pixel : block.Values)
+		{
+			minAlpha = std::min<int>(minAlpha, pixel[3]);
+			maxAlpha = std::max<int>(maxAlpha, pixel[3]);
+		}
+
+		u64 indices = 0;
+		if (maxAlpha != minAlpha)
+		{
+			// 8 alpha values mode, alpha0 > alpha1
+			int palette[8] = { maxAlpha, minAlpha };
+			for (int p = 1; p < 7; ++p)
+				palette[p + 1] = ((7 - p) * maxAlpha + p * minAlpha) / 7;
+
+			for (size_t i = 0; i < BLOCK_SIZE * BLOCK_SIZE; ++i)
+			{
+				u64 best = 0;
+				int bestError = std::numeric_limits<int>::max();
+				for (u64 p = 0; p < 8; ++p)
+				{
+					const int error = std::abs(block.Values[i][3] - palette[p]);
+					if (error < bestError)
+					{
+						bestError = error;
+						best = p;
+					}
+				}
+				indices |= best << (3 * i);
+			}
+		}
+
+		dst[0] = static_cast<u8>(maxAlpha);
+		dst[1] = static_cast<u8>(minAlpha);
+		WriteLittleEndian(dst + 2, indices, 6);
+	}
+
+	template<typename T, typename Accumulator>
+	void DownsampleScalar(const T* src, size_t width, size_t height, size_t channels, T* dst, size_t fromX, size_t toX, size_t y)
+	{
+		const size_t dstWidth = std::max<size_t>(1, width / 2);
+		const size_t x0Offset = 0, x1Offset = width > 1 ? 1 : 0;
+		const T* row0 = src + (2 * y) * width * channels;
+		const T* row1 = height > 1 ? row0 + width * channels : row0;
+		for (size_t x = fromX; x < toX; ++x)
+			for (size_t c = 0; c < channels; ++c)
+			{
+				const size_t i0 = (2 * x + x0Offset) * channels + c;
+				const size_t i1 = (2 * x + x1Offset) * channels + c;
+				const Accumulator sum = Accumulator(row0[i0]) + Accumulator(row0[i1]) + Accumulator(row1[i0]) + Accumulator(row1[i1]);
+				dst[(y * dstWidth + x) * channels + c] = std::is_integral<T>::value ? T((sum + 2) / 4) : T(sum / 4);
+			}
+	}
+}
+
+//------------------------------------------------------------------------------
+size_t TextureCooking::GetMipCount(size_t width, size_t height)
+{
+	size_t count = 1;
+	for (size_t size = std::max(width, height); size > 1; size /= 2)
+		++count;
+	return count;
+}
+
+//------------------------------------------------------------------------------
+size_t TextureCooking::GetLevelSize(eTextureCompression compression, size_t width, size_t height, size_t channels, size_t channelSize)
+{
+	const size_t blocks = ((width + BLOCK_SIZE - 1) / BLOCK_SIZE) * ((height + BLOCK_SIZE - 1) / BLOCK_SIZE);
+	switch (compression)
+	{
+	case eTextureCompression::NONE:	return width * height * channels * channelSize;
+	case eTextureCompression::BC1:	return blocks * 8;
+	case eTextureCompression::BC3:	return blocks * 16;
+	default:
+		ASSERTE(false, "Unknown texture compression!");
+	}
+	return 0;
+}
+
+//------------------------------------------------------------------------------
+void TextureCooking::Downsample(const u8* src, size_t width, size_t height, size_t channels, u8* dst)
+{
+	const size_t dstWidth = std::max<size_t>(1, width / 2);
+	const size_t dstHeight = std::max<size_t>(1, height / 2);
+	for (size_t y = 0; y < dstHeight; ++y)
+	{
+		size_t x = 0;
+#if !DISABLE_SIMD
+		// two RGBA destination pixels per iteration, channels are summed as 16 bit integers
+		if (channels == 4 && width > 1 && height > 1)
+		{
+			const u8* row0 = src + (2 * y) * width * 4;
+			const u8* row1 = row0 + width * 4;
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i rounding = _mm_set1_epi16(2);
+			for (; x + 2 <= dstWidth; x += 2)
+			{
+				const __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+				const __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+				const __m128i sumLo = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+				const __m128i sumHi = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+				const __m128i pixel0 = _mm_add_epi16(sumLo, _mm_srli_si128(sumLo, 8));
+				const __m128i pixel1 = _mm_add_epi16(sumHi, _mm_srli_si128(sumHi, 8));
+				const __m128i avg = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(pixel0, pixel1), rounding), 2);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (y * dstWidth + x) * 4), _mm_packus_epi16(avg, zero));
+			}
+		}
+#endif
+		DownsampleScalar<u8, u32>(src, width, height, channels, dst, x, dstWidth, y);
+	}
+}
+
+//------------------------------------------------------------------------------
+void TextureCooking::Downsample(const float* src, size_t width, size_t height, size_t channels, float* dst)
+{
+	const size_t dstWidth = std::max<size_t>(1, width / 2);
+	const size_t dstHeight = std::max<size_t>(1, height / 2);
+	for (size_t y = 0; y < dstHeight; ++y)
+		DownsampleScalar<float, float>(src, width, height, channels, dst, 0, dstWidth, y);
+}
+
+//------------------------------------------------------------------------------
+void TextureCooking::CompressBC1(const u8* src, size_t width, size_t height, size_t channels, u8* dst)
+{
+	const size_t blocksX = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const size_t blocksY = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	BlockPixels block;
+	for (size_t by = 0; by < blocksY; ++by)
+		for (size_t bx = 0; bx < blocksX; ++bx)
+		{
+			FetchBlock(src, width, height, channels, bx, by, block);
+			CompressColorBlock(block, dst + (by * blocksX + bx) * 8);
+		}
+}
+
+//------------------------------------------------------------------------------
+void TextureCooking::CompressBC3(const u8* src, size_t width, size_t height, u8* dst)
+{
+	const size_t blocksX = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	const size_t blocksY = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	BlockPixels block;
+	for (size_t by = 0; by < blocksY; ++by)
+		for (size_t bx = 0; bx < blocksX; ++bx)
+		{
+			FetchBlock(src, width, height, 4, bx, by, block);
+			u8* blockDst = dst + (by * blocksX + bx) * 16;
+			CompressAlphaBlock(block, blockDst);
+			CompressColorBlock(block, blockDst + 8);
+		}
+}
+
+//------------------------------------------------------------------------------
+void TextureCooking::CookMipChain(const void* src, size_t width, size_t height, size_t channels, size_t channelSize,
+	eTextureCompression compression, Dynarray<Dynarray<u8>>& levels)
+{
+	ASSERTE(channelSize == 1 || channelSize == sizeof(float), "Unsupported channel size!");
+	ASSERTE(channelSize == 1 || compression == eTextureCompression::NONE, "Float textures cannot be compressed!");
+	ASSERTE(compression != eTextureCompression::BC3 || channels == 4, "BC3 requires RGBA data!");
+
+	const size_t mipCount = GetMipCount(width, height);
+	levels.Clear();
+	levels.Reserve(mipCount);
+
+	// uncompressed chain is built level from level, compressed levels are encoded from it
+	Dynarray<u8> current;
+	current.Resize(width * height * channels * channelSize);
+	memcpy(current.GetData(), src, current.GetSize());
+	Dynarray<u8> next;
+	for (size_t level = 0; level < mipCount; ++level)
+	{
+		Dynarray<u8> data;
+		data.Resize(GetLevelSize(compression, width, height, channels, channelSize));
+		switch (compression)
+		{
+		case eTextureCompression::NONE:	memcpy(data.GetData(), current.GetData(), data.GetSize()); break;
+		case eTextureCompression::BC1:	CompressBC1(current.GetData(), width, height, channels, data.GetData()); break;
+		case eTextureCompression::BC3:	CompressBC3(current.GetData(), width, height, data.GetData()); break;
+		default:
+			ASSERTE(false, "Unknown texture compression!");
+		}
+		levels.PushBack(std::move(data));
+
+		if (level + 1 == mipCount)
+			break;
+
+		const size_t nextWidth = std::max<size_t>(1, width / 2);
+		const size_t nextHeight = std::max<size_t>(1, height / 2);
+		next.Resize(nextWidth * nextHeight * channels * channelSize);
+		if (channelSize == 1)
+			Downsample(current.GetData(), width, height, channels, next.GetData());
+		else
+			Downsample(reinterpret_cast<const float*>(current.GetData()), width, height, channels, reinterpret_cast<float*>(next.GetData()));
+		std::swap(current, next);
+		width = nextWidth;
+		height = nextHeight;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Collections/Dynarray.hpp>
+#include "Rendering/IRenderingDevice.hpp"
+
+namespace Poly
+{
+	/// <summary>Offline processing of textures: mip chain generation and block compression.</summary>
+	namespace TextureCooking
+	{
+		/// <returns>Number of mip levels of full mip chain, down to 1x1.</returns>
+		ENGINE_DLLEXPORT size_t GetMipCount(size_t width, size_t height);
+
+		/// <returns>Size of a mip level in bytes.</returns>
+		ENGINE_DLLEXPORT size_t GetLevelSize(eTextureCompression compression, size_t width, size_t height, size_t channels, size_t channelSize);
+
+		/// <summary>Halves image resolution with 2x2 box filter. Odd last row and column are dropped.</summary>
+		/// <param name="dst">Output of max(1, width / 2) x max(1, height / 2) pixels.</param>
+		ENGINE_DLLEXPORT void Downsample(const u8* src, size_t width, size_t height, size_t channels, u8* dst);
+		ENGINE_DLLEXPORT void Downsample(const float* src, size_t width, size_t height, size_t channels, float* dst);
+
+		/// <summary>Compresses RGB or RGBA image to BC1 blocks, alpha is ignored.</summary>
+		ENGINE_DLLEXPORT void CompressBC1(const u8* src, size_t width, size_t height, size_t channels, u8* dst);
+
+		/// <summary>Compresses RGBA image to BC3 blocks.</summary>
+		ENGINE_DLLEXPORT void CompressBC3(const u8* src, size_t width, size_t height, u8* dst);
+
+		/// <summary>Builds full mip chain of the image and compresses every level.</summary>
+		/// <param name="channelSize">Size of single channel, 1 for u8 data and 4 for float data. Float data cannot be compressed.</param>
+		/// <param name="levels">Output, one array of bytes per mip level.</param>
+		ENGINE_DLLEXPORT void CookMipChain(const void* src, size_t width, size_t height, size_t channels, size_t channelSize,
+			eTextureCompression compression, Dynarray<Dynarray<u8>>& levels);
+	}
+}
@@ -2,11 +2,20 @@
 
 #include "Resources/TextureResource.hpp"
 #include "Resources/ResourceManager.hpp"
+#include "Resources/AssetCache.hpp"
+#include "Resources/TextureCooking.hpp"
 #include "Rendering/IRenderingDevice.hpp"
 #include "ECS/Scene.hpp"
+#include <Utils/FileIO.hpp>
 
 using namespace Poly;
 
+namespace
+{
+	constexpr u32 TEXTURE_CACHE_MAGIC = 0x52584554; // "TEXR"
+	constexpr u32 TEXTURE_CACHE_VERSION = 1;
+}
+
 static int GetDesiredChannel(eTextureUsageType usage) noexcept
 {
 	switch (usage)
@@ -29,34 +38,181 @@ static int GetDesiredChannel(eTextureUsageType usage) noexcept
 }
 
 TextureResource::TextureResource(const String& path, eTextureUsageType usage)
+{
+	Decode(path, usage);
+	CreateDeviceProxies();
+}
+
+TextureResource::TextureResource(ResourceAsyncLoadTag)
+{
+}
+
+TextureResource::~TextureResource()
+{
+}
+
+eTextureCompression TextureResource::GetTextureCompression(eTextureUsageType usage, const unsigned char* image, size_t width, size_t height, size_t channels)
+{
+	switch (usage)
+	{
+	case eTextureUsageType::ALBEDO:
+	case eTextureUsageType::EMISSIVE:
+		if (channels == 4)
+			for (size_t i = 0; i < width * height; ++i)
+				if (image[i * 4 + 3] != 255)
+					return eTextureCompression::BC3;
+		return eTextureCompression::BC1;
+	case eTextureUsageType::AMBIENT_OCCLUSION:
+	case eTextureUsageType::METALLIC:
+	case eTextureUsageType::ROUGHNESS:
+		return eTextureCompression::BC1;
+	default:
+		// normal maps would need two channel compression and normal reconstruction in shaders
+		return eTextureCompression::NONE;
+	}
+}
+
+void TextureResource::Decode(const String& path, eTextureUsageType usage)
 {
 	gConsole.LogInfo("TextureResource::TextureResource path: {} usage: {}", path, (int)usage);
+	Usage = usage;
+
+	std::unique_ptr<BinaryBuffer> source;
+	try
+	{
+		source.reset(LoadBinaryFile(path));
+	}
+	catch (const FileIOException&)
+	{
+		gConsole.LogError("TextureResource::TextureResource cannot open: {}", path);
+		throw ResourceLoadFailedException();
+	}
+	const u64 sourceHash = HashAssetSource(*source);
+	source.reset();
+
+	// Cooked texture has precomputed, compressed mip chain, it is refreshed when source content changes.
+	// Usage decides channels, color space and compression, so every usage of the image is cooked separately.
+	const String cachePath = GetAssetCachePath(path, COOKED_EXTENSION, static_cast<u64>(usage));
+	if (LoadCooked(cachePath, sourceHash))
+		return;
 
-	int desiredChannels = GetDesiredChannel(usage);
+	Cook(path, cachePath, sourceHash);
+}
 
-	if (usage == eTextureUsageType::HDR) 
+void TextureResource::Cook(const String& path, const String& cachePath, u64 sourceHash)
+{
+	const void* image = nullptr;
+	size_t channels = 0;
+	size_t channelSize = 0;
+	if (Usage == eTextureUsageType::HDR) 
 	{
-		float* Image = LoadImageHDR(path.GetCStr(), &Width, &Height, &Channels);
-	
+		float* imageHDR = LoadImageHDR(path.GetCStr(), &Width, &Height, &Channels);
 		gConsole.LogInfo("TextureResource::TextureResource loaded width: {}, height: {}, channels: {}", Width, Height, Channels);
-
-		TextureProxy = gEngine->GetRenderingDevice()->CreateTexture(Width, Height, desiredChannels, usage);
-		TextureProxy->SetContentHDR(Image);
-		FreeImageHDR(Image);
+		image = imageHDR;
+		channels = Channels;
+		channelSize = sizeof(float);
+		Compression = eTextureCompression::NONE;
 	}
 	else
 	{
-		unsigned char* Image = LoadImage(path.GetCStr(), &Width, &Height, &Channels, desiredChannels);
-
+		unsigned char* imageLDR = LoadImage(path.GetCStr(), &Width, &Height, &Channels, GetDesiredChannel(Usage));
 		gConsole.LogInfo("TextureResource::TextureResource loaded width: {}, height: {}, channels: {}, desiredChannels: {}",
-			Width, Height, Channels, desiredChannels);
+			Width, Height, Channels, GetDesiredChannel(Usage));
+		image = imageLDR;
+		channels = GetDesiredChannel(Usage);
+		channelSize = 1;
+		if (imageLDR)
+			Compression = GetTextureCompression(Usage, imageLDR, Width, Height, channels);
+	}
+
+	if (!image)
+		throw ResourceLoadFailedException();
 
-		TextureProxy = gEngine->GetRenderingDevice()->CreateTexture(Width, Height, desiredChannels, usage);
-		TextureProxy->SetContent(Image);
-		FreeImage(Image);
+	Dynarray<Dynarray<u8>> levels;
+	TextureCooking::CookMipChain(image, Width, Height, channels, channelSize, Compression, levels);
+	if (Usage == eTextureUsageType::HDR)
+		FreeImageHDR(const_cast<float*>(static_cast<const float*>(image)));
+	else
+		FreeImage(const_cast<unsigned char*>(static_cast<const unsigned char*>(image)));
+
+	AssetCacheWriter writer(TEXTURE_CACHE_MAGIC, TEXTURE_CACHE_VERSION, sourceHash);
+	writer.Write<u32>(Width);
+	writer.Write<u32>(Height);
+	writer.Write<u32>(Channels);
+	writer.Write(Compression);
+	writer.Write<u64>(levels.GetSize());
+	for (const Dynarray<u8>& level : levels)
+		writer.WriteArray(level);
+
+	// assets directory may be read only, texture is cooked again next time then
+	if (!writer.SaveToFile(cachePath))
+		gConsole.LogWarning("Failed to save cooked texture {}", cachePath);
+
+	// device proxy is created from cooked data, same as when it is loaded from file
+	CookedData.reset(new BinaryBuffer(writer.GetData().GetSize()));
+	memcpy(CookedData->GetData(), writer.GetData().GetData(), CookedData->GetSize());
+	AssetCacheReader reader(*CookedData);
+	ReadCooked(reader);
+}
+
+bool TextureResource::LoadCooked(const String& cachePath, u64 sourceHash)
+{
+	if (!FileExists(cachePath))
+		return false;
+
+	CookedData.reset(LoadBinaryFile(cachePath));
+	AssetCacheReader reader(*CookedData);
+	if (!reader.IsUpToDate(TEXTURE_CACHE_MAGIC, TEXTURE_CACHE_VERSION, sourceHash))
+	{
+		gConsole.LogInfo("Cooked texture {} is outdated.", cachePath);
+		CookedData.reset();
+		return false;
+	}
+
+	try
+	{
+		ReadCooked(reader);
+	}
+	catch (const ResourceLoadFailedException&)
+	{
+		gConsole.LogWarning("Cooked texture {} is corrupted.", cachePath);
+		CookedData.reset();
+		MipLevels.Clear();
+		return false;
 	}
+	return true;
 }
 
-TextureResource::~TextureResource()
+void TextureResource::ReadCooked(AssetCacheReader& reader)
+{
+	Width = reader.Read<u32>();
+	Height = reader.Read<u32>();
+	Channels = reader.Read<u32>();
+	Compression = reader.Read<eTextureCompression>();
+	const size_t channelSize = Usage == eTextureUsageType::HDR ? sizeof(float) : 1;
+	const size_t channels = Usage == eTextureUsageType::HDR ? Channels : GetDesiredChannel(Usage);
+
+	MipLevels.Resize(static_cast<size_t>(reader.Read<u64>()));
+	size_t width = Width;
+	size_t height = Height;
+	for (TextureMipLevel& level : MipLevels)
+	{
+		level.Width = width;
+		level.Height = height;
+		level.Data = reader.ReadArrayView<u8>(level.Size);
+		if (level.Size != TextureCooking::GetLevelSize(Compression, width, height, channels, channelSize))
+			throw ResourceLoadFailedException();
+		width = std::max<size_t>(1, width / 2);
+		height = std::max<size_t>(1, height / 2);
+	}
+	if (MipLevels.IsEmpty())
+		throw ResourceLoadFailedException();
+}
+
+void TextureResource::CreateDeviceProxies()
 {
+	TextureProxy = gEngine->GetRenderingDevice()->CreateTexture(Width, Height, GetDesiredChannel(Usage), Usage);
+	TextureProxy->SetContentMips(Compression, MipLevels);
+	MipLevels.Clear();
+	CookedData.reset();
 }
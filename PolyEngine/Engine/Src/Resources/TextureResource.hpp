@@ -1,19 +1,24 @@
 #pragma once
 
 #include <Defines.hpp>
+#include <Memory/BinaryBuffer.hpp>
 #include "Resources/ResourceBase.hpp"
+#include "Rendering/IRenderingDevice.hpp"
 
 typedef unsigned int GLuint;
 
-namespace Poly 
+namespace Poly
 {
-	class ITextureDeviceProxy;
-	enum class eTextureUsageType;
+	class AssetCacheReader;
 
 	class ENGINE_DLLEXPORT TextureResource : public ResourceBase
 	{
 	public:
+		/// <summary>Extension appended to source path to get path of the cooked texture.</summary>
+		static constexpr const char* COOKED_EXTENSION = ".polytex";
+
 		TextureResource(const String& path, eTextureUsageType textureUsageType);
+		explicit TextureResource(ResourceAsyncLoadTag);
 		~TextureResource() override;
 
 		int GetWidth() const { return Width; }
@@ -22,11 +27,31 @@ namespace Poly
 
 		const ITextureDeviceProxy* GetTextureProxy() const { return TextureProxy.get(); }
 
+		/// <summary>Returns compression used by the texture on the device, chosen when the texture is cooked.</summary>
+		eTextureCompression GetCompression() const { return Compression; }
+
+		/// <summary>Chooses block compression for image of given usage.</summary>
+		/// <param name="image">Image data, alpha of 4 channel images decides between BC1 and BC3.</param>
+		static eTextureCompression GetTextureCompression(eTextureUsageType usage, const unsigned char* image, size_t width, size_t height, size_t channels);
+
 	private:
+		void Decode(const String& path, eTextureUsageType textureUsageType);
+		void CreateDeviceProxies();
+		bool LoadCooked(const String& cachePath, u64 sourceHash);
+		void Cook(const String& path, const String& cachePath, u64 sourceHash);
+		void ReadCooked(AssetCacheReader& reader);
+
 		std::unique_ptr<ITextureDeviceProxy> TextureProxy;
 		int Width = 0;
 		int Height = 0;
 		int Channels = 0;
+		eTextureUsageType Usage = eTextureUsageType::_COUNT;
+		eTextureCompression Compression = eTextureCompression::NONE;
+
+		// cooked mip chain kept until device proxy is created, levels point into it
+		std::unique_ptr<BinaryBuffer> CookedData;
+		Dynarray<TextureMipLevel> MipLevels;
+
+		template<typename T> friend class ResourceManager;
 	};
 }
-
@@ -0,0 +1,79 @@
+#include "PolyRenderingDeviceNullPCH.hpp"
+
+#include "NullDeviceProxies.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	size_t GetTextureFormatSize(size_t channels, eTextureUsageType usage)
+	{
+		return channels * (usage == eTextureUsageType::HDR ? sizeof(float) : sizeof(unsigned char));
+	}
+}
+
+unsigned int Poly::GenNullResourceID()
+{
+	// 0 is reserved for invalid resource, like in OpenGL
+	static std::atomic<unsigned int> nextID(1);
+	return nextID.fetch_add(1, std::memory_order_relaxed);
+}
+
+NullTextureDeviceProxy::NullTextureDeviceProxy(size_t width, size_t height, size_t channels, eTextureUsageType usage)
+	: ResourceID(GenNullResourceID()), Width(width), Height(height), Channels(channels), Usage(usage)
+{
+	ASSERTE(width > 0 && height > 0, "Invalid arguments!");
+}
+
+void NullTextureDeviceProxy::SetContent(const unsigned char* data)
+{
+	ASSERTE(data, "Invalid texture data!");
+	MipCount = 1;
+	UploadedSize += Width * Height * GetTextureFormatSize(Channels, Usage);
+}
+
+void NullTextureDeviceProxy::SetContentHDR(const float* data)
+{
+	ASSERTE(data, "Invalid texture data!");
+	MipCount = 1;
+	UploadedSize += Width * Height * Channels * sizeof(float);
+}
+
+void NullTextureDeviceProxy::SetSubContent(size_t width, size_t height, size_t offsetX, size_t offsetY, const unsigned char* data)
+{
+	ASSERTE(offsetX + width <= Width && offsetY + height <= Height, "Sub content exceeds texture size!");
+	UploadedSize += width * height * GetTextureFormatSize(Channels, Usage);
+}
+
+void NullTextureDeviceProxy::SetContentMips(eTextureCompression compression, const Dynarray<TextureMipLevel>& levels)
+{
+	ASSERTE(!levels.IsEmpty() && levels[0].Width == Width && levels[0].Height == Height, "First mip level has to match texture size!");
+	MipCount = levels.GetSize();
+	for (const TextureMipLevel& level : levels)
+		UploadedSize += level.Size;
+}
+
+NullCubemapDeviceProxy::NullCubemapDeviceProxy(size_t width, size_t height)
+{
+	ASSERTE(width > 0 && height > 0, "Invalid arguments!");
+	for (eCubemapSide side : IterateEnum<eCubemapSide>())
+		Sides[side] = false;
+}
+
+void NullCubemapDeviceProxy::SetContentHDR(const eCubemapSide side, const float* data)
+{
+	ASSERTE(data, "Invalid cubemap data!");
+	Sides[side] = true;
+}
+
+void NullMeshDeviceProxy::SetContent(const Mesh& mesh)
+{
+	ASSERTE(mesh.HasVertices() && mesh.HasIndicies(), "Meshes that does not contain vertices and faces are not supported yet!");
+	VertexCount = mesh.GetVertexCount();
+	IndexCount = mesh.GetIndicies().GetSize();
+}
+
+void NullParticleDeviceProxy::SetContent(const ParticleEmitter& particles)
+{
+	InstanceCount = particles.GetInstancesCount();
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Rendering/IRenderingDevice.hpp>
+
+namespace Poly
+{
+	/// <summary>Returns next resource identifier, so proxies are distinguishable by GetResourceID like GL objects.</summary>
+	unsigned int GenNullResourceID();
+
+	/// <summary>Texture proxy remembering only size of uploaded data.</summary>
+	class NullTextureDeviceProxy : public ITextureDeviceProxy
+	{
+	public:
+		NullTextureDeviceProxy(size_t width, size_t height, size_t channels, eTextureUsageType usage);
+
+		void SetContent(const unsigned char* data) override;
+		void SetContentHDR(const float* data) override;
+		void SetSubContent(size_t width, size_t height, size_t offsetX, size_t offsetY, const unsigned char* data) override;
+		void SetContentMips(eTextureCompression compression, const Dynarray<TextureMipLevel>& levels) override;
+		unsigned int GetResourceID() const override { return ResourceID; }
+
+		size_t GetWidth() const { return Width; }
+		size_t GetHeight() const { return Height; }
+		eTextureUsageType GetUsage() const { return Usage; }
+		size_t GetMipCount() const { return MipCount; }
+		/// <summary>Returns number of bytes uploaded by all SetContent calls.</summary>
+		size_t GetUploadedSize() const { return UploadedSize; }
+
+	private:
+		unsigned int ResourceID;
+		size_t Width;
+		size_t Height;
+		size_t Channels;
+		eTextureUsageType Usage;
+		size_t MipCount = 0;
+		size_t UploadedSize = 0;
+	};
+
+	class NullCubemapDeviceProxy : public ICubemapDeviceProxy
+	{
+	public:
+		NullCubemapDeviceProxy(size_t width, size_t height);
+
+		void SetContentHDR(const eCubemapSide side, const float* data) override;
+
+		/// <summary>Returns whether content of given side was uploaded.</summary>
+		bool HasSide(eCubemapSide side) const { return Sides[side]; }
+
+	private:
+		EnumArray<bool, eCubemapSide> Sides;
+	};
+
+	class NullTextFieldBufferDeviceProxy : public ITextFieldBufferDeviceProxy
+	{
+	public:
+		NullTextFieldBufferDeviceProxy() : ResourceID(GenNullResourceID()) {}
+
+		void SetContent(size_t count, const TextFieldLetter* letters) override { LetterCount = count; }
+		unsigned int GetResourceID() const override { return ResourceID; }
+		unsigned int GetResourceSize() const override { return (unsigned int)LetterCount; }
+
+	private:
+		unsigned int ResourceID;
+		size_t LetterCount = 0;
+	};
+
+	/// <summary>Mesh proxy remembering vertex and index counts of uploaded mesh.</summary>
+	class NullMeshDeviceProxy : public IMeshDeviceProxy
+	{
+	public:
+		NullMeshDeviceProxy() : ResourceID(GenNullResourceID()) {}
+
+		void SetContent(const Mesh& mesh) override;
+		unsigned int GetResourceID() const override { return ResourceID; }
+
+		size_t GetVertexCount() const { return VertexCount; }
+		size_t GetIndexCount() const { return IndexCount; }
+
+	private:
+		unsigned int ResourceID;
+		size_t VertexCount = 0;
+		size_t IndexCount = 0;
+	};
+
+	class NullParticleDeviceProxy : public IParticleDeviceProxy
+	{
+	public:
+		void SetContent(const ParticleEmitter& particles) override;
+
+		/// <summary>Returns number of particle instances in last update.</summary>
+		size_t GetInstanceCount() const { return InstanceCount; }
+
+	private:
+		size_t InstanceCount = 0;
+	};
+}
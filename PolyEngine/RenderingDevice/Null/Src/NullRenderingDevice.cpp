@@ -0,0 +1,72 @@
+#include "PolyRenderingDeviceNullPCH.hpp"
+
+#include "NullRenderingDevice.hpp"
+#include "NullDeviceProxies.hpp"
+
+using namespace Poly;
+
+IRenderingDevice* POLY_STDCALL PolyCreateRenderingDevice(SDL_Window* window, const Poly::ScreenSize& size) { return new NullRenderingDevice(size); }
+
+NullRenderingDevice::NullRenderingDevice(const ScreenSize& size)
+	: ScreenDim(size)
+{
+}
+
+void NullRenderingDevice::Init()
+{
+	gConsole.LogInfo("NullRenderingDevice::Init {}x{}", ScreenDim.Width, ScreenDim.Height);
+}
+
+void NullRenderingDevice::RenderWorld(Scene* world)
+{
+	Stats = RenderingStats();
+
+	// Bounds are shared by all viewports
+	Culler.GatherMeshes(world);
+
+	// dedicated servers may never assign cameras to viewports
+	for (auto& kv : world->GetWorldComponent<ViewportWorldComponent>()->GetViewports())
+	{
+		if (!kv.second.GetCamera())
+			continue;
+
+		SceneView sceneView(world, kv.second);
+		sceneView.Fill(Culler, GetDirShadowVolume(), Stats);
+		Queues.Fill(sceneView, Stats);
+
+		// every batch would be one instanced draw
+		for (const RenderQueue* queue : { &Queues.GetDirShadowQueue(), &Queues.GetDepthPrePassQueue(), &Queues.GetOpaqueLitQueue() })
+			for (const RenderQueue::Batch& batch : queue->GetBatches())
+			{
+				const RenderQueue::Command& cmd = queue->GetCommands()[batch.First];
+				AddDrawStats(cmd.MeshCmp, cmd.SubMeshIdx, batch.Count, Stats);
+			}
+	}
+
+	++FrameCount;
+}
+
+std::unique_ptr<ITextureDeviceProxy> NullRenderingDevice::CreateTexture(size_t width, size_t height, size_t channels, eTextureUsageType usage)
+{
+	return std::make_unique<NullTextureDeviceProxy>(width, height, channels, usage);
+}
+
+std::unique_ptr<ICubemapDeviceProxy> NullRenderingDevice::CreateCubemap(size_t width, size_t height)
+{
+	return std::make_unique<NullCubemapDeviceProxy>(width, height);
+}
+
+std::unique_ptr<ITextFieldBufferDeviceProxy> NullRenderingDevice::CreateTextFieldBuffer()
+{
+	return std::make_unique<NullTextFieldBufferDeviceProxy>();
+}
+
+std::unique_ptr<IMeshDeviceProxy> NullRenderingDevice::CreateMesh()
+{
+	return std::make_unique<NullMeshDeviceProxy>();
+}
+
+std::unique_ptr<IParticleDeviceProxy> NullRenderingDevice::CreateParticle()
+{
+	return std::make_unique<NullParticleDeviceProxy>();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Defines.hpp>
+#include <Rendering/IRenderingDevice.hpp>
+#include <Rendering/SceneView.hpp>
+#include <Rendering/VisibilityCuller.hpp>
+
+struct SDL_Window;
+
+namespace Poly
+{
+	class Scene;
+
+	/// <summary>
+	/// Rendering device which needs no window nor graphics context, for dedicated servers, soak tests and headless benchmarks.
+	/// Proxies keep only what was uploaded to them on CPU side. Every frame the device fills scene views and render queues
+	/// with the same code as GLRenderingDevice, and fills rendering stats accordingly, but submits nothing.
+	/// </summary>
+	class DEVICE_DLLEXPORT NullRenderingDevice : public IRenderingDevice
+	{
+	public:
+		explicit NullRenderingDevice(const ScreenSize& size);
+
+		NullRenderingDevice(const NullRenderingDevice&) = delete;
+		void operator=(const NullRenderingDevice&) = delete;
+
+		void Init() override;
+		void Resize(const ScreenSize& size) override { ScreenDim = size; }
+		void RenderWorld(Scene* world) override;
+		const ScreenSize& GetScreenSize() const override { return ScreenDim; }
+
+		std::unique_ptr<ITextureDeviceProxy> CreateTexture(size_t width, size_t height, size_t channels, eTextureUsageType usage) override;
+		std::unique_ptr<ICubemapDeviceProxy> CreateCubemap(size_t width, size_t height) override;
+		std::unique_ptr<ITextFieldBufferDeviceProxy> CreateTextFieldBuffer() override;
+		std::unique_ptr<IMeshDeviceProxy> CreateMesh() override;
+		std::unique_ptr<IParticleDeviceProxy> CreateParticle() override;
+
+		/// <summary>Returns number of frames rendered since creation.</summary>
+		size_t GetFrameCount() const { return FrameCount; }
+
+		/// <summary>Returns render queues built for the last rendered viewport.</summary>
+		const SceneRenderQueues& GetRenderQueues() const { return Queues; }
+
+	private:
+		ScreenSize ScreenDim;
+		size_t FrameCount = 0;
+
+		VisibilityCuller Culler;
+		SceneRenderQueues Queues;
+	};
+}
+
+extern "C"
+{
+	/// <summary>Creates null rendering device. Window is ignored and may be null.</summary>
+	DEVICE_DLLEXPORT Poly::IRenderingDevice* POLY_STDCALL PolyCreateRenderingDevice(SDL_Window* window, const Poly::ScreenSize& size);
+}
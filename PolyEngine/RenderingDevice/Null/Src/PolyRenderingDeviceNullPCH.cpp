@@ -0,0 +1 @@
+#include "PolyRenderingDeviceNullPCH.hpp"
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+
+// Core
+#include <Defines.hpp>
+#include <RTTI/RTTI.hpp>
+
+// Math
+#include <Math/BasicMath.hpp>
+#include <Math/Vector.hpp>
+#include <Math/Matrix.hpp>
+#include <Math/AABox.hpp>
+
+// Memory
+#include <BaseObject.hpp>
+#include <Memory/Allocator.hpp>
+#include <Memory/FrameAllocator.hpp>
+
+// Containers
+#include <Collections/Dynarray.hpp>
+
+// Other
+#include <Utils/Logger.hpp>
+#include <Utils/Optional.hpp>
+
+// ECS
+#include <ECS/Scene.hpp>
+#include <ECS/Entity.hpp>
+#include <ECS/EntityTransform.hpp>
+
+// Rendering
+#include <Rendering/Camera/CameraComponent.hpp>
+#include <Rendering/Viewport.hpp>
+#include <Rendering/ViewportWorldComponent.hpp>
+#include <Rendering/Particles/ParticleEmitter.hpp>
+#include <Rendering/Lighting/LightSourceComponent.hpp>
+#include <Rendering/MeshRenderingComponent.hpp>
+#include <Rendering/IRenderingDevice.hpp>
+#include <Rendering/SceneView.hpp>
+#include <Rendering/VisibilityCuller.hpp>
+
+// Resources
+#include <Resources/MeshResource.hpp>
@@ -1,21 +1,54 @@
 #include "PolyRenderingDeviceGLPCH.hpp"
 
 #include "Common/DebugRenderingBuffers.hpp"
+#include "Common/GLStreamingBuffer.hpp"
+#include "GLRenderingDevice.hpp"
+
+using namespace Poly;
 
 Poly::DebugRenderingBuffers::DebugRenderingBuffers()
 {
-	// create VAO and VBOs
+	// create VAO, vertex data comes from streaming buffer: positions followed by colors
 	glGenVertexArrays(1, &VAO);
 	ASSERTE(VAO > 0, "DebugRenderingBuffers VAO creation failed!");
 
-	glGenBuffers(1, &VBO);
-	ASSERTE(VBO > 0, "DebugRenderingBuffers VBO creation failed!");
+	glBindVertexArray(VAO);
+	glVertexAttribFormat(0, 3, GL_FLOAT, GL_FALSE, 0);
+	glVertexAttribBinding(0, 0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribFormat(1, 4, GL_FLOAT, GL_FALSE, 0);
+	glVertexAttribBinding(1, 1);
+	glEnableVertexAttribArray(1);
+	glBindVertexArray(0);
+	CHECK_GL_ERR();
 }
 
 Poly::DebugRenderingBuffers::~DebugRenderingBuffers()
 {
-	if (VBO)
-		glDeleteBuffers(1, &VBO);
 	if (VAO)
 		glDeleteVertexArrays(1, &VAO);
 }
+
+GLsizei Poly::DebugRenderingBuffers::SetContent(const DebugDrawStateWorldComponent& debugDraw)
+{
+	const Dynarray<DebugDrawStateWorldComponent::DebugLine>& debugLines = debugDraw.DebugLines;
+	const Dynarray<DebugDrawStateWorldComponent::DebugLineColor>& debugLinesColors = debugDraw.DebugLinesColors;
+	if (debugLines.IsEmpty())
+		return 0;
+
+	const size_t linesSize = debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine);
+	const size_t colorsSize = debugLinesColors.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLineColor);
+
+	GLStreamingBuffer& streamingBuffer = gRenderingDevice->GetStreamingBuffer();
+	const GLStreamingAllocation allocation = streamingBuffer.Map(linesSize + colorsSize);
+	memcpy(allocation.Data, debugLines.GetData(), linesSize);
+	memcpy(static_cast<char*>(allocation.Data) + linesSize, debugLinesColors.GetData(), colorsSize);
+	streamingBuffer.Unmap(allocation);
+
+	glBindVertexArray(VAO);
+	glBindVertexBuffer(0, allocation.Buffer, (GLintptr)allocation.Offset, sizeof(Vector3f));
+	glBindVertexBuffer(1, allocation.Buffer, (GLintptr)(allocation.Offset + linesSize), sizeof(Color));
+	glBindVertexArray(0);
+
+	return (GLsizei)debugLines.GetSize() * 2;
+}
@@ -5,12 +5,17 @@
 
 namespace Poly
 {
+	class DebugDrawStateWorldComponent;
+
 	struct DebugRenderingBuffers : public BaseObject<>
 	{
 		DebugRenderingBuffers();
 		~DebugRenderingBuffers();
 
+		/// <summary>Writes lines of debug draw component to streaming buffer and points VAO at them.</summary>
+		/// <returns>Number of vertices to draw.</returns>
+		GLsizei SetContent(const DebugDrawStateWorldComponent& debugDraw);
+
 		GLuint VAO = 0;
-		GLuint VBO = 0;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,160 @@
+#include "PolyRenderingDeviceGLPCH.hpp"
+
+#include "Common/GLStreamingBuffer.hpp"
+
+using namespace Poly;
+
+namespace
+{
+	size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+}
+
+GLStreamingBuffer::GLStreamingBuffer(size_t frameSize)
+{
+	Persistent = epoxy_gl_version() >= 44 || epoxy_has_gl_extension("GL_ARB_buffer_storage");
+
+	// allocations may be bound as uniform or shader storage buffer ranges
+	GLint uniformAlignment = 0;
+	GLint storageAlignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+	glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+	Alignment = std::max<size_t>({ Alignment, (size_t)uniformAlignment, (size_t)storageAlignment });
+
+	FrameSize = AlignUp(frameSize, Alignment);
+	CreateBuffer();
+
+	gConsole.LogInfo("GLStreamingBuffer: {} KB per frame, {}", FrameSize / 1024, Persistent ? "persistent mapping" : "orphaning");
+}
+
+GLStreamingBuffer::~GLStreamingBuffer()
+{
+	DeleteBuffer();
+	for (GLuint retired : RetiredBuffers)
+		glDeleteBuffers(1, &retired);
+}
+
+void GLStreamingBuffer::CreateBuffer()
+{
+	const GLsizeiptr size = (GLsizeiptr)(FrameSize * FRAME_COUNT);
+
+	glGenBuffers(1, &Buffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, Buffer);
+	if (Persistent)
+	{
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+		PersistentData = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+		ASSERTE(PersistentData, "Streaming buffer mapping failed!");
+	}
+	else
+	{
+		glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	}
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	CHECK_GL_ERR();
+}
+
+void GLStreamingBuffer::DeleteBuffer()
+{
+	for (GLsync& fence : Fences)
+	{
+		if (fence)
+			glDeleteSync(fence);
+		fence = nullptr;
+	}
+
+	// persistent mapping is released together with the buffer
+	if (Buffer)
+		glDeleteBuffers(1, &Buffer);
+	Buffer = 0;
+	PersistentData = nullptr;
+}
+
+GLStreamingAllocation GLStreamingBuffer::Map(size_t size)
+{
+	HEAVY_ASSERTE(size > 0, "Mapping empty streaming buffer range!");
+	HEAVY_ASSERTE(!Mapped, "Previous streaming buffer allocation was not unmapped!");
+
+	size_t offset = AlignUp(Head, Alignment);
+	if (offset + size > FrameSize)
+	{
+		// region of the frame is full, earlier allocations stay in the old buffer until the frame ends
+		RetiredBuffers.PushBack(Buffer);
+		Buffer = 0;
+		DeleteBuffer();
+		FrameSize = AlignUp(std::max(FrameSize * 2, size), Alignment);
+		CreateBuffer();
+		gConsole.LogInfo("GLStreamingBuffer: enlarged to {} KB per frame", FrameSize / 1024);
+		offset = 0;
+	}
+	Head = offset + size;
+
+	GLStreamingAllocation allocation;
+	allocation.Buffer = Buffer;
+	allocation.Offset = FrameIdx * FrameSize + offset;
+	if (Persistent)
+	{
+		allocation.Data = PersistentData + allocation.Offset;
+	}
+	else
+	{
+		// range is written once between orphanings, so the GPU never reads it
+		glBindBuffer(GL_COPY_WRITE_BUFFER, Buffer);
+		allocation.Data = glMapBufferRange(GL_COPY_WRITE_BUFFER, (GLintptr)allocation.Offset, (GLsizeiptr)size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		ASSERTE(allocation.Data, "Streaming buffer mapping failed!");
+		Mapped = true;
+	}
+	return allocation;
+}
+
+void GLStreamingBuffer::Unmap(const GLStreamingAllocation& allocation)
+{
+	if (Persistent)
+		return;
+
+	HEAVY_ASSERTE(Mapped && allocation.Buffer == Buffer, "Unmapping allocation which is not mapped!");
+	glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.Buffer);
+	glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	Mapped = false;
+}
+
+void GLStreamingBuffer::EndFrame()
+{
+	HEAVY_ASSERTE(!Mapped, "Streaming buffer allocation was not unmapped!");
+
+	if (Persistent)
+		Fences[FrameIdx] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	// deletion is deferred by the driver until commands using the buffers complete
+	for (GLuint retired : RetiredBuffers)
+		glDeleteBuffers(1, &retired);
+	RetiredBuffers.Clear();
+
+	FrameIdx = (FrameIdx + 1) % FRAME_COUNT;
+	Head = 0;
+
+	if (Persistent)
+	{
+		GLsync& fence = Fences[FrameIdx];
+		if (fence)
+		{
+			// GPU is normally two frames behind at most, so this only waits when it falls further behind
+			GLenum result = GL_TIMEOUT_EXPIRED;
+			while (result == GL_TIMEOUT_EXPIRED)
+				result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+			ASSERTE(result != GL_WAIT_FAILED, "Waiting for streaming buffer fence failed!");
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+	else if (FrameIdx == 0)
+	{
+		// ring wrapped, orphaned storage is released when GPU is done with it
+		glBindBuffer(GL_COPY_WRITE_BUFFER, Buffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)(FrameSize * FRAME_COUNT), nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+}
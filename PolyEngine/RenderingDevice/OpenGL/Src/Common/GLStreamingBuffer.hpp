@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Defines.hpp>
+#include "Common/GLUtils.hpp"
+
+namespace Poly
+{
+	/// <summary>Part of streaming buffer returned by GLStreamingBuffer::Map.</summary>
+	struct GLStreamingAllocation
+	{
+		GLuint Buffer = 0;
+		size_t Offset = 0;
+		void* Data = nullptr;
+	};
+
+	/// <summary>
+	/// Ring buffer for data written by CPU every frame (lights, particle instances, debug lines, text staging).
+	/// Buffer is split into three frame regions, each guarded by a fence, so CPU writes one frame
+	/// while GPU still reads previous ones. With ARB_buffer_storage the buffer stays persistently mapped,
+	/// older contexts orphan the buffer whenever the ring wraps and map ranges unsynchronized.
+	/// Allocations are valid until the end of the frame; data drawn in later frames has to be copied out.
+	/// </summary>
+	class GLStreamingBuffer : public BaseObject<>
+	{
+	public:
+		explicit GLStreamingBuffer(size_t frameSize);
+		~GLStreamingBuffer();
+
+		GLStreamingBuffer(const GLStreamingBuffer&) = delete;
+		void operator=(const GLStreamingBuffer&) = delete;
+
+		/// <summary>Allocates memory for current frame, aligned for any buffer binding.
+		/// Must be followed by Unmap before next Map.</summary>
+		/// <param name="size">Size of the allocation in bytes, greater than 0.</param>
+		GLStreamingAllocation Map(size_t size);
+
+		/// <summary>Finishes writes to allocation returned by last Map.</summary>
+		void Unmap(const GLStreamingAllocation& allocation);
+
+		/// <summary>Fences commands of current frame and moves to next frame region, waiting until GPU is done with it.</summary>
+		void EndFrame();
+
+		bool IsPersistentlyMapped() const { return Persistent; }
+
+	private:
+		static constexpr size_t FRAME_COUNT = 3;
+
+		void CreateBuffer();
+		void DeleteBuffer();
+
+		bool Persistent = false;
+		size_t Alignment = 16;
+		size_t FrameSize = 0;
+		size_t FrameIdx = 0;
+		size_t Head = 0;
+		bool Mapped = false;
+
+		GLuint Buffer = 0;
+		char* PersistentData = nullptr;
+		std::array<GLsync, FRAME_COUNT> Fences{};
+
+		// buffers replaced by bigger ones during the frame, allocations made from them are used until its end
+		Dynarray<GLuint> RetiredBuffers;
+	};
+}
@@ -5,6 +5,7 @@
 #include "Common/GLUtils.hpp"
 #include "Common/PrimitiveQuad.hpp"
 #include "Common/PrimitiveCube.hpp"
+#include "Common/GLStreamingBuffer.hpp"
 
 #include "Proxy/GLTextureDeviceProxy.hpp"
 #include "Proxy/GLCubemapDeviceProxy.hpp"
@@ -51,6 +52,25 @@ GLRenderingDevice::GLRenderingDevice(SDL_Window* window, const Poly::ScreenSize&
 	gConsole.LogInfo("GLSL Version: {}", glGetString(GL_SHADING_LANGUAGE_VERSION));
 	gConsole.LogInfo("Fitting renderer (0 - Fallback, 1 - Highend): {}", (int)RendererType);
 
+	// shader programs created by renderers compile on driver threads, statuses are queried on first use
+	if (epoxy_has_gl_extension("GL_ARB_parallel_shader_compile"))
+	{
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+		gConsole.LogInfo("Parallel shader compilation enabled");
+	}
+	else if (epoxy_has_gl_extension("GL_KHR_parallel_shader_compile"))
+	{
+		using MaxShaderCompilerThreadsFunc = decltype(epoxy_glMaxShaderCompilerThreadsARB);
+		const MaxShaderCompilerThreadsFunc maxShaderCompilerThreads = reinterpret_cast<MaxShaderCompilerThreadsFunc>(SDL_GL_GetProcAddress("glMaxShaderCompilerThreadsKHR"));
+		if (maxShaderCompilerThreads)
+		{
+			maxShaderCompilerThreads(0xFFFFFFFF);
+			gConsole.LogInfo("Parallel shader compilation enabled");
+		}
+		else
+			gConsole.LogWarning("GL_KHR_parallel_shader_compile advertised without glMaxShaderCompilerThreadsKHR");
+	}
+
 	// Setup V-Sync
 	SDL_GL_SetSwapInterval(1);
 }
@@ -97,6 +117,8 @@ GLRenderingDevice::~GLRenderingDevice()
 
 void GLRenderingDevice::EndFrame()
 {
+	StreamingBuffer->EndFrame();
+
 	if(Window && Context)
 		SDL_GL_SwapWindow(Window);
 }
@@ -195,6 +217,7 @@ void Poly::GLRenderingDevice::CleanUpResources()
 
 	PrimitivesQuad.reset();
 	PrimitivesCube.reset();
+	StreamingBuffer.reset();
 }
 
 
@@ -3,6 +3,7 @@
 #include <Defines.hpp>
 #include "Common/GLUtils.hpp"
 #include "Proxy/GLShaderProgram.hpp"
+#include <Rendering/VisibilityCuller.hpp>
 
 struct SDL_Window;
 
@@ -11,6 +12,7 @@ namespace Poly
 	struct PrimitiveQuad;
 	struct PrimitiveCube;
 	struct SceneView;
+	class GLStreamingBuffer;
 	class CameraComponent;
 	class AARect;
 	class Scene;
@@ -89,6 +91,9 @@ namespace Poly
 		std::unique_ptr<IMeshDeviceProxy> CreateMesh() override;
 		std::unique_ptr<IParticleDeviceProxy> CreateParticle() override;
 
+		/// <summary>Returns ring buffer for data uploaded every frame, see <see cref="GLStreamingBuffer"/>.</summary>
+		GLStreamingBuffer& GetStreamingBuffer() const { return *StreamingBuffer; }
+
 		std::unique_ptr<PrimitiveQuad> PrimitivesQuad;
 		std::unique_ptr<PrimitiveCube> PrimitivesCube;
 
@@ -102,7 +107,6 @@ namespace Poly
 		IRendererInterface* CreateRenderer();
 		void CreateUtilityTextures();
 
-		void FillSceneView(SceneView& sceneView);
 		void EndFrame();
 
 		void CleanUpResources();
@@ -131,6 +135,8 @@ namespace Poly
 
 		eRendererType RendererType;
 		IRendererInterface* Renderer;
+		VisibilityCuller Culler;
+		std::unique_ptr<GLStreamingBuffer> StreamingBuffer;
 
 		EnumArray<std::unique_ptr<RenderingPassBase>, eGeometryRenderPassType> GeometryRenderingPasses;
 		EnumArray<std::unique_ptr<RenderingPassBase>, ePostprocessRenderPassType> PostprocessRenderingPasses;
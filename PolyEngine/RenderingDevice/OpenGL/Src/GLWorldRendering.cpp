@@ -9,6 +9,7 @@
 #include "Common/GLUtils.hpp"
 #include "Common/PrimitiveCube.hpp"
 #include "Common/PrimitiveQuad.hpp"
+#include "Common/GLStreamingBuffer.hpp"
 
 #include "ForwardRenderer.hpp"
 #include "TiledForwardRenderer.hpp"
@@ -23,6 +24,8 @@ void GLRenderingDevice::Init()
 	
 	PrimitivesQuad = std::make_unique<PrimitiveQuad>();
 	PrimitivesCube = std::make_unique<PrimitiveCube>();
+	// 1 MB per frame fits light buffer and typical particles and debug draws, it grows when exceeded
+	StreamingBuffer = std::make_unique<GLStreamingBuffer>(1 << 20);
 
 	CreateUtilityTextures();
 
@@ -53,12 +56,17 @@ IRendererInterface* GLRenderingDevice::CreateRenderer()
 
 void GLRenderingDevice::RenderWorld(Scene* world)
 {
+	Stats = RenderingStats();
+
+	// Bounds are shared by all viewports
+	Culler.GatherMeshes(world);
+
 	// For each visible viewport draw it
 	for (auto& kv : world->GetWorldComponent<ViewportWorldComponent>()->GetViewports())
 	{
 		SceneView sceneView(world, kv.second);
 		
-		FillSceneView(sceneView);
+		sceneView.Fill(Culler, Renderer->GetDirShadowVolume(), Stats);
 
 		Renderer->Render(sceneView);
 	}
@@ -67,40 +75,6 @@ void GLRenderingDevice::RenderWorld(Scene* world)
 	EndFrame();
 }
 
-void GLRenderingDevice::FillSceneView(SceneView& sceneView)
-{
-	for (const auto componentsTuple : sceneView.WorldData->IterateComponents<MeshRenderingComponent>())
-	{
-		const MeshRenderingComponent* meshCmp = std::get<MeshRenderingComponent*>(componentsTuple);
-
-		if (sceneView.CameraCmp->IsVisibleToCamera(meshCmp->GetOwner()))
-		{
-			if (meshCmp->GetBlendingMode() == eBlendingMode::OPAUQE)
-			{
-				sceneView.OpaqueQueue.PushBack(meshCmp);
-			}
-			else if (meshCmp->GetBlendingMode() == eBlendingMode::TRANSLUCENT)
-			{
-				sceneView.TranslucentQueue.PushBack(meshCmp);
-			}
-		}
-		else
-		{
-			sceneView.DirShadowOpaqueQueue.PushBack(meshCmp);
-		}
-	}
-
-	for (const auto componentsTuple : sceneView.WorldData->IterateComponents<DirectionalLightComponent>())
-	{
-		sceneView.DirectionalLights.PushBack(std::get<DirectionalLightComponent*>(componentsTuple));
-	}
-
-	for (const auto componentsTuple : sceneView.WorldData->IterateComponents<PointLightComponent>())
-	{
-		sceneView.PointLights.PushBack(std::get<PointLightComponent*>(componentsTuple));
-	}
-}
-
 void GLRenderingDevice::CreateUtilityTextures()
 {
 	gConsole.LogInfo("GLRenderingDevice::CreateUtilityTextures");
@@ -135,13 +109,13 @@ void GLRenderingDevice::CreateUtilityTextures()
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, dataDefaultNormal);
 	CHECK_GL_ERR();
 
+	// fixed seed keeps the noise pattern the same between runs
+	RandomGenerator noiseGenerator(0x55A0);
+	float noiseXY[16 * 2];
+	noiseGenerator.FillUniform(noiseXY, 16 * 2, -1.0f, 1.0f);
 	Vector noise[16];
 	for (int i = 0; i < 16; ++i) {
-		noise[i] = Vector(
-			RandomRange(-1.0f, 1.0f),
-			RandomRange(-1.0f, 1.0f),
-			0.0f
-		);
+		noise[i] = Vector(noiseXY[2 * i], noiseXY[2 * i + 1], 0.0f);
 		noise[i].Normalize();
 	}
 
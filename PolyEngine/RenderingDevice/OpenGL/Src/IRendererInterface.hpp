@@ -1,8 +1,11 @@
 #pragma once
 
 #include <Defines.hpp>
+#include <Utils/Optional.hpp>
+#include <Math/AABox.hpp>
 #include <Rendering/Viewport.hpp>
 #include <Rendering/Lighting/LightSourceComponent.hpp>
+#include <Rendering/SceneView.hpp>
 
 // TODO: inherit from BaseRenderPass - make multipass RenderPass
 
@@ -16,24 +19,6 @@ namespace Poly {
 	class CameraComponent;
 	class MeshRenderingComponent;
 
-	struct SceneView : public BaseObject<> {
-		SceneView(Scene* w, const Viewport& v)
-			: WorldData(w), ViewportData(v), Rect(v.GetRect()), CameraCmp(v.GetCamera())
-		{};
-
-		Scene* WorldData;
-		const Viewport& ViewportData;
-		const AARect& Rect;
-		const CameraComponent* CameraCmp;
-		
-		Dynarray<const MeshRenderingComponent*> DirShadowOpaqueQueue;
-		Dynarray<const MeshRenderingComponent*> OpaqueQueue;
-		Dynarray<const MeshRenderingComponent*> TranslucentQueue;
-
-		Dynarray<const DirectionalLightComponent*> DirectionalLights;
-		Dynarray<const PointLightComponent*> PointLights;
-	};
-
 	class IRendererInterface : public BaseObject<>
 	{
 	public:
@@ -44,6 +29,10 @@ namespace Poly {
 		virtual void Render(const SceneView& sceneView) = 0;
 		virtual void Deinit() = 0;
 
+		/// <summary>Returns volume covered by directional light shadow map in light space,
+		/// or nothing if renderer does not render shadows.</summary>
+		virtual Optional<AABox> GetDirShadowVolume() const { return {}; }
+
 	protected:
 		GLRenderingDevice* RDI;
 	};
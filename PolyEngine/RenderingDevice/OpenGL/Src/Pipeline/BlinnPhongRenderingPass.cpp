@@ -191,7 +191,7 @@ void BlinnPhongRenderingPass::OnRun(Scene* world, const CameraComponent* camera,
 			glBindTexture(GL_TEXTURE_2D, NormalMapID);
 			GetProgram().SetUniform("uNormalMap", 2);
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
+			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, meshProxy->GetIndexType(), NULL);
 			glBindTexture(GL_TEXTURE_2D, 0);
 			glBindVertexArray(0);
 
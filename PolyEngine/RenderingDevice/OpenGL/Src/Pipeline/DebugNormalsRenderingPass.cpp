@@ -42,7 +42,7 @@ void DebugNormalsRenderingPass::OnRun(Scene* world, const CameraComponent* camer
 
 			glBindVertexArray(meshProxy->GetVAO());
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
+			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, meshProxy->GetIndexType(), NULL);
 			glBindTexture(GL_TEXTURE_2D, 0);
 			glBindVertexArray(0);
 
@@ -34,7 +34,7 @@ void DebugNormalsWireframeRenderingPass::OnRun(Scene* world, const CameraCompone
 		{
 			const GLMeshDeviceProxy* meshProxy = static_cast<const GLMeshDeviceProxy*>(subMesh->GetMeshProxy());
 			glBindVertexArray(meshProxy->GetVAO());
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
+			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, meshProxy->GetIndexType(), NULL);
 			glBindVertexArray(0);
 		}
 	}
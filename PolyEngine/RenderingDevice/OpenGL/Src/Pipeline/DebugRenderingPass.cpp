@@ -18,31 +18,19 @@ void DebugRenderingPass::OnRun(Scene* world, const CameraComponent* camera, cons
 
 	// Render Lines
 	{
-		auto debugLinesComponent = world->GetWorldComponent<DebugDrawStateWorldComponent>();
-		auto& debugLines = debugLinesComponent->DebugLines;
-		auto& debugLinesColors = debugLinesComponent->DebugLinesColors;
-
-		DebugRenderingBuffers debugLinesBuffers; // vertex and color buffer
-
-		// set up buffer
-		glBindVertexArray(debugLinesBuffers.VAO);
-		glBindBuffer(GL_ARRAY_BUFFER, debugLinesBuffers.VBO);
-		glBufferData(GL_ARRAY_BUFFER, debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine)
-									+ debugLinesColors.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLineColor), NULL, GL_STATIC_DRAW);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine), (GLvoid*)debugLines.GetData());
-		glBufferSubData(GL_ARRAY_BUFFER, debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine), debugLinesColors.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLineColor), (GLvoid*)debugLinesColors.GetData());
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3f), NULL);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Color), (GLvoid*)(debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine)));
-		glEnableVertexAttribArray(1);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		DebugDrawStateWorldComponent* debugLinesComponent = world->GetWorldComponent<DebugDrawStateWorldComponent>();
+		const GLsizei vertexCount = DebugLinesBuffers.SetContent(*debugLinesComponent);
 
 		GetProgram().SetUniform("uMVP", MVP);
 
-		glDrawArrays(GL_LINES, 0, (GLsizei)debugLines.GetSize() * 2);
-		glBindVertexArray(0);
+		if (vertexCount > 0)
+		{
+			glBindVertexArray(DebugLinesBuffers.VAO);
+			glDrawArrays(GL_LINES, 0, vertexCount);
+			glBindVertexArray(0);
+		}
 
-		debugLines.Clear();
-		debugLinesColors.Clear();
+		debugLinesComponent->DebugLines.Clear();
+		debugLinesComponent->DebugLinesColors.Clear();
 	}
 }
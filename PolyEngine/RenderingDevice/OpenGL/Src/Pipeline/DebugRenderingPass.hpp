@@ -3,6 +3,7 @@
 #include <Defines.hpp>
 #include "Pipeline/RenderingPassBase.hpp"
 #include "Proxy/GLShaderProgram.hpp"
+#include "Common/DebugRenderingBuffers.hpp"
 
 namespace Poly
 {
@@ -17,5 +18,8 @@ namespace Poly
 
 	protected:
 		void OnRun(Scene* world, const CameraComponent* camera, const AARect& rect, ePassType passType) override final;
+
+	private:
+		DebugRenderingBuffers DebugLinesBuffers;
 	};
 }
\ No newline at end of file
@@ -47,7 +47,7 @@ void UnlitRenderingPass::OnRun(Scene* world, const CameraComponent* camera, cons
 			glActiveTexture(GL_TEXTURE0);
 			glBindTexture(GL_TEXTURE_2D, TextureID);
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
+			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, meshProxy->GetIndexType(), NULL);
 			
 			glBindTexture(GL_TEXTURE_2D, 0);
 			glBindVertexArray(0);
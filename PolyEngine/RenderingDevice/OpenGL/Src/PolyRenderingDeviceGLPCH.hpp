@@ -25,6 +25,7 @@
 #include <Memory/Allocator.hpp>
 #include <Memory/PoolAllocator.hpp>
 #include <Memory/IterablePoolAllocator.hpp>
+#include <Memory/BitmapPoolAllocator.hpp>
 #include <Memory/RefCountedBase.hpp>
 #include <Memory/SafePtr.hpp>
 #include <Memory/SafePtrRoot.hpp>
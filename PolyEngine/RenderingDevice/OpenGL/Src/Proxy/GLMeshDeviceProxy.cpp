@@ -8,30 +8,16 @@ using namespace Poly;
 //---------------------------------------------------------------
 GLMeshDeviceProxy::GLMeshDeviceProxy()
 {
-	VBO[eBufferType::VERTEX_BUFFER] = 0;
-	VBO[eBufferType::TEXCOORD_BUFFER] = 0;
-	VBO[eBufferType::NORMAL_BUFFER] = 0;
-	VBO[eBufferType::TANGENT_BUFFER] = 0;
-	VBO[eBufferType::INDEX_BUFFER] = 0;
+	for (eBufferType type : IterateEnum<eBufferType>())
+		VBO[type] = 0;
 }
 
 //---------------------------------------------------------------
 GLMeshDeviceProxy::~GLMeshDeviceProxy()
 {
-	if (VBO[eBufferType::VERTEX_BUFFER])
-		glDeleteBuffers(1, &VBO[eBufferType::VERTEX_BUFFER]);
-
-	if (VBO[eBufferType::TEXCOORD_BUFFER])
-		glDeleteBuffers(1, &VBO[eBufferType::TEXCOORD_BUFFER]);
-
-	if (VBO[eBufferType::NORMAL_BUFFER])
-		glDeleteBuffers(1, &VBO[eBufferType::NORMAL_BUFFER]);
-
-	if(VBO[eBufferType::TANGENT_BUFFER])
-		glDeleteBuffers(1, &VBO[eBufferType::TANGENT_BUFFER]);
-
-	if (VBO[eBufferType::INDEX_BUFFER])
-		glDeleteBuffers(1, &VBO[eBufferType::INDEX_BUFFER]);
+	for (eBufferType type : IterateEnum<eBufferType>())
+		if (VBO[type])
+			glDeleteBuffers(1, &VBO[type]);
 
 	if(VAO)
 		glDeleteVertexArrays(1, &VAO);
@@ -51,6 +37,7 @@ void GLMeshDeviceProxy::SetContent(const Mesh& mesh)
 
 	ASSERTE(mesh.HasVertices() && mesh.HasIndicies(), "Meshes that does not contain vertices and faces are not supported yet!");
 
+	// positions are always in separate stream, depth only passes fetch just them
 	if (mesh.HasVertices()) {
 		EnsureVBOCreated(eBufferType::VERTEX_BUFFER);
 		glBindBuffer(GL_ARRAY_BUFFER, VBO[eBufferType::VERTEX_BUFFER]);
@@ -60,6 +47,37 @@ void GLMeshDeviceProxy::SetContent(const Mesh& mesh)
 		CHECK_GL_ERR();
 	}
 
+	if (mesh.HasPackedAttributes())
+		SetPackedAttributes(mesh);
+	else
+		SetSeparateAttributes(mesh);
+
+	if (mesh.HasIndicies())
+		SetIndices(mesh);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+//---------------------------------------------------------------
+void GLMeshDeviceProxy::SetPackedAttributes(const Mesh& mesh)
+{
+	const GLsizei stride = sizeof(Mesh::PackedAttributes);
+	EnsureVBOCreated(eBufferType::ATTRIBUTE_BUFFER);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO[eBufferType::ATTRIBUTE_BUFFER]);
+	glBufferData(GL_ARRAY_BUFFER, mesh.GetPackedAttributes().GetSize() * stride, mesh.GetPackedAttributes().GetData(), GL_STATIC_DRAW);
+	glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(Mesh::PackedAttributes, TextCoord));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(Mesh::PackedAttributes, Normal));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(Mesh::PackedAttributes, Tangent));
+	glEnableVertexAttribArray(3);
+	CHECK_GL_ERR();
+}
+
+//---------------------------------------------------------------
+void GLMeshDeviceProxy::SetSeparateAttributes(const Mesh& mesh)
+{
 	if (mesh.HasTextCoords()) {
 		EnsureVBOCreated(eBufferType::TEXCOORD_BUFFER);
 		glBindBuffer(GL_ARRAY_BUFFER, VBO[eBufferType::TEXCOORD_BUFFER]);
@@ -79,36 +97,60 @@ void GLMeshDeviceProxy::SetContent(const Mesh& mesh)
 	}
 
 	if(mesh.HasTangents()) {
+		// shaders rebuild bitangent from normal and tangent, its handedness goes to w
+		Dynarray<float> tangents;
+		tangents.Resize(mesh.GetTangents().GetSize() * 4);
+		for (size_t i = 0; i < mesh.GetTangents().GetSize(); ++i)
+		{
+			const Vector t = mesh.GetTangents()[i].GetVector();
+			float sign = 1.f;
+			if (mesh.HasNormals() && mesh.HasBitangents())
+				sign = mesh.GetNormals()[i].GetVector().Cross(t).Dot(mesh.GetBitangents()[i].GetVector()) < 0.f ? -1.f : 1.f;
+			tangents[i * 4] = t.X;
+			tangents[i * 4 + 1] = t.Y;
+			tangents[i * 4 + 2] = t.Z;
+			tangents[i * 4 + 3] = sign;
+		}
+
 		EnsureVBOCreated(eBufferType::TANGENT_BUFFER);
 		glBindBuffer(GL_ARRAY_BUFFER, VBO[eBufferType::TANGENT_BUFFER]);
-		glBufferData(GL_ARRAY_BUFFER, mesh.GetTangents().GetSize() * sizeof(Vector3f), mesh.GetTangents().GetData(), GL_STATIC_DRAW);
-		glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 0, NULL);
+		glBufferData(GL_ARRAY_BUFFER, tangents.GetSize() * sizeof(float), tangents.GetData(), GL_STATIC_DRAW);
+		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 0, NULL);
 		glEnableVertexAttribArray(3);
 		CHECK_GL_ERR();
 	}
+}
 
-	if(mesh.HasBitangents()) {
-		EnsureVBOCreated(eBufferType::BITANGENT_BUFFER);
-		glBindBuffer(GL_ARRAY_BUFFER, VBO[eBufferType::BITANGENT_BUFFER]);
-		glBufferData(GL_ARRAY_BUFFER, mesh.GetBitangents().GetSize() * sizeof(Vector3f), mesh.GetBitangents().GetData(), GL_STATIC_DRAW);
-		glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-		glEnableVertexAttribArray(4);
-		CHECK_GL_ERR();
+//---------------------------------------------------------------
+void GLMeshDeviceProxy::SetIndices(const Mesh& mesh)
+{
+	// levels of detail are ranges of the same buffer, after full detail indices
+	const Dynarray<uint32_t>& indices = mesh.GetIndicies();
+	const Dynarray<uint32_t>& lodIndices = mesh.GetLodIndices();
+	const size_t indexCount = indices.GetSize() + lodIndices.GetSize();
+	EnsureVBOCreated(eBufferType::INDEX_BUFFER);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, VBO[eBufferType::INDEX_BUFFER]);
+
+	if (mesh.GetVertexCount() <= std::numeric_limits<u16>::max() + size_t(1))
+	{
+		Dynarray<u16> shortIndices;
+		shortIndices.Resize(indexCount);
+		for (size_t i = 0; i < indices.GetSize(); ++i)
+			shortIndices[i] = static_cast<u16>(indices[i]);
+		for (size_t i = 0; i < lodIndices.GetSize(); ++i)
+			shortIndices[indices.GetSize() + i] = static_cast<u16>(lodIndices[i]);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(u16), shortIndices.GetData(), GL_STATIC_DRAW);
+		IndexType = GL_UNSIGNED_SHORT;
 	}
-
-	if (mesh.HasIndicies())
+	else
 	{
-		EnsureVBOCreated(eBufferType::INDEX_BUFFER);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, VBO[eBufferType::INDEX_BUFFER]);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.GetIndicies().GetSize() * sizeof(GLuint), mesh.GetIndicies().GetData(), GL_STATIC_DRAW);
-
-		glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, 0, NULL);
-		glEnableVertexAttribArray(5);
-		CHECK_GL_ERR();
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(GLuint), nullptr, GL_STATIC_DRAW);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.GetSize() * sizeof(GLuint), indices.GetData());
+		if (!lodIndices.IsEmpty())
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, indices.GetSize() * sizeof(GLuint), lodIndices.GetSize() * sizeof(GLuint), lodIndices.GetData());
+		IndexType = GL_UNSIGNED_INT;
 	}
-
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	CHECK_GL_ERR();
 }
 
 //---------------------------------------------------------------
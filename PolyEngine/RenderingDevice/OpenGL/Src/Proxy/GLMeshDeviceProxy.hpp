@@ -10,10 +10,10 @@ namespace Poly
 	private:
 		enum class eBufferType {
 			VERTEX_BUFFER,
+			ATTRIBUTE_BUFFER,
 			TEXCOORD_BUFFER,
 			NORMAL_BUFFER,
 			TANGENT_BUFFER,
-			BITANGENT_BUFFER,
 			INDEX_BUFFER,
 			_COUNT
 		};
@@ -26,11 +26,19 @@ namespace Poly
 		unsigned int GetResourceID() const { return VAO; };
 
 		GLuint GetVAO() const { return VAO; }
+		/// <summary>Type of indices to pass to glDrawElements, 16 bit indices are used when vertex count allows.</summary>
+		GLenum GetIndexType() const { return IndexType; }
+		/// <summary>Returns offset of index in bound index buffer, to pass to glDrawElements.</summary>
+		const void* GetIndexOffset(size_t firstIndex) const { return reinterpret_cast<const void*>(firstIndex * (IndexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint))); }
 
 	private:
 		void EnsureVBOCreated(eBufferType type);
+		void SetPackedAttributes(const Mesh& mesh);
+		void SetSeparateAttributes(const Mesh& mesh);
+		void SetIndices(const Mesh& mesh);
 
 		GLuint VAO = 0;
+		GLenum IndexType = GL_UNSIGNED_INT;
 		EnumArray<GLuint, eBufferType> VBO;
 	};
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "Proxy/GLMeshDeviceProxy.hpp"
 #include "Common/GLUtils.hpp"
 #include "Proxy/GLParticleDeviceProxy.hpp"
+#include "Common/GLStreamingBuffer.hpp"
+#include "GLRenderingDevice.hpp"
 
 using namespace Poly;
 
@@ -34,29 +36,16 @@ GLParticleDeviceProxy::GLParticleDeviceProxy()
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (GLvoid*)(3 * sizeof(float)));
 
 
-	glGenBuffers(1, &instanceVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, 0, NULL, GL_STATIC_DRAW);
-	
 	// http://sol.gfxile.net/instancing.html
 	// int pos = glGetAttribLocation((GLint)GetProgram().GetProgramHandle(), "aOffset");
 	int pos = 3;
-	int pos1 = pos + 0;
-	int pos2 = pos + 1;
-	int pos3 = pos + 2;
-	int pos4 = pos + 3;
-	glEnableVertexAttribArray(pos1);
-	glEnableVertexAttribArray(pos2);
-	glEnableVertexAttribArray(pos3);
-	glEnableVertexAttribArray(pos4);
-	glVertexAttribPointer(pos1, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4 * 4, (void*)(0));
-	glVertexAttribPointer(pos2, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4 * 4, (void*)(sizeof(float) * 4));
-	glVertexAttribPointer(pos3, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4 * 4, (void*)(sizeof(float) * 8));
-	glVertexAttribPointer(pos4, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4 * 4, (void*)(sizeof(float) * 12));
-	glVertexAttribDivisor(pos1, 1);
-	glVertexAttribDivisor(pos2, 1);
-	glVertexAttribDivisor(pos3, 1);
-	glVertexAttribDivisor(pos4, 1);
+	for (int column = 0; column < 4; ++column)
+	{
+		glEnableVertexAttribArray(pos + column);
+		glVertexAttribFormat(pos + column, 4, GL_FLOAT, GL_FALSE, sizeof(float) * 4 * column);
+		glVertexAttribBinding(pos + column, INSTANCE_BINDING);
+	}
+	glVertexBindingDivisor(INSTANCE_BINDING, 1);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
@@ -74,30 +63,27 @@ GLParticleDeviceProxy::~GLParticleDeviceProxy()
 
 void GLParticleDeviceProxy::SetContent(const ParticleEmitter& emitter)
 {
-	InstancesTransform.Clear();
-	InstancesTransform.Resize(16 * emitter.GetInstancesCount());
-	
-	for (size_t i = 0; i < InstancesTransform.GetSize(); ++i)
-	{
-		InstancesTransform[i] = 0.0f;
-	}
+	// at least one instance is allocated, so the binding always points to valid memory
+	const size_t instanceCount = emitter.GetInstancesCount();
+	GLStreamingBuffer& streamingBuffer = gRenderingDevice->GetStreamingBuffer();
+	const GLStreamingAllocation allocation = streamingBuffer.Map(sizeof(float) * 16 * std::max<size_t>(instanceCount, 1));
 
-	int transIndx = 0;
+	// mapped memory may be write combined, every value is written once and in order
+	float* instanceTransform = static_cast<float*>(allocation.Data);
 	for (const ParticleEmitter::Particle& p : emitter.GetParticlesPool())
 	{
-		// Scale
-		InstancesTransform[transIndx + 0] = p.Scale.X;
-		InstancesTransform[transIndx + 5] = p.Scale.Y;
-		InstancesTransform[transIndx + 10] = p.Scale.Z;
-		InstancesTransform[transIndx + 15] = 1.0f;
-		// translation
-		InstancesTransform[transIndx + 12] = p.Position.X;
-		InstancesTransform[transIndx + 13] = p.Position.Y;
-		InstancesTransform[transIndx + 14] = p.Position.Z;
-		transIndx += 16;
+		const float transform[16] = {
+			p.Scale.X, 0.0f, 0.0f, 0.0f,
+			0.0f, p.Scale.Y, 0.0f, 0.0f,
+			0.0f, 0.0f, p.Scale.Z, 0.0f,
+			p.Position.X, p.Position.Y, p.Position.Z, 1.0f
+		};
+		memcpy(instanceTransform, transform, sizeof(transform));
+		instanceTransform += 16;
 	}
+	streamingBuffer.Unmap(allocation);
 
-	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * InstancesTransform.GetSize(), InstancesTransform.GetData(), GL_STATIC_DRAW);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(VAO);
+	glBindVertexBuffer(INSTANCE_BINDING, allocation.Buffer, (GLintptr)allocation.Offset, sizeof(float) * 16);
+	glBindVertexArray(0);
 }
@@ -24,10 +24,10 @@ namespace Poly
 
 	private:
 
+		// instance transforms are written to streaming buffer every frame and bound to this vertex buffer binding
+		static constexpr GLuint INSTANCE_BINDING = 3;
+
 		GLuint VAO = 0;
 		GLuint VBO = 0;
-		unsigned int instanceVBO;
-
-		Dynarray<float> InstancesTransform;
 	};
 }
@@ -3,69 +3,174 @@
 #include "Proxy/GLShaderProgram.hpp"
 #include "Common/GLUtils.hpp"
 
+#include <Rendering/ShaderPreprocessor.hpp>
+#include <Resources/AssetCache.hpp>
+
 SILENCE_MSVC_WARNING(4805, "Warning originates in std::regex");
 #include <regex>
 UNSILENCE_MSVC_WARNING()
 
 using namespace Poly;
 
-GLShaderProgram::GLShaderProgram(const String& compute)
+namespace
 {
-	gConsole.LogDebug("Creating shader program {}", compute);
-	ProgramHandle = glCreateProgram();
-	if (ProgramHandle == 0) {
-		ASSERTE(false, "Creation of shader program failed! Exiting...");
+	constexpr u32 PROGRAM_CACHE_MAGIC = 0x474F5250; // "PROG"
+	constexpr u32 PROGRAM_CACHE_VERSION = 1;
+	constexpr const char* PROGRAM_CACHE_EXTENSION = ".polyshader";
+
+	// binaries are valid only for the driver that created them
+	u64 GetDriverHash()
+	{
+		static const u64 driverHash = []()
+		{
+			u64 hash = HashAssetSource(nullptr, 0);
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* str = reinterpret_cast<const char*>(glGetString(name));
+				if (str)
+					hash = HashAssetSource(str, strlen(str), hash);
+			}
+			return hash;
+		}();
+		return driverHash;
 	}
-	LoadShader(eShaderUnitType::COMPUTE, compute);
-	CompileProgram();
 
-	for (eShaderUnitType type : IterateEnum<eShaderUnitType>())
-		AnalyzeShaderCode(type);
+	String LoadShaderInclude(const String& path)
+	{
+		return LoadTextFileRelative(eResourceSource::ENGINE, path);
+	}
+}
+
+GLShaderProgram::GLShaderProgram(const String& compute, const Dynarray<String>& defines)
+{
+	gConsole.LogDebug("Creating shader program {}", compute);
+	ShaderPaths[eShaderUnitType::COMPUTE] = compute;
+	CreateProgram(defines);
 }
 
-GLShaderProgram::GLShaderProgram(const String& vertex, const String& fragment)
+GLShaderProgram::GLShaderProgram(const String& vertex, const String& fragment, const Dynarray<String>& defines)
 {
 	gConsole.LogDebug("Creating shader program {} {}", vertex, fragment);
+	ShaderPaths[eShaderUnitType::VERTEX] = vertex;
+	ShaderPaths[eShaderUnitType::FRAGMENT] = fragment;
+	CreateProgram(defines);
+}
+
+GLShaderProgram::GLShaderProgram(const String& vertex, const String& geometry, const String& fragment, const Dynarray<String>& defines)
+{
+	gConsole.LogDebug("Creating shader program {} {} {}", vertex, geometry, fragment);
+	ShaderPaths[eShaderUnitType::VERTEX] = vertex;
+	ShaderPaths[eShaderUnitType::GEOMETRY] = geometry;
+	ShaderPaths[eShaderUnitType::FRAGMENT] = fragment;
+	CreateProgram(defines);
+}
+
+
+void GLShaderProgram::BindProgram() const
+{
+	EnsureLinked();
+	glUseProgram(ProgramHandle);
+}
+
+
+void GLShaderProgram::CreateProgram(const Dynarray<String>& defines)
+{
 	ProgramHandle = glCreateProgram();
 	if (ProgramHandle == 0) {
 		ASSERTE(false, "Creation of shader program failed! Exiting...");
 	}
-	LoadShader(eShaderUnitType::VERTEX, vertex);
-	LoadShader(eShaderUnitType::FRAGMENT, fragment);
-	CompileProgram();
 
+	// program identity selects the cache file, preprocessed sources and driver validate its content
+	u64 identityHash = HashAssetSource(nullptr, 0);
+	SourceHash = GetDriverHash();
+	String firstPath;
 	for (eShaderUnitType type : IterateEnum<eShaderUnitType>())
-		AnalyzeShaderCode(type);
+	{
+		const String& path = ShaderPaths[type];
+		if (path.GetLength() == 0)
+			continue;
+		if (firstPath.GetLength() == 0)
+			firstPath = path;
+
+		Dynarray<String> includedPaths;
+		ShaderCode[type] = ShaderPreprocessor::Preprocess(LoadTextFileRelative(eResourceSource::ENGINE, path), path, defines, LoadShaderInclude, includedPaths);
+		for (size_t i = 0; i < includedPaths.GetSize(); ++i)
+			gConsole.LogDebug("Shader {} includes {} as source string {}", path, includedPaths[i], i + 1);
+
+		identityHash = HashAssetSource(path.GetCStr(), path.GetLength() + 1, identityHash);
+		SourceHash = HashAssetSource(ShaderCode[type].GetCStr(), ShaderCode[type].GetLength() + 1, SourceHash);
+	}
+	for (const String& define : defines)
+		identityHash = HashAssetSource(define.GetCStr(), define.GetLength() + 1, identityHash);
+
+	// programs built from the same first shader with other shaders or defines are cached side by side
+	BinaryCachePath = GetAssetCachePath(EvaluateFullResourcePath(eResourceSource::ENGINE, firstPath), PROGRAM_CACHE_EXTENSION, identityHash);
+
+	if (!LoadProgramBinary())
+	{
+		for (eShaderUnitType type : IterateEnum<eShaderUnitType>())
+			if (ShaderCode[type].GetLength() > 0)
+				CompileShader(type);
+
+		// status is not queried here, so the driver can compile and link in the background
+		glProgramParameteri(ProgramHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		glLinkProgram(ProgramHandle);
+	}
+	LinkPending = true;
+	CHECK_GL_ERR();
 }
 
-GLShaderProgram::GLShaderProgram(const String& vertex, const String& geometry, const String& fragment)
+
+void GLShaderProgram::CompileShader(eShaderUnitType type)
 {
-	gConsole.LogDebug("Creating shader program {} {} {}", vertex, geometry, fragment);
-	ProgramHandle = glCreateProgram();
-	if (ProgramHandle == 0) {
-		ASSERTE(false, "Creation of shader program failed! Exiting...");
+	GLuint shader = glCreateShader(GetEnumFromShaderUnitType(type));
+	if (shader == 0) {
+		ASSERTE(false, "Creation of shader failed!");
 	}
-	LoadShader(eShaderUnitType::VERTEX, vertex);
-	LoadShader(eShaderUnitType::GEOMETRY, geometry);
-	LoadShader(eShaderUnitType::FRAGMENT, fragment);
-	CompileProgram();
 
-	for(eShaderUnitType type : IterateEnum<eShaderUnitType>())
-			AnalyzeShaderCode(type);
+	const char *code = ShaderCode[type].GetCStr();
+	glShaderSource(shader, 1, &code, NULL);
+	glCompileShader(shader);
+	glAttachShader(ProgramHandle, shader);
+	PendingShaders[type] = shader;
 }
 
 
-void GLShaderProgram::BindProgram() const
+void GLShaderProgram::EnsureLinked() const
 {
-	glUseProgram(ProgramHandle);
+	// compilation is finished lazily, the program is logically complete since construction
+	if (LinkPending)
+		const_cast<GLShaderProgram*>(this)->FinishLinking();
 }
 
 
-void GLShaderProgram::CompileProgram()
+void GLShaderProgram::FinishLinking()
 {
-	glLinkProgram(ProgramHandle);
-	int linkStatus = 0;
+	LinkPending = false;
 
+	bool compiledFromSource = false;
+	for (eShaderUnitType type : IterateEnum<eShaderUnitType>())
+	{
+		const GLuint shader = PendingShaders[type];
+		if (shader == 0)
+			continue;
+		compiledFromSource = true;
+
+		int compileStatus = 0;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+
+		if (compileStatus == 0) {
+			int infoLogLength = 0;
+			glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
+			Dynarray<char> errorMessage;
+			errorMessage.Resize(static_cast<size_t>(infoLogLength + 1));
+			glGetShaderInfoLog(shader, infoLogLength, NULL, &errorMessage[0]);
+			gConsole.LogError("Shader compilation of {}: {}", ShaderPaths[type], std::string(&errorMessage[0]));
+			ASSERTE(false, "Shader compilation failed!");
+		}
+	}
+
+	int linkStatus = 0;
 	glGetProgramiv(ProgramHandle, GL_LINK_STATUS, &linkStatus);
 
 	if (linkStatus == 0) {
@@ -77,6 +182,88 @@ void GLShaderProgram::CompileProgram()
 		gConsole.LogError("Program linking: {}", std::string(&errorMessage[0]));
 		ASSERTE(false, "Program linking failed!");
 	}
+
+	for (eShaderUnitType type : IterateEnum<eShaderUnitType>())
+	{
+		if (PendingShaders[type] == 0)
+			continue;
+		glDetachShader(ProgramHandle, PendingShaders[type]);
+		glDeleteShader(PendingShaders[type]);
+		PendingShaders[type] = 0;
+	}
+
+	if (compiledFromSource && linkStatus != 0)
+		SaveProgramBinary();
+
+	for (eShaderUnitType type : IterateEnum<eShaderUnitType>())
+		AnalyzeShaderCode(type);
+	CHECK_GL_ERR();
+}
+
+
+bool GLShaderProgram::LoadProgramBinary()
+{
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	if (formatCount == 0 || !FileExists(BinaryCachePath))
+		return false;
+
+	std::unique_ptr<BinaryBuffer> data(LoadBinaryFile(BinaryCachePath));
+	AssetCacheReader reader(*data);
+	if (!reader.IsUpToDate(PROGRAM_CACHE_MAGIC, PROGRAM_CACHE_VERSION, SourceHash))
+	{
+		gConsole.LogInfo("Program binary {} is outdated.", BinaryCachePath);
+		return false;
+	}
+
+	try
+	{
+		const GLenum format = reader.Read<u32>();
+		size_t size = 0;
+		const char* binary = reader.ReadArrayView<char>(size);
+		glProgramBinary(ProgramHandle, format, binary, static_cast<GLsizei>(size));
+	}
+	catch (const ResourceLoadFailedException&)
+	{
+		gConsole.LogWarning("Program binary {} is corrupted.", BinaryCachePath);
+		return false;
+	}
+
+	// driver may reject binaries of other driver builds with the same version string
+	int linkStatus = 0;
+	glGetProgramiv(ProgramHandle, GL_LINK_STATUS, &linkStatus);
+	if (linkStatus == 0)
+	{
+		gConsole.LogInfo("Program binary {} rejected by driver.", BinaryCachePath);
+		return false;
+	}
+
+	gConsole.LogDebug("Loading program binary {} sucessfull.", BinaryCachePath);
+	return true;
+}
+
+
+void GLShaderProgram::SaveProgramBinary() const
+{
+	GLint formatCount = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+	GLint length = 0;
+	glGetProgramiv(ProgramHandle, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (formatCount == 0 || length <= 0)
+		return;
+
+	Dynarray<char> binary;
+	binary.Resize(static_cast<size_t>(length));
+	GLenum format = 0;
+	glGetProgramBinary(ProgramHandle, length, nullptr, &format, binary.GetData());
+
+	AssetCacheWriter writer(PROGRAM_CACHE_MAGIC, PROGRAM_CACHE_VERSION, SourceHash);
+	writer.Write<u32>(format);
+	writer.WriteArray(binary);
+
+	// engine resources may be read only, program is compiled from source next time then
+	if (!writer.SaveToFile(BinaryCachePath))
+		gConsole.LogWarning("Failed to save program binary {}", BinaryCachePath);
 }
 
 
@@ -98,48 +285,27 @@ void GLShaderProgram::Validate()
 }
 
 
-void GLShaderProgram::LoadShader(eShaderUnitType type, const String& shaderName)
-{
-	GLuint shader = glCreateShader(GetEnumFromShaderUnitType(type));
-	if (shader == 0) {
-		ASSERTE(false, "Creation of shader failed!");
-	}
-
-	ShaderCode[type] = LoadTextFileRelative(eResourceSource::ENGINE, shaderName);
-
-	const char *code = ShaderCode[type].GetCStr();
-	glShaderSource(shader, 1, &code, NULL);
-	glCompileShader(shader);
-
-	int compileStatus = 0;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
-
-	if (compileStatus == 0) {
-		int infoLogLength = 0;
-		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLength);
-		Dynarray<char> errorMessage;
-		errorMessage.Resize(static_cast<size_t>(infoLogLength + 1));
-		glGetShaderInfoLog(shader, infoLogLength, NULL, &errorMessage[0]);
-		gConsole.LogError("Shader compilation: {}", std::string(&errorMessage[0]));
-		ASSERTE(false, "Shader compilation failed!");
-	}
-
-	glAttachShader(ProgramHandle, shader);
-	glDeleteShader(shader);  // is it ok to do it here?
-	CHECK_GL_ERR();
-}
-
-
 unsigned int GLShaderProgram::GetProgramHandle() const
 {
+	EnsureLinked();
 	return ProgramHandle;
 }
 
 
 void GLShaderProgram::RegisterUniform(const String& type, const String& name)
 {
-	if (Uniforms.find(name) != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* registered = Uniforms.Find(name);
+	if (registered)
+	{
+		// lookups compare hashes only, so colliding names would silently set each other
+		if (!(registered->Name == name))
+		{
+			gConsole.LogError("Uniform {} has the same name hash as {}!", name, registered->Name);
+			ASSERTE(false, "Uniform name hash collision!");
+		}
 		return;
+	}
 
 	GLint location = 0;
 	location = glGetUniformLocation(ProgramHandle, name.GetCStr());
@@ -148,98 +314,110 @@ void GLShaderProgram::RegisterUniform(const String& type, const String& name)
 		gConsole.LogError("Invalid uniform location for {}. Probably optimized out.", name);
 		return;
 	}
-	Uniforms[name] = UniformInfo(type, location);
+	if (!Uniforms.Register(name, UniformTable::GetTypeFromName(type), location))
+	{
+		gConsole.LogError("Uniform {} registered twice!", name);
+		ASSERTE(false, "Uniform registration failed!");
+	}
 	CHECK_GL_ERR();
 }
 
 
-void GLShaderProgram::SetUniform(const String& name, int val)
+void GLShaderProgram::SetUniform(UniformName name, int val)
 {
-	auto it = Uniforms.find(name);
-	if (it != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* uniform = Uniforms.Find(name);
+	if (uniform)
 	{
-		bool isTypeValid = it->second.TypeName == "int" || it->second.TypeName == "sampler2D" || it->second.TypeName == "samplerCube";
+		bool isTypeValid = uniform->Type == eUniformType::INT || uniform->Type == eUniformType::SAMPLER_2D || uniform->Type == eUniformType::SAMPLER_CUBE;
 		if (!isTypeValid)
 		{
-			gConsole.LogError("Invalid uniform type int for {}", name);
+			gConsole.LogError("Invalid uniform type int for uniform {}", uniform->Name);
 		}
 		HEAVY_ASSERTE(isTypeValid, "Invalid uniform type!");
-		glUniform1i(it->second.Location, val);
+		glUniform1i(uniform->Location, val);
 	}
 }
 
 
-void GLShaderProgram::SetUniform(const String& name, uint val)
+void GLShaderProgram::SetUniform(UniformName name, uint val)
 {
-	auto it = Uniforms.find(name);
-	if (it != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* uniform = Uniforms.Find(name);
+	if (uniform)
 	{
-		bool isTypeValid = it->second.TypeName == "uint";
+		bool isTypeValid = uniform->Type == eUniformType::UINT;
 		if (!isTypeValid)
 		{
-			gConsole.LogError("Invalid uniform type uint for {}", name);
+			gConsole.LogError("Invalid uniform type uint for uniform {}", uniform->Name);
 		}
 		HEAVY_ASSERTE(isTypeValid, "Invalid uniform type!");
-		glUniform1i(it->second.Location, val);
+		glUniform1i(uniform->Location, val);
 	}
 }
 
 
-void GLShaderProgram::SetUniform(const String& name, float val)
+void GLShaderProgram::SetUniform(UniformName name, float val)
 {
-	auto it = Uniforms.find(name);
-	if (it != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* uniform = Uniforms.Find(name);
+	if (uniform)
 	{
-		HEAVY_ASSERTE(it->second.TypeName == "float", "Invalid uniform type!");
-		glUniform1f(it->second.Location, val);
+		HEAVY_ASSERTE(uniform->Type == eUniformType::FLOAT, "Invalid uniform type!");
+		glUniform1f(uniform->Location, val);
 	}
 }
 
 
-void GLShaderProgram::SetUniform(const String & name, float val1, float val2)
+void GLShaderProgram::SetUniform(UniformName name, float val1, float val2)
 {
-	auto it = Uniforms.find(name);
-	if (it != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* uniform = Uniforms.Find(name);
+	if (uniform)
 	{
-		HEAVY_ASSERTE(it->second.TypeName == "vec2", "Invalid uniform type!");
-		glUniform2f(it->second.Location, val1, val2);
+		HEAVY_ASSERTE(uniform->Type == eUniformType::VEC2, "Invalid uniform type!");
+		glUniform2f(uniform->Location, val1, val2);
 	}
 }
 
 
-void GLShaderProgram::SetUniform(const String& name, const Vector& val)
+void GLShaderProgram::SetUniform(UniformName name, const Vector& val)
 {
-	auto it = Uniforms.find(name);
-	if (it != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* uniform = Uniforms.Find(name);
+	if (uniform)
 	{
-		HEAVY_ASSERTE(it->second.TypeName == "vec4", "Invalid uniform type!");
-		glUniform4f(it->second.Location, val.X, val.Y, val.Z, val.W);
+		HEAVY_ASSERTE(uniform->Type == eUniformType::VEC4, "Invalid uniform type!");
+		glUniform4f(uniform->Location, val.X, val.Y, val.Z, val.W);
 	}
 }
 
 
-void GLShaderProgram::SetUniform(const String& name, const Color& val)
+void GLShaderProgram::SetUniform(UniformName name, const Color& val)
 {
-	auto it = Uniforms.find(name);
-	if (it != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* uniform = Uniforms.Find(name);
+	if (uniform)
 	{
-		HEAVY_ASSERTE(it->second.TypeName == "vec4", "Invalid uniform type!");
-		glUniform4f(it->second.Location, val.R, val.G, val.B, val.A);
+		HEAVY_ASSERTE(uniform->Type == eUniformType::VEC4, "Invalid uniform type!");
+		glUniform4f(uniform->Location, val.R, val.G, val.B, val.A);
 	}
 }
 
 
-void GLShaderProgram::SetUniform(const String& name, const Matrix& val)
+void GLShaderProgram::SetUniform(UniformName name, const Matrix& val)
 {
-	auto it = Uniforms.find(name);
-	if (it != Uniforms.end())
+	EnsureLinked();
+	const UniformTable::Entry* uniform = Uniforms.Find(name);
+	if (uniform)
 	{
-		HEAVY_ASSERTE(it->second.TypeName == "mat4", "Invalid uniform type!");
-		glUniformMatrix4fv(it->second.Location, 1, GL_FALSE, val.GetTransposed().GetDataPtr());
+		HEAVY_ASSERTE(uniform->Type == eUniformType::MAT4, "Invalid uniform type!");
+		// GL_TRUE transposes row major matrix without a copy
+		glUniformMatrix4fv(uniform->Location, 1, GL_TRUE, val.GetDataPtr());
 	}
 }
 
-void GLShaderProgram::BindSampler(const String& name, int samplerID, int textureID)
+void GLShaderProgram::BindSampler(UniformName name, int samplerID, int textureID)
 {
 	HEAVY_ASSERTE(samplerID >= 0, "Invalid sampler ID!");
 	HEAVY_ASSERTE(textureID > 0, "Invalid texture resource ID!");
@@ -249,7 +427,7 @@ void GLShaderProgram::BindSampler(const String& name, int samplerID, int texture
 	SetUniform(name, samplerID);
 }
 
-void GLShaderProgram::BindSamplerCube(const String& name, int samplerID, int cubemapID)
+void GLShaderProgram::BindSamplerCube(UniformName name, int samplerID, int cubemapID)
 {
 	HEAVY_ASSERTE(samplerID >= 0, "Invalid sampler ID!");
 	HEAVY_ASSERTE(cubemapID > 0, "Invalid cubemap resource ID!");
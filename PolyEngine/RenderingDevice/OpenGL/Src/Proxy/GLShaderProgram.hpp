@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Defines.hpp>
+#include <Rendering/UniformTable.hpp>
 
 typedef unsigned int GLuint;
 typedef unsigned int GLenum;
@@ -18,15 +19,6 @@ namespace Poly
 			_COUNT
 		};
 
-		struct UniformInfo
-		{
-			UniformInfo() {}
-			UniformInfo(const String& type, int location) : TypeName(type), Location(location) {}
-
-			String TypeName;
-			int Location = 0;
-		};
-
 		struct OutputInfo
 		{
 			OutputInfo() {}
@@ -37,45 +29,63 @@ namespace Poly
 		};
 
 	public:
-		GLShaderProgram(const String& compute);
-		GLShaderProgram(const String& vertex, const String& fragment);
-		GLShaderProgram(const String& vertex, const String& geometry, const String& fragment);
+		/// <summary>Starts compilation of shader program, or loads it from program binary cache.
+		/// Compilation and linking finish on first use, so programs created one after another compile in parallel
+		/// when the driver supports it.</summary>
+		/// <param name="defines">Macros defined for all shader stages ("NAME" or "NAME VALUE"),
+		/// every set of defines is a separate variant of the program.</param>
+		GLShaderProgram(const String& compute, const Dynarray<String>& defines = {});
+		GLShaderProgram(const String& vertex, const String& fragment, const Dynarray<String>& defines = {});
+		GLShaderProgram(const String& vertex, const String& geometry, const String& fragment, const Dynarray<String>& defines = {});
 
 		void BindProgram() const;
 
 		unsigned int GetProgramHandle() const;
 
-		void SetUniform(const String& name, int val);
-		void SetUniform(const String& name, uint val);
-		void SetUniform(const String& name, float val);
-		void SetUniform(const String& name, float val1, float val2);
-		void SetUniform(const String& name, const Vector& val);
-		void SetUniform(const String& name, const Color& val);
-		void SetUniform(const String& name, const Matrix& val);
-		void BindSampler(const String& name, int samplerID, int textureID);
-		void BindSamplerCube(const String& name, int samplerID, int cubemapID);
-
-		const std::map<String, OutputInfo>& GetOutputsInfo() const { return Outputs; }
-		const std::map<String, UniformInfo>& GetUniformsInfo() const { return Uniforms; }
-
+		// names of uniforms set per draw should be constexpr, so their hashes are computed at compile time
+		void SetUniform(UniformName name, int val);
+		void SetUniform(UniformName name, uint val);
+		void SetUniform(UniformName name, float val);
+		void SetUniform(UniformName name, float val1, float val2);
+		void SetUniform(UniformName name, const Vector& val);
+		void SetUniform(UniformName name, const Color& val);
+		void SetUniform(UniformName name, const Matrix& val);
+		void BindSampler(UniformName name, int samplerID, int textureID);
+		void BindSamplerCube(UniformName name, int samplerID, int cubemapID);
+
+		const std::map<String, OutputInfo>& GetOutputsInfo() const { EnsureLinked(); return Outputs; }
+		const UniformTable& GetUniforms() const { EnsureLinked(); return Uniforms; }
+
+		/// <summary>Resolves location of uniform once, so setting it later needs no string operations or GL queries.</summary>
+		/// <param name="type">GLSL type name, checked against type of set values in debug builds.</param>
+		/// <param name="name">Name of uniform, names of struct members and array elements are qualified ("uLights[0].Color").</param>
 		void RegisterUniform(const String& type, const String& name);
 
 	private:
-		void CompileProgram();
+		void CreateProgram(const Dynarray<String>& defines);
+		void CompileShader(eShaderUnitType type);
+		void EnsureLinked() const;
+		void FinishLinking();
 		void Validate();
-		void LoadShader(eShaderUnitType type, const String &shaderName);
+
+		bool LoadProgramBinary();
+		void SaveProgramBinary() const;
 
 		static GLenum GetEnumFromShaderUnitType(eShaderUnitType type);
 
 		void AnalyzeShaderCode(eShaderUnitType type);
 
-		std::map<String, UniformInfo> Uniforms;
+		UniformTable Uniforms;
 		std::map<String, OutputInfo> Outputs;
 		GLuint ProgramHandle;
+		EnumArray<String, eShaderUnitType> ShaderPaths;
 		EnumArray<String, eShaderUnitType> ShaderCode;
 
-		String VertexProgramPath;
-		String GeometryProgramPath;
-		String FragmentProgramPath;
+		// shaders compiled from source, deleted once the program is linked
+		EnumArray<GLuint, eShaderUnitType> PendingShaders;
+		bool LinkPending = false;
+
+		String BinaryCachePath;
+		u64 SourceHash = 0;
 	};
 }
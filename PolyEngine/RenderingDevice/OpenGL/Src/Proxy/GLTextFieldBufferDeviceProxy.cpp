@@ -2,6 +2,8 @@
 
 #include "Proxy/GLTextFieldBufferDeviceProxy.hpp"
 #include "Common/GLUtils.hpp"
+#include "Common/GLStreamingBuffer.hpp"
+#include "GLRenderingDevice.hpp"
 
 using namespace Poly;
 
@@ -46,7 +48,12 @@ void GLTextFieldBufferDeviceProxy::SetContent(size_t count, const TextFieldLette
 
 	Size = count;
 
-	Dynarray<float> vboData(count * 36);
+	// text changes rarely, so glyph quads are staged in streaming buffer and copied to VBO on GPU,
+	// which is reallocated only when it has to grow
+	const size_t dataSize = sizeof(GLfloat) * 36 * count;
+	GLStreamingBuffer& streamingBuffer = gRenderingDevice->GetStreamingBuffer();
+	const GLStreamingAllocation allocation = streamingBuffer.Map(dataSize);
+	GLfloat* vboData = static_cast<GLfloat*>(allocation.Data);
 	for (size_t i = 0; i < count; ++i)
 	{
 		GLfloat xpos = letters[i].PosX;
@@ -56,7 +63,7 @@ void GLTextFieldBufferDeviceProxy::SetContent(size_t count, const TextFieldLette
 		GLfloat h = letters[i].SizeY;
 		// Update VBO for each character
 
-		float vertices[36] = {
+		const GLfloat vertices[36] = {
 			// tri1 (pos + uv) //0 min, 1 max
 			xpos, ypos + h, 0.0f, 1.0f,		letters[i].MinU, letters[i].MinV,
 			xpos, ypos, 0.0f, 1.0f,			letters[i].MinU, letters[i].MaxV,
@@ -68,12 +75,19 @@ void GLTextFieldBufferDeviceProxy::SetContent(size_t count, const TextFieldLette
 			xpos + w, ypos + h, 0.0f, 1.0f, letters[i].MaxU, letters[i].MinV
 		};
 
-		for (int k = 0; k < 36; ++k)
-			vboData.PushBack(vertices[k]);
+		memcpy(vboData + 36 * i, vertices, sizeof(vertices));
 	}
+	streamingBuffer.Unmap(allocation);
 
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vboData.GetSize(), vboData.GetData(), GL_DYNAMIC_DRAW);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, VBO);
+	if (dataSize > VBOCapacity)
+	{
+		VBOCapacity = std::max(dataSize, VBOCapacity * 2);
+		glBufferData(GL_COPY_WRITE_BUFFER, VBOCapacity, nullptr, GL_STATIC_DRAW);
+	}
+	glBindBuffer(GL_COPY_READ_BUFFER, allocation.Buffer);
+	glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)allocation.Offset, 0, dataSize);
+	glBindBuffer(GL_COPY_READ_BUFFER, 0);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 	CHECK_GL_ERR();
-}
\ No newline at end of file
+}
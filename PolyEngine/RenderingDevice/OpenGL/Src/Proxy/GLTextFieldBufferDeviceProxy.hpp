@@ -22,5 +22,6 @@ namespace Poly
 		GLuint VAO = 0;
 		GLuint VBO = 0;
 		size_t Size = 0;
+		size_t VBOCapacity = 0;
 	};
 }
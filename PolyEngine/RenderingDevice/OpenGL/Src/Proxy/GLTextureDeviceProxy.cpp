@@ -79,6 +79,55 @@ void GLTextureDeviceProxy::SetContentHDR(const float* data)
 	CHECK_GL_ERR();
 }
 
+void GLTextureDeviceProxy::SetContentMips(eTextureCompression compression, const Dynarray<TextureMipLevel>& levels)
+{
+	ASSERTE(Usage != eTextureUsageType::FONT && Usage != eTextureUsageType::RENDER_TARGET, "Invalid texture usage type, mip chains are for material textures");
+	ASSERTE(!levels.IsEmpty() && levels[0].Width == Width && levels[0].Height == Height, "Invalid arguments!");
+	ASSERTE(TextureID > 0, "Texture is invalid!");
+
+	GLenum compressedFormat = 0;
+	const bool sRGB = Usage == eTextureUsageType::ALBEDO || Usage == eTextureUsageType::EMISSIVE;
+	switch (compression)
+	{
+	case eTextureCompression::NONE:
+		break;
+	case eTextureCompression::BC1:
+		compressedFormat = sRGB ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+		break;
+	case eTextureCompression::BC3:
+		compressedFormat = sRGB ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		break;
+	default:
+		ASSERTE(false, "Unknown texture compression!");
+	}
+
+	glBindTexture(GL_TEXTURE_2D, TextureID);
+	// rows of uncompressed levels are tightly packed, previous alignment is restored after the upload
+	GLint unpackAlignment = 4;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (size_t level = 0; level < levels.GetSize(); ++level)
+	{
+		const TextureMipLevel& mip = levels[level];
+		ASSERTE(mip.Data, "Data pointer is nullptr!");
+		if (compression == eTextureCompression::NONE)
+			glTexImage2D(GL_TEXTURE_2D, (GLint)level, InternalFormat, (GLsizei)mip.Width, (GLsizei)mip.Height, 0, Format,
+				Usage == eTextureUsageType::HDR ? GL_FLOAT : GL_UNSIGNED_BYTE, mip.Data);
+		else
+			glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)level, compressedFormat, (GLsizei)mip.Width, (GLsizei)mip.Height, 0, (GLsizei)mip.Size, mip.Data);
+	}
+	glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+	if (compression != eTextureCompression::NONE)
+		InternalFormat = compressedFormat;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.GetSize() - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels.GetSize() > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	CHECK_GL_ERR();
+}
+
 void GLTextureDeviceProxy::SetSubContent(size_t width, size_t height,
 	size_t offsetX, size_t offsetY, const unsigned char* data)
 {
@@ -25,6 +25,7 @@ namespace Poly
 		void SetContent(const unsigned char* data) override;
 		void SetContentHDR(const float* data) override;
 		void SetSubContent(size_t width, size_t height, size_t offsetX, size_t offsetY, const unsigned char* data) override;
+		void SetContentMips(eTextureCompression compression, const Dynarray<TextureMipLevel>& levels) override;
 		unsigned int GetResourceID() const override { return TextureID; };
 
 		GLuint GetTextureID() const { return TextureID; }
@@ -8,12 +8,31 @@
 #include "Proxy/GLParticleDeviceProxy.hpp"
 #include "Pipeline/RenderingPassBase.hpp"
 #include "Common/DebugRenderingBuffers.hpp"
+#include "Common/GLStreamingBuffer.hpp"
 #include "Proxy/GLShaderProgram.hpp"
 #include "Common/PrimitiveCube.hpp"
 #include "Common/PrimitiveQuad.hpp"
 
 using namespace Poly;
 
+namespace
+{
+	// per draw uniforms, hashed at compile time
+	constexpr UniformName CLIP_FROM_MODEL("uClipFromModel");
+	constexpr UniformName WORLD_FROM_MODEL("uWorldFromModel");
+	constexpr UniformName MATERIAL_EMISSIVE("uMaterial.Emissive");
+	constexpr UniformName MATERIAL_ALBEDO("uMaterial.Albedo");
+	constexpr UniformName MATERIAL_ROUGHNESS("uMaterial.Roughness");
+	constexpr UniformName MATERIAL_METALLIC("uMaterial.Metallic");
+	constexpr UniformName MATERIAL_OPACITY_MASK_THRESHOLD("uMaterial.OpacityMaskThreshold");
+	constexpr UniformName EMISSIVE_MAP("uEmissiveMap");
+	constexpr UniformName ALBEDO_MAP("uAlbedoMap");
+	constexpr UniformName ROUGHNESS_MAP("uRoughnessMap");
+	constexpr UniformName METALLIC_MAP("uMetallicMap");
+	constexpr UniformName NORMAL_MAP("uNormalMap");
+	constexpr UniformName AMBIENT_OCCLUSION_MAP("uAmbientOcclusionMap");
+}
+
 void RenderTargetPingPong::Init(int width, int height)
 {
 	Width = width;
@@ -68,12 +87,8 @@ TiledForwardRenderer::TiledForwardRenderer(GLRenderingDevice* rdi)
 	DebugLightAccumShader("Shaders/debugLightAccum.vert.glsl", "Shaders/debugLightAccum.frag.glsl"),
 	DebugTextureInputsShader("Shaders/lightAccumulation.vert.glsl", "Shaders/lightAccumulationTexDebug.frag.glsl")
 {
-	ShadowMapShader.RegisterUniform("mat4", "uClipFromModel");
+	ShadowMapShader.RegisterUniform("mat4", "uClipFromWorld");
 
-	LightAccumulationShader.RegisterUniform("float", "uTime");
-	LightAccumulationShader.RegisterUniform("vec4", "uViewPosition");
-	LightAccumulationShader.RegisterUniform("mat4", "uClipFromModel");
-	LightAccumulationShader.RegisterUniform("mat4", "uWorldFromModel");
 	LightAccumulationShader.RegisterUniform("vec4", "uMaterial.Emissive");
 	LightAccumulationShader.RegisterUniform("vec4", "uMaterial.Albedo");
 	LightAccumulationShader.RegisterUniform("float", "uMaterial.Roughness");
@@ -90,17 +105,6 @@ TiledForwardRenderer::TiledForwardRenderer(GLRenderingDevice* rdi)
 	LightAccumulationShader.RegisterUniform("sampler2D", "uNormalMap");
 	LightAccumulationShader.RegisterUniform("sampler2D", "uAmbientOcclusionMap");
 	LightAccumulationShader.RegisterUniform("sampler2D", "uDirShadowMap");
-	
-	for (int i = 0; i < 8; ++i)
-	{
-		String baseName = String("uDirectionalLight[") + String::From(i) + String("].");
-		LightAccumulationShader.RegisterUniform("vec4", baseName + "ColorIntensity");
-		LightAccumulationShader.RegisterUniform("vec4", baseName + "Direction");
-	}
-	LightAccumulationShader.RegisterUniform("int", "uDirectionalLightCount");
-	LightAccumulationShader.RegisterUniform("int", "uLightCount");
-	LightAccumulationShader.RegisterUniform("int", "uWorkGroupsX");
-	LightAccumulationShader.RegisterUniform("int", "uWorkGroupsY");
 
 	HDRShader.RegisterUniform("sampler2D", "uHdrBuffer");
 	HDRShader.RegisterUniform("float", "uExposure");
@@ -138,8 +142,6 @@ TiledForwardRenderer::TiledForwardRenderer(GLRenderingDevice* rdi)
 	SkyboxShader.RegisterUniform("mat4", "uClipFromWorld");
 	SkyboxShader.RegisterUniform("vec4", "uTint");
 
-	TranslucentShader.RegisterUniform("float", "uTime");
-	TranslucentShader.RegisterUniform("vec4", "uViewPosition");
 	TranslucentShader.RegisterUniform("mat4", "uClipFromModel");
 	TranslucentShader.RegisterUniform("mat4", "uWorldFromModel");
 	TranslucentShader.RegisterUniform("vec4", "uMaterial.Emissive");
@@ -158,17 +160,6 @@ TiledForwardRenderer::TiledForwardRenderer(GLRenderingDevice* rdi)
 	TranslucentShader.RegisterUniform("sampler2D", "uNormalMap");
 	TranslucentShader.RegisterUniform("sampler2D", "uAmbientOcclusionMap");	
 
-	for (int i = 0; i < 8; ++i)
-	{
-		String baseName = String("uDirectionalLight[") + String::From(i) + String("].");
-		TranslucentShader.RegisterUniform("vec4", baseName + "ColorIntensity");
-		TranslucentShader.RegisterUniform("vec4", baseName + "Direction");
-	}
-	TranslucentShader.RegisterUniform("int", "uDirectionalLightCount");
-	TranslucentShader.RegisterUniform("int", "uLightCount");
-	TranslucentShader.RegisterUniform("int", "uWorkGroupsX");
-	TranslucentShader.RegisterUniform("int", "uWorkGroupsY");
-
 	ParticleShader.RegisterUniform("float", "uTime");
 	ParticleShader.RegisterUniform("mat4", "uScreenFromView");
 	ParticleShader.RegisterUniform("mat4", "uViewFromWorld");
@@ -207,10 +198,22 @@ void TiledForwardRenderer::Init()
 	 
 	CapturePreintegratedBRDF();
 
-	SetupLightsBufferFromScene();
-
 	Splash = ResourceManager<TextureResource>::Load("Textures/splash_00.png", eResourceSource::ENGINE, eTextureUsageType::ALBEDO);
 
+	DebugLinesBuffers = std::make_unique<DebugRenderingBuffers>();
+
+	glGenBuffers(1, &DirShadowInstanceBuffer);
+	glGenBuffers(1, &DepthPrePassInstanceBuffer);
+	glGenBuffers(1, &OpaqueLitInstanceBuffer);
+
+	glGenBuffers(1, &ViewUniformBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, ViewUniformBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(ViewUniforms), nullptr, GL_DYNAMIC_DRAW);
+	glGenBuffers(1, &DirectionalLightUniformBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, DirectionalLightUniformBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(DirectionalLightUniforms), nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
 	glDepthMask(GL_TRUE);
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_CULL_FACE);
@@ -237,6 +240,13 @@ void TiledForwardRenderer::Deinit()
 
 	DeleteRenderTargets();
 
+	glDeleteBuffers(1, &DirShadowInstanceBuffer);
+	glDeleteBuffers(1, &DepthPrePassInstanceBuffer);
+	glDeleteBuffers(1, &OpaqueLitInstanceBuffer);
+	glDeleteBuffers(1, &ViewUniformBuffer);
+	glDeleteBuffers(1, &DirectionalLightUniformBuffer);
+	DebugLinesBuffers.reset();
+
 	if (Splash)
 	{
 		ResourceManager<TextureResource>::Release(Splash);
@@ -295,12 +305,8 @@ void TiledForwardRenderer::CreateLightBuffers(const ScreenSize& size)
 	gConsole.LogInfo("TiledForwardRenderer::Init workGroups: ({},{}), numberOfTiles: {}", WorkGroupsX, WorkGroupsY, numberOfTiles);
 
 	// Generate our shader storage buffers
-	glGenBuffers(1, &LightBuffer);
 	glGenBuffers(1, &VisibleLightIndicesBuffer);
 
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, LightBuffer);
-	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(Light) * MAX_NUM_LIGHTS, 0, GL_DYNAMIC_DRAW);
-
 	glBindBuffer(GL_SHADER_STORAGE_BUFFER, VisibleLightIndicesBuffer);
 	glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(VisibleIndex) * MAX_NUM_LIGHTS * numberOfTiles, 0, GL_STATIC_DRAW);
 
@@ -311,9 +317,6 @@ void TiledForwardRenderer::CreateLightBuffers(const ScreenSize& size)
 
 void TiledForwardRenderer::DeleteLightBuffers()
 {
-	if(LightBuffer > 0)
-		glDeleteBuffers(1, &LightBuffer);
-
 	if(VisibleLightIndicesBuffer > 0)
 		glDeleteBuffers(1, &VisibleLightIndicesBuffer);
 }
@@ -517,6 +520,10 @@ void TiledForwardRenderer::Render(const SceneView& sceneView)
 
 	UpdateEnvCapture(sceneView);
 
+	FillRenderQueues(sceneView);
+
+	UploadViewUniforms(sceneView);
+
 	RenderShadowMap(sceneView);
 	
 	RenderDepthPrePass(sceneView);
@@ -608,14 +615,19 @@ Matrix TiledForwardRenderer::GetProjectionForShadowMap(const DirectionalLightCom
 {
 	// TODO: calc bounding box and then determine projection size
 	// make sure contains all the objects
-	float near_plane = -4096.0f, far_plane = 4096.0f;
+	float near_plane = -DIR_SHADOW_VOLUME_EXTENT, far_plane = DIR_SHADOW_VOLUME_EXTENT;
 	Matrix dirLightProjection;
-	dirLightProjection.SetOrthographic(-4096.0f, 4096.0f, -4096.0f, 4096.0f, near_plane, far_plane);
+	dirLightProjection.SetOrthographic(-DIR_SHADOW_VOLUME_EXTENT, DIR_SHADOW_VOLUME_EXTENT, -DIR_SHADOW_VOLUME_EXTENT, DIR_SHADOW_VOLUME_EXTENT, near_plane, far_plane);
 	
 	Matrix dirLightFromWorld = dirLightCmp->GetTransform().GetWorldFromModel().GetInversed();
 	return dirLightFromWorld * dirLightProjection;
 }
 
+Optional<AABox> TiledForwardRenderer::GetDirShadowVolume() const
+{
+	return Poly::GetDirShadowVolume();
+}
+
 void TiledForwardRenderer::RenderShadowMap(const SceneView& sceneView)
 {
 	if (sceneView.DirectionalLights.GetSize() < 1)
@@ -629,39 +641,122 @@ void TiledForwardRenderer::RenderShadowMap(const SceneView& sceneView)
 	Matrix projDirLightFromWorld = GetProjectionForShadowMap(sceneView.DirectionalLights[0]);
 	
 	ShadowMapShader.BindProgram();
+	ShadowMapShader.SetUniform("uClipFromWorld", projDirLightFromWorld);
 
-	for (const MeshRenderingComponent* meshCmp : sceneView.OpaqueQueue)
+	for (const RenderQueue::Batch& batch : Queues.GetDirShadowQueue().GetBatches())
 	{
-		const Matrix& worldFromModel = meshCmp->GetTransform().GetWorldFromModel();
-		ShadowMapShader.SetUniform("uClipFromModel", projDirLightFromWorld * worldFromModel);
+		const RenderQueue::Command& cmd = Queues.GetDirShadowQueue().GetCommands()[batch.First];
+		if (cmd.MeshChanged)
+		{
+			glBindVertexArray(cmd.MeshCmp->GetMesh()->GetSubMeshes()[cmd.SubMeshIdx]->GetMeshProxy()->GetResourceID());
+			BindInstanceTransforms(DirShadowInstanceBuffer);
+		}
 
-		for (const MeshResource::SubMesh* subMesh : meshCmp->GetMesh()->GetSubMeshes())
-		{			
-			glBindVertexArray(subMesh->GetMeshProxy()->GetResourceID());
+		DrawBatch(Queues.GetDirShadowQueue(), batch);
+	}
+	glBindVertexArray(0);
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
-			glBindTexture(GL_TEXTURE_2D, 0);
-			glBindVertexArray(0);
-		}
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glCullFace(GL_BACK);
+}
+
+void TiledForwardRenderer::FillRenderQueues(const SceneView& sceneView)
+{
+	Queues.Fill(sceneView, RDI->Stats);
+
+	UploadInstanceTransforms(Queues.GetDirShadowQueue(), DirShadowInstanceBuffer);
+	UploadInstanceTransforms(Queues.GetDepthPrePassQueue(), DepthPrePassInstanceBuffer);
+	UploadInstanceTransforms(Queues.GetOpaqueLitQueue(), OpaqueLitInstanceBuffer);
+}
+
+void TiledForwardRenderer::UploadViewUniforms(const SceneView& sceneView)
+{
+	static_assert(sizeof(ViewUniforms) == 304, "ViewUniforms has to match std140 layout of ViewData block!");
+	static_assert(sizeof(DirectionalLightUniforms) == 272, "DirectionalLightUniforms has to match std140 layout of DirectionalLightData block!");
+
+	ViewUniforms view;
+	view.ClipFromWorld = sceneView.CameraCmp->GetClipFromWorld();
+	view.ViewFromWorld = sceneView.CameraCmp->GetViewFromWorld();
+	view.ClipFromView = sceneView.CameraCmp->GetClipFromView();
+	view.DirLightFromWorld = sceneView.DirectionalLights.IsEmpty() ? Matrix() : GetProjectionForShadowMap(sceneView.DirectionalLights[0]);
+	view.ViewPosition = sceneView.CameraCmp->GetTransform().GetGlobalTranslation();
+	view.Time = (float)TimeSystem::GetTimerElapsedTime(sceneView.WorldData, eEngineTimer::GAMEPLAY);
+	view.ScreenSizeX = RDI->GetScreenSize().Width;
+	view.ScreenSizeY = RDI->GetScreenSize().Height;
+	view.WorkGroupsX = (i32)WorkGroupsX;
+	view.WorkGroupsY = (i32)WorkGroupsY;
+	view.LightCount = std::min((i32)sceneView.PointLights.GetSize(), MAX_NUM_LIGHTS);
+
+	DirectionalLightUniforms dirLights;
+	dirLights.DirectionalLightCount = 0;
+	for (const DirectionalLightComponent* dirLightCmp : sceneView.DirectionalLights)
+	{
+		DirectionalLightUniforms::DirectionalLight& dirLight = dirLights.DirectionalLights[dirLights.DirectionalLightCount];
+		dirLight.ColorIntensity = dirLightCmp->GetColor();
+		dirLight.ColorIntensity.A = dirLightCmp->GetIntensity();
+		dirLight.Direction = MovementSystem::GetGlobalForward(dirLightCmp->GetTransform());
+
+		++dirLights.DirectionalLightCount;
+		if (dirLights.DirectionalLightCount == MAX_LIGHT_COUNT_DIRECTIONAL)
+			break;
 	}
 
-	for (const MeshRenderingComponent* meshCmp : sceneView.DirShadowOpaqueQueue)
+	glBindBuffer(GL_UNIFORM_BUFFER, ViewUniformBuffer);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ViewUniforms), &view);
+	glBindBuffer(GL_UNIFORM_BUFFER, DirectionalLightUniformBuffer);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(DirectionalLightUniforms), &dirLights);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, VIEW_UNIFORMS_BINDING, ViewUniformBuffer);
+	glBindBufferBase(GL_UNIFORM_BUFFER, DIRECTIONAL_LIGHT_UNIFORMS_BINDING, DirectionalLightUniformBuffer);
+}
+
+void TiledForwardRenderer::UploadInstanceTransforms(const RenderQueue& queue, GLuint instanceBuffer)
+{
+	const Dynarray<RenderQueue::Command>& commands = queue.GetCommands();
+	if (commands.IsEmpty())
+		return;
+
+	// GLSL reads matrices column by column
+	InstanceTransforms.Resize(commands.GetSize() * 16);
+	for (size_t i = 0; i < commands.GetSize(); ++i)
 	{
-		const Matrix& worldFromModel = meshCmp->GetTransform().GetWorldFromModel();
-		ShadowMapShader.SetUniform("uClipFromModel", projDirLightFromWorld * worldFromModel);
+		const Matrix worldFromModel = commands[i].MeshCmp->GetTransform().GetWorldFromModel().GetTransposed();
+		std::copy(worldFromModel.GetDataPtr(), worldFromModel.GetDataPtr() + 16, InstanceTransforms.GetData() + i * 16);
+	}
 
-		for (const MeshResource::SubMesh* subMesh : meshCmp->GetMesh()->GetSubMeshes())
-		{
-			glBindVertexArray(subMesh->GetMeshProxy()->GetResourceID());
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	glBufferData(GL_ARRAY_BUFFER, InstanceTransforms.GetSize() * sizeof(float), InstanceTransforms.GetData(), GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
-			glBindTexture(GL_TEXTURE_2D, 0);
-			glBindVertexArray(0);
-		}
+void TiledForwardRenderer::BindInstanceTransforms(GLuint instanceBuffer)
+{
+	// mesh vertex arrays use attributes 0-5, instance transform takes four vec4 attributes after them
+	constexpr GLuint firstAttribute = 6;
+	constexpr GLsizei stride = 16 * sizeof(float);
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	for (GLuint column = 0; column < 4; ++column)
+	{
+		glEnableVertexAttribArray(firstAttribute + column);
+		glVertexAttribPointer(firstAttribute + column, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid*)(column * 4 * sizeof(float)));
+		glVertexAttribDivisor(firstAttribute + column, 1);
 	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glCullFace(GL_BACK);
+void TiledForwardRenderer::DrawBatch(const RenderQueue& queue, const RenderQueue::Batch& batch)
+{
+	// base instance offsets per instance attributes, so one buffer serves all batches of the queue
+	const RenderQueue::Command& cmd = queue.GetCommands()[batch.First];
+	const MeshResource::SubMesh* subMesh = cmd.MeshCmp->GetMesh()->GetSubMeshes()[cmd.SubMeshIdx];
+	const GLMeshDeviceProxy* meshProxy = static_cast<const GLMeshDeviceProxy*>(subMesh->GetMeshProxy());
+	const Mesh::Lod lod = subMesh->GetMeshData().GetLod(cmd.MeshCmp->GetLodLevel());
+	glDrawElementsInstancedBaseInstance(GL_TRIANGLES, (GLsizei)lod.IndexCount, meshProxy->GetIndexType(), meshProxy->GetIndexOffset(lod.FirstIndex),
+		(GLsizei)batch.Count, (GLuint)batch.First);
+
+	AddDrawStats(cmd.MeshCmp, cmd.SubMeshIdx, batch.Count, RDI->Stats);
 }
 
 void TiledForwardRenderer::RenderDepthPrePass(const SceneView& sceneView)
@@ -678,26 +773,26 @@ void TiledForwardRenderer::RenderDepthPrePass(const SceneView& sceneView)
 // 	glViewport((int)(sceneView.Rect.GetMin().X * screenSize.Width), (int)(sceneView.Rect.GetMin().Y * screenSize.Height),
 // 		(int)(sceneView.Rect.GetSize().X * screenSize.Width), (int)(sceneView.Rect.GetSize().Y * screenSize.Height));
 
-	const Matrix& clipFromWorld = sceneView.CameraCmp->GetClipFromWorld();
-	
-	for (const MeshRenderingComponent* meshCmp : sceneView.OpaqueQueue)
+	DepthShader.SetUniform("uScreenFromWorld", sceneView.CameraCmp->GetClipFromWorld());
+
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, RDI->FallbackWhiteTexture);
+
+	for (const RenderQueue::Batch& batch : Queues.GetDepthPrePassQueue().GetBatches())
 	{
-		const Matrix& worldFromModel = meshCmp->GetTransform().GetWorldFromModel();
-		DepthShader.SetUniform("uScreenFromModel", clipFromWorld * worldFromModel);
-		
-		for (const MeshResource::SubMesh* subMesh : meshCmp->GetMesh()->GetSubMeshes())
+		const RenderQueue::Command& cmd = Queues.GetDepthPrePassQueue().GetCommands()[batch.First];
+		if (cmd.MeshChanged)
 		{
-			glBindVertexArray(subMesh->GetMeshProxy()->GetResourceID());
-		
-			glActiveTexture(GL_TEXTURE0);
-			glBindTexture(GL_TEXTURE_2D, RDI->FallbackWhiteTexture);
-		
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
-			glBindTexture(GL_TEXTURE_2D, 0);
-			glBindVertexArray(0);
+			glBindVertexArray(cmd.MeshCmp->GetMesh()->GetSubMeshes()[cmd.SubMeshIdx]->GetMeshProxy()->GetResourceID());
+			BindInstanceTransforms(DepthPrePassInstanceBuffer);
 		}
+
+		DrawBatch(Queues.GetDepthPrePassQueue(), batch);
 	}
 
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glBindVertexArray(0);
+
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
@@ -708,21 +803,13 @@ void TiledForwardRenderer::ComputeLightCulling(const SceneView& sceneView)
 	// );
 
 	LightCullingShader.BindProgram();
-	LightCullingShader.SetUniform("uViewFromWorld", sceneView.CameraCmp->GetViewFromWorld());
-	LightCullingShader.SetUniform("uClipFromWorld", sceneView.CameraCmp->GetClipFromWorld());
-	LightCullingShader.SetUniform("uClipFromView",  sceneView.CameraCmp->GetClipFromView());
-	LightCullingShader.SetUniform("uScreenSizeX", RDI->GetScreenSize().Width);
-	LightCullingShader.SetUniform("uScreenSizeY", RDI->GetScreenSize().Height);
-	LightCullingShader.SetUniform("uWorkGroupsX", (int)WorkGroupsX);
-	LightCullingShader.SetUniform("uWorkGroupsY", (int)WorkGroupsY);
-	LightCullingShader.SetUniform("uLightCount", (int)std::min((int)sceneView.PointLights.GetSize(), MAX_NUM_LIGHTS));
 
 	// Bind depth map texture to texture location 4 (which will not be used by any model texture)
 	glActiveTexture(GL_TEXTURE0);
 	glUniform1i(glGetUniformLocation((GLuint)(LightCullingShader.GetProgramHandle()), "uDepthMap"), 0);
 	glBindTexture(GL_TEXTURE_2D, PreDepthBuffer);
 
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, LightBuffer);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, LightBuffer, LightBufferOffset, LightBufferSize);
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, VisibleLightIndicesBuffer);
 
 	glDispatchCompute(WorkGroupsX, WorkGroupsY, 1);
@@ -737,7 +824,6 @@ void TiledForwardRenderer::ComputeLightCulling(const SceneView& sceneView)
 void TiledForwardRenderer::RenderOpaqueLit(const SceneView& sceneView)
 {
 	// gConsole.LogInfo("TiledForwardRenderer::AccumulateLights");
-	float time = (float)TimeSystem::GetTimerElapsedTime(sceneView.WorldData, eEngineTimer::GAMEPLAY);
 
 	ScreenSize screenSize = RDI->GetScreenSize();
 	glViewport(0, 0, screenSize.Width, screenSize.Height);
@@ -754,62 +840,32 @@ void TiledForwardRenderer::RenderOpaqueLit(const SceneView& sceneView)
 
 	LightAccumulationShader.BindProgram();
 
-	Matrix projDirLightFromWorld = sceneView.DirectionalLights.IsEmpty() ? Matrix() : GetProjectionForShadowMap(sceneView.DirectionalLights[0]);
-
-	LightAccumulationShader.SetUniform("uDirLightFromWorld", projDirLightFromWorld);
 	LightAccumulationShader.BindSampler("uDirShadowMap", 9, DirShadowMap);
 
-	const EntityTransform& cameraTransform = sceneView.CameraCmp->GetTransform();
-
-	LightAccumulationShader.SetUniform("uTime", time);
-	LightAccumulationShader.SetUniform("uLightCount", (int)std::min((int)sceneView.PointLights.GetSize(), MAX_NUM_LIGHTS));
-	LightAccumulationShader.SetUniform("uWorkGroupsX", (int)WorkGroupsX);
-	LightAccumulationShader.SetUniform("uWorkGroupsY", (int)WorkGroupsY);
-	LightAccumulationShader.SetUniform("uViewPosition", cameraTransform.GetGlobalTranslation());
-
-	int dirLightsCount = 0;
-	for (const DirectionalLightComponent* dirLightCmp : sceneView.DirectionalLights)
-	{		
-		const EntityTransform& transform = dirLightCmp->GetTransform();
-		String baseName = String("uDirectionalLight[") + String::From(dirLightsCount) + String("].");
-		Color colorIntensity = dirLightCmp->GetColor();
-		colorIntensity.A = dirLightCmp->GetIntensity();
-		LightAccumulationShader.SetUniform(baseName + "ColorIntensity", colorIntensity);
-		LightAccumulationShader.SetUniform(baseName + "Direction", MovementSystem::GetGlobalForward(transform));
-
-		++dirLightsCount;
-		if (dirLightsCount == MAX_LIGHT_COUNT_DIRECTIONAL)
-			break;
-	}
-	LightAccumulationShader.SetUniform("uDirectionalLightCount", dirLightsCount);
-	
 	LightAccumulationShader.BindSamplerCube("uIrradianceMap", 0, SkyboxCapture.GetIrradianceMap());
 	LightAccumulationShader.BindSamplerCube("uPrefilterMap", 1, SkyboxCapture.GetPrefilterMap());
 	LightAccumulationShader.BindSampler("uBrdfLUT", 2, PreintegratedBrdfLUT);
 
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, LightBuffer);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, LightBuffer, LightBufferOffset, LightBufferSize);
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, VisibleLightIndicesBuffer);
 	
 	glBindFragDataLocation((GLuint)LightAccumulationShader.GetProgramHandle(), 0, "oColor");
 	glBindFragDataLocation((GLuint)LightAccumulationShader.GetProgramHandle(), 1, "oNormal");
 
-	const Matrix& clipFromWorld = sceneView.CameraCmp->GetClipFromWorld();
-	for (const MeshRenderingComponent* meshCmp : sceneView.OpaqueQueue)
+	for (const RenderQueue::Batch& batch : Queues.GetOpaqueLitQueue().GetBatches())
 	{
-		const EntityTransform& transform = meshCmp->GetTransform();
-		const Matrix& worldFromModel = transform.GetWorldFromModel();
-		LightAccumulationShader.SetUniform("uClipFromModel", clipFromWorld * worldFromModel);
-		LightAccumulationShader.SetUniform("uWorldFromModel", worldFromModel);
-		
-		int i = 0;
-		for (const MeshResource::SubMesh* subMesh : meshCmp->GetMesh()->GetSubMeshes())
+		const RenderQueue::Command& cmd = Queues.GetOpaqueLitQueue().GetCommands()[batch.First];
+		const MeshRenderingComponent* meshCmp = cmd.MeshCmp;
+		const MeshResource::SubMesh* subMesh = meshCmp->GetMesh()->GetSubMeshes()[cmd.SubMeshIdx];
+
+		if (cmd.MaterialChanged)
 		{
-			Material material = meshCmp->GetMaterial(i);
-			LightAccumulationShader.SetUniform("uMaterial.Emissive", material.Emissive);
-			LightAccumulationShader.SetUniform("uMaterial.Albedo", material.Albedo);
-			LightAccumulationShader.SetUniform("uMaterial.Roughness", material.Roughness); 
-			LightAccumulationShader.SetUniform("uMaterial.Metallic", material.Metallic);
-			LightAccumulationShader.SetUniform("uMaterial.OpacityMaskThreshold", material.OpacityMaskThreshold);
+			const Material& material = meshCmp->GetMaterial((int)cmd.SubMeshIdx);
+			LightAccumulationShader.SetUniform(MATERIAL_EMISSIVE, material.Emissive);
+			LightAccumulationShader.SetUniform(MATERIAL_ALBEDO, material.Albedo);
+			LightAccumulationShader.SetUniform(MATERIAL_ROUGHNESS, material.Roughness); 
+			LightAccumulationShader.SetUniform(MATERIAL_METALLIC, material.Metallic);
+			LightAccumulationShader.SetUniform(MATERIAL_OPACITY_MASK_THRESHOLD, material.OpacityMaskThreshold);
 
 			const TextureResource* emissiveMap = subMesh->GetMeshData().GetEmissiveMap();
 			const TextureResource* albedoMap = subMesh->GetMeshData().GetAlbedoMap();
@@ -819,19 +875,21 @@ void TiledForwardRenderer::RenderOpaqueLit(const SceneView& sceneView)
 			const TextureResource* ambientOcclusionMap = subMesh->GetMeshData().GetAmbientOcclusionMap();
 
 			// Material textures
-			LightAccumulationShader.BindSampler("uEmissiveMap",			3, emissiveMap			? emissiveMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
-			LightAccumulationShader.BindSampler("uAlbedoMap",			4, albedoMap			? albedoMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackWhiteTexture);
-			LightAccumulationShader.BindSampler("uRoughnessMap",		5, roughnessMap			? roughnessMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
-			LightAccumulationShader.BindSampler("uMetallicMap",			6, metallicMap			? metallicMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
-			LightAccumulationShader.BindSampler("uNormalMap",			7, normalMap			? normalMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackNormalMap);
-			LightAccumulationShader.BindSampler("uAmbientOcclusionMap",	8, ambientOcclusionMap	? ambientOcclusionMap->GetTextureProxy()->GetResourceID()	: RDI->FallbackWhiteTexture);
-
-			const GLuint subMeshVAO = (GLuint)(subMesh->GetMeshProxy()->GetResourceID());
-			glBindVertexArray(subMeshVAO);
+			LightAccumulationShader.BindSampler(EMISSIVE_MAP,			3, emissiveMap			? emissiveMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
+			LightAccumulationShader.BindSampler(ALBEDO_MAP,				4, albedoMap			? albedoMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackWhiteTexture);
+			LightAccumulationShader.BindSampler(ROUGHNESS_MAP,			5, roughnessMap			? roughnessMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
+			LightAccumulationShader.BindSampler(METALLIC_MAP,			6, metallicMap			? metallicMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
+			LightAccumulationShader.BindSampler(NORMAL_MAP,				7, normalMap			? normalMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackNormalMap);
+			LightAccumulationShader.BindSampler(AMBIENT_OCCLUSION_MAP,	8, ambientOcclusionMap	? ambientOcclusionMap->GetTextureProxy()->GetResourceID()	: RDI->FallbackWhiteTexture);
+		}
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
-			++i;
+		if (cmd.MeshChanged)
+		{
+			glBindVertexArray((GLuint)(subMesh->GetMeshProxy()->GetResourceID()));
+			BindInstanceTransforms(OpaqueLitInstanceBuffer);
 		}
+
+		DrawBatch(Queues.GetOpaqueLitQueue(), batch);
 	}
 	
 	// CHECK_GL_ERR();
@@ -917,28 +975,7 @@ void TiledForwardRenderer::RenderTranslucentLit(const SceneView& sceneView)
 	glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
 	glBlendEquation(GL_FUNC_ADD);
 
-	const EntityTransform& cameraTransform = sceneView.CameraCmp->GetTransform();
 	TranslucentShader.BindProgram();
-	TranslucentShader.SetUniform("uLightCount", (int)std::min((int)sceneView.PointLights.GetSize(), MAX_NUM_LIGHTS));
-	TranslucentShader.SetUniform("uWorkGroupsX", (int)WorkGroupsX);
-	TranslucentShader.SetUniform("uWorkGroupsY", (int)WorkGroupsY);
-	TranslucentShader.SetUniform("uViewPosition", cameraTransform.GetGlobalTranslation());
-
-	int dirLightsCount = 0;
-	for (const DirectionalLightComponent* dirLightCmp : sceneView.DirectionalLights)
-	{
-		const EntityTransform& transform = dirLightCmp->GetTransform();
-		String baseName = String("uDirectionalLight[") + String::From(dirLightsCount) + String("].");
-		Color colorIntensity = dirLightCmp->GetColor();
-		colorIntensity.A = dirLightCmp->GetIntensity();
-		TranslucentShader.SetUniform(baseName + "ColorIntensity", colorIntensity);
-		TranslucentShader.SetUniform(baseName + "Direction", MovementSystem::GetGlobalForward(transform));
-
-		++dirLightsCount;
-		if (dirLightsCount == MAX_LIGHT_COUNT_DIRECTIONAL)
-			break;
-	}
-	TranslucentShader.SetUniform("uDirectionalLightCount", dirLightsCount);
 
 	TranslucentShader.BindSamplerCube("uIrradianceMap", 0, SkyboxCapture.GetIrradianceMap());
 	TranslucentShader.BindSamplerCube("uPrefilterMap", 1, SkyboxCapture.GetPrefilterMap());
@@ -952,18 +989,18 @@ void TiledForwardRenderer::RenderTranslucentLit(const SceneView& sceneView)
 	{
 		const EntityTransform& transform = meshCmp->GetTransform();
 		const Matrix& worldFromModel = transform.GetWorldFromModel();
-		TranslucentShader.SetUniform("uClipFromModel", clipFromWorld * worldFromModel);
-		TranslucentShader.SetUniform("uWorldFromModel", worldFromModel);
+		TranslucentShader.SetUniform(CLIP_FROM_MODEL, clipFromWorld * worldFromModel);
+		TranslucentShader.SetUniform(WORLD_FROM_MODEL, worldFromModel);
 
 		int i = 0;
 		for (const MeshResource::SubMesh* subMesh : meshCmp->GetMesh()->GetSubMeshes())
 		{
 			Material material = meshCmp->GetMaterial(i);
-			TranslucentShader.SetUniform("uMaterial.Emissive", material.Emissive);
-			TranslucentShader.SetUniform("uMaterial.Albedo", material.Albedo);
-			TranslucentShader.SetUniform("uMaterial.Roughness", material.Roughness);
-			TranslucentShader.SetUniform("uMaterial.Metallic", material.Metallic);
-			TranslucentShader.SetUniform("uMaterial.OpacityMaskThreshold", material.OpacityMaskThreshold);
+			TranslucentShader.SetUniform(MATERIAL_EMISSIVE, material.Emissive);
+			TranslucentShader.SetUniform(MATERIAL_ALBEDO, material.Albedo);
+			TranslucentShader.SetUniform(MATERIAL_ROUGHNESS, material.Roughness);
+			TranslucentShader.SetUniform(MATERIAL_METALLIC, material.Metallic);
+			TranslucentShader.SetUniform(MATERIAL_OPACITY_MASK_THRESHOLD, material.OpacityMaskThreshold);
 
 			const TextureResource* emissiveMap = subMesh->GetMeshData().GetEmissiveMap();
 			const TextureResource* albedoMap = subMesh->GetMeshData().GetAlbedoMap();
@@ -973,17 +1010,20 @@ void TiledForwardRenderer::RenderTranslucentLit(const SceneView& sceneView)
 			const TextureResource* ambientOcclusionMap = subMesh->GetMeshData().GetAmbientOcclusionMap();
 
 			// Material textures
-			TranslucentShader.BindSampler("uEmissiveMap",			3, emissiveMap			? emissiveMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackBlackTexture);
-			TranslucentShader.BindSampler("uAlbedoMap",				4, albedoMap			? albedoMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackWhiteTexture);
-			TranslucentShader.BindSampler("uRoughnessMap",			5, roughnessMap			? roughnessMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
-			TranslucentShader.BindSampler("uMetallicMap",			6, metallicMap			? metallicMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
-			TranslucentShader.BindSampler("uNormalMap",				7, normalMap			? normalMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackNormalMap);
-			TranslucentShader.BindSampler("uAmbientOcclusionMap",	8, ambientOcclusionMap	? ambientOcclusionMap->GetTextureProxy()->GetResourceID()	: RDI->FallbackWhiteTexture);
-
-			const GLuint subMeshVAO = (GLuint)(subMesh->GetMeshProxy()->GetResourceID());
+			TranslucentShader.BindSampler(EMISSIVE_MAP,				3, emissiveMap			? emissiveMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackBlackTexture);
+			TranslucentShader.BindSampler(ALBEDO_MAP,				4, albedoMap			? albedoMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackWhiteTexture);
+			TranslucentShader.BindSampler(ROUGHNESS_MAP,			5, roughnessMap			? roughnessMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
+			TranslucentShader.BindSampler(METALLIC_MAP,				6, metallicMap			? metallicMap->GetTextureProxy()->GetResourceID()			: RDI->FallbackWhiteTexture);
+			TranslucentShader.BindSampler(NORMAL_MAP,				7, normalMap			? normalMap->GetTextureProxy()->GetResourceID()				: RDI->FallbackNormalMap);
+			TranslucentShader.BindSampler(AMBIENT_OCCLUSION_MAP,	8, ambientOcclusionMap	? ambientOcclusionMap->GetTextureProxy()->GetResourceID()	: RDI->FallbackWhiteTexture);
+
+			const GLMeshDeviceProxy* meshProxy = static_cast<const GLMeshDeviceProxy*>(subMesh->GetMeshProxy());
+			const GLuint subMeshVAO = meshProxy->GetVAO();
 			glBindVertexArray(subMeshVAO);
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
+			const Mesh::Lod lod = subMesh->GetMeshData().GetLod(meshCmp->GetLodLevel());
+			glDrawElements(GL_TRIANGLES, (GLsizei)lod.IndexCount, meshProxy->GetIndexType(), meshProxy->GetIndexOffset(lod.FirstIndex));
+			AddDrawStats(meshCmp, i, 1, RDI->Stats);
 			++i;
 		}
 	}
@@ -1323,30 +1363,18 @@ void TiledForwardRenderer::EditorDebug(const SceneView& sceneView)
 
 	// Render Lines
 	{
-		auto debugLinesComponent = sceneView.WorldData->GetWorldComponent<DebugDrawStateWorldComponent>();
-		auto& debugLines = debugLinesComponent->DebugLines;
-		auto& debugLinesColors = debugLinesComponent->DebugLinesColors;
-
-		DebugRenderingBuffers debugLinesBuffers; // vertex and color buffer
-
-												 // set up buffer
-		glBindVertexArray(debugLinesBuffers.VAO);
-		glBindBuffer(GL_ARRAY_BUFFER, debugLinesBuffers.VBO);
-		glBufferData(GL_ARRAY_BUFFER, debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine)
-			+ debugLinesColors.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLineColor), NULL, GL_STATIC_DRAW);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine), (GLvoid*)debugLines.GetData());
-		glBufferSubData(GL_ARRAY_BUFFER, debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine), debugLinesColors.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLineColor), (GLvoid*)debugLinesColors.GetData());
-		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vector3f), NULL);
-		glEnableVertexAttribArray(0);
-		glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Color), (GLvoid*)(debugLines.GetSize() * sizeof(DebugDrawStateWorldComponent::DebugLine)));
-		glEnableVertexAttribArray(1);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-		glDrawArrays(GL_LINES, 0, (GLsizei)debugLines.GetSize() * 2);
-		glBindVertexArray(0);
+		DebugDrawStateWorldComponent* debugLinesComponent = sceneView.WorldData->GetWorldComponent<DebugDrawStateWorldComponent>();
+		const GLsizei vertexCount = DebugLinesBuffers->SetContent(*debugLinesComponent);
 
-		debugLines.Clear();
-		debugLinesColors.Clear();
+		if (vertexCount > 0)
+		{
+			glBindVertexArray(DebugLinesBuffers->VAO);
+			glDrawArrays(GL_LINES, 0, vertexCount);
+			glBindVertexArray(0);
+		}
+
+		debugLinesComponent->DebugLines.Clear();
+		debugLinesComponent->DebugLinesColors.Clear();
 	}
 
 	glEnable(GL_DEPTH_TEST);
@@ -1402,77 +1430,29 @@ void TiledForwardRenderer::UIText2D(const SceneView& sceneView)
 	glEnable(GL_DEPTH_TEST);
 }
 
-void TiledForwardRenderer::SetupLightsBufferFromScene()
-{
-	if (LightBuffer == 0)
-	{
-		return;
-	}
-
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, LightBuffer);
-	Light *lights = (Light*)glMapBuffer(GL_SHADER_STORAGE_BUFFER, GL_READ_WRITE);
-
-	for (int i = 0; i < MAX_NUM_LIGHTS; ++i)
-	{
-		Light &light = lights[i];
-		light.Position = Vector::ZERO;
-		light.Color = Vector::ZERO;
-		light.RangeIntensity = Vector(-1.0f, 0.0f, 0.0f);
-	}
-
-	glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
-}
-
 void TiledForwardRenderer::UpdateLightsBufferFromScene(const SceneView& sceneView)
 {
-	Dynarray<Vector> positions;
-	Dynarray<Vector> color;
-	Dynarray<Vector> rangeIntensity;
-
-	int lightCounter = 0;
-	for (const PointLightComponent* pointLightCmp : sceneView.PointLights)
+	if ((int)sceneView.PointLights.GetSize() > MAX_NUM_LIGHTS)
+		gConsole.LogInfo("TiledForwardRenderer::UpdateLightsBufferFromScene more lights than supported by renderer({})", MAX_NUM_LIGHTS);
+
+	// shaders read only uLightCount lights, buffer range can not be empty though
+	const int lightCount = std::min((int)sceneView.PointLights.GetSize(), MAX_NUM_LIGHTS);
+	LightBufferSize = (GLsizeiptr)(sizeof(Light) * std::max(lightCount, 1));
+	const GLStreamingAllocation allocation = RDI->GetStreamingBuffer().Map((size_t)LightBufferSize);
+	LightBuffer = allocation.Buffer;
+	LightBufferOffset = (GLintptr)allocation.Offset;
+	Light* lights = static_cast<Light*>(allocation.Data);
+
+	for (int i = 0; i < lightCount; ++i)
 	{
-		const EntityTransform& transform = pointLightCmp->GetTransform();
-
-		positions.PushBack(transform.GetGlobalTranslation());
-		color.PushBack(Vector(pointLightCmp->GetColor()));
-		rangeIntensity.PushBack(Vector(pointLightCmp->GetRange(), pointLightCmp->GetIntensity(), 0.0f));
-
-		++lightCounter;
-
-		if (lightCounter > MAX_NUM_LIGHTS)
-		{
-			gConsole.LogInfo("TiledForwardRenderer::UpdateLightsBufferFromScene more lights than supported by renderer({})", MAX_NUM_LIGHTS);
-			break;
-		}
+		const PointLightComponent* pointLightCmp = sceneView.PointLights[i];
+		Light& light = lights[i];
+		light.Position = pointLightCmp->GetTransform().GetGlobalTranslation();
+		light.Color = Vector(pointLightCmp->GetColor());
+		light.RangeIntensity = Vector(pointLightCmp->GetRange(), pointLightCmp->GetIntensity(), 0.0f);
 	}
 
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, LightBuffer);
-	Light *lights = (Light*)glMapBuffer(GL_SHADER_STORAGE_BUFFER, GL_READ_WRITE);
-
-	for (int i = 0; i < lightCounter; ++i)
-	{
-		Light &light = lights[i];
-		light.Position = positions[i];
-		light.Color = color[i];
-		light.RangeIntensity = rangeIntensity[i];
-
-		// 		gConsole.LogInfo("TiledForwardRenderer::UpdateLightsBufferFromScene set Position: {}, Radius: {}",
-		// 			light.Position, light.Radius);
-	}
-
-	int remainingSlots = MAX_NUM_LIGHTS - lightCounter;
-	for (int i = 0; i < remainingSlots; ++i)
-	{
-		Light &light = lights[lightCounter + i];
-		light.Position = Vector::ZERO;
-		light.Color = Vector::ZERO;
-		light.RangeIntensity = Vector(-1.0f, 0.0f, 0.0f);
-	}
-
-	glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+	RDI->GetStreamingBuffer().Unmap(allocation);
 }
 
 void TiledForwardRenderer::DebugDepthPrepass(const SceneView& sceneView)
@@ -1501,7 +1481,7 @@ void TiledForwardRenderer::DebugLightAccum(const SceneView& sceneView)
 	DebugLightAccumShader.SetUniform("uWorkGroupsY", (int)WorkGroupsY);
 	DebugLightAccumShader.SetUniform("uLightCount", (int)std::min((int)sceneView.PointLights.GetSize(), MAX_NUM_LIGHTS));
 
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, LightBuffer);
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, LightBuffer, LightBufferOffset, LightBufferSize);
 	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, VisibleLightIndicesBuffer);
 
 	const Matrix& clipFromWorld = sceneView.CameraCmp->GetClipFromWorld();
@@ -1521,7 +1501,7 @@ void TiledForwardRenderer::DebugLightAccum(const SceneView& sceneView)
 			glActiveTexture(GL_TEXTURE0);
 			glBindTexture(GL_TEXTURE_2D, RDI->FallbackWhiteTexture);
 
-			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, GL_UNSIGNED_INT, NULL);
+			glDrawElements(GL_TRIANGLES, (GLsizei)subMesh->GetMeshData().GetTriangleCount() * 3, meshProxy->GetIndexType(), NULL);
 			glBindTexture(GL_TEXTURE_2D, 0);
 			glBindVertexArray(0);
 		}
@@ -4,7 +4,9 @@
 #include "IRendererInterface.hpp"
 #include "Proxy/GLShaderProgram.hpp"
 #include "Common/GLUtils.hpp"
+#include "Common/DebugRenderingBuffers.hpp"
 #include "Pipeline/EnvCapture.hpp"
+#include <Rendering/SceneView.hpp>
 
 namespace Poly {
 
@@ -49,6 +51,7 @@ namespace Poly {
 		void Resize(const ScreenSize& size) override;
 
 		void Render(const SceneView& sceneView) override;
+		Optional<AABox> GetDirShadowVolume() const override;
 
 		void Deinit() override;
 
@@ -66,6 +69,52 @@ namespace Poly {
 			int Index;
 		};
 
+		// std140 uniform blocks shared by lit shaders, declared as row_major so matrices are copied as they are
+		struct ViewUniforms
+		{
+			Matrix ClipFromWorld;
+			Matrix ViewFromWorld;
+			Matrix ClipFromView;
+			Matrix DirLightFromWorld;
+			Vector ViewPosition;
+			float Time;
+			i32 ScreenSizeX;
+			i32 ScreenSizeY;
+			i32 WorkGroupsX;
+			i32 WorkGroupsY;
+			i32 LightCount;
+		};
+
+		struct DirectionalLightUniforms
+		{
+			struct DirectionalLight
+			{
+				Color ColorIntensity;
+				Vector Direction;
+			};
+			DirectionalLight DirectionalLights[8];
+			i32 DirectionalLightCount;
+		};
+
+		// binding points of uniform blocks, match layout qualifiers in shaders
+		static constexpr GLuint VIEW_UNIFORMS_BINDING = 0;
+		static constexpr GLuint DIRECTIONAL_LIGHT_UNIFORMS_BINDING = 1;
+
+		// Opaque geometry sorted to minimize state changes, rebuilt for every scene view
+		SceneRenderQueues Queues;
+
+		// World transforms of queued draws in sorted order, read as per instance vertex attributes
+		GLuint DirShadowInstanceBuffer = 0;
+		GLuint DepthPrePassInstanceBuffer = 0;
+		GLuint OpaqueLitInstanceBuffer = 0;
+		Dynarray<float> InstanceTransforms;
+
+		std::unique_ptr<DebugRenderingBuffers> DebugLinesBuffers;
+
+		// Per view data uploaded once per scene view instead of setting uniforms of every shader
+		GLuint ViewUniformBuffer = 0;
+		GLuint DirectionalLightUniformBuffer = 0;
+
 		Matrix PreviousFrameCameraTransform;
 		Matrix PreviousFrameCameraClipFromWorld;
 
@@ -79,8 +128,11 @@ namespace Poly {
 		GLuint WorkGroupsX = 0;
 		GLuint WorkGroupsY = 0;
 
-		// Used for storage buffer objects to hold light data and visible light indicies data
+		// Used for storage buffer objects to hold light data and visible light indicies data,
+		// light data is written to streaming buffer for every view
 		GLuint LightBuffer = 0;
+		GLintptr LightBufferOffset = 0;
+		GLsizeiptr LightBufferSize = 0;
 		GLuint VisibleLightIndicesBuffer = 0;
 
 		// Render Targets
@@ -145,12 +197,20 @@ namespace Poly {
 
 		void DeleteRenderTargets();
 
-		void SetupLightsBufferFromScene();
-
 		void UpdateLightsBufferFromScene(const SceneView& sceneView);
 
 		void UpdateEnvCapture(const SceneView& sceneView);
 
+		void FillRenderQueues(const SceneView& sceneView);
+
+		void UploadViewUniforms(const SceneView& sceneView);
+
+		void UploadInstanceTransforms(const RenderQueue& queue, GLuint instanceBuffer);
+
+		static void BindInstanceTransforms(GLuint instanceBuffer);
+
+		void DrawBatch(const RenderQueue& queue, const RenderQueue::Batch& batch);
+
 		void RenderDepthPrePass(const SceneView& sceneView);
 
 		void ComputeLightCulling(const SceneView& sceneView);
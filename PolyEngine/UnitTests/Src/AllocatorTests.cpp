@@ -3,6 +3,10 @@
 
 #include <Memory/PoolAllocator.hpp>
 #include <Memory/IterablePoolAllocator.hpp>
+#include <Memory/BitmapPoolAllocator.hpp>
+#include <Memory/FrameAllocator.hpp>
+#include <Collections/Dynarray.hpp>
+#include <Math/Vector.hpp>
 
 using namespace Poly;
 
@@ -99,4 +103,150 @@ TEST_CASE("Iterable pool allocator corner case test", "[Allocator]") {
 	size_t* e = allocator.Alloc();
 	REQUIRE(e != nullptr);
 	REQUIRE(allocator.GetSize() == 3);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Bitmap pool allocator", "[Allocator]") {
+	// test allocation
+	BitmapPoolAllocator<size_t> allocator(10);
+	REQUIRE(allocator.GetSize() == 0);
+	REQUIRE(allocator.Begin() == allocator.End());
+
+	size_t* a = allocator.Alloc();
+	REQUIRE(a != nullptr);
+	REQUIRE(allocator.GetSize() == 1);
+
+	size_t* b = allocator.Alloc();
+	REQUIRE(b == a + 1);
+	REQUIRE(allocator.GetSize() == 2);
+
+	size_t* c = allocator.Alloc();
+	REQUIRE(c == a + 2);
+	REQUIRE(allocator.GetSize() == 3);
+
+	// freed cell is reused before cells after it
+	allocator.Free(b);
+	REQUIRE(allocator.GetSize() == 2);
+	size_t* b_2 = allocator.Alloc();
+	REQUIRE(b_2 == b);
+	REQUIRE(allocator.GetSize() == 3);
+
+	// test iterators
+	*a = 1;
+	*b_2 = 2;
+	*c = 3;
+
+	size_t i = 0;
+	for (size_t val : allocator)
+		REQUIRE(val == ++i);
+	REQUIRE(i == 3);
+
+	auto it = allocator.End();
+	for (size_t j = 3; j > 0; --j)
+		REQUIRE(*(--it) == j);
+	REQUIRE(it == allocator.Begin());
+
+	// exhaust the pool
+	while (allocator.GetFreeBlockCount() > 0)
+		REQUIRE(allocator.Alloc() != nullptr);
+	REQUIRE(allocator.GetSize() == 10);
+	REQUIRE(allocator.Alloc() == nullptr);
+}
+
+TEST_CASE("Bitmap pool allocator iteration over sparse blocks", "[Allocator]") {
+	const size_t count = 5000;
+	BitmapPoolAllocator<size_t> allocator(count);
+
+	Dynarray<size_t*> ptrs;
+	for (size_t i = 0; i < count; ++i)
+	{
+		size_t* p = allocator.Alloc();
+		REQUIRE(p != nullptr);
+		*p = i;
+		ptrs.PushBack(p);
+	}
+	REQUIRE(allocator.Alloc() == nullptr);
+
+	// leave only a few survivors, far apart from each other (whole 64-cell blocks become empty)
+	const size_t survivors[] = { 0, 63, 64, 1000, 4095, 4096, 4999 };
+	size_t survivorIdx = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (survivorIdx < 7 && survivors[survivorIdx] == i)
+			++survivorIdx;
+		else
+			allocator.Free(ptrs[i]);
+	}
+	REQUIRE(allocator.GetSize() == 7);
+
+	survivorIdx = 0;
+	for (size_t val : allocator)
+		REQUIRE(val == survivors[survivorIdx++]);
+	REQUIRE(survivorIdx == 7);
+
+	const BitmapPoolAllocator<size_t>& constAllocator = allocator;
+	auto it = constAllocator.End();
+	while (survivorIdx > 0)
+		REQUIRE(*(--it) == survivors[--survivorIdx]);
+	REQUIRE(it == constAllocator.Begin());
+
+	// new allocations fill the lowest free cells first
+	REQUIRE(allocator.Alloc() == ptrs[1]);
+	REQUIRE(allocator.Alloc() == ptrs[2]);
+}
+
+namespace
+{
+	std::atomic<size_t> gHeapAllocationCount(0);
+	void CountAllocation(size_t) { ++gHeapAllocationCount; }
+}
+
+TEST_CASE("Linear allocator", "[Allocator]") {
+	LinearAllocator allocator(64);
+	REQUIRE(allocator.GetCapacity() == 64);
+
+	char* a = static_cast<char*>(allocator.Alloc(1));
+	char* b = static_cast<char*>(allocator.Alloc(20));
+	char* c = static_cast<char*>(allocator.Alloc(16));
+	REQUIRE(reinterpret_cast<size_t>(a) % Impl::MEM_ALIGNMENT == 0);
+	REQUIRE(b == a + 16);
+	REQUIRE(c == b + 32);
+	REQUIRE(allocator.GetUsedSize() == 64);
+
+	// does not fit the block, served from heap
+	char* d = static_cast<char*>(allocator.Alloc(32));
+	REQUIRE(d != nullptr);
+	REQUIRE((d < a || d >= a + 64));
+	REQUIRE(allocator.GetUsedSize() == 96);
+
+	// block grows to fit previous usage
+	allocator.Reset();
+	REQUIRE(allocator.GetUsedSize() == 0);
+	REQUIRE(allocator.GetCapacity() >= 96);
+	char* e = static_cast<char*>(allocator.Alloc(96));
+	REQUIRE(static_cast<char*>(allocator.Alloc(0)) == e + 96);
+}
+
+TEST_CASE("Frame allocator", "[Allocator]") {
+	FrameAllocator::EndFrame();
+
+	SECTION("Memory lives until end of next frame") {
+		FrameDynarray<int> previous = { 1, 2, 3 };
+		FrameAllocator::EndFrame();
+		FrameDynarray<int> current = { 4, 5, 6 };
+		REQUIRE(previous == FrameDynarray<int>({ 1, 2, 3 }));
+		REQUIRE(current.GetData() != previous.GetData());
+		FrameAllocator::EndFrame();
+		REQUIRE(FrameAllocator::GetCurrentArena().GetUsedSize() == 0);
+	}
+
+	SECTION("Allocation hook sees heap allocations only") {
+		gHeapAllocationCount = 0;
+		SetAllocationHook(&CountAllocation);
+		FrameDynarray<size_t> frame;
+		frame.PushBack(1);
+		Dynarray<size_t> heap;
+		heap.PushBack(1);
+		SetAllocationHook(nullptr);
+		REQUIRE(gHeapAllocationCount == 1);
+	}
+}
@@ -0,0 +1,256 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Resources/AssetCache.hpp>
+#include <Resources/MeshResource.hpp>
+#include <Math/Vector.hpp>
+#include <Math/Vector3f.hpp>
+#include <Utils/FileIO.hpp>
+#include <Configs/AssetsPathConfig.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	constexpr u32 TEST_MAGIC = 0x54534554; // "TEST"
+
+	BinaryBuffer ToBuffer(const AssetCacheWriter& writer)
+	{
+		BinaryBuffer buffer(writer.GetData().GetSize());
+		memcpy(buffer.GetData(), writer.GetData().GetData(), buffer.GetSize());
+		return buffer;
+	}
+}
+
+TEST_CASE("Asset cache round trip", "[AssetCache]")
+{
+	Dynarray<Vector3f> positions;
+	Dynarray<u32> indices;
+	positions.Resize(100);
+	for (size_t i = 0; i < positions.GetSize(); ++i)
+	{
+		positions[i].X = float(i);
+		positions[i].Y = float(2 * i);
+		positions[i].Z = float(3 * i);
+		indices.PushBack(u32(99 - i));
+	}
+
+	AssetCacheWriter writer(TEST_MAGIC, 1, 0x1234);
+	writer.Write<u8>(7); // arrays are aligned regardless of preceding data
+	writer.WriteArray(positions);
+	writer.WriteString("textures/albedo.png");
+	writer.WriteArray(Dynarray<Vector>());
+	writer.WriteArray(indices);
+	writer.Write(Vector(1, 2, 3));
+	const BinaryBuffer data = ToBuffer(writer);
+
+	AssetCacheReader reader(data);
+	REQUIRE(reader.IsUpToDate(TEST_MAGIC, 1, 0x1234));
+	REQUIRE_FALSE(reader.IsUpToDate(TEST_MAGIC, 1, 0x1235));
+	REQUIRE_FALSE(reader.IsUpToDate(TEST_MAGIC, 2, 0x1234));
+	REQUIRE_FALSE(reader.IsUpToDate(TEST_MAGIC + 1, 1, 0x1234));
+
+	Dynarray<Vector3f> readPositions;
+	Dynarray<Vector> readEmpty;
+	Dynarray<u32> readIndices;
+	REQUIRE(reader.Read<u8>() == 7);
+	reader.ReadArray(readPositions);
+	REQUIRE(reader.ReadString() == "textures/albedo.png");
+	reader.ReadArray(readEmpty);
+	size_t indexCount = 0;
+	const u32* indexView = reader.ReadArrayView<u32>(indexCount);
+	REQUIRE(reinterpret_cast<uintptr_t>(indexView) % 16 == 0);
+	for (size_t i = 0; i < indexCount; ++i)
+		readIndices.PushBack(indexView[i]);
+	REQUIRE(reader.Read<Vector>() == Vector(1, 2, 3));
+
+	REQUIRE(readPositions.GetSize() == positions.GetSize());
+	REQUIRE(readIndices.GetSize() == indices.GetSize());
+	REQUIRE(readEmpty.IsEmpty());
+	for (size_t i = 0; i < positions.GetSize(); ++i)
+	{
+		REQUIRE(readPositions[i].X == positions[i].X);
+		REQUIRE(readPositions[i].Y == positions[i].Y);
+		REQUIRE(readPositions[i].Z == positions[i].Z);
+		REQUIRE(readIndices[i] == indices[i]);
+	}
+
+	// reading past the end is reported as failed load
+	REQUIRE_THROWS_AS(reader.Read<u8>(), ResourceLoadFailedException);
+}
+
+TEST_CASE("Asset cache rejects corrupted data", "[AssetCache]")
+{
+	Dynarray<u32> indices;
+	indices.Resize(64);
+	AssetCacheWriter writer(TEST_MAGIC, 1, 42);
+	writer.WriteArray(indices);
+	const BinaryBuffer data = ToBuffer(writer);
+
+	// truncated file
+	BinaryBuffer truncated(data.GetSize() - 4);
+	memcpy(truncated.GetData(), data.GetData(), truncated.GetSize());
+	AssetCacheReader truncatedReader(truncated);
+	REQUIRE(truncatedReader.IsUpToDate(TEST_MAGIC, 1, 42));
+	Dynarray<u32> readIndices;
+	REQUIRE_THROWS_AS(truncatedReader.ReadArray(readIndices), ResourceLoadFailedException);
+
+	// not a cooked mesh
+	BinaryBuffer garbage(8);
+	memset(garbage.GetData(), 0xAB, garbage.GetSize());
+	REQUIRE_FALSE(AssetCacheReader(garbage).IsUpToDate(TEST_MAGIC, 1, 42));
+
+	// same content hashes the same
+	REQUIRE(HashAssetSource(data) == HashAssetSource(ToBuffer(writer)));
+	REQUIRE(HashAssetSource(data) != HashAssetSource(truncated));
+}
+
+namespace
+{
+	class DecodedMesh : public MeshResource
+	{
+	public:
+		DecodedMesh() : MeshResource(ResourceAsyncLoadTag{}) {}
+
+		using MeshResource::Decode;
+		using MeshResource::Import;
+	};
+
+	// size x size grid in XZ plane with optional height waves, written as Wavefront OBJ
+	void WriteGrid(const String& path, size_t gridSize, float amplitude)
+	{
+		FILE* f;
+		fopen_s(&f, path.GetCStr(), "w");
+		REQUIRE(f);
+		for (size_t y = 0; y < gridSize; ++y)
+			for (size_t x = 0; x < gridSize; ++x)
+			{
+				const float height = amplitude * std::sin(0.3f * float(x)) * std::cos(0.2f * float(y));
+				fprintf(f, "v %f %f %f\nvt %f %f\nvn 0 1 0\n", float(x), height, float(y), float(x) / gridSize, float(y) / gridSize);
+			}
+		for (size_t y = 0; y + 1 < gridSize; ++y)
+			for (size_t x = 0; x + 1 < gridSize; ++x)
+			{
+				const size_t v = y * gridSize + x + 1;
+				fprintf(f, "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", v, v, v, v + gridSize, v + gridSize, v + gridSize, v + 1, v + 1, v + 1);
+				fprintf(f, "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n", v + 1, v + 1, v + 1, v + gridSize, v + gridSize, v + gridSize, v + gridSize + 1, v + gridSize + 1, v + gridSize + 1);
+			}
+		fclose(f);
+	}
+
+	template<typename T, typename Equal>
+	void RequireEqualArrays(const Dynarray<T>& a, const Dynarray<T>& b, const Equal& equal)
+	{
+		REQUIRE(a.GetSize() == b.GetSize());
+		for (size_t i = 0; i < a.GetSize(); ++i)
+			REQUIRE(equal(a[i], b[i]));
+	}
+}
+
+TEST_CASE("Asset cache paths", "[AssetCache]")
+{
+	const String& cacheDirectory = gAssetsPathConfig.GetAssetCacheDirectory();
+	const String path = GetAssetCachePath("../Games/Game/Res/Models/box.obj", MeshResource::COOKED_EXTENSION);
+	const String otherPath = GetAssetCachePath("../Engine/Res/Models/box.obj", MeshResource::COOKED_EXTENSION);
+
+	// cooked files live in the cache directory, not next to sources
+	const size_t extensionLength = strlen(MeshResource::COOKED_EXTENSION);
+	REQUIRE(path.Substring(cacheDirectory.GetLength()) == cacheDirectory);
+	REQUIRE(path.Substring(path.GetLength() - extensionLength, path.GetLength()) == MeshResource::COOKED_EXTENSION);
+	REQUIRE(path.Substring(cacheDirectory.GetLength(), cacheDirectory.GetLength() + 8) == "box.obj.");
+	REQUIRE_FALSE(path == otherPath);
+	REQUIRE(path == GetAssetCachePath("../Games/Game/Res/Models/box.obj", MeshResource::COOKED_EXTENSION));
+	REQUIRE_FALSE(path == GetAssetCachePath("../Games/Game/Res/Models/box.obj", MeshResource::COOKED_EXTENSION, 1));
+
+	// missing directories are created when saving
+	const String nestedPath = cacheDirectory + "AssetCacheTests/nested/test.bin";
+	AssetCacheWriter writer(TEST_MAGIC, 1, 0);
+	REQUIRE(writer.SaveToFile(nestedPath));
+	REQUIRE(remove(nestedPath.GetCStr()) == 0);
+}
+
+TEST_CASE("Cooked mesh matches imported mesh", "[AssetCache]")
+{
+	const String path = "MeshCacheRoundTrip.obj";
+	WriteGrid(path, 40, 2.f);
+	remove(GetAssetCachePath(path, MeshResource::COOKED_EXTENSION).GetCStr());
+
+	DecodedMesh imported;
+	imported.Decode(path); // imports and cooks the mesh
+	DecodedMesh cooked;
+	cooked.Decode(path);
+
+	REQUIRE(imported.GetSubMeshes().GetSize() == 1);
+	REQUIRE(cooked.GetSubMeshes().GetSize() == 1);
+	REQUIRE(cooked.GetAABox().GetMin() == imported.GetAABox().GetMin());
+	REQUIRE(cooked.GetAABox().GetSize() == imported.GetAABox().GetSize());
+
+	const MeshResource::SubMesh* importedSubMesh = imported.GetSubMeshes()[0];
+	const MeshResource::SubMesh* cookedSubMesh = cooked.GetSubMeshes()[0];
+	REQUIRE(cookedSubMesh->GetAABox().GetMin() == importedSubMesh->GetAABox().GetMin());
+	REQUIRE(cookedSubMesh->GetAABox().GetSize() == importedSubMesh->GetAABox().GetSize());
+	RequireEqualArrays(cookedSubMesh->GetBones(), importedSubMesh->GetBones(),
+		[](const MeshResource::SubMesh::Bone& a, const MeshResource::SubMesh::Bone& b) { return a.name == b.name; });
+
+	const Mesh& a = importedSubMesh->GetMeshData();
+	const Mesh& b = cookedSubMesh->GetMeshData();
+	const auto equalVectors = [](const Vector3f& u, const Vector3f& v) { return u.X == v.X && u.Y == v.Y && u.Z == v.Z; };
+	RequireEqualArrays(a.GetPositions(), b.GetPositions(), equalVectors);
+	RequireEqualArrays(a.GetNormals(), b.GetNormals(), equalVectors);
+	RequireEqualArrays(a.GetTangents(), b.GetTangents(), equalVectors);
+	RequireEqualArrays(a.GetBitangents(), b.GetBitangents(), equalVectors);
+	RequireEqualArrays(a.GetTextCoords(), b.GetTextCoords(),
+		[](const Mesh::TextCoord& u, const Mesh::TextCoord& v) { return u.U == v.U && u.V == v.V; });
+	RequireEqualArrays(a.GetIndicies(), b.GetIndicies(), std::equal_to<u32>());
+	RequireEqualArrays(a.GetPackedAttributes(), b.GetPackedAttributes(), [](const Mesh::PackedAttributes& u, const Mesh::PackedAttributes& v) {
+		return u.Normal == v.Normal && u.Tangent == v.Tangent && u.TextCoord[0] == v.TextCoord[0] && u.TextCoord[1] == v.TextCoord[1];
+	});
+	RequireEqualArrays(a.GetLodIndices(), b.GetLodIndices(), std::equal_to<u32>());
+	REQUIRE(b.GetVertexSize() == a.GetVertexSize());
+
+	// grid is large enough to be simplified on import
+	REQUIRE(a.HasPackedAttributes());
+	REQUIRE(a.GetLodCount() > 1);
+	REQUIRE(b.GetLodCount() == a.GetLodCount());
+	for (size_t level = 0; level < a.GetLodCount(); ++level)
+	{
+		REQUIRE(b.GetLod(level).FirstIndex == a.GetLod(level).FirstIndex);
+		REQUIRE(b.GetLod(level).IndexCount == a.GetLod(level).IndexCount);
+		REQUIRE(b.GetLod(level).Error == a.GetLod(level).Error);
+	}
+
+	remove(path.GetCStr());
+	remove(GetAssetCachePath(path, MeshResource::COOKED_EXTENSION).GetCStr());
+}
+
+TEST_CASE("Mesh load benchmark", "[.][Benchmark]")
+{
+	// 512 x 512 grid written as Wavefront OBJ
+	const String path = "MeshCacheBenchmark.obj";
+	WriteGrid(path, 512, 0.f);
+	remove(GetAssetCachePath(path, MeshResource::COOKED_EXTENSION).GetCStr());
+
+	size_t importedVertices = 0;
+	BENCHMARK("Assimp import 512x512 grid")
+	{
+		DecodedMesh mesh;
+		mesh.Import(path);
+		importedVertices = mesh.GetSubMeshes()[0]->GetMeshData().GetVertexCount();
+	}
+
+	{
+		DecodedMesh mesh;
+		mesh.Decode(path); // cooks the mesh
+	}
+	size_t cookedVertices = 0;
+	BENCHMARK("Cooked mesh load 512x512 grid")
+	{
+		DecodedMesh mesh;
+		mesh.Decode(path);
+		cookedVertices = mesh.GetSubMeshes()[0]->GetMeshData().GetVertexCount();
+	}
+	REQUIRE(cookedVertices == importedVertices);
+
+	remove(path.GetCStr());
+	remove(GetAssetCachePath(path, MeshResource::COOKED_EXTENSION).GetCStr());
+}
@@ -3,6 +3,7 @@
 
 #include <ECS/Scene.hpp>
 #include <ECS/DeferredTaskSystem.hpp>
+#include <Threading/JobSystem.hpp>
 // test components
 #include <Audio/SoundListenerComponent.hpp>
 #include <Movement/FreeFloatMovementComponent.hpp>
@@ -131,4 +132,163 @@ TEST_CASE("Scene component iteration tests.", "ComponentIterator")
 	}
 	REQUIRE(i == 1);
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Scene component iteration with archetype storage.", "ComponentIterator")
+{
+	Scene* w = new Scene(eComponentStorageMode::ARCHETYPE);
+	DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(w);
+	Entity* e[6];
+
+	for (size_t i = 0; i < 6; ++i)
+	{
+		e[i] = DeferredTaskSystem::SpawnEntityImmediate(w);
+		if (i < 4)
+			DeferredTaskSystem::AddComponentImmediate<SoundListenerComponent>(w, e[i]);
+		if (i % 2 == 1)
+			DeferredTaskSystem::AddComponentImmediate<FreeFloatMovementComponent>(w, e[i]);
+		if (i >= 3)
+			DeferredTaskSystem::AddComponentImmediate<PostprocessSettingsComponent>(w, e[i]);
+	}
+
+	//	
+	//	SoundListenerComponent			|	0 1 2 3
+	//	FreeFloatMovementComponent		|	  1   3   5
+	//	PostprocessSettingsComponent	|	      3 4 5
+	//
+
+	auto count = [](auto proxy)
+	{
+		int i = 0;
+		for (auto c : proxy)
+		{
+			UNUSED(c);
+			++i;
+		}
+		return i;
+	};
+
+	REQUIRE(count(w->IterateComponents<SoundListenerComponent>()) == 4);
+	REQUIRE(count(w->IterateComponents<FreeFloatMovementComponent>()) == 3);
+	REQUIRE(count(w->IterateComponents<PostprocessSettingsComponent>()) == 3);
+	REQUIRE(count(w->IterateComponents<SoundListenerComponent, FreeFloatMovementComponent>()) == 2);
+	REQUIRE(count(w->IterateComponents<FreeFloatMovementComponent, PostprocessSettingsComponent>()) == 2);
+	REQUIRE(count(w->IterateComponents<PostprocessSettingsComponent, FreeFloatMovementComponent, SoundListenerComponent>()) == 1);
+
+	for (auto [listener, movement] : w->IterateComponents<SoundListenerComponent, FreeFloatMovementComponent>())
+	{
+		REQUIRE(listener->GetOwner() == movement->GetOwner());
+		REQUIRE(listener->GetOwner()->GetComponent<FreeFloatMovementComponent>() == movement);
+	}
+
+	// structural changes move entities between archetypes
+	DeferredTaskSystem::AddComponentImmediate<FreeFloatMovementComponent>(w, e[0]);
+	REQUIRE(count(w->IterateComponents<SoundListenerComponent, FreeFloatMovementComponent>()) == 3);
+
+	DeferredTaskSystem::DestroyEntityImmediate(w, e[3]);
+	REQUIRE(count(w->IterateComponents<SoundListenerComponent, FreeFloatMovementComponent>()) == 2);
+	REQUIRE(count(w->IterateComponents<PostprocessSettingsComponent>()) == 2);
+
+	delete w;
+}
+
+TEST_CASE("Scene parallel for over components.", "ComponentIterator")
+{
+	JobSystem jobs(3);
+	for (eComponentStorageMode mode : { eComponentStorageMode::POOL, eComponentStorageMode::ARCHETYPE })
+	{
+		Scene* w = new Scene(mode);
+		DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(w);
+
+		const size_t entityCount = 1000;
+		for (size_t i = 0; i < entityCount; ++i)
+		{
+			Entity* e = DeferredTaskSystem::SpawnEntityImmediate(w);
+			DeferredTaskSystem::AddComponentImmediate<FreeFloatMovementComponent>(w, e, 0.0f, static_cast<float>(i));
+			if (i % 3 == 0)
+				DeferredTaskSystem::AddComponentImmediate<SoundListenerComponent>(w, e);
+			if (i % 5 == 0)
+				DeferredTaskSystem::AddComponentImmediate<PostprocessSettingsComponent>(w, e);
+		}
+
+		// every matching entity is visited exactly once
+		std::atomic<size_t> visited{ 0 };
+		w->ParallelForComponents<FreeFloatMovementComponent, SoundListenerComponent>(jobs, [&visited](FreeFloatMovementComponent* movement, SoundListenerComponent* listener) {
+			movement->SetMovementSpeed(movement->GetMovementSpeed() + listener->GetGain());
+			++visited;
+		}, 16);
+		REQUIRE(visited == 334);
+
+		w->ParallelForComponents<FreeFloatMovementComponent>(jobs, [](FreeFloatMovementComponent* movement) {
+			movement->SetMovementSpeed(movement->GetMovementSpeed() + 1.0f);
+		}, 7);
+
+		size_t checked = 0;
+		for (auto [movement] : w->IterateComponents<FreeFloatMovementComponent>())
+		{
+			const size_t idx = static_cast<size_t>(movement->GetAngularVelocity());
+			REQUIRE(movement->GetMovementSpeed() == (idx % 3 == 0 ? 2.0f : 1.0f));
+			++checked;
+		}
+		REQUIRE(checked == entityCount);
+
+		// without engine the work is done on the calling thread
+		size_t serialVisited = 0;
+		w->ParallelForComponents<PostprocessSettingsComponent, SoundListenerComponent>([&serialVisited](PostprocessSettingsComponent*, SoundListenerComponent*) { ++serialVisited; });
+		REQUIRE(serialVisited == 67);
+
+		delete w;
+	}
+}
+
+
+TEST_CASE("Entity compact component table.", "ComponentIterator")
+{
+	for (eComponentStorageMode mode : { eComponentStorageMode::POOL, eComponentStorageMode::ARCHETYPE })
+	{
+		Scene* w = new Scene(mode);
+		DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(w);
+		Entity* e = DeferredTaskSystem::SpawnEntityImmediate(w);
+		REQUIRE_FALSE(e->HasComponent<SoundListenerComponent>());
+		REQUIRE(e->GetComponent<SoundListenerComponent>() == nullptr);
+
+		// components added in order different than their IDs
+		PostprocessSettingsComponent* postprocess = DeferredTaskSystem::AddComponentImmediate<PostprocessSettingsComponent>(w, e);
+		SoundListenerComponent* listener = DeferredTaskSystem::AddComponentImmediate<SoundListenerComponent>(w, e);
+		FreeFloatMovementComponent* movement = DeferredTaskSystem::AddComponentImmediate<FreeFloatMovementComponent>(w, e);
+
+		REQUIRE(e->GetComponent<PostprocessSettingsComponent>() == postprocess);
+		REQUIRE(e->GetComponent<SoundListenerComponent>() == listener);
+		REQUIRE(e->GetComponent<FreeFloatMovementComponent>() == movement);
+		REQUIRE(movement->GetSibling<SoundListenerComponent>() == listener);
+		REQUIRE(e->HasComponents(BIT(GetComponentID<SoundListenerComponent>()) | BIT(GetComponentID<PostprocessSettingsComponent>())));
+
+		DeferredTaskSystem::RemoveComponent<SoundListenerComponent>(w, e);
+		DeferredTaskSystem::DeferredTaskPhase(w);
+		REQUIRE_FALSE(e->HasComponent<SoundListenerComponent>());
+		REQUIRE(e->GetComponent<SoundListenerComponent>() == nullptr);
+		REQUIRE(e->GetComponent<PostprocessSettingsComponent>() == postprocess);
+		REQUIRE(e->GetComponent<FreeFloatMovementComponent>() == movement);
+
+		listener = DeferredTaskSystem::AddComponentImmediate<SoundListenerComponent>(w, e);
+		DeferredTaskSystem::RemoveComponent<PostprocessSettingsComponent>(w, e);
+		DeferredTaskSystem::DeferredTaskPhase(w);
+		REQUIRE(e->GetComponent<PostprocessSettingsComponent>() == nullptr);
+		REQUIRE(e->GetComponent<SoundListenerComponent>() == listener);
+		REQUIRE(e->GetComponent<FreeFloatMovementComponent>() == movement);
+
+		size_t count = 0;
+		for (auto [m, l] : w->IterateComponents<FreeFloatMovementComponent, SoundListenerComponent>())
+		{
+			REQUIRE(m == movement);
+			REQUIRE(l == listener);
+			++count;
+		}
+		REQUIRE(count == 1);
+
+		// the table holds only present components
+		REQUIRE(e->GetComponentStorageMemory() < sizeof(Entity) + MAX_COMPONENTS_COUNT * sizeof(Entity::ComponentUniquePtr));
+
+		delete w;
+	}
+}
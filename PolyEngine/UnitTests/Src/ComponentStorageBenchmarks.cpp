@@ -0,0 +1,129 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <ECS/Scene.hpp>
+#include <ECS/DeferredTaskSystem.hpp>
+// test components
+#include <Audio/SoundListenerComponent.hpp>
+#include <Movement/FreeFloatMovementComponent.hpp>
+#include <Rendering/PostprocessSettingsComponent.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	Scene* CreateBenchmarkScene(eComponentStorageMode mode, size_t entityCount)
+	{
+		Scene* w = new Scene(mode);
+		DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(w);
+
+		// mix of signatures similar to a game scene: every entity moves, some of them also carry other components
+		for (size_t i = 0; i < entityCount; ++i)
+		{
+			Entity* e = DeferredTaskSystem::SpawnEntityImmediate(w);
+			DeferredTaskSystem::AddComponentImmediate<FreeFloatMovementComponent>(w, e, static_cast<float>(i % 7));
+			if (i % 2 == 0)
+				DeferredTaskSystem::AddComponentImmediate<SoundListenerComponent>(w, e);
+			if (i % 3 == 0)
+				DeferredTaskSystem::AddComponentImmediate<PostprocessSettingsComponent>(w, e);
+		}
+		return w;
+	}
+}
+
+TEST_CASE("Component storage iteration benchmark", "[.][Benchmark]")
+{
+	const size_t entityCounts[] = { 1000, 10000, 65000 };
+	const char* modeNames[] = { "pool", "archetype" };
+
+	for (size_t entityCount : entityCounts)
+	{
+		float expectedSum = 0.0f;
+		for (eComponentStorageMode mode : { eComponentStorageMode::POOL, eComponentStorageMode::ARCHETYPE })
+		{
+			Scene* w = CreateBenchmarkScene(mode, entityCount);
+			const std::string prefix = std::string(modeNames[static_cast<int>(mode)]) + " " + std::to_string(entityCount) + " entities: ";
+
+			float sum = 0.0f;
+			BENCHMARK(prefix + "single component")
+			{
+				sum = 0.0f;
+				for (auto [movement] : w->IterateComponents<FreeFloatMovementComponent>())
+					sum += movement->GetMovementSpeed();
+			}
+
+			BENCHMARK(prefix + "two components")
+			{
+				sum = 0.0f;
+				for (auto [movement, listener] : w->IterateComponents<FreeFloatMovementComponent, SoundListenerComponent>())
+					sum += movement->GetMovementSpeed() * listener->GetGain();
+			}
+
+			BENCHMARK(prefix + "three components")
+			{
+				sum = 0.0f;
+				for (auto [postprocess, movement, listener] : w->IterateComponents<PostprocessSettingsComponent, FreeFloatMovementComponent, SoundListenerComponent>())
+				{
+					UNUSED(postprocess);
+					sum += movement->GetMovementSpeed() * listener->GetGain();
+				}
+			}
+
+			// both storages have to visit exactly the same entities
+			if (mode == eComponentStorageMode::POOL)
+				expectedSum = sum;
+			else
+				REQUIRE(sum == Approx(expectedSum));
+
+			delete w;
+		}
+	}
+}
+
+TEST_CASE("Entity component table memory report", "[.][Benchmark]")
+{
+	const size_t entityCount = 65000;
+	Scene* w = CreateBenchmarkScene(eComponentStorageMode::POOL, entityCount);
+
+	size_t components = 0;
+	size_t compactBytes = 0;
+	for (auto [movement] : w->IterateComponents<FreeFloatMovementComponent>())
+	{
+		const Entity* e = movement->GetOwner();
+		components += (e->HasComponent<FreeFloatMovementComponent>() ? 1 : 0) + (e->HasComponent<SoundListenerComponent>() ? 1 : 0) + (e->HasComponent<PostprocessSettingsComponent>() ? 1 : 0);
+		compactBytes += e->GetComponentStorageMemory();
+	}
+
+	// previous layout kept a slot for every possible component ID, each slot aligned by the allocator to 16 bytes
+	const size_t fixedTableBytes = MAX_COMPONENTS_COUNT * 16;
+	const size_t compactTableBytes = compactBytes / entityCount - sizeof(Entity);
+	WARN(entityCount << " entities, " << double(components) / entityCount << " components per entity");
+	WARN("fixed 64 slot table: " << sizeof(Entity) + fixedTableBytes << " bytes per entity (" << fixedTableBytes << " table), "
+		<< (sizeof(Entity) + fixedTableBytes) * entityCount / 1024 << " KiB total");
+	WARN("compact table: " << compactBytes / entityCount << " bytes per entity (" << compactTableBytes << " table), "
+		<< compactBytes / 1024 << " KiB total");
+	REQUIRE(compactTableBytes < fixedTableBytes);
+
+	delete w;
+}
+
+TEST_CASE("Entity spawn benchmark", "[.][Benchmark]")
+{
+	// entity, its transform and every component are RTTI objects
+	const size_t entityCount = 10000;
+	BENCHMARK("Spawn and destroy 10000 entities with 1-3 components")
+	{
+		Scene* w = CreateBenchmarkScene(eComponentStorageMode::POOL, entityCount);
+		delete w;
+	}
+
+	size_t assigned = 0;
+	BENCHMARK("Spawn and destroy 10000 entities with UUIDs requested")
+	{
+		Scene* w = CreateBenchmarkScene(eComponentStorageMode::POOL, entityCount);
+		for (auto [movement] : w->IterateComponents<FreeFloatMovementComponent>())
+			assigned += movement->GetOwner()->GetUUID().IsValid() ? 1 : 0;
+		delete w;
+	}
+	REQUIRE(assigned > 0);
+}
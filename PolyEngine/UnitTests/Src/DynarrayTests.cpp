@@ -2,6 +2,7 @@
 #include <catch.hpp>
 
 #include <Collections/Dynarray.hpp>
+#include <Collections/String.hpp>
 //TODO implement
 
 using namespace Poly;
@@ -221,4 +222,100 @@ TEST_CASE("Dynarray find all idx", "[Dynarray]")
 	result = a.FindAllIdx(10);
 	REQUIRE(result[0] == 0);
 	REQUIRE(result[1] == 2);
-}
\ No newline at end of file
+}
+namespace
+{
+	// counts live instances, so constructing over or assigning to dead slots shows up as imbalance
+	struct LifetimeCounter
+	{
+		static int Alive;
+
+		LifetimeCounter(int value) : Value(std::make_unique<int>(value)) { ++Alive; }
+		LifetimeCounter(const LifetimeCounter& rhs) : Value(std::make_unique<int>(*rhs.Value)) { ++Alive; }
+		LifetimeCounter(LifetimeCounter&& rhs) : Value(std::move(rhs.Value)) { ++Alive; }
+		~LifetimeCounter() { --Alive; }
+		LifetimeCounter& operator=(const LifetimeCounter& rhs) { Value = std::make_unique<int>(*rhs.Value); return *this; }
+		LifetimeCounter& operator=(LifetimeCounter&& rhs) { Value = std::move(rhs.Value); return *this; }
+
+		std::unique_ptr<int> Value;
+	};
+
+	int LifetimeCounter::Alive = 0;
+
+	Dynarray<int> GetValues(const Dynarray<LifetimeCounter>& a)
+	{
+		Dynarray<int> values;
+		for (const LifetimeCounter& c : a)
+			values.PushBack(*c.Value);
+		return values;
+	}
+}
+
+TEST_CASE("Dynarray insert and remove with non-trivial types", "[Dynarray]")
+{
+	SECTION("unique_ptr")
+	{
+		Dynarray<std::unique_ptr<int>> a;
+		a.PushBack(std::make_unique<int>(2));
+		a.Insert(0, std::make_unique<int>(0)); // front
+		a.Insert(1, std::make_unique<int>(1)); // middle
+		a.Insert(3, std::make_unique<int>(3)); // end
+		REQUIRE(a.GetSize() == 4);
+		for (size_t i = 0; i < a.GetSize(); ++i)
+			REQUIRE(*a[i] == (int)i);
+
+		a.RemoveByIdx(0); // front
+		REQUIRE(*a[0] == 1);
+		a.RemoveByIdx(1); // middle
+		REQUIRE(*a[0] == 1);
+		REQUIRE(*a[1] == 3);
+		a.RemoveByIdx(1); // end
+		REQUIRE(a.GetSize() == 1);
+		REQUIRE(*a[0] == 1);
+	}
+
+	SECTION("String")
+	{
+		Dynarray<String> a;
+		a.PushBack(String("b"));
+		const String front("a");
+		a.Insert(0, front);
+		a.Insert(2, String("d"));
+		a.Insert(2, String("c"));
+		REQUIRE(a.GetSize() == 4);
+		REQUIRE(a[0] == "a");
+		REQUIRE(a[1] == "b");
+		REQUIRE(a[2] == "c");
+		REQUIRE(a[3] == "d");
+
+		a.RemoveByIdx(1);
+		a.RemoveByIdx(2);
+		a.RemoveByIdx(0);
+		REQUIRE(a.GetSize() == 1);
+		REQUIRE(a[0] == "c");
+	}
+
+	SECTION("Object lifetimes")
+	{
+		{
+			Dynarray<LifetimeCounter> a;
+			for (int i = 0; i < 4; ++i)
+				a.PushBack(LifetimeCounter(i * 10));
+			REQUIRE(LifetimeCounter::Alive == 4);
+
+			const LifetimeCounter copied(5);
+			a.Insert(0, LifetimeCounter(-10));
+			a.Insert(2, copied);
+			a.Insert(a.GetSize(), LifetimeCounter(40));
+			REQUIRE(GetValues(a) == Dynarray<int>{ -10, 0, 5, 10, 20, 30, 40 });
+			REQUIRE(LifetimeCounter::Alive == 8);
+
+			a.RemoveByIdx(0);
+			a.RemoveByIdx(2);
+			a.RemoveByIdx(a.GetSize() - 1);
+			REQUIRE(GetValues(a) == Dynarray<int>{ 0, 5, 20, 30 });
+			REQUIRE(LifetimeCounter::Alive == 5);
+		}
+		REQUIRE(LifetimeCounter::Alive == 0);
+	}
+}
@@ -0,0 +1,167 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <ECS/Scene.hpp>
+#include <ECS/DeferredTaskSystem.hpp>
+#include <Memory/SafePtr.hpp>
+// test components
+#include <Audio/SoundListenerComponent.hpp>
+#include <Movement/FreeFloatMovementComponent.hpp>
+
+using namespace Poly;
+
+TEST_CASE("Entity handle table", "[EntityHandle]")
+{
+	EntityHandleTable table;
+	Entity* a = reinterpret_cast<Entity*>(0x10);
+	Entity* b = reinterpret_cast<Entity*>(0x20);
+
+	REQUIRE(table.Resolve(EntityHandle()) == nullptr);
+
+	const EntityHandle ha = table.Acquire(a);
+	const EntityHandle hb = table.Acquire(b);
+	REQUIRE(ha != hb);
+	REQUIRE(table.Resolve(ha) == a);
+	REQUIRE(table.Resolve(hb) == b);
+	REQUIRE(table.GetSize() == 2);
+
+	// released slot is reused with a new generation, old handle stays invalid
+	table.Release(ha);
+	REQUIRE(table.Resolve(ha) == nullptr);
+	const EntityHandle hc = table.Acquire(b);
+	REQUIRE(hc.Index == ha.Index);
+	REQUIRE(hc.Generation != ha.Generation);
+	REQUIRE(table.Resolve(ha) == nullptr);
+	REQUIRE(table.Resolve(hc) == b);
+	REQUIRE(table.GetSize() == 2);
+}
+
+TEST_CASE("Scene entity and component handles", "[EntityHandle]")
+{
+	Scene* w = new Scene();
+	DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(w);
+
+	Entity* e = DeferredTaskSystem::SpawnEntityImmediate(w);
+	SoundListenerComponent* listener = DeferredTaskSystem::AddComponentImmediate<SoundListenerComponent>(w, e);
+	const EntityHandle handle = e->GetHandle();
+	const ComponentHandle<SoundListenerComponent> listenerHandle = Scene::GetComponentHandle(listener);
+	const ComponentHandle<FreeFloatMovementComponent> movementHandle(handle);
+
+	REQUIRE(w->GetEntity(handle) == e);
+	REQUIRE(w->GetComponent(listenerHandle) == listener);
+	REQUIRE(w->GetComponent(movementHandle) == nullptr);
+
+	FreeFloatMovementComponent* movement = DeferredTaskSystem::AddComponentImmediate<FreeFloatMovementComponent>(w, e);
+	REQUIRE(w->GetComponent(movementHandle) == movement);
+
+	DeferredTaskSystem::RemoveComponent<SoundListenerComponent>(w, e);
+	DeferredTaskSystem::DeferredTaskPhase(w);
+	REQUIRE(w->GetComponent(listenerHandle) == nullptr);
+
+	// deferred tasks scheduled for destroyed entity are skipped
+	DeferredTaskSystem::AddComponent<SoundListenerComponent>(w, e);
+	DeferredTaskSystem::DestroyEntityImmediate(w, e);
+	DeferredTaskSystem::DeferredTaskPhase(w);
+	REQUIRE(w->GetEntity(handle) == nullptr);
+	REQUIRE(w->GetComponent(movementHandle) == nullptr);
+
+	// new entity may reuse memory and slot of the destroyed one
+	Entity* other = DeferredTaskSystem::SpawnEntityImmediate(w);
+	REQUIRE(other->GetHandle() != handle);
+	REQUIRE(w->GetEntity(handle) == nullptr);
+	REQUIRE(w->GetEntity(other->GetHandle()) == other);
+
+	delete w;
+}
+
+namespace
+{
+	class SafePtrTestObject : public SafePtrRoot
+	{
+	public:
+		size_t Value = 0;
+	};
+}
+
+TEST_CASE("Entity spawn/destroy churn benchmark", "[.][Benchmark]")
+{
+	const size_t entityCount = 10000;
+	const size_t rounds = 10;
+
+	Scene* w = new Scene();
+	DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(w);
+	Dynarray<Entity*> entities;
+	Dynarray<EntityHandle> handles;
+	entities.Reserve(entityCount);
+	handles.Reserve(entityCount);
+
+	size_t alive = 0;
+	BENCHMARK("scene spawn/resolve/destroy 10 x 10000 entities")
+	{
+		for (size_t round = 0; round < rounds; ++round)
+		{
+			for (size_t i = 0; i < entityCount; ++i)
+			{
+				Entity* e = DeferredTaskSystem::SpawnEntityImmediate(w);
+				entities.PushBack(e);
+				handles.PushBack(e->GetHandle());
+			}
+			for (size_t i = 0; i < entityCount; ++i)
+				alive += w->GetEntity(handles[i]) ? 1 : 0;
+			// destroying in reverse order keeps removal from root children cheap, so the benchmark measures bookkeeping
+			for (size_t i = entityCount; i > 0; --i)
+				DeferredTaskSystem::DestroyEntityImmediate(w, entities[i - 1]);
+			for (size_t i = 0; i < entityCount; ++i)
+				alive += w->GetEntity(handles[i]) ? 1 : 0;
+			entities.Clear();
+			handles.Clear();
+		}
+	}
+	REQUIRE(alive == entityCount * rounds);
+	delete w;
+
+	// bookkeeping alone: generational handle table versus the global safe pointer registry entities used before
+	SafePtrTestObject* objects = Allocate<SafePtrTestObject>(entityCount);
+	EntityHandleTable table;
+	alive = 0;
+	BENCHMARK("handle table acquire/resolve/release 10 x 10000")
+	{
+		for (size_t round = 0; round < rounds; ++round)
+		{
+			for (size_t i = 0; i < entityCount; ++i)
+				handles.PushBack(table.Acquire(reinterpret_cast<Entity*>(objects + i)));
+			for (size_t i = 0; i < entityCount; ++i)
+				alive += table.Resolve(handles[i]) ? 1 : 0;
+			for (size_t i = 0; i < entityCount; ++i)
+				table.Release(handles[i]);
+			for (size_t i = 0; i < entityCount; ++i)
+				alive += table.Resolve(handles[i]) ? 1 : 0;
+			handles.Clear();
+		}
+	}
+	REQUIRE(alive == entityCount * rounds);
+
+	Dynarray<SafePtr<SafePtrTestObject>> pointers;
+	pointers.Reserve(entityCount);
+	alive = 0;
+	BENCHMARK("SafePtr register/resolve/unregister 10 x 10000")
+	{
+		for (size_t round = 0; round < rounds; ++round)
+		{
+			for (size_t i = 0; i < entityCount; ++i)
+			{
+				::new(objects + i) SafePtrTestObject();
+				pointers.PushBack(SafePtr<SafePtrTestObject>(objects + i));
+			}
+			for (size_t i = 0; i < entityCount; ++i)
+				alive += pointers[i] ? 1 : 0;
+			for (size_t i = 0; i < entityCount; ++i)
+				objects[i].~SafePtrTestObject();
+			for (size_t i = 0; i < entityCount; ++i)
+				alive += pointers[i] ? 1 : 0;
+			pointers.Clear();
+		}
+	}
+	REQUIRE(alive == entityCount * rounds);
+	Deallocate(objects);
+}
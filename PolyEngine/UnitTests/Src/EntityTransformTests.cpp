@@ -2,6 +2,9 @@
 #include <catch.hpp>
 
 #include <ECS/Entity.hpp>
+#include <ECS/Scene.hpp>
+#include <ECS/DeferredTaskSystem.hpp>
+#include <Threading/JobSystem.hpp>
 
 using namespace Poly;
 
@@ -125,4 +128,115 @@ TEST_CASE("Checking equality of transforms after applying global and local trans
 		REQUIRE(e[4]->GetTransform().GetGlobalRotation() == e[5]->GetTransform().GetGlobalRotation());
 		REQUIRE(e[4]->GetTransform().GetGlobalScale() != e[5]->GetTransform().GetGlobalScale());
 	}
-}
\ No newline at end of file
+
+	// children without scene are destroyed together with their parent
+	delete e[0];
+}
+
+namespace
+{
+	// 10 root children, each with two children that have one child of their own
+	Dynarray<Entity*> CreateTransformHierarchy(Scene* scene)
+	{
+		Dynarray<Entity*> entities;
+		for (int i = 0; i < 10; ++i)
+		{
+			Entity* top = DeferredTaskSystem::SpawnEntityImmediate(scene);
+			entities.PushBack(top);
+			for (int j = 0; j < 2; ++j)
+			{
+				Entity* mid = DeferredTaskSystem::SpawnEntityImmediate(scene);
+				mid->SetParent(top);
+				Entity* leaf = DeferredTaskSystem::SpawnEntityImmediate(scene);
+				leaf->SetParent(mid);
+				entities.PushBack(mid);
+				entities.PushBack(leaf);
+			}
+		}
+
+		for (size_t i = 0; i < entities.GetSize(); ++i)
+		{
+			const float f = static_cast<float>(i);
+			EntityTransform& transform = entities[i]->GetTransform();
+			transform.SetLocalTranslation({ f, 2.0f * f, -f });
+			transform.SetLocalRotation(EulerAngles{ Angle::FromDegrees(f * 3.0f), Angle::FromDegrees(f), 0_deg });
+			transform.SetLocalScale(Vector(1.0f, 1.0f, 1.0f) * (1.0f + 0.1f * f));
+		}
+		return entities;
+	}
+}
+
+TEST_CASE("Transform hierarchy update matches lazily computed transforms.", "[GlobalLocalTransform]")
+{
+	JobSystem jobs(3);
+	Scene* updated = new Scene();
+	Scene* lazy = new Scene();
+	Dynarray<Entity*> a = CreateTransformHierarchy(updated);
+	Dynarray<Entity*> b = CreateTransformHierarchy(lazy);
+
+	auto requireSameTransforms = [&a, &b]() {
+		for (size_t i = 0; i < a.GetSize(); ++i)
+		{
+			REQUIRE(a[i]->GetTransform().GetWorldFromModel() == b[i]->GetTransform().GetWorldFromModel());
+			REQUIRE(a[i]->GetTransform().GetGlobalTranslation() == b[i]->GetTransform().GetGlobalTranslation());
+		}
+	};
+
+	// every spawned transform is dirty after creation, scene root is included in node count
+	updated->UpdateTransformHierarchy();
+	REQUIRE(updated->GetTransformHierarchy().GetNodeCount() == a.GetSize() + 1);
+	REQUIRE(updated->GetTransformHierarchy().GetLastUpdatedCount() == a.GetSize());
+	requireSameTransforms();
+
+	// nothing changed
+	updated->UpdateTransformHierarchy(&jobs);
+	REQUIRE(updated->GetTransformHierarchy().GetLastUpdatedCount() == 0);
+
+	// only changed subtree is recomputed
+	a[0]->GetTransform().SetLocalTranslation({ 3.0f, 4.0f, 5.0f });
+	b[0]->GetTransform().SetLocalTranslation({ 3.0f, 4.0f, 5.0f });
+	a[6]->GetTransform().SetLocalScale({ 2.0f, 2.0f, 2.0f });
+	b[6]->GetTransform().SetLocalScale({ 2.0f, 2.0f, 2.0f });
+	updated->UpdateTransformHierarchy(&jobs);
+	REQUIRE(updated->GetTransformHierarchy().GetLastUpdatedCount() == 5 + 2);
+	requireSameTransforms();
+
+	// reparenting and destruction rebuild flattened hierarchy
+	a[5]->SetParent(a[1]);
+	b[5]->SetParent(b[1]);
+	DeferredTaskSystem::DestroyEntityImmediate(updated, a[10]);
+	DeferredTaskSystem::DestroyEntityImmediate(lazy, b[10]);
+	for (int i = 0; i < 5; ++i)
+	{
+		a.RemoveByIdx(10);
+		b.RemoveByIdx(10);
+	}
+	updated->UpdateTransformHierarchy(&jobs);
+	REQUIRE(updated->GetTransformHierarchy().GetNodeCount() == a.GetSize() + 1);
+	requireSameTransforms();
+
+	delete updated;
+	delete lazy;
+}
+
+
+TEST_CASE("Global bounding box follows transform changes.", "[GlobalLocalTransform]")
+{
+	Scene* scene = new Scene();
+	Entity* parent = DeferredTaskSystem::SpawnEntityImmediate(scene);
+	Entity* child = DeferredTaskSystem::SpawnEntityImmediate(scene);
+	child->SetParent(parent);
+	child->GetTransform().SetLocalTranslation({ 1.0f, 2.0f, 3.0f });
+	REQUIRE(child->GetGlobalBoundingBox(eEntityBoundingChannel::RENDERING).GetMin() == Vector(1.0f, 2.0f, 3.0f));
+
+	// cached box is invalidated by transform of parent
+	parent->GetTransform().SetLocalTranslation({ 10.0f, 0.0f, 0.0f });
+	REQUIRE(child->GetGlobalBoundingBox(eEntityBoundingChannel::RENDERING).GetMin() == Vector(11.0f, 2.0f, 3.0f));
+
+	// and by transform hierarchy pass
+	parent->GetTransform().SetLocalTranslation({ 20.0f, 0.0f, 0.0f });
+	scene->UpdateTransformHierarchy();
+	REQUIRE(child->GetGlobalBoundingBox(eEntityBoundingChannel::RENDERING).GetMin() == Vector(21.0f, 2.0f, 3.0f));
+
+	delete scene;
+}
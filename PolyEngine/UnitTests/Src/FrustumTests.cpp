@@ -1,6 +1,7 @@
 #include <Defines.hpp>
 #include <catch.hpp>
 #include <Math/Frustum.hpp>
+#include <Math/FrustumCulling.hpp>
 #include <Math/Quaternion.hpp>
 #include <Math/Random.hpp>
 #include <Utils/Logger.hpp>
@@ -51,4 +52,100 @@ TEST_CASE("Frustum position tests", "[Frustum]") {
 		CHECK(match);
 	}
 	
-}
\ No newline at end of file
+}
+TEST_CASE("Batched frustum culling", "[Frustum]") {
+	Frustum f(60_deg, 4.f / 3.f, 1.f, 1000.f);
+	Matrix viewFromWorld;
+	viewFromWorld.SetRotationY(30_deg);
+	viewFromWorld.m03 = 5.f;
+	viewFromWorld.m23 = -20.f;
+
+	AABoxSoA boxes;
+	Dynarray<AABox> reference;
+	for (size_t i = 0; i < 1003; ++i)
+	{
+		AABox box(Poly::RandomVectorRange(-200, 200), Poly::RandomVectorRange(0.1f, 10.f));
+		boxes.PushBack(box);
+		reference.PushBack(box);
+	}
+	REQUIRE(boxes.GetSize() == reference.GetSize());
+	REQUIRE(boxes.Get(7).GetMin() == reference[7].GetMin());
+	REQUIRE(boxes.Get(7).GetSize() == reference[7].GetSize());
+
+	// same result for batches and for single boxes, including the ones in the tail of the last batch
+	const FrustumCuller culler(f, viewFromWorld);
+	Dynarray<bool> visibility;
+	const size_t visibleCount = culler.Cull(boxes, visibility);
+	REQUIRE(visibility.GetSize() == reference.GetSize());
+
+	size_t expectedCount = 0;
+	for (size_t i = 0; i < reference.GetSize(); ++i)
+	{
+		CHECK(visibility[i] == culler.IsVisible(reference[i]));
+		expectedCount += visibility[i] ? 1 : 0;
+
+		// transformed bounding box used by Frustum is looser, so it never culls a box that batched test keeps
+		if (visibility[i])
+			CHECK(f.GetObjectLocation(reference[i], viewFromWorld) != Frustum::eObjectLocation::OUTSIDE);
+	}
+	REQUIRE(visibleCount == expectedCount);
+	REQUIRE(visibleCount > 0);
+	REQUIRE(visibleCount < reference.GetSize());
+}
+
+TEST_CASE("Frustum culling benchmark", "[.][Benchmark]") {
+	Frustum f(60_deg, 16.f / 9.f, 1.f, 1000.f);
+	Matrix viewFromWorld;
+	viewFromWorld.SetRotationY(45_deg);
+
+	const size_t boxCount = 100000;
+	AABoxSoA boxes;
+	Dynarray<AABox> reference;
+	for (size_t i = 0; i < boxCount; ++i)
+	{
+		AABox box(Poly::RandomVectorRange(-1000, 1000), Poly::RandomVectorRange(0.5f, 5.f));
+		boxes.PushBack(box);
+		reference.PushBack(box);
+	}
+
+	size_t scalarCount = 0;
+	BENCHMARK("100000 boxes, Frustum::GetObjectLocation")
+	{
+		scalarCount = 0;
+		for (const AABox& box : reference)
+			scalarCount += f.GetObjectLocation(box, viewFromWorld) != Frustum::eObjectLocation::OUTSIDE ? 1 : 0;
+	}
+
+	size_t batchedCount = 0;
+	Dynarray<bool> visibility;
+	BENCHMARK("100000 boxes, FrustumCuller::Cull")
+	{
+		batchedCount = FrustumCuller(f, viewFromWorld).Cull(boxes, visibility);
+	}
+	REQUIRE(batchedCount <= scalarCount);
+}
+
+TEST_CASE("Frustum vertices", "[Frustum]") {
+	Frustum f(60_deg, 4.f / 3.f, 1.f, 100.f);
+	for (const Vector& vertex : f.GetVertices())
+	{
+		for (eFrustumPlane type : IterateEnum<eFrustumPlane>())
+			CHECK(f.GetPlanes()[type].GetPointLocation(vertex + (Vector(0, 0, -50.5f) - vertex) * 0.001f) == Plane::eObjectLocation::FRONT);
+	}
+	REQUIRE(f.GetVertices()[0].Z == Approx(-1.f));
+	REQUIRE(f.GetVertices()[7].Z == Approx(-100.f));
+}
+
+TEST_CASE("Box volume culling", "[Frustum]") {
+	// volume rotated by 90 degrees around Y, so its X axis points along world -Z
+	const AABox volume(Vector(-1, -1, -1), Vector(2, 2, 2));
+	Matrix volumeFromWorld;
+	volumeFromWorld.SetRotationY(90_deg);
+	const FrustumCuller culler(volume, volumeFromWorld);
+
+	REQUIRE(culler.IsVisible(AABox(Vector(-0.5f, -0.5f, -0.5f), Vector(1, 1, 1))));
+	REQUIRE(culler.IsVisible(AABox(Vector(0.5f, 0.5f, 0.5f), Vector(1, 1, 1))));
+	REQUIRE(!culler.IsVisible(AABox(Vector(1.5f, -0.5f, -0.5f), Vector(1, 1, 1))));
+	REQUIRE(!culler.IsVisible(AABox(Vector(-0.5f, -0.5f, -3.f), Vector(1, 1, 1))));
+	REQUIRE(!culler.IsVisible(AABox(Vector(-0.5f, 1.5f, -0.5f), Vector(1, 1, 1))));
+}
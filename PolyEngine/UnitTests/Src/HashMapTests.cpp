@@ -0,0 +1,295 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Collections/HashMap.hpp>
+#include <Collections/HashSet.hpp>
+#include <Collections/OrderedMap.hpp>
+#include <Collections/Dynarray.hpp>
+#include <random>
+
+using namespace Poly;
+
+namespace
+{
+	Dynarray<int> ShuffledKeys(size_t size)
+	{
+		Dynarray<int> keys;
+		keys.Reserve(size);
+		for (int n = 0; n < int(size); ++n)
+			keys.PushBack(n);
+
+		std::mt19937 rng(std::rand()); // std::rand() is seeded by Catch, use `--rng-seed` to reproduce failures
+		std::shuffle(keys.Begin(), keys.End(), rng);
+		return keys;
+	}
+}
+
+TEST_CASE("HashMap insertion/lookup", "[HashMap]") {
+	constexpr size_t size = 1024;
+	const Dynarray<int> keys = ShuffledKeys(size);
+
+	HashMap<int, int> map;
+	REQUIRE(map.IsEmpty());
+	REQUIRE_FALSE(map.Get(0));
+
+	for (int key : keys) {
+		auto previous = map.Insert(key, -key);
+		REQUIRE_FALSE(previous);
+	}
+	REQUIRE(map.GetSize() == size);
+	// load factor stays below 7/8
+	REQUIRE(map.GetCapacity() * 7 / 8 >= size);
+
+	AND_THEN("Lookup") {
+		for (int n = 0; n < int(size); ++n) {
+			auto got = map.Get(n);
+			REQUIRE(got);
+			REQUIRE(got.Value() == -n);
+			REQUIRE(map[n] == -n);
+			REQUIRE(map.Contains(n));
+		}
+		REQUIRE_FALSE(map.Get(int(size)));
+		REQUIRE_FALSE(map.Contains(-1));
+	}
+
+	AND_THEN("Replacement insertion") {
+		for (int n = 0; n < int(size); ++n) {
+			auto previous = map.Insert(n, n);
+			REQUIRE(previous);
+			REQUIRE(previous.Value() == -n);
+		}
+		REQUIRE(map.GetSize() == size);
+		for (int n = 0; n < int(size); ++n)
+			REQUIRE(map[n] == n);
+	}
+
+	AND_THEN("GetOrInsert") {
+		REQUIRE(map.GetOrInsert(5, 100) == -5);
+		map.GetOrInsert(int(size), 100) += 1;
+		REQUIRE(map[int(size)] == 101);
+		REQUIRE(map.GetSize() == size + 1);
+	}
+
+	AND_THEN("Iteration") {
+		Dynarray<bool> visited;
+		visited.Resize(size);
+		for (size_t i = 0; i < size; ++i)
+			visited[i] = false;
+
+		size_t count = 0;
+		for (auto kv : map) {
+			REQUIRE(kv.key == -kv.value);
+			REQUIRE_FALSE(visited[kv.key]);
+			visited[kv.key] = true;
+			++count;
+		}
+		REQUIRE(count == size);
+	}
+
+	AND_THEN("Copy and move") {
+		HashMap<int, int> copy(map);
+		REQUIRE(copy.GetSize() == size);
+		copy.Insert(0, 1);
+		REQUIRE(map[0] == 0);
+		REQUIRE(copy[0] == 1);
+
+		HashMap<int, int> moved(std::move(copy));
+		REQUIRE(moved.GetSize() == size);
+		REQUIRE(copy.IsEmpty());
+		REQUIRE_FALSE(copy.Get(0));
+	}
+}
+
+TEST_CASE("HashMap removals", "[HashMap]") {
+	constexpr size_t size = 1024;
+	const Dynarray<int> keys = ShuffledKeys(size);
+
+	HashMap<int, int> map;
+	for (int key : keys)
+		map.Insert(key, -key);
+	const size_t capacity = map.GetCapacity();
+
+	for (size_t i = 0; i < size / 2; ++i) {
+		auto removed = map.Remove(keys[i]);
+		REQUIRE(removed);
+		REQUIRE(removed.Value() == -keys[i]);
+		REQUIRE_FALSE(map.Remove(keys[i]));
+	}
+	REQUIRE(map.GetSize() == size - size / 2);
+
+	for (size_t i = 0; i < size; ++i)
+		REQUIRE(map.Contains(keys[i]) == (i >= size / 2));
+
+	// reinserting removed keys reuses freed slots
+	for (size_t i = 0; i < size / 2; ++i)
+		map.MustInsert(keys[i], keys[i]);
+	REQUIRE(map.GetSize() == size);
+	REQUIRE(map.GetCapacity() == capacity);
+	for (size_t i = 0; i < size; ++i)
+		REQUIRE(map[keys[i]] == (i < size / 2 ? keys[i] : -keys[i]));
+
+	AND_THEN("Churn at constant size does not grow the table") {
+		for (int round = 0; round < 16; ++round) {
+			for (size_t i = 0; i < size; ++i)
+				map.MustRemove(keys[i]);
+			REQUIRE(map.IsEmpty());
+			for (size_t i = 0; i < size; ++i)
+				map.Insert(keys[i] + round * int(size), 1);
+			for (size_t i = 0; i < size; ++i)
+				map.MustRemove(keys[i] + round * int(size));
+			for (size_t i = 0; i < size; ++i)
+				map.Insert(keys[i], 0);
+		}
+		REQUIRE(map.GetSize() == size);
+		REQUIRE(map.GetCapacity() == capacity);
+	}
+
+	AND_THEN("Clearing") {
+		map.Clear();
+		REQUIRE(map.IsEmpty());
+		REQUIRE(map.GetCapacity() == capacity);
+		for (size_t i = 0; i < size; ++i)
+			REQUIRE_FALSE(map.Get(keys[i]));
+		REQUIRE(map.begin() == map.end());
+	}
+}
+
+TEST_CASE("HashMap pointer and string keys", "[HashMap]") {
+	// std::hash of pointers is identity, aligned pointers must still spread over the table
+	Dynarray<int> storage;
+	storage.Resize(4096);
+	HashMap<const int*, size_t> pointers;
+	for (size_t i = 0; i < storage.GetSize(); ++i)
+		pointers.Insert(&storage[i], i);
+	for (size_t i = 0; i < storage.GetSize(); ++i)
+		REQUIRE(pointers[&storage[i]] == i);
+
+	HashMap<std::string, int> strings;
+	strings.Insert("one", 1);
+	strings.Insert(std::string("two"), 2);
+	REQUIRE(strings["one"] == 1);
+	REQUIRE(strings["two"] == 2);
+	REQUIRE_FALSE(strings.Get("three"));
+}
+
+TEST_CASE("HashMap properly running destructors", "[HashMap]") {
+	static size_t gCurrentInstances = 0;
+	struct Counting {
+		Counting(size_t value) : value(value) { gCurrentInstances += 1; }
+		Counting(const Counting&  other) : Counting(other.value) {}
+		Counting(      Counting&& other) : Counting(other.value) {}
+		~Counting() { gCurrentInstances -= 1; }
+		Counting& operator=(const Counting&  other) { this->value = other.value; return *this; }
+		Counting& operator=(      Counting&& other) { this->value = other.value; return *this; }
+		bool operator==(const Counting& other) const { return this->value == other.value; }
+		size_t value;
+	};
+	struct CountingHash {
+		size_t operator()(const Counting& c) const { return c.value; }
+	};
+
+	constexpr size_t size = 1024;
+	gCurrentInstances = 0;
+	{
+		HashMap<Counting, Counting, CountingHash> map;
+		for (size_t i = 0; i < size; ++i)
+			map.Insert(Counting(i), Counting(i));
+		REQUIRE(gCurrentInstances == map.GetSize() * 2);
+
+		for (size_t i = 0; i < size / 2; ++i)
+			map.Remove(Counting(i));
+		REQUIRE(gCurrentInstances == map.GetSize() * 2);
+
+		HashMap<Counting, Counting, CountingHash> copy(map);
+		REQUIRE(gCurrentInstances == map.GetSize() * 4);
+		copy.Clear();
+		REQUIRE(gCurrentInstances == map.GetSize() * 2);
+	}
+	REQUIRE(gCurrentInstances == 0);
+}
+
+TEST_CASE("HashSet operations", "[HashMap]") {
+	constexpr size_t size = 1000;
+	const Dynarray<int> keys = ShuffledKeys(size);
+
+	HashSet<int> set;
+	for (int key : keys)
+		REQUIRE(set.Insert(key));
+	for (int key : keys)
+		REQUIRE_FALSE(set.Insert(key));
+	REQUIRE(set.GetSize() == size);
+
+	for (int key : keys)
+		if (key % 2 == 0)
+			REQUIRE(set.Remove(key));
+	REQUIRE(set.GetSize() == size / 2);
+
+	size_t count = 0;
+	for (int key : set) {
+		REQUIRE(key % 2 == 1);
+		++count;
+	}
+	REQUIRE(count == size / 2);
+
+	for (int n = 0; n < int(size); ++n)
+		REQUIRE(set.Contains(n) == (n % 2 == 1));
+}
+
+TEST_CASE("HashMap lookup benchmark", "[.][Benchmark]") {
+	constexpr size_t size = 100000;
+	const Dynarray<int> keys = ShuffledKeys(size);
+
+	HashMap<int, int> hashMap;
+	OrderedMap<int, int> orderedMap;
+	std::unordered_map<int, int> unorderedMap;
+
+	BENCHMARK("HashMap insert 100000") {
+		for (int key : keys)
+			hashMap.Insert(key, key);
+	}
+	BENCHMARK("OrderedMap insert 100000") {
+		for (int key : keys)
+			orderedMap.Insert(key, key);
+	}
+	BENCHMARK("std::unordered_map insert 100000") {
+		for (int key : keys)
+			unorderedMap[key] = key;
+	}
+
+	// half of the lookups miss
+	long long sum[3] = {};
+	BENCHMARK("HashMap lookup 200000") {
+		for (int key : keys) {
+			sum[0] += hashMap.Get(key).Value();
+			sum[0] += hashMap.Contains(key + int(size)) ? 1 : 0;
+		}
+	}
+	BENCHMARK("OrderedMap lookup 200000") {
+		for (int key : keys) {
+			sum[1] += orderedMap.Get(key).Value();
+			sum[1] += orderedMap.Get(key + int(size)) ? 1 : 0;
+		}
+	}
+	BENCHMARK("std::unordered_map lookup 200000") {
+		for (int key : keys) {
+			sum[2] += unorderedMap.find(key)->second;
+			sum[2] += unorderedMap.find(key + int(size)) != unorderedMap.end() ? 1 : 0;
+		}
+	}
+	REQUIRE(sum[0] == sum[1]);
+	REQUIRE(sum[0] == sum[2]);
+
+	BENCHMARK("HashMap remove 100000") {
+		for (int key : keys)
+			hashMap.Remove(key);
+	}
+	BENCHMARK("OrderedMap remove 100000") {
+		for (int key : keys)
+			orderedMap.Remove(key);
+	}
+	BENCHMARK("std::unordered_map remove 100000") {
+		for (int key : keys)
+			unorderedMap.erase(key);
+	}
+	REQUIRE(hashMap.IsEmpty());
+}
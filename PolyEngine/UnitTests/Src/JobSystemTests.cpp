@@ -0,0 +1,77 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Threading/JobSystem.hpp>
+#include <Collections/Dynarray.hpp>
+
+using namespace Poly;
+
+TEST_CASE("Serial job system", "[JobSystem]") {
+	JobSystem jobs(0);
+	REQUIRE(jobs.IsSerial());
+
+	// jobs are executed immediately, in submission order
+	Dynarray<int> order;
+	JobCounter counter;
+	for (int i = 0; i < 5; ++i)
+		jobs.Submit([&order, i]() { order.PushBack(i); }, counter);
+	REQUIRE(counter.IsDone());
+	jobs.Wait(counter);
+	REQUIRE(order == Dynarray<int>{ 0, 1, 2, 3, 4 });
+
+	size_t calls = 0;
+	jobs.ParallelFor(100, 8, [&calls](size_t begin, size_t end) { ++calls; REQUIRE(begin == 0); REQUIRE(end == 100); });
+	REQUIRE(calls == 1);
+}
+
+TEST_CASE("Parallel job system", "[JobSystem]") {
+	JobSystem jobs(3);
+	REQUIRE(jobs.GetWorkerCount() == 3);
+
+	SECTION("Submit and wait") {
+		std::atomic<size_t> sum{ 0 };
+		JobCounter counter;
+		for (size_t i = 1; i <= 1000; ++i)
+			jobs.Submit([&sum, i]() { sum += i; }, counter);
+		jobs.Wait(counter);
+		REQUIRE(counter.IsDone());
+		REQUIRE(sum == 500500);
+	}
+
+	SECTION("Nested jobs") {
+		std::atomic<size_t> leafCount{ 0 };
+		JobCounter counter;
+		for (size_t i = 0; i < 16; ++i)
+		{
+			jobs.Submit([&jobs, &leafCount]() {
+				JobCounter nested;
+				for (size_t j = 0; j < 16; ++j)
+					jobs.Submit([&leafCount]() { ++leafCount; }, nested);
+				jobs.Wait(nested);
+			}, counter);
+		}
+		jobs.Wait(counter);
+		REQUIRE(leafCount == 256);
+	}
+
+	SECTION("Parallel for covers whole range once") {
+		const size_t count = 10007;
+		Dynarray<int> visits;
+		visits.Resize(count);
+		for (int& v : visits)
+			v = 0;
+
+		// Catch assertions are not thread safe, results are checked after the loop
+		std::atomic<bool> chunkTooBig{ false };
+		jobs.ParallelFor(count, 64, [&visits, &chunkTooBig](size_t begin, size_t end) {
+			if (end - begin > 64)
+				chunkTooBig = true;
+			for (size_t i = begin; i < end; ++i)
+				++visits[i];
+		});
+
+		REQUIRE(!chunkTooBig);
+		for (int v : visits)
+			REQUIRE(v == 1);
+	}
+}
@@ -369,4 +369,15 @@ TEST_CASE("Matrix decomposition", "[Matrix]") {
 		REQUIRE(Cmpf(skew.YZ, 0.f));
 		REQUIRE(p == Vector());
 	}
+
+	SECTION("Translation-Rotation-Scale composition") {
+		Matrix m;
+		m.SetTransformation(trans, rot, scale);
+		REQUIRE(m == tMat * (rMat * sMat));
+
+		m.Decompose(t, r, s);
+		REQUIRE(t == trans);
+		REQUIRE(r == rot);
+		REQUIRE(s == scale);
+	}
 }
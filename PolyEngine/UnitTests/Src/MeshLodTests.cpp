@@ -0,0 +1,250 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Resources/MeshOptimization.hpp>
+#include <Resources/MeshResource.hpp>
+#include <Utils/FileIO.hpp>
+#include <Rendering/VisibilityCuller.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	// grid in XZ plane with optional height waves, triangles face +Y
+	void MakeGrid(size_t size, float amplitude, Dynarray<Vector3f>& positions, Dynarray<u32>& indices)
+	{
+		positions.Resize(size * size);
+		for (size_t y = 0; y < size; ++y)
+			for (size_t x = 0; x < size; ++x)
+			{
+				positions[y * size + x].X = float(x);
+				positions[y * size + x].Y = amplitude * std::sin(0.3f * float(x)) * std::cos(0.2f * float(y));
+				positions[y * size + x].Z = float(y);
+			}
+
+		indices.Clear();
+		for (size_t y = 0; y + 1 < size; ++y)
+			for (size_t x = 0; x + 1 < size; ++x)
+			{
+				const u32 v = u32(y * size + x);
+				for (u32 index : { v, v + u32(size), v + 1, v + 1, v + u32(size), v + u32(size) + 1 })
+					indices.PushBack(index);
+			}
+	}
+
+	float GetNormalY(const Dynarray<Vector3f>& positions, const u32* tri)
+	{
+		const Vector e1 = positions[tri[1]].GetVector() - positions[tri[0]].GetVector();
+		const Vector e2 = positions[tri[2]].GetVector() - positions[tri[0]].GetVector();
+		return e1.Cross(e2).Y;
+	}
+
+	class GridMeshResource : public MeshResource
+	{
+	public:
+		GridMeshResource(size_t size, float amplitude) : MeshResource(ResourceAsyncLoadTag{})
+		{
+			Dynarray<Vector3f> positions;
+			Dynarray<u32> indices;
+			MakeGrid(size, amplitude, positions, indices);
+
+			const String path = "MeshLodGrid.obj";
+			FILE* f;
+			fopen_s(&f, path.GetCStr(), "w");
+			REQUIRE(f);
+			for (const Vector3f& p : positions)
+				fprintf(f, "v %f %f %f\nvt %f %f\nvn 0 1 0\n", p.X, p.Y, p.Z, p.X / size, p.Z / size);
+			for (size_t i = 0; i < indices.GetSize(); i += 3)
+				fprintf(f, "f %u/%u/%u %u/%u/%u %u/%u/%u\n", indices[i] + 1, indices[i] + 1, indices[i] + 1,
+					indices[i + 1] + 1, indices[i + 1] + 1, indices[i + 1] + 1, indices[i + 2] + 1, indices[i + 2] + 1, indices[i + 2] + 1);
+			fclose(f);
+
+			Import(path);
+			remove(path.GetCStr());
+		}
+	};
+}
+
+TEST_CASE("Mesh simplification of flat grid", "[MeshLod]")
+{
+	const size_t size = 64;
+	Dynarray<Vector3f> positions;
+	Dynarray<u32> indices;
+	MakeGrid(size, 0.f, positions, indices);
+
+	Dynarray<u32> result;
+	const size_t target = indices.GetSize() / 4 / 3 * 3;
+	const float error = MeshOptimization::Simplify(indices, positions, target, 0.01f, result);
+
+	// flat interior collapses without error, so the target is reached
+	REQUIRE(result.GetSize() % 3 == 0);
+	CHECK(result.GetSize() <= target);
+	CHECK(error < 1e-3f);
+
+	// border vertices are locked, so the outline of the grid is kept
+	Dynarray<bool> used;
+	used.Resize(positions.GetSize());
+	std::fill(used.Begin(), used.End(), false);
+	for (u32 index : result)
+		used[index] = true;
+	for (size_t i = 0; i < size; ++i)
+	{
+		REQUIRE(used[i]);
+		REQUIRE(used[(size - 1) * size + i]);
+		REQUIRE(used[i * size]);
+		REQUIRE(used[i * size + size - 1]);
+	}
+
+	// every triangle keeps its facing and no area is lost
+	float area = 0.f;
+	for (size_t i = 0; i < result.GetSize(); i += 3)
+	{
+		const float normalY = GetNormalY(positions, result.GetData() + i);
+		REQUIRE(normalY > 0.f);
+		area += 0.5f * normalY;
+	}
+	CHECK(area == Approx(float((size - 1) * (size - 1))));
+
+	// nothing to do when the mesh is small enough already
+	REQUIRE(MeshOptimization::Simplify(indices, positions, indices.GetSize(), 0.01f, result) == 0.f);
+	REQUIRE(result == indices);
+}
+
+TEST_CASE("Mesh simplification error limit", "[MeshLod]")
+{
+	Dynarray<Vector3f> positions;
+	Dynarray<u32> indices;
+	MakeGrid(48, 2.f, positions, indices);
+
+	Dynarray<u32> coarse, fine;
+	const float coarseError = MeshOptimization::Simplify(indices, positions, 0, 0.05f, coarse);
+	const float fineError = MeshOptimization::Simplify(indices, positions, 0, 0.005f, fine);
+
+	// curved surface stops simplifying when the error limit is reached
+	CHECK(coarseError <= 0.05f);
+	CHECK(fineError <= 0.005f);
+	CHECK(coarse.GetSize() < fine.GetSize());
+	CHECK(fine.GetSize() < indices.GetSize());
+	for (size_t i = 0; i < fine.GetSize(); i += 3)
+		REQUIRE(GetNormalY(positions, fine.GetData() + i) > 0.f);
+}
+
+TEST_CASE("Mesh levels of detail", "[MeshLod]")
+{
+	GridMeshResource resource(48, 2.f);
+	REQUIRE(resource.GetSubMeshes().GetSize() == 1);
+	// levels are regenerated in place, resource is never uploaded to a device
+	Mesh& mesh = const_cast<Mesh&>(resource.GetSubMeshes()[0]->GetMeshData());
+	const size_t indexCount = mesh.GetIndicies().GetSize();
+
+	SECTION("Levels tile the index buffer")
+	{
+		mesh.GenerateLods(4, 64);
+		REQUIRE(mesh.GetLodCount() > 1);
+		REQUIRE(mesh.GetLodCount() <= 4);
+
+		size_t firstIndex = indexCount;
+		Mesh::Lod previous = mesh.GetLod(0);
+		REQUIRE(previous.FirstIndex == 0);
+		REQUIRE(previous.IndexCount == indexCount);
+		REQUIRE(previous.Error == 0.f);
+		for (size_t level = 1; level < mesh.GetLodCount(); ++level)
+		{
+			const Mesh::Lod lod = mesh.GetLod(level);
+			REQUIRE(lod.FirstIndex == firstIndex);
+			REQUIRE(lod.IndexCount % 3 == 0);
+			REQUIRE(lod.IndexCount * 4 <= previous.IndexCount * 3);
+			REQUIRE(lod.IndexCount / 3 >= 64);
+			REQUIRE(lod.Error >= previous.Error);
+			for (size_t i = lod.FirstIndex - indexCount; i < lod.FirstIndex - indexCount + lod.IndexCount; ++i)
+				REQUIRE(mesh.GetLodIndices()[i] < mesh.GetVertexCount());
+			firstIndex += lod.IndexCount;
+			previous = lod;
+		}
+		REQUIRE(firstIndex == indexCount + mesh.GetLodIndices().GetSize());
+
+		// levels past the last one clamp to the coarsest
+		const Mesh::Lod coarsest = mesh.GetLod(mesh.GetLodCount() - 1);
+		for (size_t level : { mesh.GetLodCount(), mesh.GetLodCount() + 10 })
+		{
+			REQUIRE(mesh.GetLod(level).FirstIndex == coarsest.FirstIndex);
+			REQUIRE(mesh.GetLod(level).IndexCount == coarsest.IndexCount);
+		}
+	}
+
+	SECTION("Level count limit")
+	{
+		mesh.GenerateLods(2, 1);
+		REQUIRE(mesh.GetLodCount() == 2);
+		REQUIRE(mesh.GetLodIndices().GetSize() == mesh.GetLod(1).IndexCount);
+
+		mesh.GenerateLods(1, 1);
+		REQUIRE(mesh.GetLodCount() == 1);
+		REQUIRE(mesh.GetLodIndices().GetSize() == 0);
+	}
+
+	SECTION("Minimal triangle count")
+	{
+		// halving would go below the minimum
+		mesh.GenerateLods(4, indexCount / 6 + 1);
+		REQUIRE(mesh.GetLodCount() == 1);
+		REQUIRE(mesh.GetLod(3).FirstIndex == 0);
+		REQUIRE(mesh.GetLod(3).IndexCount == indexCount);
+	}
+}
+
+TEST_CASE("Level of detail selection", "[MeshLod]")
+{
+	// full detail for large objects, one level per halving of coverage
+	REQUIRE(VisibilityCuller::SelectLodLevel(1.f, 0) == 0);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.5f, 3) == 0);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.2f, 0) == 1);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.1f, 0) == 2);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.f, 0) == VisibilityCuller::SelectLodLevel(1e-6f, 0));
+
+	// small changes of coverage around transition point keep the current level
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.26f, 0) == 0);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.24f, 0) == 0);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.24f, 1) == 1);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.26f, 1) == 1);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.3f, 1) == 0);
+	REQUIRE(VisibilityCuller::SelectLodLevel(0.3f, 0) == 0);
+
+	// level changes when coverage leaves the band
+	size_t level = 0;
+	for (float coverage = 0.5f; coverage > 0.01f; coverage *= 0.9f)
+	{
+		const size_t next = VisibilityCuller::SelectLodLevel(coverage, level);
+		REQUIRE(next >= level);
+		level = next;
+	}
+	REQUIRE(level == 5);
+}
+
+TEST_CASE("Mesh simplification benchmark", "[.][Benchmark]")
+{
+	Dynarray<Vector3f> positions;
+	Dynarray<u32> indices;
+	MakeGrid(256, 2.f, positions, indices);
+
+	Dynarray<u32> result;
+	float error = 0.f;
+	BENCHMARK("Simplification of 256x256 grid to a quarter")
+	{
+		error = MeshOptimization::Simplify(indices, positions, indices.GetSize() / 4, 0.05f, result);
+	}
+
+	// chain of levels halving triangle count, as built on import
+	size_t submitted = indices.GetSize() / 3;
+	Dynarray<u32> source = indices;
+	for (size_t level = 1; level < 4; ++level)
+	{
+		MeshOptimization::Simplify(source, positions, source.GetSize() / 6 * 3, 0.05f, result);
+		WARN("Level " << level << ": " << result.GetSize() / 3 << " triangles");
+		submitted = result.GetSize() / 3;
+		source = result;
+	}
+	WARN("Simplified " << indices.GetSize() / 3 << " triangles to " << result.GetSize() / 3 << " in 3 levels with error " << error
+		<< ", coarsest level skips " << indices.GetSize() / 3 - submitted << " triangles per draw");
+	REQUIRE(submitted < indices.GetSize() / 3);
+}
@@ -0,0 +1,214 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Resources/MeshOptimization.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	void MakeGrid(size_t size, Dynarray<Vector3f>& positions, Dynarray<u32>& indices)
+	{
+		positions.Resize(size * size);
+		for (size_t y = 0; y < size; ++y)
+			for (size_t x = 0; x < size; ++x)
+			{
+				positions[y * size + x].X = float(x);
+				positions[y * size + x].Z = float(y);
+			}
+
+		indices.Clear();
+		for (size_t y = 0; y + 1 < size; ++y)
+			for (size_t x = 0; x + 1 < size; ++x)
+			{
+				const u32 v = u32(y * size + x);
+				for (u32 index : { v, v + u32(size), v + 1, v + 1, v + u32(size), v + u32(size) + 1 })
+					indices.PushBack(index);
+			}
+	}
+
+	// exported meshes often come with triangles in arbitrary order
+	void ShuffleTriangles(Dynarray<u32>& indices)
+	{
+		for (size_t t = indices.GetSize() / 3; t > 1; --t)
+		{
+			const size_t other = size_t(std::rand()) % t;
+			for (size_t k = 0; k < 3; ++k)
+				std::swap(indices[(t - 1) * 3 + k], indices[other * 3 + k]);
+		}
+	}
+
+	// triangles as sorted list of rotated index triples, reordering has to keep winding
+	Dynarray<u64> GetTriangleSet(const Dynarray<u32>& indices)
+	{
+		Dynarray<u64> triangles;
+		for (size_t t = 0; t < indices.GetSize() / 3; ++t)
+		{
+			const u32* tri = indices.GetData() + t * 3;
+			const size_t first = std::min_element(tri, tri + 3) - tri;
+			triangles.PushBack((u64(tri[first]) << 42) | (u64(tri[(first + 1) % 3]) << 21) | u64(tri[(first + 2) % 3]));
+		}
+		std::sort(triangles.GetData(), triangles.GetData() + triangles.GetSize());
+		return triangles;
+	}
+}
+
+TEST_CASE("Mesh attribute quantization", "[MeshOptimization]")
+{
+	float w = 0.f;
+	const Vector3f normal = MeshOptimization::UnpackSnorm10(MeshOptimization::PackSnorm10(Vector3f(0.f, 1.f, 0.f), 1.f), w);
+	REQUIRE(normal.X == 0.f);
+	REQUIRE(normal.Y == 1.f);
+	REQUIRE(normal.Z == 0.f);
+	REQUIRE(w == 1.f);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		const float angle = float(i) * 0.37f;
+		const Vector3f v(std::cos(angle) * 0.6f, std::sin(angle) * 0.6f, -0.8f);
+		const Vector3f unpacked = MeshOptimization::UnpackSnorm10(MeshOptimization::PackSnorm10(v, -1.f), w);
+		REQUIRE(w == -1.f);
+		REQUIRE(std::abs(unpacked.X - v.X) <= 0.5f / 511.f + 1e-6f);
+		REQUIRE(std::abs(unpacked.Y - v.Y) <= 0.5f / 511.f + 1e-6f);
+		REQUIRE(std::abs(unpacked.Z - v.Z) <= 0.5f / 511.f + 1e-6f);
+	}
+
+	REQUIRE(MeshOptimization::PackHalf(0.f) == 0x0000);
+	REQUIRE(MeshOptimization::PackHalf(1.f) == 0x3C00);
+	REQUIRE(MeshOptimization::PackHalf(-2.f) == 0xC000);
+	REQUIRE(MeshOptimization::PackHalf(0.5f) == 0x3800);
+	REQUIRE(MeshOptimization::PackHalf(65504.f) == 0x7BFF);
+	REQUIRE(MeshOptimization::PackHalf(1e6f) == 0x7C00);
+	REQUIRE(MeshOptimization::PackHalf(std::ldexp(1.f, -24)) == 0x0001);
+	REQUIRE(MeshOptimization::PackHalf(1.f + std::ldexp(1.f, -11)) == 0x3C00); // tie rounds to even
+	REQUIRE(MeshOptimization::UnpackHalf(0x3555) == Approx(0.333251953f));
+	REQUIRE(MeshOptimization::UnpackHalf(0x0001) == std::ldexp(1.f, -24));
+
+	// texture coordinates of tiled textures keep 11 significant bits
+	for (float uv = -16.f; uv < 16.f; uv += 0.0137f)
+		REQUIRE(std::abs(MeshOptimization::UnpackHalf(MeshOptimization::PackHalf(uv)) - uv) <= std::max(std::abs(uv), 1.f) / 2048.f);
+}
+
+TEST_CASE("Vertex cache optimization", "[MeshOptimization]")
+{
+	Dynarray<Vector3f> positions;
+	Dynarray<u32> indices;
+	MakeGrid(64, positions, indices);
+	ShuffleTriangles(indices);
+	const Dynarray<u64> triangles = GetTriangleSet(indices);
+
+	const float acmrBefore = MeshOptimization::ComputeACMR(indices, positions.GetSize());
+	MeshOptimization::OptimizeVertexCache(indices, positions.GetSize());
+	const float acmrAfter = MeshOptimization::ComputeACMR(indices, positions.GetSize());
+
+	// shuffled grid misses almost every vertex, optimal order for FIFO 16 is around 0.6
+	CHECK(acmrBefore > 2.f);
+	CHECK(acmrAfter < 0.85f);
+	REQUIRE(GetTriangleSet(indices) == triangles);
+
+	// every vertex is transformed at least once
+	REQUIRE(acmrAfter >= float(positions.GetSize()) / float(indices.GetSize() / 3));
+	REQUIRE(MeshOptimization::ComputeACMR(Dynarray<u32>(), 0) == 0.f);
+	Dynarray<u32> single = { 0, 1, 2 };
+	REQUIRE(MeshOptimization::ComputeACMR(single, 3) == 3.f);
+}
+
+TEST_CASE("Overdraw optimization", "[MeshOptimization]")
+{
+	// two nested boxes split into grids, cache optimized order interleaves them
+	Dynarray<Vector3f> positions;
+	Dynarray<u32> indices;
+	const size_t size = 16;
+	for (float scale : { 1.f, 2.f })
+		for (size_t side = 0; side < 6; ++side)
+		{
+			Dynarray<Vector3f> facePositions;
+			Dynarray<u32> faceIndices;
+			MakeGrid(size, facePositions, faceIndices);
+			const u32 base = u32(positions.GetSize());
+			const float sign = side % 2 ? 1.f : -1.f;
+			positions.Resize(base + facePositions.GetSize());
+			for (size_t i = 0; i < facePositions.GetSize(); ++i)
+			{
+				const float a = scale * (facePositions[i].X / (size - 1) * 2.f - 1.f);
+				const float b = scale * (facePositions[i].Z / (size - 1) * 2.f - 1.f);
+				const float coords[3] = { scale * sign, a, b };
+				// rotate coordinates so every pair of sides faces different axis
+				positions[base + i].X = coords[(3 - side / 2) % 3];
+				positions[base + i].Y = coords[(4 - side / 2) % 3];
+				positions[base + i].Z = coords[(5 - side / 2) % 3];
+			}
+
+			// counter clockwise winding seen from outside
+			const Vector3f& p0 = positions[base + faceIndices[0]];
+			const Vector3f& p1 = positions[base + faceIndices[1]];
+			const Vector3f& p2 = positions[base + faceIndices[2]];
+			const Vector normal = (p1.GetVector() - p0.GetVector()).Cross(p2.GetVector() - p0.GetVector());
+			const bool flip = normal.Dot(p0.GetVector()) < 0.f;
+			for (size_t i = 0; i < faceIndices.GetSize(); i += 3)
+			{
+				indices.PushBack(base + faceIndices[i]);
+				indices.PushBack(base + faceIndices[flip ? i + 2 : i + 1]);
+				indices.PushBack(base + faceIndices[flip ? i + 1 : i + 2]);
+			}
+		}
+	ShuffleTriangles(indices);
+	MeshOptimization::OptimizeVertexCache(indices, positions.GetSize());
+	const Dynarray<u64> triangles = GetTriangleSet(indices);
+	const float acmrBefore = MeshOptimization::ComputeACMR(indices, positions.GetSize());
+
+	MeshOptimization::OptimizeOverdraw(indices, positions, 1.05f);
+	REQUIRE(GetTriangleSet(indices) == triangles);
+	REQUIRE(MeshOptimization::ComputeACMR(indices, positions.GetSize()) <= acmrBefore * 1.05f);
+
+	// outer box is drawn before the inner one on average
+	double outerOrder = 0.0, innerOrder = 0.0;
+	size_t outerCount = 0, innerCount = 0;
+	for (size_t t = 0; t < indices.GetSize() / 3; ++t)
+	{
+		const Vector3f& p = positions[indices[t * 3]];
+		const bool outer = std::max(std::abs(p.X), std::max(std::abs(p.Y), std::abs(p.Z))) > 1.5f;
+		(outer ? outerOrder : innerOrder) += double(t);
+		++(outer ? outerCount : innerCount);
+	}
+	CHECK(outerOrder / outerCount < innerOrder / innerCount);
+}
+
+TEST_CASE("Vertex fetch optimization", "[MeshOptimization]")
+{
+	Dynarray<u32> indices = { 4, 2, 0, 0, 2, 5 };
+	Dynarray<u32> remap;
+	REQUIRE(MeshOptimization::OptimizeVertexFetch(indices, 6, remap) == 4);
+	REQUIRE(indices == Dynarray<u32>({ 0, 1, 2, 2, 1, 3 }));
+	REQUIRE(remap == Dynarray<u32>({ 2, MeshOptimization::INVALID_VERTEX, 1, MeshOptimization::INVALID_VERTEX, 0, 3 }));
+}
+
+TEST_CASE("Mesh optimization report", "[.][Benchmark]")
+{
+	Dynarray<Vector3f> positions;
+	Dynarray<u32> indices;
+	MakeGrid(256, positions, indices);
+	ShuffleTriangles(indices);
+	const Dynarray<u32> shuffled = indices;
+	const float acmrBefore = MeshOptimization::ComputeACMR(indices, positions.GetSize());
+
+	BENCHMARK("Vertex cache optimization of 256x256 grid")
+	{
+		indices = shuffled;
+		MeshOptimization::OptimizeVertexCache(indices, positions.GetSize());
+	}
+	BENCHMARK("Overdraw optimization of 256x256 grid")
+	{
+		MeshOptimization::OptimizeOverdraw(indices, positions, 1.05f);
+	}
+	const float acmrAfter = MeshOptimization::ComputeACMR(indices, positions.GetSize());
+
+	// separate float streams: position, normal, tangent, bitangent and texture coordinates
+	const size_t bytesBefore = 4 * sizeof(Vector3f) + 2 * sizeof(float);
+	// float position stream and interleaved 10-10-10-2 normal and tangent with half float texture coordinates
+	const size_t bytesAfter = sizeof(Vector3f) + 2 * sizeof(u32) + 2 * sizeof(u16);
+	WARN("Vertex size: " << bytesBefore << " -> " << bytesAfter << " bytes, index size: 4 -> "
+		<< (positions.GetSize() <= 65536 ? 2 : 4) << " bytes, ACMR (FIFO " << MeshOptimization::DEFAULT_CACHE_SIZE << "): "
+		<< acmrBefore << " -> " << acmrAfter);
+	REQUIRE(acmrAfter < acmrBefore);
+}
@@ -0,0 +1,248 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <NullRenderingDevice.hpp>
+#include <NullDeviceProxies.hpp>
+#include <Engine.hpp>
+#include <Memory/FrameAllocator.hpp>
+#include <ECS/Scene.hpp>
+#include <ECS/DeferredTaskSystem.hpp>
+#include <ECS/DeferredTaskWorldComponent.hpp>
+#include <Input/InputWorldComponent.hpp>
+#include <Rendering/ViewportWorldComponent.hpp>
+#include <Rendering/MeshRenderingComponent.hpp>
+#include <Rendering/Camera/CameraComponent.hpp>
+#include <Rendering/Lighting/LightSourceComponent.hpp>
+#include <Rendering/Particles/ParticleComponent.hpp>
+#include <Rendering/Particles/ParticleUpdateSystem.hpp>
+#include <Time/TimeWorldComponent.hpp>
+#include <Resources/AssetCache.hpp>
+#include <Resources/MeshResource.hpp>
+#include <Utils/FileIO.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	const ScreenSize TEST_SCREEN_SIZE = { 800, 600 };
+
+	// unit quad facing +Z, written as Wavefront OBJ
+	void WriteQuad(const String& path)
+	{
+		FILE* f;
+		fopen_s(&f, path.GetCStr(), "w");
+		REQUIRE(f);
+		fprintf(f, "v -0.5 -0.5 0\nv 0.5 -0.5 0\nv 0.5 0.5 0\nv -0.5 0.5 0\n");
+		fprintf(f, "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\nvn 0 0 1\n");
+		fprintf(f, "f 1/1/1 2/2/1 3/3/1\nf 1/1/1 3/3/1 4/4/1\n");
+		fclose(f);
+	}
+
+	MeshRenderingComponent* SpawnQuad(Scene* scene, const String& path, const Vector& position)
+	{
+		Entity* entity = DeferredTaskSystem::SpawnEntityImmediate(scene);
+		entity->GetTransform().SetLocalTranslation(position);
+		return DeferredTaskSystem::AddComponentImmediate<MeshRenderingComponent>(scene, entity, path, eResourceSource::NONE);
+	}
+
+	std::atomic<size_t> gHeapAllocationCount(0);
+	void CountAllocation(size_t) { ++gHeapAllocationCount; }
+}
+
+TEST_CASE("Null rendering device proxies", "[NullRenderingDevice]")
+{
+	std::unique_ptr<IRenderingDevice> device(PolyCreateRenderingDevice(nullptr, TEST_SCREEN_SIZE));
+	REQUIRE(device);
+	device->Init();
+	REQUIRE(device->GetScreenSize().Width == TEST_SCREEN_SIZE.Width);
+	REQUIRE(device->GetScreenSize().Height == TEST_SCREEN_SIZE.Height);
+
+	SECTION("Textures")
+	{
+		std::unique_ptr<ITextureDeviceProxy> texture = device->CreateTexture(8, 4, 4, eTextureUsageType::ALBEDO);
+		std::unique_ptr<ITextureDeviceProxy> hdrTexture = device->CreateTexture(2, 2, 3, eTextureUsageType::HDR);
+		const NullTextureDeviceProxy* nullTexture = static_cast<const NullTextureDeviceProxy*>(texture.get());
+
+		// identifiers are unique and never 0, like OpenGL names
+		REQUIRE(texture->GetResourceID() != 0);
+		REQUIRE(hdrTexture->GetResourceID() != 0);
+		REQUIRE(texture->GetResourceID() != hdrTexture->GetResourceID());
+
+		REQUIRE(nullTexture->GetWidth() == 8);
+		REQUIRE(nullTexture->GetHeight() == 4);
+		REQUIRE(nullTexture->GetUsage() == eTextureUsageType::ALBEDO);
+		REQUIRE(nullTexture->GetMipCount() == 0);
+		REQUIRE(nullTexture->GetUploadedSize() == 0);
+
+		const unsigned char data[8 * 4 * 4] = {};
+		texture->SetContent(data);
+		REQUIRE(nullTexture->GetMipCount() == 1);
+		REQUIRE(nullTexture->GetUploadedSize() == 8 * 4 * 4);
+
+		texture->SetSubContent(2, 2, 1, 1, data);
+		REQUIRE(nullTexture->GetUploadedSize() == 8 * 4 * 4 + 2 * 2 * 4);
+
+		const float hdrData[2 * 2 * 3] = {};
+		hdrTexture->SetContentHDR(hdrData);
+		REQUIRE(static_cast<const NullTextureDeviceProxy*>(hdrTexture.get())->GetUploadedSize() == 2 * 2 * 3 * sizeof(float));
+	}
+
+	SECTION("Text fields")
+	{
+		std::unique_ptr<ITextFieldBufferDeviceProxy> textField = device->CreateTextFieldBuffer();
+		REQUIRE(textField->GetResourceID() != 0);
+		REQUIRE(textField->GetResourceSize() == 0);
+		textField->SetContent(5, nullptr);
+		REQUIRE(textField->GetResourceSize() == 5);
+	}
+
+	SECTION("Meshes and particles")
+	{
+		Engine engine(true);
+		engine.InitRenderingDevice(std::move(device));
+
+		const String path = "NullRenderingDeviceProxies.obj";
+		WriteQuad(path);
+		{
+			Scene scene;
+			DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(&scene);
+			const MeshRenderingComponent* quad = SpawnQuad(&scene, path, Vector::ZERO);
+			const MeshResource::SubMesh* subMesh = quad->GetMesh()->GetSubMeshes()[0];
+			const NullMeshDeviceProxy* meshProxy = static_cast<const NullMeshDeviceProxy*>(subMesh->GetMeshProxy());
+			REQUIRE(meshProxy->GetResourceID() != 0);
+			REQUIRE(meshProxy->GetVertexCount() == subMesh->GetMeshData().GetVertexCount());
+			REQUIRE(meshProxy->GetIndexCount() == 6);
+
+			ParticleEmitter::Settings settings;
+			settings.InitialSize = 7;
+			settings.Spritesheet.Source = eResourceSource::NONE;
+			Entity* particles = DeferredTaskSystem::SpawnEntityImmediate(&scene);
+			ParticleComponent* particleCmp = DeferredTaskSystem::AddComponentImmediate<ParticleComponent>(&scene, particles, settings);
+			ParticleEmitter* emitter = particleCmp->GetEmitter();
+			const NullParticleDeviceProxy* particleProxy = static_cast<const NullParticleDeviceProxy*>(emitter->GetParticleProxy());
+			REQUIRE(particleProxy->GetInstanceCount() == 0);
+
+			ParticleUpdateSystem::EmitterEmit(&scene, emitter, particleCmp);
+			ParticleUpdateSystem::EmitterRecreateBuffer(&scene, emitter);
+			REQUIRE(particleProxy->GetInstanceCount() == 7);
+		}
+		remove(path.GetCStr());
+		remove(GetAssetCachePath(path, MeshResource::COOKED_EXTENSION).GetCStr());
+	}
+}
+
+TEST_CASE("Null rendering device world rendering", "[NullRenderingDevice]")
+{
+	Engine engine(true);
+	engine.InitRenderingDevice(std::unique_ptr<IRenderingDevice>(PolyCreateRenderingDevice(nullptr, TEST_SCREEN_SIZE)));
+	const NullRenderingDevice* device = static_cast<const NullRenderingDevice*>(engine.GetRenderingDevice());
+
+	const String path = "NullRenderingDeviceWorld.obj";
+	WriteQuad(path);
+	{
+		Scene scene;
+		DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(&scene);
+		DeferredTaskSystem::AddWorldComponentImmediate<InputWorldComponent>(&scene);
+		DeferredTaskSystem::AddWorldComponentImmediate<ViewportWorldComponent>(&scene);
+
+		// camera at origin looks along -Z, light shines the same way
+		Entity* camera = DeferredTaskSystem::SpawnEntityImmediate(&scene);
+		CameraComponent* cameraCmp = DeferredTaskSystem::AddComponentImmediate<CameraComponent>(&scene, camera, 60_deg, 1.0f, 100.0f);
+		scene.GetWorldComponent<ViewportWorldComponent>()->SetCamera(0, cameraCmp);
+		Entity* light = DeferredTaskSystem::SpawnEntityImmediate(&scene);
+		DeferredTaskSystem::AddComponentImmediate<DirectionalLightComponent>(&scene, light);
+
+		// 3 visible quads, 1 hidden quad shadowing the view and 1 hidden quad shadowing nothing visible
+		SpawnQuad(&scene, path, Vector(0.0f, 0.0f, -10.0f));
+		SpawnQuad(&scene, path, Vector(2.0f, 0.0f, -10.0f));
+		SpawnQuad(&scene, path, Vector(0.0f, 0.0f, -20.0f));
+		SpawnQuad(&scene, path, Vector(0.0f, 0.0f, 50.0f));
+		SpawnQuad(&scene, path, Vector(1000.0f, 0.0f, 50.0f));
+
+		CameraSystem::CameraUpdatePhase(&scene);
+		engine.GetRenderingDevice()->RenderWorld(&scene);
+		REQUIRE(device->GetFrameCount() == 1);
+
+		// all quads share submesh and material, so every queue is drawn with a single instanced draw
+		const SceneRenderQueues& queues = device->GetRenderQueues();
+		REQUIRE(queues.GetDirShadowQueue().GetCommands().GetSize() == 4);
+		REQUIRE(queues.GetDepthPrePassQueue().GetCommands().GetSize() == 3);
+		REQUIRE(queues.GetOpaqueLitQueue().GetCommands().GetSize() == 3);
+		for (const RenderQueue* queue : { &queues.GetDirShadowQueue(), &queues.GetDepthPrePassQueue(), &queues.GetOpaqueLitQueue() })
+			REQUIRE(queue->GetBatches().GetSize() == 1);
+
+		const RenderingStats& stats = device->GetRenderingStats();
+		REQUIRE(stats.ShadowCastersDrawn == 4);
+		REQUIRE(stats.ShadowCastersCulled == 1);
+		REQUIRE(stats.DrawCommands == 10);
+		REQUIRE(stats.InstancedDrawsSaved == 10 - 3);
+		REQUIRE(stats.TrianglesSubmitted == 2 * 10);
+		REQUIRE(stats.TrianglesSkippedByLod == 0);
+
+		// stats are gathered per frame
+		engine.GetRenderingDevice()->RenderWorld(&scene);
+		REQUIRE(device->GetFrameCount() == 2);
+		REQUIRE(device->GetRenderingStats().DrawCommands == 10);
+	}
+	remove(path.GetCStr());
+	remove(GetAssetCachePath(path, MeshResource::COOKED_EXTENSION).GetCStr());
+}
+
+TEST_CASE("Null rendering device steady frames do not allocate", "[NullRenderingDevice]")
+{
+	Engine engine(true);
+	engine.InitRenderingDevice(std::unique_ptr<IRenderingDevice>(PolyCreateRenderingDevice(nullptr, TEST_SCREEN_SIZE)));
+
+	const String path = "NullRenderingDeviceFrames.obj";
+	WriteQuad(path);
+	{
+		Scene scene;
+		DeferredTaskSystem::AddWorldComponentImmediate<DeferredTaskWorldComponent>(&scene);
+		DeferredTaskSystem::AddWorldComponentImmediate<InputWorldComponent>(&scene);
+		DeferredTaskSystem::AddWorldComponentImmediate<ViewportWorldComponent>(&scene);
+		DeferredTaskSystem::AddWorldComponentImmediate<TimeWorldComponent>(&scene);
+
+		Entity* camera = DeferredTaskSystem::SpawnEntityImmediate(&scene);
+		CameraComponent* cameraCmp = DeferredTaskSystem::AddComponentImmediate<CameraComponent>(&scene, camera, 60_deg, 1.0f, 100.0f);
+		scene.GetWorldComponent<ViewportWorldComponent>()->SetCamera(0, cameraCmp);
+		DeferredTaskSystem::AddComponentImmediate<DirectionalLightComponent>(&scene, DeferredTaskSystem::SpawnEntityImmediate(&scene));
+		for (size_t i = 0; i < 3; ++i)
+			DeferredTaskSystem::AddComponentImmediate<PointLightComponent>(&scene, DeferredTaskSystem::SpawnEntityImmediate(&scene));
+		for (size_t i = 0; i < 20; ++i)
+			SpawnQuad(&scene, path, Vector((float)i, 0.0f, (i % 2) ? -10.0f : 10.0f));
+
+		// particles expire as soon as they are updated, so every frame emits and frees the same amount
+		ParticleEmitter::Settings settings;
+		settings.InitialSize = 0;
+		settings.Spritesheet.Source = eResourceSource::NONE;
+		settings.ParticleInitFunc = [](ParticleEmitter::Particle* p) { p->LifeTime = -1.0f; };
+		ParticleComponent* particleCmp = DeferredTaskSystem::AddComponentImmediate<ParticleComponent>(&scene, DeferredTaskSystem::SpawnEntityImmediate(&scene), settings);
+		particleCmp->GetEmitter()->SetBurstEnabled(false);
+
+		// scene view, light gathering, render queues and particle updates of a single frame
+		auto frame = [&]() {
+			particleCmp->GetEmitter()->Emit(100);
+			ParticleUpdateSystem::ParticleUpdatePhase(&scene);
+			CameraSystem::CameraUpdatePhase(&scene);
+			engine.GetRenderingDevice()->RenderWorld(&scene);
+			FrameAllocator::EndFrame();
+		};
+
+		// first frames may enlarge frame arenas and persistent containers
+		for (size_t i = 0; i < 4; ++i)
+			frame();
+
+		gHeapAllocationCount = 0;
+		SetAllocationHook(&CountAllocation);
+		for (size_t i = 0; i < 100; ++i)
+			frame();
+		SetAllocationHook(nullptr);
+		REQUIRE(gHeapAllocationCount == 0);
+
+		const NullRenderingDevice* device = static_cast<const NullRenderingDevice*>(engine.GetRenderingDevice());
+		REQUIRE(device->GetRenderingStats().DrawCommands > 0);
+		REQUIRE(particleCmp->GetEmitter()->GetInstancesCount() == 0);
+	}
+	remove(path.GetCStr());
+	remove(GetAssetCachePath(path, MeshResource::COOKED_EXTENSION).GetCStr());
+}
@@ -33,6 +33,12 @@ class TestClass2 : public RTTIBase {
 };
 RTTI_DEFINE_TYPE(TestClass2)
 
+class TestClass3 : public TestClass {
+	RTTI_DECLARE_TYPE_DERIVED(TestClass3, TestClass) { NO_RTTI_PROPERTY(); }
+public:
+};
+RTTI_DEFINE_TYPE(TestClass3)
+
 TEST_CASE("RTTI basics", "[RTTI]") {
 	TestClass* a = new TestClass();
 	RTTIBase* b = a;
@@ -82,3 +88,84 @@ TEST_CASE("RTTI property", "[RTTI]") {
 	CHECK(properties[2].Name == "Val2");
 	CHECK((char*)b + properties[2].Offset == (char*)&(a->val2));
 }
+
+TEST_CASE("RTTI hierarchy", "[RTTI]") {
+	TestClass3* a = new TestClass3();
+	RTTIBase* b = a;
+	CHECK(rtti_cast<TestClass3*>(b) == a);
+	CHECK(rtti_cast<TestClass*>(b) == a);
+	CHECK(rtti_cast<RTTIBase*>(a) == b);
+	CHECK(rtti_cast<TestClass2*>(b) == nullptr);
+	CHECK(rtti_cast<const TestClass*>(static_cast<const RTTIBase*>(b)) == a);
+	delete a;
+
+	TestClass* c = new TestClass();
+	CHECK(rtti_cast<TestClass3*>(c) == nullptr);
+	CHECK(rtti_cast<RTTIBase*>(c) == c);
+	delete c;
+
+	const RTTI::TypeInfo base = RTTI::TypeInfo::Get<RTTIBase>();
+	const RTTI::TypeInfo derived = RTTI::TypeInfo::Get<TestClass3>();
+	CHECK(derived.isTypeDerivedFrom<TestClass>());
+	CHECK(derived.isTypeDerivedFrom<RTTIBase>());
+	CHECK_FALSE(base.isTypeDerivedFrom<TestClass>());
+	CHECK_FALSE(RTTI::TypeInfo::Get<TestClass2>().isTypeDerivedFrom<TestClass>());
+
+	CHECK(std::string(derived.GetTypeName()) == "TestClass3");
+	CHECK(RTTI::Impl::TypeManager::Get().GetTypeByName("TestClass3") == derived);
+	CHECK(RTTI::Impl::TypeManager::Get().GetTypeByName("NotRegisteredClass") == RTTI::TypeInfo::INVALID);
+}
+
+TEST_CASE("RTTI object identity", "[RTTI]") {
+	TestClass* a = new TestClass();
+	TestClass* b = new TestClass();
+
+	// runtime only objects get UUID on first request
+	CHECK_FALSE(a->HasUUID());
+	const UniqueID id = a->GetUUID();
+	CHECK(id.IsValid());
+	CHECK(a->HasUUID());
+	CHECK(a->GetUUID() == id);
+	CHECK(RTTIObjectsManager::Get().TryGetObjectByID(id) == a);
+	CHECK_FALSE(b->HasUUID());
+	CHECK(b->GetUUID() != id);
+
+	delete a;
+	CHECK(RTTIObjectsManager::Get().TryGetObjectByID(id) == nullptr);
+	delete b;
+}
+
+TEST_CASE("RTTI cast benchmark", "[.][Benchmark]") {
+	// component lookups cast from base pointers, most of the casts fail
+	Dynarray<std::unique_ptr<RTTIBase>> objects;
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		if (i % 3 == 0)
+			objects.PushBack(std::make_unique<TestClass>());
+		else if (i % 3 == 1)
+			objects.PushBack(std::make_unique<TestClass2>());
+		else
+			objects.PushBack(std::make_unique<TestClass3>());
+	}
+
+	size_t found = 0;
+	BENCHMARK("rtti_cast to leaf type (100000 casts)")
+	{
+		for (size_t n = 0; n < 100; ++n)
+			for (const auto& object : objects)
+				found += rtti_cast<TestClass3*>(object.get()) != nullptr;
+	}
+	BENCHMARK("rtti_cast to intermediate type (100000 casts)")
+	{
+		for (size_t n = 0; n < 100; ++n)
+			for (const auto& object : objects)
+				found += rtti_cast<TestClass*>(object.get()) != nullptr;
+	}
+	BENCHMARK("Type name lookup (100000 lookups)")
+	{
+		for (size_t n = 0; n < 100; ++n)
+			for (const auto& object : objects)
+				found += object->GetTypeInfo().GetTypeName()[0] == 'T';
+	}
+	REQUIRE(found > 0);
+}
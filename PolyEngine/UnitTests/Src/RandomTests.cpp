@@ -3,6 +3,7 @@
 #include <Defines.hpp>
 #include <Math/BasicMath.hpp>
 #include <Math/Random.hpp>
+#include <Collections/Dynarray.hpp>
 
 using namespace Poly;
 
@@ -39,3 +40,177 @@ TEST_CASE("Generation of pesudorandom numbers", "Random") {
 		REQUIRE(rnd01 == rnd21);
 	}
 }
+
+namespace
+{
+	// chi-squared statistic of values in [0, 1) over equally sized buckets
+	double ChiSquared(const float* values, size_t count, size_t bucketCount)
+	{
+		Dynarray<size_t> buckets;
+		buckets.Resize(bucketCount);
+		std::fill(buckets.Begin(), buckets.End(), 0);
+		for (size_t i = 0; i < count; ++i)
+			++buckets[std::min(static_cast<size_t>(values[i] * bucketCount), bucketCount - 1)];
+
+		const double expected = double(count) / bucketCount;
+		double chiSquared = 0.0;
+		for (size_t bucket : buckets)
+			chiSquared += (bucket - expected) * (bucket - expected) / expected;
+		return chiSquared;
+	}
+
+	void CheckUniformity(const float* values, size_t count)
+	{
+		double sum = 0.0, sumSq = 0.0, serial = 0.0;
+		for (size_t i = 0; i < count; ++i)
+		{
+			REQUIRE(values[i] >= 0.0f);
+			REQUIRE(values[i] < 1.0f);
+			sum += values[i];
+			sumSq += values[i] * values[i];
+			if (i > 0)
+				serial += (values[i] - 0.5) * (values[i - 1] - 0.5);
+		}
+		const double mean = sum / count;
+		CHECK(mean == Approx(0.5).margin(0.005));
+		CHECK(sumSq / count - mean * mean == Approx(1.0 / 12.0).margin(0.002));
+		// correlation of neighbouring values
+		CHECK(std::abs(serial / count * 12.0) < 0.01);
+		// 63 degrees of freedom, 99.9th percentile is 103.4
+		CHECK(ChiSquared(values, count, 64) < 103.4);
+	}
+}
+
+TEST_CASE("Random generator", "[Random]") {
+	SECTION("Reference sequence") {
+		// xoshiro128** seeded by splitmix64
+		RandomGenerator generator(42);
+		CHECK(generator.NextU32() == 0x69e85a2au);
+		CHECK(generator.NextU32() == 0xf843fad0u);
+		CHECK(generator.NextU32() == 0x0105185fu);
+		CHECK(generator.NextU32() == 0x8a1f1ea6u);
+
+		RandomGenerator jumped(42);
+		jumped.Jump();
+		CHECK(jumped.NextU32() == 0x9204100au);
+		CHECK(jumped.NextU32() == 0x9b51c3a4u);
+	}
+
+	SECTION("Seeding and streams") {
+		RandomGenerator a(7), b(7), c(8);
+		for (size_t i = 0; i < 100; ++i)
+		{
+			const u64 value = a.NextU64();
+			REQUIRE(value == b.NextU64());
+			REQUIRE(value != c.NextU64());
+		}
+
+		a.SetSeed(7);
+		RandomGenerator stream = a.SplitStream();
+		b.SetSeed(7);
+		REQUIRE(stream.NextU64() == b.NextU64());
+		REQUIRE(a.NextU64() != stream.NextU64());
+	}
+
+	SECTION("Statistical quality") {
+		const size_t count = 1 << 20;
+		Dynarray<float> values;
+		values.Resize(count);
+
+		RandomGenerator generator(1);
+		for (float& value : values)
+			value = generator.NextFloat();
+		CheckUniformity(values.GetData(), count);
+
+		generator.FillUniform(values.GetData(), count);
+		CheckUniformity(values.GetData(), count);
+	}
+
+	SECTION("Batch fill") {
+		float values[1027];
+		RandomGenerator a(3), b(3);
+		a.FillUniform(values, 1027, -2.0f, 3.0f);
+		for (float value : values)
+		{
+			REQUIRE(value >= -2.0f);
+			REQUIRE(value <= 3.0f);
+		}
+
+		// results depend only on generator state, also for counts not divisible by SIMD width
+		float other[1027];
+		b.FillUniform(other, 1027, -2.0f, 3.0f);
+		REQUIRE(std::equal(values, values + 1027, other));
+		REQUIRE(a.NextU64() == b.NextU64());
+
+		Vector vectors[130];
+		a.FillVectorRange(vectors, 130, 1.0f, 2.0f);
+		for (const Vector& vector : vectors)
+		{
+			REQUIRE(vector.X >= 1.0f);
+			REQUIRE(vector.Y <= 2.0f);
+			REQUIRE(vector.Z >= 1.0f);
+			REQUIRE(vector.W == 1.0f);
+		}
+		REQUIRE(vectors[0].X != vectors[0].Y);
+	}
+
+	SECTION("Thread local generators") {
+		RandomSetSeed(5);
+		const float mainValue = Random();
+		float workerValue = mainValue;
+		std::thread worker([&workerValue]() { RandomSetSeed(5); workerValue = Random(); });
+		worker.join();
+		REQUIRE(workerValue == mainValue);
+
+		// unseeded workers get different streams
+		float workerValues[2];
+		std::thread first([&workerValues]() { workerValues[0] = Random(); });
+		first.join();
+		std::thread second([&workerValues]() { workerValues[1] = Random(); });
+		second.join();
+		REQUIRE(workerValues[0] != workerValues[1]);
+
+		// seed covers threads which start drawing later
+		for (float& value : workerValues)
+		{
+			RandomSetSeed(7);
+			std::thread worker([&value]() { value = Random(); });
+			worker.join();
+		}
+		REQUIRE(workerValues[0] == workerValues[1]);
+		REQUIRE(workerValues[0] != Random());
+	}
+}
+
+TEST_CASE("Random generator benchmark", "[.][Benchmark]") {
+	const size_t count = 1 << 20;
+	Dynarray<float> values;
+	values.Resize(count);
+
+	float sum = 0.0f;
+	BENCHMARK("rand() based Random (1M floats)")
+	{
+		for (float& value : values)
+			value = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+	}
+	sum += values[0];
+	RandomGenerator generator(1);
+	BENCHMARK("RandomGenerator::NextFloat (1M floats)")
+	{
+		for (float& value : values)
+			value = generator.NextFloat();
+	}
+	sum += values[0];
+	BENCHMARK("Thread local Random (1M floats)")
+	{
+		for (float& value : values)
+			value = Random();
+	}
+	sum += values[0];
+	BENCHMARK("RandomGenerator::FillUniform (1M floats)")
+	{
+		generator.FillUniform(values.GetData(), count);
+	}
+	sum += values[0];
+	REQUIRE(sum >= 0.0f);
+}
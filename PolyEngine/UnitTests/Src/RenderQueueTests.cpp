@@ -0,0 +1,165 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Rendering/RenderQueue.hpp>
+#include <Math/Random.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	// Render queue only compares component pointers, so fake ones are enough for sorting tests.
+	const MeshRenderingComponent* FakeComponent(size_t idx) { return reinterpret_cast<const MeshRenderingComponent*>(0x1000 + idx * 0x100); }
+	const void* FakeGeometry(size_t idx) { return reinterpret_cast<const void*>(0x100000 + idx * 0x100); }
+}
+
+TEST_CASE("Render queue sort keys", "[RenderQueue]") {
+	const u64 key = RenderQueue::MakeSortKey(3, 12345, 678, 9);
+	REQUIRE(RenderQueue::GetPass(key) == 3);
+	REQUIRE(RenderQueue::GetMaterial(key) == 12345);
+	REQUIRE(RenderQueue::GetMesh(key) == 678);
+	REQUIRE((key & 0xffff) == 9);
+
+	// more significant fields dominate
+	REQUIRE(RenderQueue::MakeSortKey(1, 0, 0, 0) > RenderQueue::MakeSortKey(0, RenderQueue::MAX_MATERIAL, RenderQueue::MAX_MESH, 0xffff));
+	REQUIRE(RenderQueue::MakeSortKey(0, 1, 0, 0) > RenderQueue::MakeSortKey(0, 0, RenderQueue::MAX_MESH, 0xffff));
+}
+
+TEST_CASE("Render queue sorting and state change elision", "[RenderQueue]") {
+	RenderQueue queue;
+
+	// 3 materials x 2 meshes, added in worst possible order
+	for (size_t i = 0; i < 60; ++i)
+		queue.Add(0, /*material*/ i % 3, FakeGeometry(i % 2), 0, static_cast<float>(60 - i) / 60.0f, FakeComponent(i), 0);
+	queue.Add(1, 0, FakeGeometry(0), 0, 0.5f, FakeComponent(0), 1);
+	queue.Sort();
+
+	const Dynarray<RenderQueue::Command>& commands = queue.GetCommands();
+	REQUIRE(commands.GetSize() == 61);
+	for (size_t i = 1; i < commands.GetSize(); ++i)
+		REQUIRE(commands[i - 1].SortKey <= commands[i].SortKey);
+
+	// pass 1 command is last, commands with the same state are sorted front to back
+	REQUIRE(RenderQueue::GetPass(commands[60].SortKey) == 1);
+	REQUIRE(commands[60].SubMeshIdx == 1);
+	REQUIRE(commands[0].MeshCmp == FakeComponent(54));
+	REQUIRE(commands[9].MeshCmp == FakeComponent(0));
+
+	// every material is bound once, meshes alternate within every material, new pass rebinds material
+	const RenderQueueStats& stats = queue.GetStats();
+	REQUIRE(stats.Commands == 61);
+	REQUIRE(stats.MaterialChanges == 3 + 1);
+	REQUIRE(stats.MeshChanges == 6 + 1);
+	REQUIRE(stats.GetStateChangesSaved() == 2 * 61 - 4 - 7);
+
+	size_t materialBinds = 0;
+	for (const RenderQueue::Command& cmd : commands)
+		materialBinds += cmd.MaterialChanged ? 1 : 0;
+	REQUIRE(materialBinds == stats.MaterialChanges);
+	REQUIRE(commands[0].ObjectChanged);
+	REQUIRE(commands[0].MaterialChanged);
+	REQUIRE(commands[0].MeshChanged);
+
+	queue.Clear();
+	REQUIRE(queue.GetCommands().GetSize() == 0);
+	REQUIRE(queue.GetStats().Commands == 0);
+}
+
+TEST_CASE("Render queue identifier overflow", "[RenderQueue]") {
+	RenderQueue queue;
+	const size_t meshCount = RenderQueue::MAX_MESH + 10;
+	for (size_t i = 0; i < meshCount; ++i)
+		queue.Add(0, 0, FakeGeometry(i), 0, 0.0f, FakeComponent(0), 0);
+	queue.Add(0, 0, FakeGeometry(meshCount - 1), 0, 0.0f, FakeComponent(0), 0);
+	queue.Sort();
+
+	// meshes sharing overflowed identifier can not be elided
+	REQUIRE(queue.GetStats().MeshChanges == meshCount + 1);
+}
+
+TEST_CASE("Render queue instancing batches", "[RenderQueue]") {
+	RenderQueue queue;
+
+	// 3 materials x 2 meshes in pass 0, one more draw of the first material and mesh in pass 1
+	for (size_t i = 0; i < 60; ++i)
+		queue.Add(0, /*material*/ i % 3, FakeGeometry(i % 2), 0, static_cast<float>(i) / 60.0f, FakeComponent(i), 0);
+	queue.Add(1, 0, FakeGeometry(0), 0, 0.5f, FakeComponent(0), 0);
+	queue.Sort();
+
+	const Dynarray<RenderQueue::Command>& commands = queue.GetCommands();
+	const Dynarray<RenderQueue::Batch>& batches = queue.GetBatches();
+	REQUIRE(batches.GetSize() == 6 + 1);
+	REQUIRE(queue.GetStats().Batches == batches.GetSize());
+	REQUIRE(queue.GetStats().GetDrawsSaved() == 61 - 7);
+
+	// batches cover all commands in order and every batch shares shader, material and mesh
+	size_t next = 0;
+	for (const RenderQueue::Batch& batch : batches)
+	{
+		REQUIRE(batch.First == next);
+		REQUIRE(batch.Count > 0);
+		const u64 stateMask = ~static_cast<u64>(0xffff);
+		for (size_t i = batch.First; i < batch.First + batch.Count; ++i)
+			REQUIRE((commands[i].SortKey & stateMask) == (commands[batch.First].SortKey & stateMask));
+		next += batch.Count;
+	}
+	REQUIRE(next == commands.GetSize());
+	REQUIRE(batches[0].Count == 10);
+	REQUIRE(batches[6].Count == 1);
+
+	// commands with overflowed identifiers are drawn one by one
+	queue.Clear();
+	REQUIRE(queue.GetBatches().GetSize() == 0);
+	const size_t meshCount = RenderQueue::MAX_MESH + 10;
+	for (size_t i = 0; i < meshCount; ++i)
+		queue.Add(0, 0, FakeGeometry(i), 0, 0.0f, FakeComponent(i), 0);
+	queue.Add(0, 0, FakeGeometry(meshCount - 1), 0, 0.0f, FakeComponent(0), 0);
+	queue.Add(0, 0, FakeGeometry(0), 0, 0.0f, FakeComponent(1), 0);
+	queue.Sort();
+	REQUIRE(queue.GetBatches().GetSize() == meshCount + 1);
+	REQUIRE(queue.GetBatches()[0].Count == 2);
+}
+
+TEST_CASE("Render queue levels of detail", "[RenderQueue]") {
+	RenderQueue queue;
+
+	// levels of the same vertex data draw different index ranges
+	for (size_t i = 0; i < 10; ++i)
+		queue.Add(0, 0, FakeGeometry(0), static_cast<u32>(i % 2), 0.0f, FakeComponent(i), 0);
+	queue.Add(0, 0, FakeGeometry(1), 0, 0.0f, FakeComponent(0), 0);
+	queue.Sort();
+
+	REQUIRE(queue.GetBatches().GetSize() == 3);
+	REQUIRE(queue.GetStats().MeshChanges == 3);
+	REQUIRE(queue.GetBatches()[0].Count == 5);
+	REQUIRE(queue.GetBatches()[1].Count == 5);
+}
+
+TEST_CASE("Render queue sorting benchmark", "[.][Benchmark]") {
+	const size_t commandCount = 100000;
+	Dynarray<u64> materials;
+	for (size_t i = 0; i < commandCount; ++i)
+		materials.PushBack(static_cast<u64>(RandomRange(0.0f, 500.0f)));
+
+	RenderQueue queue;
+	BENCHMARK("100000 commands, build")
+	{
+		for (size_t i = 0; i < commandCount; ++i)
+			queue.Add(0, materials[i], FakeGeometry(i % 1000), 0, static_cast<float>(i % 97) / 97.0f, FakeComponent(i), 0);
+	}
+
+	Dynarray<u64> keys;
+	for (const RenderQueue::Command& cmd : queue.GetCommands())
+		keys.PushBack(cmd.SortKey);
+
+	BENCHMARK("100000 commands, radix sort")
+	{
+		queue.Sort();
+	}
+
+	BENCHMARK("100000 keys only, std::sort")
+	{
+		std::sort(keys.Begin(), keys.End());
+	}
+	REQUIRE(queue.GetStats().MaterialChanges <= 501);
+}
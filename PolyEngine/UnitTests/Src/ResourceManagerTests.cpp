@@ -47,3 +47,85 @@ TEST_CASE("ResourceManager loading/freeing", "[ResourceManager]")
 	ResourceManager<DummyResource>::Release(res3);
 	ResourceManager<DummyResource>::Release(res4);
 }
+
+class AsyncDummyResource : public Poly::ResourceBase
+{
+public:
+	AsyncDummyResource(const String& path) { Decode(path); CreateDeviceProxies(); }
+	explicit AsyncDummyResource(ResourceAsyncLoadTag) {}
+
+	static size_t DecodeCount;
+	int Value = 0;
+	bool ProxyCreated = false;
+
+private:
+	void Decode(const String& path, int value = 1)
+	{
+		++DecodeCount;
+		if (path.GetLength() > 0 && path[path.GetLength() - 1] == '!')
+			throw ResourceLoadFailedException();
+		Value = value;
+	}
+	void CreateDeviceProxies() { ProxyCreated = true; }
+
+	template<typename T> friend class Poly::ResourceManager;
+};
+size_t AsyncDummyResource::DecodeCount = 0;
+
+namespace Poly {
+	TEST_DECLARE_RESOURCE(AsyncDummyResource, gAsyncDummyResourcesMap)
+}
+DEFINE_RESOURCE(AsyncDummyResource, gAsyncDummyResourcesMap)
+
+TEST_CASE("ResourceManager asynchronous loading", "[ResourceManager]")
+{
+	AsyncDummyResource::DecodeCount = 0;
+	ResourceLoadHandle<AsyncDummyResource> h1 = ResourceManager<AsyncDummyResource>::LoadAsync("a", eResourceSource::NONE, 5);
+	ResourceLoadHandle<AsyncDummyResource> h2 = ResourceManager<AsyncDummyResource>::LoadAsync("a", eResourceSource::NONE, 5);
+
+	// requests for the same path share one resource and decode it once
+	REQUIRE(h1.GetResource() == h2.GetResource());
+	REQUIRE(h1.GetResource()->GetRefCount() == 2);
+	REQUIRE_FALSE(h1.IsReady());
+	REQUIRE(h1.Get() == nullptr);
+
+	AsyncResourceLoader::Update();
+	REQUIRE(AsyncDummyResource::DecodeCount == 1);
+	REQUIRE(AsyncResourceLoader::GetPendingCount() == 0);
+	REQUIRE(h1.IsReady());
+	REQUIRE_FALSE(h1.HasFailed());
+	REQUIRE(h1.Get()->Value == 5);
+	REQUIRE(h1.Get()->ProxyCreated);
+
+	ResourceManager<AsyncDummyResource>::Release(h2.GetResource());
+	ResourceManager<AsyncDummyResource>::Release(h1.GetResource());
+	REQUIRE(Impl::GetResources<AsyncDummyResource>().empty());
+}
+
+TEST_CASE("ResourceManager synchronous load of pending resource", "[ResourceManager]")
+{
+	ResourceLoadHandle<AsyncDummyResource> handle = ResourceManager<AsyncDummyResource>::LoadAsync("b", eResourceSource::NONE, 7);
+	AsyncDummyResource* res = ResourceManager<AsyncDummyResource>::Load("b", eResourceSource::NONE);
+
+	// synchronous load waits for the pending one instead of loading the file again
+	REQUIRE(res == handle.GetResource());
+	REQUIRE(res->GetState() == eResourceState::READY);
+	REQUIRE(res->Value == 7);
+	REQUIRE(res->GetRefCount() == 2);
+
+	ResourceManager<AsyncDummyResource>::Release(res);
+	ResourceManager<AsyncDummyResource>::Release(handle.GetResource());
+}
+
+TEST_CASE("ResourceManager failed asynchronous loading", "[ResourceManager]")
+{
+	ResourceLoadHandle<AsyncDummyResource> handle = ResourceManager<AsyncDummyResource>::LoadAsync("c!", eResourceSource::NONE);
+	REQUIRE(handle.Wait() == nullptr);
+	REQUIRE(handle.IsReady());
+	REQUIRE(handle.HasFailed());
+	REQUIRE_FALSE(handle.GetResource()->ProxyCreated);
+	REQUIRE(ResourceManager<AsyncDummyResource>::Load("c!", eResourceSource::NONE) == nullptr);
+
+	ResourceManager<AsyncDummyResource>::Release(handle.GetResource());
+	REQUIRE(Impl::GetResources<AsyncDummyResource>().empty());
+}
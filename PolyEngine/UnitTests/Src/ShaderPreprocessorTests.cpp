@@ -0,0 +1,89 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Rendering/ShaderPreprocessor.hpp>
+#include <Utils/FileIO.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	ShaderPreprocessor::IncludeLoader MakeLoader(const std::map<String, String>& files, Dynarray<String>& loaded)
+	{
+		return [&files, &loaded](const String& path)
+		{
+			loaded.PushBack(path);
+			auto it = files.find(path);
+			if (it == files.end())
+				throw FileIOException(path);
+			return it->second;
+		};
+	}
+}
+
+TEST_CASE("Shader include expansion", "[ShaderPreprocessor]")
+{
+	const std::map<String, String> files = {
+		{ "Shaders/common.glsl", "float Common();\n" },
+		{ "Shaders/lights.glsl", "#include \"common.glsl\"\nfloat Lights();\n" },
+		{ "Shaders/Utils/math.glsl", "#include \"../common.glsl\"\nfloat Math();\n" }
+	};
+	Dynarray<String> loaded;
+	Dynarray<String> included;
+
+	SECTION("Include with line directives")
+	{
+		const String result = ShaderPreprocessor::Preprocess("#version 430\n#include \"common.glsl\"\nvoid main() {}\n",
+			"Shaders/test.frag.glsl", {}, MakeLoader(files, loaded), included);
+		REQUIRE(result == "#version 430\n#line 1 1\nfloat Common();\n#line 3 0\nvoid main() {}\n");
+		REQUIRE(included.GetSize() == 1);
+		REQUIRE(included[0] == "Shaders/common.glsl");
+	}
+
+	SECTION("Nested includes relative to including file")
+	{
+		const String result = ShaderPreprocessor::Preprocess("#version 430\n#include \"lights.glsl\"\n#include \"Utils/math.glsl\"\n",
+			"Shaders/test.frag.glsl", {}, MakeLoader(files, loaded), included);
+		REQUIRE(result == "#version 430\n"
+			"#line 1 1\n"
+			"#line 1 2\nfloat Common();\n#line 2 1\n"
+			"float Lights();\n"
+			"#line 3 0\n"
+			"#line 1 3\n"
+			"\n" // common.glsl is included once only
+			"float Math();\n"
+			"#line 4 0\n");
+		REQUIRE(included.GetSize() == 3);
+		REQUIRE(included[0] == "Shaders/lights.glsl");
+		REQUIRE(included[1] == "Shaders/common.glsl");
+		REQUIRE(included[2] == "Shaders/Utils/math.glsl");
+		REQUIRE(loaded.GetSize() == 3);
+	}
+
+	SECTION("Missing include")
+	{
+		REQUIRE_THROWS_AS(ShaderPreprocessor::Preprocess("#version 430\n#include \"missing.glsl\"\n",
+			"Shaders/test.frag.glsl", {}, MakeLoader(files, loaded), included), FileIOException);
+	}
+
+	SECTION("Source without directives is unchanged")
+	{
+		const String source = "#version 430\n// #include in comment is not a directive\nvoid main() {}\n";
+		REQUIRE(ShaderPreprocessor::Preprocess(source, "Shaders/test.frag.glsl", {}, MakeLoader(files, loaded), included) == source);
+		REQUIRE(loaded.GetSize() == 0);
+	}
+}
+
+TEST_CASE("Shader defines", "[ShaderPreprocessor]")
+{
+	const std::map<String, String> files;
+	Dynarray<String> loaded;
+	Dynarray<String> included;
+	const Dynarray<String> defines = { "USE_SHADOWS", "MAX_LIGHTS 8" };
+
+	// defines go after #version, which has to be the first directive
+	REQUIRE(ShaderPreprocessor::Preprocess("// comment\n#version 430 core\nvoid main() {}\n", "test.frag.glsl", defines, MakeLoader(files, loaded), included)
+		== "// comment\n#version 430 core\n#define USE_SHADOWS\n#define MAX_LIGHTS 8\n#line 3 0\nvoid main() {}\n");
+	REQUIRE(ShaderPreprocessor::Preprocess("void main() {}\n", "test.frag.glsl", defines, MakeLoader(files, loaded), included)
+		== "#define USE_SHADOWS\n#define MAX_LIGHTS 8\n#line 1 0\nvoid main() {}\n");
+}
@@ -0,0 +1,235 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Resources/TextureCooking.hpp>
+#include <Resources/TextureResource.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	Dynarray<u8> MakeImage(size_t width, size_t height, size_t channels)
+	{
+		// smooth gradients with a bit of noise, similar to real textures
+		Dynarray<u8> image;
+		image.Resize(width * height * channels);
+		for (size_t y = 0; y < height; ++y)
+			for (size_t x = 0; x < width; ++x)
+				for (size_t c = 0; c < channels; ++c)
+					image[(y * width + x) * channels + c] = u8(125 + 120 * std::sin(0.1f * x * (c + 1) + 0.07f * y) + std::rand() % 8);
+		return image;
+	}
+
+	void DecodeColor565(u16 packed, int color[3])
+	{
+		const int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+		color[0] = (r << 3) | (r >> 2);
+		color[1] = (g << 2) | (g >> 4);
+		color[2] = (b << 3) | (b >> 2);
+	}
+
+	// Reference decoder of BC1 color block (4 color mode only, which is what the encoder produces)
+	void DecodeColorBlock(const u8* block, u8 pixels[16][3])
+	{
+		const u16 c0 = u16(block[0] | (block[1] << 8));
+		const u16 c1 = u16(block[2] | (block[3] << 8));
+		const u32 indices = u32(block[4]) | (u32(block[5]) << 8) | (u32(block[6]) << 16) | (u32(block[7]) << 24);
+		int palette[4][3];
+		DecodeColor565(c0, palette[0]);
+		DecodeColor565(c1, palette[1]);
+		for (size_t c = 0; c < 3; ++c)
+		{
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		REQUIRE(c0 >= c1);
+		for (size_t i = 0; i < 16; ++i)
+			for (size_t c = 0; c < 3; ++c)
+				pixels[i][c] = u8(palette[(indices >> (2 * i)) & 3][c]);
+	}
+
+	void DecodeAlphaBlock(const u8* block, u8 pixels[16])
+	{
+		const int a0 = block[0], a1 = block[1];
+		u64 indices = 0;
+		for (size_t i = 0; i < 6; ++i)
+			indices |= u64(block[2 + i]) << (8 * i);
+		int palette[8] = { a0, a1 };
+		if (a0 > a1)
+			for (int p = 1; p < 7; ++p)
+				palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+		else
+		{
+			for (int p = 1; p < 5; ++p)
+				palette[p + 1] = ((5 - p) * a0 + p * a1) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+		for (size_t i = 0; i < 16; ++i)
+			pixels[i] = u8(palette[(indices >> (3 * i)) & 7]);
+	}
+}
+
+TEST_CASE("Texture mip chain", "[TextureCooking]")
+{
+	REQUIRE(TextureCooking::GetMipCount(1, 1) == 1);
+	REQUIRE(TextureCooking::GetMipCount(256, 256) == 9);
+	REQUIRE(TextureCooking::GetMipCount(300, 20) == 9);
+
+	REQUIRE(TextureCooking::GetLevelSize(eTextureCompression::NONE, 5, 3, 3, 1) == 45);
+	REQUIRE(TextureCooking::GetLevelSize(eTextureCompression::NONE, 5, 3, 3, 4) == 180);
+	REQUIRE(TextureCooking::GetLevelSize(eTextureCompression::BC1, 5, 3, 4, 1) == 2 * 8);
+	REQUIRE(TextureCooking::GetLevelSize(eTextureCompression::BC3, 1, 1, 4, 1) == 16);
+
+	Dynarray<Dynarray<u8>> levels;
+	const Dynarray<u8> image = MakeImage(64, 32, 4);
+	TextureCooking::CookMipChain(image.GetData(), 64, 32, 4, 1, eTextureCompression::BC1, levels);
+	REQUIRE(levels.GetSize() == 7);
+	REQUIRE(levels[0].GetSize() == 16 * 8 * 8);
+	REQUIRE(levels[6].GetSize() == 8);
+
+	TextureCooking::CookMipChain(image.GetData(), 64, 32, 4, 1, eTextureCompression::NONE, levels);
+	REQUIRE(levels.GetSize() == 7);
+	REQUIRE(memcmp(levels[0].GetData(), image.GetData(), image.GetSize()) == 0);
+	REQUIRE(levels[6].GetSize() == 4);
+}
+
+TEST_CASE("Texture box filter downsampling", "[TextureCooking]")
+{
+	// odd sizes and widths not divisible by vector width exercise both SIMD and scalar paths
+	for (size_t channels : { 1, 3, 4 })
+	{
+		const size_t width = 37, height = 17;
+		const Dynarray<u8> image = MakeImage(width, height, channels);
+		Dynarray<u8> result;
+		result.Resize((width / 2) * (height / 2) * channels);
+		TextureCooking::Downsample(image.GetData(), width, height, channels, result.GetData());
+
+		for (size_t y = 0; y < height / 2; ++y)
+			for (size_t x = 0; x < width / 2; ++x)
+				for (size_t c = 0; c < channels; ++c)
+				{
+					const auto at = [&](size_t px, size_t py) { return u32(image[(py * width + px) * channels + c]); };
+					const u32 expected = (at(2 * x, 2 * y) + at(2 * x + 1, 2 * y) + at(2 * x, 2 * y + 1) + at(2 * x + 1, 2 * y + 1) + 2) / 4;
+					REQUIRE(result[(y * (width / 2) + x) * channels + c] == expected);
+				}
+	}
+
+	const float hdr[] = { 1.f, 2.f, 3.f, 6.f, 10.f, 20.f, 30.f, 60.f };
+	float hdrResult[2];
+	TextureCooking::Downsample(hdr, 2, 2, 2, hdrResult);
+	REQUIRE(hdrResult[0] == Approx(11.f));
+	REQUIRE(hdrResult[1] == Approx(22.f));
+
+	// single row or column
+	const u8 row[] = { 10, 20, 30, 40 };
+	u8 rowResult[2];
+	TextureCooking::Downsample(row, 4, 1, 1, rowResult);
+	REQUIRE(rowResult[0] == 15);
+	REQUIRE(rowResult[1] == 35);
+	TextureCooking::Downsample(row, 1, 4, 1, rowResult);
+	REQUIRE(rowResult[0] == 15);
+	REQUIRE(rowResult[1] == 35);
+}
+
+TEST_CASE("Texture block compression", "[TextureCooking]")
+{
+	const size_t width = 30, height = 18; // partial blocks at the edges
+	const size_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	const Dynarray<u8> image = MakeImage(width, height, 4);
+
+	Dynarray<u8> bc1;
+	bc1.Resize(TextureCooking::GetLevelSize(eTextureCompression::BC1, width, height, 4, 1));
+	TextureCooking::CompressBC1(image.GetData(), width, height, 4, bc1.GetData());
+	Dynarray<u8> bc3;
+	bc3.Resize(TextureCooking::GetLevelSize(eTextureCompression::BC3, width, height, 4, 1));
+	TextureCooking::CompressBC3(image.GetData(), width, height, bc3.GetData());
+
+	int maxColorError = 0, maxAlphaError = 0;
+	double colorErrorSum = 0;
+	for (size_t by = 0; by < blocksY; ++by)
+		for (size_t bx = 0; bx < blocksX; ++bx)
+		{
+			u8 colors[16][3], bc3Colors[16][3], alphas[16];
+			DecodeColorBlock(bc1.GetData() + (by * blocksX + bx) * 8, colors);
+			DecodeAlphaBlock(bc3.GetData() + (by * blocksX + bx) * 16, alphas);
+			DecodeColorBlock(bc3.GetData() + (by * blocksX + bx) * 16 + 8, bc3Colors);
+			REQUIRE(memcmp(colors, bc3Colors, sizeof(colors)) == 0);
+
+			for (size_t i = 0; i < 16; ++i)
+			{
+				const size_t x = bx * 4 + i % 4, y = by * 4 + i / 4;
+				if (x >= width || y >= height)
+					continue;
+				const u8* pixel = image.GetData() + (y * width + x) * 4;
+				for (size_t c = 0; c < 3; ++c)
+				{
+					const int error = std::abs(int(colors[i][c]) - int(pixel[c]));
+					maxColorError = std::max(maxColorError, error);
+					colorErrorSum += error;
+				}
+				maxAlphaError = std::max(maxAlphaError, std::abs(int(alphas[i]) - int(pixel[3])));
+			}
+		}
+	// 4x4 blocks of smooth gradients are approximated well by 4 colors on a line
+	CHECK(colorErrorSum / (width * height * 3) < 8.0);
+	CHECK(maxColorError < 48);
+	CHECK(maxAlphaError <= 20);
+
+	// uniform block is reproduced up to 565 quantization
+	const u8 solid[4] = { 200, 100, 50, 128 };
+	u8 solidImage[16 * 4];
+	for (size_t i = 0; i < 16; ++i)
+		memcpy(solidImage + i * 4, solid, 4);
+	u8 solidBlock[16];
+	TextureCooking::CompressBC3(solidImage, 4, 4, solidBlock);
+	u8 solidColors[16][3], solidAlphas[16];
+	DecodeAlphaBlock(solidBlock, solidAlphas);
+	DecodeColorBlock(solidBlock + 8, solidColors);
+	for (size_t i = 0; i < 16; ++i)
+	{
+		REQUIRE(solidAlphas[i] == 128);
+		for (size_t c = 0; c < 3; ++c)
+			REQUIRE(std::abs(int(solidColors[i][c]) - int(solid[c])) <= 4);
+	}
+}
+
+TEST_CASE("Texture compression selection", "[TextureCooking]")
+{
+	Dynarray<u8> image = MakeImage(8, 8, 4);
+	for (size_t i = 0; i < 64; ++i)
+		image[i * 4 + 3] = 255;
+	REQUIRE(TextureResource::GetTextureCompression(eTextureUsageType::ALBEDO, image.GetData(), 8, 8, 4) == eTextureCompression::BC1);
+	image[17 * 4 + 3] = 254;
+	REQUIRE(TextureResource::GetTextureCompression(eTextureUsageType::ALBEDO, image.GetData(), 8, 8, 4) == eTextureCompression::BC3);
+	REQUIRE(TextureResource::GetTextureCompression(eTextureUsageType::ROUGHNESS, image.GetData(), 8, 8, 3) == eTextureCompression::BC1);
+	REQUIRE(TextureResource::GetTextureCompression(eTextureUsageType::NORMAL, image.GetData(), 8, 8, 3) == eTextureCompression::NONE);
+	REQUIRE(TextureResource::GetTextureCompression(eTextureUsageType::HDR, image.GetData(), 8, 8, 3) == eTextureCompression::NONE);
+}
+
+TEST_CASE("Texture cooking benchmark", "[.][Benchmark]")
+{
+	const size_t size = 2048;
+	const Dynarray<u8> image = MakeImage(size, size, 4);
+	Dynarray<Dynarray<u8>> levels;
+
+	size_t uncompressedSize = 0, compressedSize = 0;
+	BENCHMARK("Mip chain 2048x2048 RGBA8")
+	{
+		TextureCooking::CookMipChain(image.GetData(), size, size, 4, 1, eTextureCompression::NONE, levels);
+	}
+	for (const Dynarray<u8>& level : levels)
+		uncompressedSize += level.GetSize();
+
+	BENCHMARK("Mip chain 2048x2048 BC1")
+	{
+		TextureCooking::CookMipChain(image.GetData(), size, size, 4, 1, eTextureCompression::BC1, levels);
+	}
+	for (const Dynarray<u8>& level : levels)
+		compressedSize += level.GetSize();
+
+	// runtime path before cooking: full resolution RGBA8 upload, mips generated by the driver
+	WARN("Texture memory with mips: RGBA8 " << uncompressedSize / 1024 << " KiB, BC1 " << compressedSize / 1024 << " KiB");
+	// 4 bits per pixel, levels smaller than a block still take whole block
+	REQUIRE(compressedSize * 7 < uncompressedSize);
+}
@@ -0,0 +1,87 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <Rendering/UniformTable.hpp>
+
+using namespace Poly;
+
+namespace
+{
+	// uniforms of light accumulation shader set per draw or per material
+	const char* const UNIFORM_NAMES[] = {
+		"uClipFromModel", "uWorldFromModel", "uMaterial.Emissive", "uMaterial.Albedo", "uMaterial.Roughness",
+		"uMaterial.Metallic", "uMaterial.OpacityMaskThreshold", "uEmissiveMap", "uAlbedoMap", "uRoughnessMap",
+		"uMetallicMap", "uNormalMap", "uAmbientOcclusionMap", "uBrdfLUT", "uIrradianceMap", "uPrefilterMap", "uDirShadowMap"
+	};
+}
+
+TEST_CASE("Uniform name hashing", "[UniformTable]")
+{
+	constexpr UniformName name("uMaterial.Albedo");
+	static_assert(name.GetHash() == UniformName("uMaterial.Albedo").GetHash(), "Hash has to be computed at compile time");
+	static_assert(UniformName("").GetHash() == 2166136261u, "FNV-1a offset basis");
+	static_assert(UniformName("a").GetHash() == 0xE40C292Cu, "FNV-1a reference value");
+
+	REQUIRE(UniformName(String("uMaterial.Albedo")).GetHash() == name.GetHash());
+	REQUIRE(UniformName(String("uDirectionalLight[") + String::From(1) + String("]")).GetHash() == UniformName("uDirectionalLight[1]").GetHash());
+	REQUIRE(UniformName("uMaterial.Albedo").GetHash() != UniformName("uMaterial.Emissive").GetHash());
+}
+
+TEST_CASE("Uniform table", "[UniformTable]")
+{
+	UniformTable table;
+	int location = 0;
+	for (const char* name : UNIFORM_NAMES)
+		REQUIRE(table.Register(name, eUniformType::VEC4, location++));
+	REQUIRE(table.GetSize() == location);
+	REQUIRE_FALSE(table.Register("uAlbedoMap", eUniformType::SAMPLER_2D, 100));
+
+	location = 0;
+	for (const char* name : UNIFORM_NAMES)
+	{
+		const UniformTable::Entry* entry = table.Find(name);
+		REQUIRE(entry != nullptr);
+		REQUIRE(entry->Location == location++);
+		REQUIRE(entry->Type == eUniformType::VEC4);
+		REQUIRE(entry->Name == name);
+	}
+	REQUIRE(table.Find("uMaterial") == nullptr);
+	REQUIRE(UniformTable().Find("uTime") == nullptr);
+
+	REQUIRE(UniformTable::GetTypeFromName("mat4") == eUniformType::MAT4);
+	REQUIRE(UniformTable::GetTypeFromName("samplerCube") == eUniformType::SAMPLER_CUBE);
+	REQUIRE(UniformTable::GetTypeFromName("Material") == eUniformType::OTHER);
+}
+
+TEST_CASE("Uniform lookup benchmark", "[.][Benchmark]")
+{
+	std::map<String, int> stringMap;
+	UniformTable table;
+	int location = 0;
+	for (const char* name : UNIFORM_NAMES)
+	{
+		stringMap[String(name)] = location;
+		table.Register(name, eUniformType::VEC4, location++);
+	}
+
+	// material change in lit pass sets 11 uniforms, 1000 material changes per frame
+	const size_t iterations = 1000;
+	int sum = 0;
+	BENCHMARK("String map lookup with String construction (11000 lookups)")
+	{
+		for (size_t i = 0; i < iterations; ++i)
+			for (size_t n = 2; n < 13; ++n)
+				sum += stringMap.find(String(UNIFORM_NAMES[n]))->second;
+	}
+	BENCHMARK("Hashed lookup with compile time hashes (11000 lookups)")
+	{
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			constexpr UniformName names[] = { "uMaterial.Emissive", "uMaterial.Albedo", "uMaterial.Roughness", "uMaterial.Metallic",
+				"uMaterial.OpacityMaskThreshold", "uEmissiveMap", "uAlbedoMap", "uRoughnessMap", "uMetallicMap", "uNormalMap", "uAmbientOcclusionMap" };
+			for (const UniformName& name : names)
+				sum += table.Find(name)->Location;
+		}
+	}
+	REQUIRE(sum > 0);
+}
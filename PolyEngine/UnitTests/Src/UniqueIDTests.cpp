@@ -10,3 +10,21 @@ TEST_CASE("String conversions", "[UniqueID]")
 	UniqueID a = UniqueID::FromString("abcdef01-2345-6789-abcd-ef0123456789").Value();
 	CHECK(a.ToString() == String("abcdef01-2345-6789-abcd-ef0123456789"));
 }
+
+TEST_CASE("Generation", "[UniqueID]")
+{
+	std::unordered_map<UniqueID, size_t> generated;
+	for (size_t i = 0; i < 10000; ++i)
+	{
+		const UniqueID id = UniqueID::Generate();
+		REQUIRE(id.IsValid());
+		REQUIRE(generated.emplace(id, i).second);
+
+		// RFC 4122 version 4 and variant bits
+		const String str = id.ToString();
+		REQUIRE(str[14] == '4');
+		REQUIRE((str[19] == '8' || str[19] == '9' || str[19] == 'a' || str[19] == 'b'));
+		REQUIRE(UniqueID::FromString(str).Value() == id);
+	}
+	REQUIRE_FALSE(UniqueID().IsValid());
+}
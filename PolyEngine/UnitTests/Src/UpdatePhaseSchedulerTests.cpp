@@ -0,0 +1,125 @@
+#include <Defines.hpp>
+#include <catch.hpp>
+
+#include <ECS/UpdatePhaseScheduler.hpp>
+#include <ECS/EntityTransform.hpp>
+// test components
+#include <Audio/SoundListenerComponent.hpp>
+#include <Movement/FreeFloatMovementComponent.hpp>
+#include <Rendering/PostprocessSettingsComponent.hpp>
+
+using namespace Poly;
+
+TEST_CASE("Update phase access conflicts", "[UpdatePhaseScheduler]") {
+	UpdatePhaseAccess readMovement = UpdatePhaseAccess().Reads<FreeFloatMovementComponent>();
+	UpdatePhaseAccess writeMovement = UpdatePhaseAccess().Writes<FreeFloatMovementComponent, EntityTransform>();
+	UpdatePhaseAccess writeListener = UpdatePhaseAccess().Writes<SoundListenerComponent>().OnMainThread();
+
+	REQUIRE(!readMovement.ConflictsWith(readMovement));
+	REQUIRE(readMovement.ConflictsWith(writeMovement));
+	REQUIRE(writeMovement.ConflictsWith(readMovement));
+	REQUIRE(writeMovement.ConflictsWith(writeMovement));
+	REQUIRE(!writeMovement.ConflictsWith(writeListener));
+	REQUIRE(!readMovement.IsMainThreadOnly());
+	REQUIRE(writeListener.IsMainThreadOnly());
+
+	UpdatePhaseAccess exclusive = UpdatePhaseAccess::Exclusive();
+	REQUIRE(exclusive.IsMainThreadOnly());
+	REQUIRE(exclusive.ConflictsWith(UpdatePhaseAccess()));
+	REQUIRE(UpdatePhaseAccess().ConflictsWith(exclusive));
+}
+
+TEST_CASE("Update phase batches", "[UpdatePhaseScheduler]") {
+	UpdatePhaseScheduler scheduler;
+	Dynarray<size_t> order;
+	auto phase = [&order](size_t idx) { return [&order, idx](Scene*) { order.PushBack(idx); }; };
+
+	scheduler.AddPhase(phase(0), UpdatePhaseAccess().Writes<FreeFloatMovementComponent>());
+	scheduler.AddPhase(phase(1), UpdatePhaseAccess().Writes<SoundListenerComponent>().OnMainThread());
+	scheduler.AddPhase(phase(2), UpdatePhaseAccess().Reads<FreeFloatMovementComponent>());
+	scheduler.AddPhase(phase(3), UpdatePhaseAccess().Reads<PostprocessSettingsComponent>());
+	scheduler.AddPhase(phase(4), UpdatePhaseAccess::Exclusive());
+	scheduler.AddPhase(phase(5), UpdatePhaseAccess().Reads<PostprocessSettingsComponent>());
+
+	const Dynarray<Dynarray<size_t>>& batches = scheduler.GetBatches();
+	REQUIRE(batches.GetSize() == 4);
+	REQUIRE(batches[0] == Dynarray<size_t>{ 0, 1, 3 });
+	REQUIRE(batches[1] == Dynarray<size_t>{ 2 });
+	REQUIRE(batches[2] == Dynarray<size_t>{ 4 });
+	REQUIRE(batches[3] == Dynarray<size_t>{ 5 });
+
+	// serial job system keeps registration order
+	JobSystem serial(0);
+	scheduler.Execute(nullptr, serial);
+	REQUIRE(order == Dynarray<size_t>{ 0, 1, 2, 3, 4, 5 });
+}
+
+TEST_CASE("Parallel update phase execution", "[UpdatePhaseScheduler]") {
+	JobSystem jobs(3);
+	UpdatePhaseScheduler scheduler;
+
+	// chain of dependent phases mixed with independent ones, each writer has to see the value written by previous one
+	std::atomic<int> chainValue{ 0 };
+	std::atomic<int> independentCount{ 0 };
+	std::atomic<bool> orderBroken{ false };
+	const std::thread::id mainThread = std::this_thread::get_id();
+	std::atomic<bool> mainThreadPhaseMoved{ false };
+
+	for (int i = 0; i < 8; ++i)
+	{
+		scheduler.AddPhase([&chainValue, &orderBroken, i](Scene*) {
+			if (chainValue.load() != i)
+				orderBroken = true;
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+			chainValue = i + 1;
+		}, UpdatePhaseAccess().Writes<FreeFloatMovementComponent>());
+
+		scheduler.AddPhase([&independentCount](Scene*) { ++independentCount; }, UpdatePhaseAccess().Reads<PostprocessSettingsComponent>());
+		scheduler.AddPhase([&mainThreadPhaseMoved, mainThread](Scene*) {
+			if (std::this_thread::get_id() != mainThread)
+				mainThreadPhaseMoved = true;
+		}, UpdatePhaseAccess().Reads<SoundListenerComponent>().OnMainThread());
+	}
+
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		chainValue = 0;
+		scheduler.Execute(nullptr, jobs);
+		REQUIRE(chainValue == 8);
+	}
+	REQUIRE(!orderBroken);
+	REQUIRE(!mainThreadPhaseMoved);
+	REQUIRE(independentCount == 80);
+}
+
+TEST_CASE("Update phase scheduling scaling benchmark", "[.][Benchmark]") {
+	const size_t phaseCount = 16;
+	const size_t maxWorkers = std::max<size_t>(JobSystem::GetDefaultWorkerCount(), 3);
+
+	for (size_t workerCount = 0; workerCount <= maxWorkers; ++workerCount)
+	{
+		JobSystem jobs(workerCount);
+		UpdatePhaseScheduler scheduler;
+
+		// independent CPU-bound phases, results are kept per phase so they can not be optimized away
+		Dynarray<double> results;
+		results.Resize(phaseCount);
+		for (size_t i = 0; i < phaseCount; ++i)
+		{
+			scheduler.AddPhase([&results, i](Scene*) {
+				double acc = 0.0;
+				for (size_t n = 1; n < 200000; ++n)
+					acc += std::sqrt(static_cast<double>(n + i));
+				results[i] = acc;
+			}, UpdatePhaseAccess());
+		}
+
+		BENCHMARK(std::to_string(phaseCount) + " independent phases, " + std::to_string(workerCount) + " workers")
+		{
+			scheduler.Execute(nullptr, jobs);
+		}
+
+		for (size_t i = 1; i < phaseCount; ++i)
+			REQUIRE(results[i] > results[i - 1]);
+	}
+}